@@ -5,6 +5,12 @@
 //!
 //! Usage:
 //!   cargo run --bin music_viz [-- <group>]   (group 0-6, default 3 = intro)
+//!   cargo run --bin music_viz -- <group> --render FILE
+//!
+//! `--render FILE` skips the visualizer: the group is rendered offline, as
+//! fast as the CPU allows, through the game's own sequencer and mixer
+//! (`audio::render_score`) and written to `FILE` as 16-bit stereo WAV.  One
+//! pass of each track is rendered; looping tracks are cut after it.
 //!
 //! Controls:
 //!   Space         — pause / resume
@@ -15,15 +21,22 @@
 //!   Q / Esc       — quit
 
 // ---------------------------------------------------------------------------
-// Bring in the songs module directly (it has no intra-crate deps).
+// Bring in the songs module directly (it has no intra-crate deps), and the
+// game's audio module for the offline renderer.
 // ---------------------------------------------------------------------------
-#[allow(dead_code, unused_imports)]
-#[path = "../game/songs.rs"]
-mod songs;
+#[path = "../game"]
+mod game {
+    #[allow(dead_code, unused_imports)]
+    pub mod audio;
+    #[allow(dead_code, unused_imports)]
+    pub mod songs;
+    #[allow(dead_code, unused_imports)]
+    pub mod spsc;
+}
 
-use songs::{
+use game::songs::{
     SongLibrary, Track, TrackEvent, AMIGA_CLOCK_NTSC, DEFAULT_TEMPO, NOTE_DURATIONS, PTABLE,
-    VBL_RATE_HZ,
+    TIMECLOCK_RATE, VBL_RATE_HZ,
 };
 
 // ---------------------------------------------------------------------------
@@ -1012,6 +1025,47 @@ fn pad_or_clip(s: &str, width: usize) -> String {
 // Entry point
 // ---------------------------------------------------------------------------
 
+/// `--render`: one pass of `group` rendered offline and written as WAV.
+fn render_wav(
+    songs: &SongLibrary,
+    instruments: &game::audio::Instruments,
+    group: usize,
+    path: &Path,
+) -> io::Result<()> {
+    let tracks = songs
+        .compiled_group(group)
+        .ok_or_else(|| io::Error::new(io::ErrorKind::NotFound, format!("no song group {group}")))?;
+    // The longest voice sets the length; one extra second lets the tails ring out.
+    let ticks = tracks.iter().map(|t| t.duration_ticks).max().unwrap_or(0) as u64;
+    let frames = (ticks * SAMPLE_RATE as u64 / TIMECLOCK_RATE as u64) as usize + SAMPLE_RATE as usize;
+    let pcm = game::audio::render_score(tracks, instruments, false, frames);
+
+    let data_len = (pcm.len() * 2) as u32;
+    let mut wav = Vec::with_capacity(44 + data_len as usize);
+    wav.extend_from_slice(b"RIFF");
+    wav.extend_from_slice(&(36 + data_len).to_le_bytes());
+    wav.extend_from_slice(b"WAVEfmt ");
+    wav.extend_from_slice(&16u32.to_le_bytes());
+    wav.extend_from_slice(&1u16.to_le_bytes()); // PCM
+    wav.extend_from_slice(&2u16.to_le_bytes()); // channels
+    wav.extend_from_slice(&SAMPLE_RATE.to_le_bytes());
+    wav.extend_from_slice(&(SAMPLE_RATE * 4).to_le_bytes()); // bytes per second
+    wav.extend_from_slice(&4u16.to_le_bytes()); // bytes per frame
+    wav.extend_from_slice(&16u16.to_le_bytes()); // bits per sample
+    wav.extend_from_slice(b"data");
+    wav.extend_from_slice(&data_len.to_le_bytes());
+    for sample in &pcm {
+        wav.extend_from_slice(&sample.to_le_bytes());
+    }
+    std::fs::write(path, wav)?;
+    println!(
+        "{}: group {group}, {:.1} s",
+        path.display(),
+        pcm.len() as f64 / 2.0 / SAMPLE_RATE as f64
+    );
+    Ok(())
+}
+
 fn main() -> Result<(), Box<dyn std::error::Error>> {
     let base = Path::new(env!("CARGO_MANIFEST_DIR"));
     let songs = SongLibrary::load(&base.join("game/songs"))
@@ -1026,6 +1080,13 @@ fn main() -> Result<(), Box<dyn std::error::Error>> {
         .and_then(|s| s.parse::<usize>().ok())
         .unwrap_or(3);
 
+    if let Some(i) = args.iter().position(|a| a == "--render") {
+        let out = args.get(i + 1).ok_or("--render needs an output file")?;
+        let instruments = game::audio::Instruments::load(&base.join("game/v6"))
+            .expect("Could not load game/v6 — run from the project root");
+        return Ok(render_wav(&songs, &instruments, initial_group, Path::new(out))?);
+    }
+
     // ── SDL3 audio setup ────────────────────────────────────────────────────
     let sdl = sdl3::init()?;
     let audio_ss = sdl.audio()?;
@@ -0,0 +1,100 @@
+//! Build the sprite/tile decode cache bundle (see `src/game/bundle.rs`).
+//!
+//! Runs the game's own sprite and tile decoders over the ADF named by
+//! `faery.toml` and writes their output to one bundle file.  Nothing else
+//! is bundled.  The game maps the
+//! bundle at startup and falls back to decoding the ADF whenever the bundle is
+//! missing or was built from different data, so re-run this after changing
+//! the ADF or the region tables.
+//!
+//! Usage:
+//!   cargo run --release --bin pack_bundle -- [--lib faery.toml] [--out FILE]
+
+#[path = "../game/mod.rs"]
+mod game;
+
+use std::path::{Path, PathBuf};
+use std::process::ExitCode;
+
+use clap::Parser;
+
+use game::adf::AdfDisk;
+use game::bundle::{self, BundleWriter};
+use game::ecs::resources::SpriteSheets;
+use game::game_library;
+use game::region_cache::{RegionAssets, RegionSource};
+use game::sprites::SpriteSheet;
+
+#[derive(Parser, Debug)]
+#[command(about = "Write the sprite/tile decode cache bundle")]
+struct Cli {
+    /// Game library to read region tables and the ADF path from.
+    #[arg(long, default_value = "faery.toml")]
+    lib: String,
+    /// Output path; defaults to the `[disk] bundle` entry or game/fmain.bundle.
+    #[arg(long)]
+    out: Option<PathBuf>,
+}
+
+fn main() -> ExitCode {
+    let cli = Cli::parse();
+    let game_lib = match game_library::load_game_library(Path::new(&cli.lib)) {
+        Ok(lib) => lib,
+        Err(e) => {
+            eprintln!("Failed to load game library {}: {}", cli.lib, e);
+            return ExitCode::FAILURE;
+        }
+    };
+    let adf_path = game_lib.disk.as_ref().map_or("game/image", |d| d.adf.as_str());
+    let adf = match AdfDisk::open(Path::new(adf_path)) {
+        Ok(adf) => adf,
+        Err(e) => {
+            eprintln!("{e:#}");
+            return ExitCode::FAILURE;
+        }
+    };
+
+    let mut writer = BundleWriter::default();
+    let mut sheets = 0;
+    for cfile_idx in SpriteSheets::CHARACTER_CFILES {
+        if let Some(sheet) = SpriteSheet::load(&adf, cfile_idx) {
+            writer.add_sprite_sheet(&sheet);
+            sheets += 1;
+        }
+    }
+    if let Some(sheet) = SpriteSheet::load_objects(&adf) {
+        writer.add_sprite_sheet(&sheet);
+        sheets += 1;
+    }
+
+    let mut regions = 0;
+    for region in 0..=u8::MAX {
+        let Some(src) = RegionSource::from_library(&game_lib, region) else {
+            continue;
+        };
+        match RegionAssets::load(&src, &adf, None) {
+            Ok(assets) => {
+                writer.add_tile_atlas(region, &assets.atlas);
+                regions += 1;
+            }
+            Err(e) => eprintln!("Skipping region {region}: {e:#}"),
+        }
+    }
+
+    let out = cli
+        .out
+        .unwrap_or_else(|| PathBuf::from(bundle::bundle_path(&game_lib)));
+    let fingerprint = bundle::source_fingerprint(&adf, &game_lib);
+    if let Err(e) = writer.write(&out, fingerprint) {
+        eprintln!("{e:#}");
+        return ExitCode::FAILURE;
+    }
+    println!(
+        "Wrote {}: {} sprite sheets, {} tile atlases, fingerprint {:016x}",
+        out.display(),
+        sheets,
+        regions,
+        fingerprint
+    );
+    ExitCode::SUCCESS
+}
@@ -0,0 +1,641 @@
+//! Headless simulation runner for throughput benchmarking.
+//!
+//! Loads `faery.toml` and the ADF, builds an `EcsScene` without a window or
+//! audio device, and runs the gameplay tick schedule as fast as possible with
+//! scripted input.  Reports ticks/sec, heap allocations per tick and the time
+//! spent in each system.  Tick-derived randomness makes runs with the same
+//! script reproducible.
+//!
+//! With `--runs N` it instead plays N independent seeded random walks across
+//! all cores for balance sweeps.  The scenes share one `GameLibrary`, ADF,
+//! set of sprite sheets and decoded-region store, and each run prints one
+//! JSON line of encounter/combat stats to stdout.
+//!
+//! Usage:
+//!   cargo run --release --bin sim_bench -- [--ticks N] [--script FILE] [--parallel]
+//!   cargo run --release --bin sim_bench -- --runs N [--jobs J] [--seed S] [--ticks N]
+//!   cargo run --release --bin sim_bench -- --replay FILE
+//!
+//! `--record FILE` writes the scripted run as an input journal (see
+//! `src/game/ecs/journal.rs`); `fmainrs --record FILE` does the same for a
+//! played session.  `--replay FILE` plays a journal back as fast as possible,
+//! checks its state hashes, and fails at the first tick that diverges.
+//!
+//! Script format: one step per line, `<ticks> <dir> [fire]`, where `<dir>` is
+//! one of `N NE E SE S SW W NW -` (`-` = stand still).  Blank lines and `#`
+//! comments are ignored; the script repeats until `--ticks` have run.  Without
+//! a script the hero walks a fixed eight-direction loop.
+
+#[path = "../game/mod.rs"]
+mod game;
+
+use std::alloc::{GlobalAlloc, Layout, System};
+use std::cell::Cell;
+use std::fs;
+use std::path::{Path, PathBuf};
+use std::process::ExitCode;
+use std::sync::atomic::{AtomicBool, AtomicU32, Ordering};
+use std::sync::Arc;
+use std::thread;
+use std::time::Instant;
+
+use clap::Parser;
+use serde::Serialize;
+
+use game::direction::Direction;
+use game::ecs::components::HeroStats;
+use game::ecs::journal::{self, Journal};
+use game::ecs::scene::{EcsScene, SharedAssets};
+use game::game_library::{self, GameLibrary};
+use game::scene::SceneResult;
+
+/// System allocator that counts allocations made on the calling thread, so
+/// the tick loop's own allocations can be told apart from worker threads'.
+struct CountingAlloc;
+
+thread_local! {
+    static ALLOCATIONS: Cell<u64> = const { Cell::new(0) };
+}
+
+fn count_allocation() {
+    // try_with: the counter may already be gone during thread teardown.
+    let _ = ALLOCATIONS.try_with(|n| n.set(n.get() + 1));
+}
+
+/// Allocations (including reallocations) made so far on this thread.
+fn allocations() -> u64 {
+    ALLOCATIONS.try_with(Cell::get).unwrap_or(0)
+}
+
+// SAFETY: every call is forwarded unchanged to `System`; the counter is a
+// const-initialised thread-local `Cell` without a destructor, so touching it
+// never allocates or re-enters the allocator.
+unsafe impl GlobalAlloc for CountingAlloc {
+    unsafe fn alloc(&self, layout: Layout) -> *mut u8 {
+        count_allocation();
+        System.alloc(layout)
+    }
+
+    unsafe fn alloc_zeroed(&self, layout: Layout) -> *mut u8 {
+        count_allocation();
+        System.alloc_zeroed(layout)
+    }
+
+    unsafe fn realloc(&self, ptr: *mut u8, layout: Layout, new_size: usize) -> *mut u8 {
+        count_allocation();
+        System.realloc(ptr, layout, new_size)
+    }
+
+    unsafe fn dealloc(&self, ptr: *mut u8, layout: Layout) {
+        System.dealloc(ptr, layout)
+    }
+}
+
+#[global_allocator]
+static GLOBAL: CountingAlloc = CountingAlloc;
+
+#[derive(Parser, Debug)]
+#[command(name = "sim_bench", about = "Headless Faery Tale tick benchmark")]
+struct Cli {
+    /// Number of gameplay ticks to run
+    #[arg(long, default_value_t = 10_000)]
+    ticks: u32,
+    /// Input script (see module docs); default is a fixed walking loop
+    #[arg(long)]
+    script: Option<PathBuf>,
+    /// Game library to load
+    #[arg(long, default_value = "faery.toml")]
+    lib: PathBuf,
+    /// Run the collision/door/zone checks on a helper thread
+    #[arg(long)]
+    parallel: bool,
+    /// Play N seeded random-walk runs and print per-run stats as JSON lines
+    #[arg(long, conflicts_with = "script")]
+    runs: Option<u32>,
+    /// Worker threads for --runs (default: one per core)
+    #[arg(long)]
+    jobs: Option<usize>,
+    /// Seed of the first --runs playthrough; run i uses seed + i
+    #[arg(long, default_value_t = 1)]
+    seed: u32,
+    /// Write the run's input journal to FILE
+    #[arg(long, value_name = "FILE", conflicts_with = "runs")]
+    record: Option<PathBuf>,
+    /// Ticks between state hashes in the --record journal (0 = none)
+    #[arg(long, requires = "record", default_value_t = journal::DEFAULT_HASH_INTERVAL)]
+    hash_interval: u32,
+    /// Replay an input journal and verify its state hashes
+    #[arg(long, value_name = "FILE", conflicts_with_all = ["script", "runs", "record"])]
+    replay: Option<PathBuf>,
+}
+
+/// One scripted input step: hold `dir` (and fire) for `ticks` ticks.
+#[derive(Debug, Clone, Copy, PartialEq)]
+struct Step {
+    ticks: u32,
+    dir: Direction,
+    fire: bool,
+}
+
+fn parse_dir(s: &str) -> Option<Direction> {
+    Some(match s.to_ascii_uppercase().as_str() {
+        "N" => Direction::N,
+        "NE" => Direction::NE,
+        "E" => Direction::E,
+        "SE" => Direction::SE,
+        "S" => Direction::S,
+        "SW" => Direction::SW,
+        "W" => Direction::W,
+        "NW" => Direction::NW,
+        "-" => Direction::None,
+        _ => return None,
+    })
+}
+
+fn parse_script(text: &str) -> Result<Vec<Step>, String> {
+    let mut steps = Vec::new();
+    for (n, line) in text.lines().enumerate() {
+        let line = line.split('#').next().unwrap_or("").trim();
+        if line.is_empty() {
+            continue;
+        }
+        let mut words = line.split_whitespace();
+        let ticks = words.next().and_then(|w| w.parse::<u32>().ok());
+        let dir = words.next().and_then(parse_dir);
+        let fire = match words.next() {
+            None => Some(false),
+            Some(w) if w.eq_ignore_ascii_case("fire") => Some(true),
+            Some(_) => None,
+        };
+        match (ticks, dir, fire, words.next()) {
+            (Some(ticks), Some(dir), Some(fire), None) if ticks > 0 => {
+                steps.push(Step { ticks, dir, fire })
+            }
+            _ => return Err(format!("line {}: expected `<ticks> <dir> [fire]`", n + 1)),
+        }
+    }
+    if steps.is_empty() {
+        return Err("script has no steps".to_string());
+    }
+    Ok(steps)
+}
+
+fn default_script() -> Vec<Step> {
+    [
+        Direction::N,
+        Direction::NE,
+        Direction::E,
+        Direction::SE,
+        Direction::S,
+        Direction::SW,
+        Direction::W,
+        Direction::NW,
+    ]
+    .into_iter()
+    .map(|dir| Step {
+        ticks: 90,
+        dir,
+        fire: false,
+    })
+    .collect()
+}
+
+/// A seeded random walk: each step holds one of the eight directions (or
+/// stands still) for 16-127 ticks, swinging on roughly one step in four.
+fn random_script(seed: u32) -> Vec<Step> {
+    let mut state = (seed ^ 0x9E37_79B9).max(1);
+    (0..64)
+        .map(|_| {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            Step {
+                ticks: 16 + state % 112,
+                dir: Direction::from((state >> 8) as u8 % 9),
+                fire: (state >> 16) & 3 == 0,
+            }
+        })
+        .collect()
+}
+
+/// Balance statistics for one `--runs` playthrough (one JSON line).
+#[derive(Debug, Default, PartialEq, Serialize)]
+struct RunStats {
+    run: u32,
+    seed: u32,
+    ticks: u32,
+    game_over: bool,
+    /// Encounter groups spawned.
+    encounters: u32,
+    /// Ticks with an enemy in battle range.
+    battle_ticks: u32,
+    enemies_killed: u32,
+    /// Hero vitality lost, summed over every brother played.
+    vitality_lost: u32,
+    /// Brothers that died and were succeeded.
+    successions: u32,
+    region_changes: u32,
+    final_vitality: i16,
+}
+
+fn hero_vitality(scene: &EcsScene) -> i16 {
+    scene
+        .world
+        .get::<&HeroStats>(scene.res.hero_entity)
+        .map_or(0, |s| s.vitality)
+}
+
+/// Play `ticks` ticks of `random_script(seed)` on a fresh scene that takes
+/// its assets from `assets`.
+fn run_playthrough(
+    game_lib: &GameLibrary,
+    assets: &Arc<SharedAssets>,
+    run: u32,
+    seed: u32,
+    ticks: u32,
+) -> Result<RunStats, String> {
+    let mut scene = EcsScene::new(game_lib, None, false).with_shared_assets(assets.clone());
+    scene.step_headless(game_lib, Direction::None, false);
+    if scene.res.map.world.is_none() {
+        return Err(format!("run {run}: world failed to load"));
+    }
+
+    let mut stats = RunStats {
+        run,
+        seed,
+        ..RunStats::default()
+    };
+    let mut hero = scene.res.hero_entity;
+    let mut vitality = hero_vitality(&scene);
+    'run: for step in random_script(seed).iter().cycle() {
+        for _ in 0..step.ticks {
+            if stats.ticks == ticks {
+                break 'run;
+            }
+            stats.ticks += 1;
+            let encounter_number = scene.res.region.encounter_number;
+            let region_num = scene.res.region.region_num;
+            let result = scene.step_headless(game_lib, step.dir, step.fire);
+
+            let res = &scene.res;
+            stats.encounters += u32::from(res.region.encounter_number != encounter_number);
+            stats.battle_ticks += u32::from(res.region.battleflag);
+            stats.enemies_killed += res.events.died.len() as u32;
+            stats.region_changes += u32::from(res.region.region_num != region_num);
+            let now = hero_vitality(&scene);
+            if res.hero_entity != hero {
+                hero = res.hero_entity;
+                stats.successions += 1;
+            } else if now < vitality {
+                stats.vitality_lost += (vitality - now) as u32;
+            }
+            vitality = now;
+            if let Some(SceneResult::GameOver) = result {
+                stats.game_over = true;
+                break 'run;
+            }
+        }
+    }
+    stats.final_vitality = vitality;
+    Ok(stats)
+}
+
+/// `--runs`: play `runs` playthroughs on a pool of worker threads, streaming
+/// one JSON line per finished run to stdout.
+fn run_batch(cli: &Cli, runs: u32, game_lib: &GameLibrary) -> ExitCode {
+    let assets = match SharedAssets::load(game_lib) {
+        Ok(a) => Arc::new(a),
+        Err(e) => {
+            eprintln!("sim_bench: failed to load assets: {e}");
+            return ExitCode::FAILURE;
+        }
+    };
+    let jobs = cli
+        .jobs
+        .unwrap_or_else(|| thread::available_parallelism().map_or(1, |n| n.get()))
+        .clamp(1, runs.max(1) as usize);
+
+    let next = AtomicU32::new(0);
+    let failed = AtomicBool::new(false);
+    let start = Instant::now();
+    thread::scope(|s| {
+        for _ in 0..jobs {
+            s.spawn(|| {
+                while !failed.load(Ordering::Relaxed) {
+                    let run = next.fetch_add(1, Ordering::Relaxed);
+                    if run >= runs {
+                        break;
+                    }
+                    let seed = cli.seed.wrapping_add(run);
+                    match run_playthrough(game_lib, &assets, run, seed, cli.ticks) {
+                        Ok(stats) => println!(
+                            "{}",
+                            serde_json::to_string(&stats).expect("RunStats serializes")
+                        ),
+                        Err(e) => {
+                            eprintln!("sim_bench: {e}");
+                            failed.store(true, Ordering::Relaxed);
+                        }
+                    }
+                }
+            });
+        }
+    });
+    eprintln!(
+        "sim_bench: {runs} runs x {} ticks on {jobs} threads in {:.2} s",
+        cli.ticks,
+        start.elapsed().as_secs_f64()
+    );
+    if failed.load(Ordering::Relaxed) {
+        ExitCode::FAILURE
+    } else {
+        ExitCode::SUCCESS
+    }
+}
+
+/// `--replay`: play `path` back on a fresh scene and compare state hashes.
+fn run_replay(cli: &Cli, path: &Path, game_lib: &GameLibrary) -> ExitCode {
+    let journal = match Journal::open(path) {
+        Ok(j) => j,
+        Err(e) => {
+            eprintln!("sim_bench: {e:#}");
+            return ExitCode::FAILURE;
+        }
+    };
+    let mut scene = EcsScene::new(game_lib, None, false);
+    scene.parallel_systems = cli.parallel;
+
+    // Keep the world load out of the measurement.
+    let load_start = Instant::now();
+    if let Err(e) = scene.begin_replay(game_lib, &journal.save) {
+        eprintln!("sim_bench: {}: {e:#}", path.display());
+        return ExitCode::FAILURE;
+    }
+    let load_time = load_start.elapsed();
+    if scene.res.map.world.is_none() {
+        for line in &scene.res.diag_log {
+            eprintln!("{line}");
+        }
+        eprintln!("sim_bench: world failed to load");
+        return ExitCode::FAILURE;
+    }
+
+    let start = Instant::now();
+    let report = journal::replay(&mut scene, game_lib, &journal);
+    let secs = start.elapsed().as_secs_f64();
+
+    let ending = match report.result {
+        Some(SceneResult::GameOver) => " (game over)",
+        Some(SceneResult::Quit) => " (quit)",
+        _ => "",
+    };
+    println!("world load:  {:.1} ms", load_time.as_secs_f64() * 1e3);
+    println!("ticks:       {} of {}{ending}", report.ticks, journal.ticks());
+    println!("elapsed:     {:.3} s", secs);
+    if secs > 0.0 {
+        println!("ticks/sec:   {:.0}", report.ticks as f64 / secs);
+    }
+    println!("hashes:      {} matched", report.checkpoints - u32::from(report.divergence.is_some()));
+    if let Some(d) = report.divergence {
+        println!(
+            "diverged:    at tick {}: expected {:016x}, got {:016x}",
+            d.tick, d.expected, d.actual
+        );
+        return ExitCode::FAILURE;
+    }
+    ExitCode::SUCCESS
+}
+
+fn main() -> ExitCode {
+    let cli = Cli::parse();
+
+    let steps = match &cli.script {
+        Some(path) => match fs::read_to_string(path)
+            .map_err(|e| e.to_string())
+            .and_then(|t| parse_script(&t))
+        {
+            Ok(s) => s,
+            Err(e) => {
+                eprintln!("sim_bench: {}: {e}", path.display());
+                return ExitCode::FAILURE;
+            }
+        },
+        None => default_script(),
+    };
+
+    let game_lib = match game_library::load_game_library(Path::new(&cli.lib)) {
+        Ok(lib) => lib,
+        Err(e) => {
+            eprintln!("sim_bench: failed to load game library: {e}");
+            return ExitCode::FAILURE;
+        }
+    };
+
+    if let Some(runs) = cli.runs {
+        return run_batch(&cli, runs, &game_lib);
+    }
+    if let Some(path) = &cli.replay {
+        return run_replay(&cli, path, &game_lib);
+    }
+
+    let mut scene = EcsScene::new(&game_lib, None, false);
+    scene.parallel_systems = cli.parallel;
+    if let Some(path) = &cli.record {
+        scene.record_journal(path, cli.hash_interval);
+    }
+
+    // The first tick loads the world; keep that out of the measurement.
+    let load_start = Instant::now();
+    scene.step_headless(&game_lib, Direction::None, false);
+    let load_time = load_start.elapsed();
+    if scene.res.map.world.is_none() {
+        for line in &scene.res.diag_log {
+            eprintln!("{line}");
+        }
+        eprintln!("sim_bench: world failed to load");
+        return ExitCode::FAILURE;
+    }
+    scene.profiler.set_enabled(true);
+
+    let mut ran = 0u32;
+    let mut game_over = false;
+    let allocs_before = allocations();
+    let start = Instant::now();
+    'run: for step in steps.iter().cycle() {
+        for _ in 0..step.ticks {
+            if ran == cli.ticks {
+                break 'run;
+            }
+            ran += 1;
+            if let Some(SceneResult::GameOver) = scene.step_headless(&game_lib, step.dir, step.fire)
+            {
+                game_over = true;
+                break 'run;
+            }
+        }
+    }
+    let elapsed = start.elapsed();
+    let allocs = allocations() - allocs_before;
+
+    let secs = elapsed.as_secs_f64();
+    println!("world load:  {:.1} ms", load_time.as_secs_f64() * 1e3);
+    println!(
+        "ticks:       {ran}{}",
+        if game_over { " (game over)" } else { "" }
+    );
+    println!("elapsed:     {:.3} s", secs);
+    if secs > 0.0 {
+        println!("ticks/sec:   {:.0}", ran as f64 / secs);
+    }
+    println!("allocs/tick: {:.2}", allocs as f64 / ran.max(1) as f64);
+
+    let total = scene.profiler.total().as_secs_f64().max(f64::EPSILON);
+    println!();
+    println!(
+        "{:<14} {:>10} {:>10} {:>10} {:>7}",
+        "system", "total ms", "avg us", "p99 us", "share"
+    );
+    for stage in scene.profiler.summary() {
+        let t = stage.total.as_secs_f64();
+        println!(
+            "{:<14} {:>10.2} {:>10.2} {:>10.2} {:>6.1}%",
+            stage.name,
+            t * 1e3,
+            t * 1e6 / stage.calls.max(1) as f64,
+            stage.p99.as_secs_f64() * 1e6,
+            t / total * 100.0
+        );
+    }
+    ExitCode::SUCCESS
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::game::actor::Goal;
+    use crate::game::combat::MissileType;
+    use crate::game::ecs::components::{AiState, HeroStats, Inventory};
+    use crate::game::ecs::resources::Resources;
+    use crate::game::ecs::spawn::{spawn_enemy, spawn_hero, spawn_missile};
+    use crate::game::ecs::systems;
+    use crate::game::npc::{NpcState, RACE_ENEMY};
+    use hecs::World;
+
+    #[test]
+    fn parses_script_lines_and_comments() {
+        let steps = parse_script("# warm up\n30 -\n\n12 ne fire  # attack\n").unwrap();
+        assert_eq!(
+            steps,
+            vec![
+                Step {
+                    ticks: 30,
+                    dir: Direction::None,
+                    fire: false
+                },
+                Step {
+                    ticks: 12,
+                    dir: Direction::NE,
+                    fire: true
+                },
+            ]
+        );
+    }
+
+    /// One pass of the actor systems, in schedule order.
+    fn actor_tick(world: &mut World, res: &mut Resources) {
+        res.events.clear();
+        res.clock.tick_counter = res.clock.tick_counter.wrapping_add(1);
+        res.input_direction = Direction::from((res.clock.tick_counter / 16 % 8) as u8);
+        systems::movement::run(world, res);
+        systems::spatial::run(world, res);
+        systems::collision::run(world, res);
+        systems::npc_ai::run(world, res);
+        systems::npc_movement::run(world, res);
+        systems::spatial::run(world, res);
+        systems::combat::run(world, res);
+        systems::damage::run(world, res);
+        systems::missile::run(world, res);
+        systems::spatial::run(world, res);
+        systems::proximity::run(world, res);
+    }
+
+    #[test]
+    fn steady_state_actor_ticks_do_not_allocate() {
+        let mut world = World::new();
+        let stats = HeroStats {
+            vitality: 100,
+            brave: 0,
+            luck: 0,
+            kind: 0,
+            wealth: 0,
+            hunger: 0,
+            fatigue: 0,
+            gold: 0,
+        };
+        let hero = spawn_hero(&mut world, 400.0, 400.0, 0, stats, Inventory::empty());
+        let mut res = Resources::new(hero);
+        for i in 0..8 {
+            let enemy = spawn_enemy(
+                &mut world,
+                340.0 + 15.0 * i as f32,
+                360.0 + 10.0 * (i % 3) as f32,
+                1,
+                RACE_ENEMY,
+                50,
+                1,
+                0,
+                2,
+                i % 2,
+                0,
+            );
+            let mut ai = world.get::<&mut AiState>(enemy).unwrap();
+            ai.state = NpcState::Walking;
+            ai.goal = Goal::Attack1;
+        }
+        // Arrows into the group: hits, damage and despawns all happen while
+        // the buffers warm up.
+        for i in 0..6 {
+            spawn_missile(
+                &mut world,
+                300.0,
+                360.0 + 4.0 * i as f32,
+                3.0,
+                0.0,
+                0,
+                MissileType::Arrow,
+                true,
+            );
+        }
+
+        for _ in 0..256 {
+            actor_tick(&mut world, &mut res);
+        }
+        let before = allocations();
+        for _ in 0..256 {
+            actor_tick(&mut world, &mut res);
+        }
+        assert_eq!(
+            allocations() - before,
+            0,
+            "steady-state actor ticks allocated"
+        );
+    }
+
+    #[test]
+    fn random_scripts_are_seeded() {
+        let a = random_script(7);
+        assert_eq!(a, random_script(7));
+        assert_ne!(a, random_script(8));
+        assert!(a.iter().all(|s| (16..128).contains(&s.ticks)));
+        assert!(a.iter().any(|s| s.fire) && a.iter().any(|s| !s.fire));
+        assert!(a.iter().any(|s| s.dir == Direction::None));
+    }
+
+    #[test]
+    fn rejects_malformed_script_lines() {
+        assert!(parse_script("10 up\n").is_err());
+        assert!(parse_script("0 N\n").is_err());
+        assert!(parse_script("5 N fire extra\n").is_err());
+        assert!(parse_script("# nothing\n").is_err());
+    }
+}
@@ -4,8 +4,12 @@
 //! We access it as a flat array of 512-byte blocks by index.
 //! No filesystem parsing is needed — all data offsets are hardcoded from
 //! the original game's hdrive.c block table.
+//!
+//! `open` memory-maps the image, so block slices borrow straight from the
+//! page cache (shared between processes) instead of a private heap copy.
 
 use anyhow::{bail, Context, Result};
+use std::fs::File;
 use std::path::Path;
 
 /// Number of bytes per ADF block (sector).
@@ -15,24 +19,55 @@ pub const TOTAL_BLOCKS: usize = 1760;
 /// Total size of the ADF image in bytes.
 pub const DISK_SIZE: usize = BLOCK_SIZE * TOTAL_BLOCKS;
 
+/// Backing bytes of a disk image.
+enum Storage {
+    Owned(Vec<u8>),
+    Mapped(memmap2::Mmap),
+}
+
 pub struct AdfDisk {
-    data: Vec<u8>,
+    data: Storage,
 }
 
 impl AdfDisk {
-    /// Open an ADF disk image from disk.
+    /// Open an ADF disk image from disk, memory-mapped when the platform allows
+    /// it and read into memory otherwise.
     pub fn open(path: &Path) -> Result<Self> {
-        let data = std::fs::read(path)
+        let file = File::open(path)
             .with_context(|| format!("failed to read ADF image: {}", path.display()))?;
-        if data.len() < BLOCK_SIZE {
-            bail!("ADF image too small: {} bytes", data.len());
+        // SAFETY: the mapping is read-only and the game never writes the image.
+        // Another process truncating or rewriting the file while we run would
+        // change what the slices observe, the same hazard as any mmap reader;
+        // the ADF is static game data, so we accept it.
+        let data = match unsafe { memmap2::Mmap::map(&file) } {
+            Ok(map) => Storage::Mapped(map),
+            Err(_) => Storage::Owned(
+                std::fs::read(path)
+                    .with_context(|| format!("failed to read ADF image: {}", path.display()))?,
+            ),
+        };
+        let adf = AdfDisk { data };
+        if adf.bytes().len() < BLOCK_SIZE {
+            bail!("ADF image too small: {} bytes", adf.bytes().len());
         }
-        Ok(AdfDisk { data })
+        Ok(adf)
     }
 
     /// Create an AdfDisk from raw bytes (useful for testing).
     pub fn from_bytes(data: Vec<u8>) -> Self {
-        AdfDisk { data }
+        AdfDisk { data: Storage::Owned(data) }
+    }
+
+    /// True when the image is served from a memory mapping.
+    pub fn is_mapped(&self) -> bool {
+        matches!(self.data, Storage::Mapped(_))
+    }
+
+    fn bytes(&self) -> &[u8] {
+        match &self.data {
+            Storage::Owned(v) => v,
+            Storage::Mapped(m) => m,
+        }
     }
 
     /// Returns a slice covering `count` blocks starting at `f_block`.
@@ -40,14 +75,15 @@ impl AdfDisk {
     pub fn load_blocks(&self, f_block: u32, count: u32) -> &[u8] {
         let start = (f_block as usize) * BLOCK_SIZE;
         let end = start + (count as usize) * BLOCK_SIZE;
+        let data = self.bytes();
         assert!(
-            end <= self.data.len(),
+            end <= data.len(),
             "ADF block range [{}, {}) exceeds image size {}",
             f_block,
             f_block + count,
-            self.data.len() / BLOCK_SIZE
+            data.len() / BLOCK_SIZE
         );
-        &self.data[start..end]
+        &data[start..end]
     }
 
     /// Returns a single block's bytes.
@@ -57,7 +93,7 @@ impl AdfDisk {
 
     /// Total number of available blocks in this image.
     pub fn num_blocks(&self) -> usize {
-        self.data.len() / BLOCK_SIZE
+        self.bytes().len() / BLOCK_SIZE
     }
 }
 
@@ -97,6 +133,17 @@ mod tests {
         assert_eq!(adf.num_blocks(), 10);
     }
 
+    #[test]
+    fn test_open_maps_file() {
+        let mut file = tempfile::NamedTempFile::new().unwrap();
+        let mut data = vec![0u8; 3 * BLOCK_SIZE];
+        data[2 * BLOCK_SIZE] = 0xAB;
+        std::io::Write::write_all(&mut file, &data).unwrap();
+        let adf = AdfDisk::open(file.path()).unwrap();
+        assert_eq!(adf.num_blocks(), 3);
+        assert_eq!(adf.block(2)[0], 0xAB);
+    }
+
     #[test]
     #[should_panic]
     fn test_out_of_range_panics() {
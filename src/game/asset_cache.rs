@@ -0,0 +1,101 @@
+//! Decode-on-first-use cache for file-backed assets.
+//!
+//! An [`AssetCache`] maps asset names to decoded values behind `Arc`, so the
+//! foreground and a background prewarm thread can share one copy.  Decoding
+//! runs outside the lock: a slow file never blocks lookups of other assets,
+//! and if two threads race on the same name the first insert wins and the
+//! other decode is dropped.
+
+use std::collections::HashMap;
+use std::sync::{Arc, Mutex, MutexGuard};
+
+pub struct AssetCache<T> {
+    entries: Mutex<HashMap<String, Arc<T>>>,
+}
+
+impl<T> Default for AssetCache<T> {
+    fn default() -> Self {
+        AssetCache { entries: Mutex::new(HashMap::new()) }
+    }
+}
+
+impl<T> std::fmt::Debug for AssetCache<T> {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        f.debug_struct("AssetCache").field("len", &self.len()).finish()
+    }
+}
+
+impl<T> AssetCache<T> {
+    fn entries(&self) -> MutexGuard<'_, HashMap<String, Arc<T>>> {
+        // A panic while holding the lock cannot leave the map half-updated.
+        self.entries.lock().unwrap_or_else(|e| e.into_inner())
+    }
+
+    pub fn get(&self, name: &str) -> Option<Arc<T>> {
+        self.entries().get(name).cloned()
+    }
+
+    pub fn contains(&self, name: &str) -> bool {
+        self.entries().contains_key(name)
+    }
+
+    pub fn len(&self) -> usize {
+        self.entries().len()
+    }
+
+    /// Return the cached `name`, decoding it with `load` on a miss.
+    /// Failures are not cached; the next call tries again.
+    pub fn get_or_load<E>(&self, name: &str, load: impl FnOnce() -> Result<T, E>) -> Result<Arc<T>, E> {
+        if let Some(hit) = self.get(name) {
+            return Ok(hit);
+        }
+        let decoded = Arc::new(load()?);
+        Ok(Arc::clone(self.entries().entry(name.to_string()).or_insert(decoded)))
+    }
+
+    /// Drop the cached `name`.  Holders of the `Arc` keep their copy.
+    pub fn evict(&self, name: &str) -> bool {
+        self.entries().remove(name).is_some()
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn decodes_once_and_evicts() {
+        let cache = AssetCache::<u32>::default();
+        let mut decodes = 0;
+        for _ in 0..3 {
+            let v = cache.get_or_load("n", || -> Result<u32, ()> { decodes += 1; Ok(7) });
+            assert_eq!(*v.unwrap(), 7);
+        }
+        assert_eq!(decodes, 1);
+        assert!(cache.evict("n"));
+        assert!(!cache.contains("n"));
+        assert!(!cache.evict("n"));
+    }
+
+    #[test]
+    fn failures_are_retried() {
+        let cache = AssetCache::<u32>::default();
+        assert_eq!(cache.get_or_load("n", || Err("missing")).unwrap_err(), "missing");
+        assert_eq!(cache.len(), 0);
+        assert_eq!(*cache.get_or_load("n", || Ok::<_, ()>(1)).unwrap(), 1);
+    }
+
+    #[test]
+    fn racing_loads_share_the_first_insert() {
+        let cache = Arc::new(AssetCache::<Vec<u8>>::default());
+        let handles: Vec<_> = (0..4u8)
+            .map(|i| {
+                let cache = Arc::clone(&cache);
+                std::thread::spawn(move || cache.get_or_load("n", || Ok::<_, ()>(vec![i])).unwrap())
+            })
+            .collect();
+        let got: Vec<Arc<Vec<u8>>> = handles.into_iter().map(|h| h.join().unwrap()).collect();
+        let cached = cache.get("n").unwrap();
+        assert!(got.iter().all(|v| Arc::ptr_eq(v, &cached)));
+    }
+}
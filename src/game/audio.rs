@@ -14,9 +14,15 @@ use std::fs;
 ///      waveform length, volume).
 ///
 /// We replicate all of this in Rust using an SDL3 audio stream callback.  The
-/// callback runs on a background thread and fills PCM buffers.  Sequencer
-/// state is shared with the main thread via `Arc<Mutex<SequencerState>>` so
-/// that `play_score()` / `stop_score()` are safe to call at any time.
+/// callback runs on a background thread and fills PCM buffers.  It owns the
+/// sequencer and SFX state outright; the main thread controls it by pushing
+/// [`AudioCommand`]s through a lock-free SPSC ring (`spsc.rs`) that the
+/// callback drains at the start of every buffer, so neither side ever waits
+/// on the other.
+///
+/// Tracks reach the sequencer as [`CompiledTrack`]s, flattened at load time,
+/// so a VBL only compares timeclocks and advances a step cursor.  The same
+/// sequencer and mixer also run offline through [`render_score`].
 ///
 /// # Waveform layout (`game/v6`)
 ///
@@ -47,15 +53,18 @@ use std::fs;
 /// |  9   |  5   |  4  |
 /// | 10   |  1   |  0  |
 /// | 11   |  5   |  0  |
+use std::cell::Cell;
 use std::path::Path;
-use std::sync::{Arc, Mutex};
+use std::sync::atomic::{AtomicU32, AtomicU64, Ordering};
+use std::sync::Arc;
+use std::time::{Duration, Instant};
 
 use sdl3::audio::{AudioCallback, AudioFormat, AudioSpec, AudioStreamWithCallback};
 
 use super::songs::{
-    SongLibrary, Track, TrackEvent, AMIGA_CLOCK_NTSC, DEFAULT_TEMPO, NOTE_DURATIONS, PTABLE,
-    VBL_RATE_HZ,
+    CompiledTrack, SongLibrary, StepKind, AMIGA_CLOCK_NTSC, DEFAULT_TEMPO, PTABLE, VBL_RATE_HZ,
 };
+use super::spsc;
 
 // ---------------------------------------------------------------------------
 // Constants
@@ -91,10 +100,6 @@ const NEW_WAVE: [(u8, u8); INSTRUMENT_SLOTS] = [
     (5, 0), // slots 8-11
 ];
 
-/// Gap between the end-of-note and the start of the next event, in timeclock
-/// units.  Ported from `#300` in `gdriver.asm` `note_comm`.
-const NOTE_GAP: u32 = 300;
-
 /// Stereo panning weights for the Amiga's fixed DAC routing.
 ///
 /// Amiga Paula DAC routing (interleaved to reduce chip-trace cross-talk):
@@ -117,6 +122,11 @@ pub const SAMPLE_RATE: u32 = 44100;
 /// A "frame" is one L+R sample pair; the raw sample count is 2× this value.
 const SAMPLES_PER_VBL: f64 = SAMPLE_RATE as f64 / VBL_RATE_HZ as f64;
 
+/// Frames rendered per mixer pass.  Each voice and the SFX channel own a
+/// scratch block of this size, so the callback never allocates while mixing
+/// and any SDL buffer size is handled as a run of blocks.
+const MIX_BLOCK: usize = 256;
+
 // ---------------------------------------------------------------------------
 // Sound effects
 // ---------------------------------------------------------------------------
@@ -143,40 +153,46 @@ struct SfxPlayback {
     pos: f64,
 }
 
-/// All SFX state shared between the main thread and the audio callback.
+/// SFX playback state, owned by the audio callback.
 pub struct SfxChannel {
-    /// Decoded PCM for each of the 6 effects; `None` until `load_samples`.
-    samples: [Option<Arc<Vec<i8>>>; SFX_COUNT],
     /// The effect currently playing, if any.
     active: Option<SfxPlayback>,
+    /// Output of the last [`render`](Self::render) call.
+    block: [f32; MIX_BLOCK],
 }
 
 impl SfxChannel {
     fn new() -> Self {
         SfxChannel {
-            samples: Default::default(),
             active: None,
+            block: [0.0; MIX_BLOCK],
         }
     }
 
-    /// Resample and mix the active SFX into `left` and `right` (both centred).
-    /// Uses nearest-neighbour interpolation to match the Amiga Paula hardware.
-    fn mix_into(&mut self, left: &mut [f32], right: &mut [f32], frames: usize) {
+    /// Start `data` from the beginning, replacing any effect already playing.
+    fn trigger(&mut self, data: Arc<Vec<i8>>) {
+        self.active = Some(SfxPlayback { data, pos: 0.0 });
+    }
+
+    /// Resample the next `n` (≤ [`MIX_BLOCK`]) frames of the active SFX into
+    /// `self.block`, zero-filled past its end.  Uses nearest-neighbour
+    /// interpolation to match the Amiga Paula hardware.
+    fn render(&mut self, n: usize) {
+        let out = &mut self.block[..n];
+        out.fill(0.0);
         let pb = match &mut self.active {
             Some(pb) => pb,
             None => return,
         };
         let len = pb.data.len();
         let mut finished = false;
-        for i in 0..frames {
+        for s in out.iter_mut() {
             let idx = pb.pos as usize;
             if idx >= len {
                 finished = true;
                 break;
             }
-            let s = pb.data[idx] as f32 / 128.0 * SFX_AMPLITUDE;
-            left[i] += s;
-            right[i] += s;
+            *s = pb.data[idx] as f32 / 128.0 * SFX_AMPLITUDE;
             pb.pos += SFX_STEP;
         }
         if finished {
@@ -260,7 +276,7 @@ impl Instruments {
 /// `event_start`, `event_stop`, `vol_list`, `trak_ptr`, etc.).
 struct Voice {
     // --- sequencer ---
-    /// Pointer into the track (index into `track` slice); `None` = no track.
+    /// Pointer into the track (index into its steps); `None` = no track.
     trak_ptr: Option<usize>,
     /// Index of the start of the current track (for looping).
     trak_beg: Option<usize>,
@@ -304,6 +320,11 @@ struct Voice {
     /// Max value is `volume / 64 * 0.5`; ramps to 0 when the voice is silent.
     /// The mix loop keeps running (draining the LP filter) until this reaches 0.
     declick: f32,
+    /// Output of the last [`render`](Voice::render) call: the filtered,
+    /// de-clicked voice signal before stereo panning.
+    block: [f32; MIX_BLOCK],
+    /// Per-sample de-click gain scratch for `render`.
+    gain: [f32; MIX_BLOCK],
 }
 
 impl Voice {
@@ -325,6 +346,8 @@ impl Voice {
             playing: false,
             lp_state: 0.0,
             declick: 0.0,
+            block: [0.0; MIX_BLOCK],
+            gain: [0.0; MIX_BLOCK],
         }
     }
 
@@ -393,42 +416,27 @@ impl Voice {
         }
     }
 
-    /// Generate mono f32 samples and mix into `buf` with the current volume,
-    /// advancing the waveform phase with linear interpolation.
+    /// Generate mono f32 samples and mix them into `buf`.
     ///
-    /// Used by unit tests; production rendering goes through `mix_stereo`.
+    /// Used by unit tests; production rendering goes through
+    /// [`SynthCallback::render_block`].
     fn mix_into(&mut self, buf: &mut [f32], instruments: &Instruments, no_interpolation: bool) {
-        // Route entirely to the left side (gain=1.0) and discard the right
-        // side output (gain=0.0, written into a throwaway buffer).
-        let mut right_dummy = vec![0.0f32; buf.len()];
-        self.mix_stereo(
-            buf,
-            &mut right_dummy,
-            instruments,
-            no_interpolation,
-            1.0,
-            0.0,
-        );
+        for chunk in buf.chunks_mut(MIX_BLOCK) {
+            self.render(chunk.len(), instruments, no_interpolation);
+            for (o, s) in chunk.iter_mut().zip(&self.block) {
+                *o += *s;
+            }
+        }
     }
 
-    /// Synthesise samples for this voice and mix them into both `left` and
-    /// `right` in a single waveform pass.
+    /// Synthesise the next `n` (≤ [`MIX_BLOCK`]) samples into `self.block`.
     ///
-    /// `left_gain` and `right_gain` control the per-side contribution.  For
-    /// correct normalisation with 2 voices per side they should sum to 1.0
-    /// (see `STEREO_PRIMARY` / `STEREO_BLEED`).
-    ///
-    /// Advancing the phase only once here prevents the double phase-advance
-    /// that would occur if `mix_into` were called twice on the same voice.
-    fn mix_stereo(
-        &mut self,
-        left: &mut [f32],
-        right: &mut [f32],
-        instruments: &Instruments,
-        no_interpolation: bool,
-        left_gain: f32,
-        right_gain: f32,
-    ) {
+    /// Runs as three passes over the block instead of one per-sample loop:
+    ///   1. waveform fetch + linear interpolation (advances the phase);
+    ///   2. the 1-pole low-pass filter — the only serial dependency;
+    ///   3. the de-click gain: a short ramp, then a constant, applied with a
+    ///      plain multiply the compiler vectorises.
+    fn render(&mut self, n: usize, instruments: &Instruments, no_interpolation: bool) {
         // Noise floor: below this the i16 output would be 0 regardless.
         const NOISE_FLOOR: f32 = 1.0 / 65536.0;
         // De-click ramp rate: reach full volume (or silence) in 64 samples (~1.4 ms).
@@ -439,8 +447,12 @@ impl Voice {
         // Approximates the Amiga A500 passive RC filter on each Paula channel.
         const LP_ALPHA: f32 = 0.487;
 
+        let out = &mut self.block[..n];
+
+        // Active only when playing and audible; constant across the block.
+        let active = self.playing && self.wave_len > 0 && self.volume > 0;
         // Target gain for this voice: non-zero only when actively playing.
-        let target = if self.playing && self.wave_len > 0 && self.volume > 0 {
+        let target = if active {
             self.volume as f32 / 64.0 * 0.5
         } else {
             0.0
@@ -451,67 +463,88 @@ impl Voice {
         if self.declick < NOISE_FLOOR && target < NOISE_FLOOR && self.lp_state.abs() < NOISE_FLOOR {
             self.declick = 0.0;
             self.lp_state = 0.0;
+            out.fill(0.0);
             return;
         }
 
-        let wf = &instruments.waveforms[self.wave_num.min(WAVEFORM_COUNT - 1)];
-        let start = self.wave_start;
-        let len = self.wave_len;
-
-        for (l, r) in left.iter_mut().zip(right.iter_mut()) {
-            // Ramp the de-click gain toward the target one step at a time.
-            // This replaces the abrupt volume jump with a short linear ramp.
-            if self.declick < target {
-                self.declick = (self.declick + DECLICK_RATE).min(target);
-            } else if self.declick > target {
-                self.declick = (self.declick - DECLICK_RATE).max(target);
-            }
-
-            // Generate a waveform sample only while actively playing.
-            // During the decay tail (target == 0) we feed 0 into the LP
-            // filter so it drains naturally rather than cutting off abruptly.
-            let raw = if self.playing && len > 0 && self.volume > 0 {
+        // Pass 1: waveform samples.  During the decay tail (not active) we
+        // feed 0 into the LP filter so it drains naturally rather than
+        // cutting off abruptly.
+        if active {
+            let wf = &instruments.waveforms[self.wave_num.min(WAVEFORM_COUNT - 1)];
+            // The phase wrap guarantees 0.0 <= phase < len, so int_part is
+            // always in [0, len-1].
+            let loop_wf = &wf[self.wave_start..self.wave_start + self.wave_len];
+            let len = loop_wf.len();
+            let len_f = len as f64;
+            let inc = self.phase_inc;
+            let mut phase = self.phase;
+            if no_interpolation {
+                for s in out.iter_mut() {
+                    *s = loop_wf[phase as usize] as f32 / 128.0;
+                    phase += inc;
+                    if phase >= len_f {
+                        phase -= len_f;
+                    }
+                }
+            } else {
                 // Linear interpolation between consecutive waveform bytes.
-                //
-                // The phase wrap guarantees 0.0 <= phase < len, so int_part is
-                // always in [0, len-1].  i1 wraps modulo len so the last sample
-                // interpolates back to the loop start, avoiding a click on every
-                // waveform cycle (audible as noise on short 8-byte loops).
-                let int_part = self.phase as usize;
-                let i0 = start + int_part;
-                let s = if no_interpolation {
-                    wf[i0] as f32 / 128.0
-                } else {
-                    let frac = (self.phase - int_part as f64) as f32;
-                    let i1 = start + (int_part + 1) % len;
-                    let s0 = wf[i0] as f32;
-                    let s1 = wf[i1] as f32;
-                    (s0 + frac * (s1 - s0)) / 128.0
-                };
-                self.phase += self.phase_inc;
-                if self.phase >= len as f64 {
-                    self.phase -= len as f64;
+                // i1 wraps modulo len so the last sample interpolates back
+                // to the loop start, avoiding a click on every waveform
+                // cycle (audible as noise on short 8-byte loops).
+                for s in out.iter_mut() {
+                    let int_part = phase as usize;
+                    let frac = (phase - int_part as f64) as f32;
+                    let s0 = loop_wf[int_part] as f32;
+                    let s1 = loop_wf[(int_part + 1) % len] as f32;
+                    *s = (s0 + frac * (s1 - s0)) / 128.0;
+                    phase += inc;
+                    if phase >= len_f {
+                        phase -= len_f;
+                    }
                 }
-                s
+            }
+            self.phase = phase;
+        } else {
+            out.fill(0.0);
+        }
+
+        // Pass 2: low-pass filter (one filter per voice).
+        let mut lp = self.lp_state;
+        for s in out.iter_mut() {
+            lp = LP_ALPHA * *s + (1.0 - LP_ALPHA) * lp;
+            *s = lp;
+        }
+        self.lp_state = lp;
+
+        // Pass 3: de-click.  Ramp the gain toward the target one step per
+        // sample, replacing an abrupt volume jump; once there it is constant.
+        let gain = &mut self.gain[..n];
+        let mut d = self.declick;
+        let mut ramp = 0;
+        while ramp < n && d != target {
+            d = if d < target {
+                (d + DECLICK_RATE).min(target)
             } else {
-                0.0
+                (d - DECLICK_RATE).max(target)
             };
-
-            // Apply low-pass filter (shared state — one filter per voice).
-            self.lp_state = LP_ALPHA * raw + (1.0 - LP_ALPHA) * self.lp_state;
-
-            // Mix into the stereo output scaled by the smoothed de-click gain.
-            *l += self.lp_state * self.declick * left_gain;
-            *r += self.lp_state * self.declick * right_gain;
+            gain[ramp] = d;
+            ramp += 1;
+        }
+        gain[ramp..].fill(d);
+        self.declick = d;
+        for (s, g) in out.iter_mut().zip(gain.iter()) {
+            *s *= *g;
         }
     }
 }
 
 // ---------------------------------------------------------------------------
-// Sequencer state (shared with audio thread)
+// Sequencer state (owned by the audio callback)
 // ---------------------------------------------------------------------------
 
-/// All mutable state accessed by both the main thread and the audio callback.
+/// All mutable sequencer state.  Lives inside the audio callback; the main
+/// thread only reaches it through [`AudioCommand`]s.
 pub struct SequencerState {
     /// The four voices.
     voices: [Voice; 4],
@@ -522,11 +555,9 @@ pub struct SequencerState {
     /// When true, the sequencer does not advance (matches `nosound` flag).
     nosound: bool,
     /// Track data for each voice.
-    tracks: [Option<Arc<Track>>; 4],
+    tracks: [Option<Arc<CompiledTrack>>; 4],
     /// Fractional sample accumulator for VBL timing.
     samples_to_vbl: f64,
-    /// Song group currently loaded (0–6), if any.
-    pub current_group: Option<usize>,
     /// When true, instrument slot 10 uses cave overrides (wave=3, vol=7).
     /// Mirrors `new_wave[10] = 0x0307` from `fmain.c` cave handling.
     pub cave_mode: bool,
@@ -541,7 +572,6 @@ impl SequencerState {
             nosound: true,
             tracks: [None, None, None, None],
             samples_to_vbl: 0.0,
-            current_group: None,
             cave_mode: false,
         }
     }
@@ -549,10 +579,10 @@ impl SequencerState {
     /// Assign four tracks and begin playback from the start (mirrors `_playscore`).
     fn play_score(
         &mut self,
-        t0: Arc<Track>,
-        t1: Arc<Track>,
-        t2: Arc<Track>,
-        t3: Arc<Track>,
+        t0: Arc<CompiledTrack>,
+        t1: Arc<CompiledTrack>,
+        t2: Arc<CompiledTrack>,
+        t3: Arc<CompiledTrack>,
         inst: &Instruments,
     ) {
         let tracks = [t0, t1, t2, t3];
@@ -586,13 +616,18 @@ impl SequencerState {
     /// Stop all playback (mirrors `_stopscore`).
     fn stop_score(&mut self) {
         self.nosound = true;
-        self.current_group = None;
         for v in self.voices.iter_mut() {
             v.silence();
             v.trak_ptr = None;
         }
     }
 
+    /// True once every voice has reached a non-looping `End` while the score
+    /// was not stopped (see [`AudioSystem::is_score_finished`]).
+    fn score_finished(&self) -> bool {
+        !self.nosound && self.voices.iter().all(|v| v.trak_ptr.is_none())
+    }
+
     /// Run one VBL tick of the sequencer across all four voices.
     fn vbl_tick(&mut self, inst: &Instruments) {
         if self.nosound {
@@ -643,97 +678,280 @@ impl SequencerState {
             return;
         }
 
-        // timeclock >= event_start: consume track events
+        // timeclock >= event_start: consume track steps
         let mut ptr = self.voices[vi].trak_ptr.unwrap();
-        loop {
-            let event = match track.get(ptr) {
-                Some(e) => e,
-                None => break,
-            };
+        while let Some(step) = track.steps.get(ptr) {
             ptr += 1;
 
-            match event {
-                TrackEvent::Note {
-                    pitch,
-                    duration_idx,
-                } => {
-                    let dur = NOTE_DURATIONS[(*duration_idx as usize).min(63)] as u32;
-                    // Original gdriver.asm `note_comm`:
-                    //   sub.l #300,d4   ; d4 = duration - NOTE_GAP
-                    //   bpl.s nc1       ; if ≥ 0, keep reduced duration
-                    //   move.l d5,d4    ; else no gap: use full duration
-                    // Short notes (dur < NOTE_GAP) get no gap at all,
-                    // NOT a gap equal to their full duration (which would
-                    // set event_stop == event_start and silence them immediately).
-                    let sustain = if dur >= NOTE_GAP { dur - NOTE_GAP } else { dur };
-                    let event_start = self.voices[vi].event_start;
-                    self.voices[vi].event_stop = event_start.wrapping_add(sustain);
-                    self.voices[vi].event_start = event_start.wrapping_add(dur);
-                    self.voices[vi].trak_ptr = Some(ptr);
-                    self.voices[vi].trigger_note(*pitch as usize, inst);
-                    return;
+            // Untimed commands that preceded this event in the stream.
+            if let Some(slot) = step.instrument {
+                let slot = slot as usize;
+                // Cave override: slot 10 → (wave=3, vol=7) when in region 9.
+                // Mirrors `new_wave[10] = 0x0307` from fmain.c.
+                if slot == 10 && self.cave_mode {
+                    self.voices[vi].wave_num = 3;
+                    self.voices[vi].vol_num = 7;
+                } else {
+                    self.voices[vi].set_instrument_slot(slot);
                 }
-                TrackEvent::Rest { duration_idx } => {
-                    let dur = NOTE_DURATIONS[(*duration_idx as usize).min(63)] as u32;
-                    let event_start = self.voices[vi].event_start;
-                    self.voices[vi].event_stop = event_start; // silence immediately
-                    self.voices[vi].event_start = event_start.wrapping_add(dur);
-                    self.voices[vi].trak_ptr = Some(ptr);
-                    self.voices[vi].silence();
+            }
+            if let Some(value) = step.tempo {
+                self.tempo = value as u32;
+            }
+
+            let voice = &mut self.voices[vi];
+            match step.kind {
+                StepKind::Note { pitch, sustain } => {
+                    let event_start = voice.event_start;
+                    voice.event_stop = event_start.wrapping_add(sustain);
+                    voice.event_start = event_start.wrapping_add(step.duration);
+                    voice.trak_ptr = Some(ptr);
+                    voice.trigger_note(pitch as usize, inst);
                     return;
                 }
-                TrackEvent::SetInstrument { slot } => {
-                    let slot = *slot as usize;
-                    // Cave override: slot 10 → (wave=3, vol=7) when in region 9.
-                    // Mirrors `new_wave[10] = 0x0307` from fmain.c.
-                    if slot == 10 && self.cave_mode {
-                        self.voices[vi].wave_num = 3;
-                        self.voices[vi].vol_num = 7;
-                    } else {
-                        self.voices[vi].set_instrument_slot(slot);
-                    }
-                    // continue consuming events
+                StepKind::Rest => {
+                    let event_start = voice.event_start;
+                    voice.event_stop = event_start; // silence immediately
+                    voice.event_start = event_start.wrapping_add(step.duration);
+                    voice.trak_ptr = Some(ptr);
+                    voice.silence();
+                    return;
                 }
-                TrackEvent::SetTempo { value } => {
-                    self.tempo = *value as u32;
-                    // continue consuming events
+                StepKind::End { looping: true } => {
+                    // continue from beginning of track
+                    ptr = voice.trak_beg.unwrap_or(0);
                 }
-                TrackEvent::End { looping } => {
-                    if *looping {
-                        ptr = self.voices[vi].trak_beg.unwrap_or(0);
-                        // continue from beginning of track
-                    } else {
-                        self.voices[vi].trak_ptr = None;
-                        self.voices[vi].silence();
-                        return;
-                    }
-                }
-                TrackEvent::Unknown { .. } => {
-                    // skip, per original
+                StepKind::End { looping: false } => {
+                    voice.trak_ptr = None;
+                    voice.silence();
+                    return;
                 }
+                StepKind::Unterminated => {}
             }
         }
         self.voices[vi].trak_ptr = Some(ptr);
     }
 }
 
+// ---------------------------------------------------------------------------
+// PCM rendering (shared by the audio callback and offline rendering)
+// ---------------------------------------------------------------------------
+
+/// Render `out.len() / 2` (≤ [`MIX_BLOCK`]) interleaved stereo frames.
+///
+/// Each voice and the SFX channel first fill their own scratch block; a
+/// single pass then pans, sums, clamps and interleaves them into `out`.
+fn render_block(
+    seq: &mut SequencerState,
+    sfx: &mut SfxChannel,
+    inst: &Instruments,
+    no_interpolation: bool,
+    out: &mut [i16],
+) {
+    let n = out.len() / 2;
+    for v in seq.voices.iter_mut() {
+        v.render(n, inst, no_interpolation);
+    }
+    sfx.render(n);
+
+    // Amiga Paula hardware DAC routing (not sequential by number):
+    //   channels 0 and 3 → Left DAC
+    //   channels 1 and 2 → Right DAC
+    // This interleaved arrangement was used to reduce cross-talk between
+    // adjacent chip traces.  Getting it wrong groups two voices that the
+    // composer intended to be on separate sides onto the same side, causing
+    // phase cancellation on harmonically related melodic lines.
+    // A bleed of STEREO_BLEED to the opposite side centres the soundstage
+    // while preserving the original left/right bias of the hardware.
+    // SFX are independent of the 4 music voices and centred.
+    let [b0, b1, b2, b3] = seq.voices.each_ref().map(|v| &v.block[..n]);
+    let sfx = &sfx.block[..n];
+    for (i, frame) in out.chunks_exact_mut(2).enumerate() {
+        let left_side = b0[i] + b3[i];
+        let right_side = b1[i] + b2[i];
+        let l = left_side * STEREO_PRIMARY + right_side * STEREO_BLEED + sfx[i];
+        let r = right_side * STEREO_PRIMARY + left_side * STEREO_BLEED + sfx[i];
+        // Scale f32 [-1.0, 1.0] → i16 [-32767, 32767].
+        frame[0] = (l.clamp(-1.0, 1.0) * i16::MAX as f32) as i16;
+        frame[1] = (r.clamp(-1.0, 1.0) * i16::MAX as f32) as i16;
+    }
+}
+
+/// Fill `out` (interleaved stereo: [L0, R0, L1, R1, ...]), firing a sequencer
+/// VBL tick every [`SAMPLES_PER_VBL`] frames.
+fn render_frames(
+    seq: &mut SequencerState,
+    sfx: &mut SfxChannel,
+    inst: &Instruments,
+    no_interpolation: bool,
+    out: &mut [i16],
+) {
+    // Work in frames (stereo pairs) to keep VBL timing consistent.
+    let total_frames = out.len() / 2;
+    let mut frame_pos = 0usize;
+
+    while frame_pos < total_frames {
+        // How many frames until the next VBL tick?
+        let until_vbl = seq.samples_to_vbl;
+
+        if until_vbl <= 0.0 {
+            // Fire a VBL tick (sequencer advances)
+            seq.vbl_tick(inst);
+            seq.samples_to_vbl += SAMPLES_PER_VBL;
+            continue;
+        }
+
+        // Render frames up to the next VBL boundary, one block at a time.
+        let chunk_frames = (until_vbl.floor() as usize)
+            .min(total_frames - frame_pos)
+            .min(MIX_BLOCK)
+            .max(1);
+
+        render_block(seq, sfx, inst, no_interpolation,
+                     &mut out[frame_pos * 2..(frame_pos + chunk_frames) * 2]);
+
+        frame_pos += chunk_frames;
+        seq.samples_to_vbl -= chunk_frames as f64;
+    }
+}
+
+/// Render a score to interleaved stereo PCM at [`SAMPLE_RATE`], as fast as the
+/// CPU allows, through the same sequencer and mixer as live playback.
+///
+/// Stops once every voice has reached a non-looping end and its filter tail
+/// has died away, or after `max_frames` frames (looping scores never end).
+pub fn render_score(
+    tracks: [Arc<CompiledTrack>; 4],
+    instruments: &Instruments,
+    cave_mode: bool,
+    max_frames: usize,
+) -> Vec<i16> {
+    let mut seq = SequencerState::new();
+    seq.cave_mode = cave_mode;
+    let [t0, t1, t2, t3] = tracks;
+    seq.play_score(t0, t1, t2, t3, instruments);
+    let mut sfx = SfxChannel::new();
+
+    let mut out = Vec::new();
+    let mut frames = 0;
+    while frames < max_frames {
+        let n = MIX_BLOCK.min(max_frames - frames);
+        out.resize((frames + n) * 2, 0);
+        render_frames(&mut seq, &mut sfx, instruments, false, &mut out[frames * 2..]);
+        frames += n;
+        let drained = seq.voices.iter().all(|v| v.declick == 0.0 && v.lp_state == 0.0);
+        if seq.score_finished() && drained {
+            break;
+        }
+    }
+    out
+}
+
+// ---------------------------------------------------------------------------
+// Main thread → audio callback control path
+// ---------------------------------------------------------------------------
+
+/// Commands queued by [`AudioSystem`] for the audio callback.
+enum AudioCommand {
+    /// Start four tracks from the beginning; `id` tags the score for
+    /// [`AudioStatus::finished_score`].
+    PlayScore {
+        tracks: [Arc<CompiledTrack>; 4],
+        id: u32,
+    },
+    StopScore,
+    SetTempo(u32),
+    SetCaveMode(bool),
+    PlaySfx(Arc<Vec<i8>>),
+}
+
+/// Commands the ring can hold.  The callback drains it every buffer (~10 ms)
+/// and the game queues a handful per tick at most.
+const COMMAND_QUEUE_LEN: usize = 64;
+
+/// Shortest gap between two reports of dropped commands.
+const DROP_REPORT_INTERVAL: Duration = Duration::from_secs(1);
+
+/// Output that may arrive this late past the end of the previously delivered
+/// PCM before it counts as an underrun (absorbs scheduler jitter).
+const UNDERRUN_SLACK: Duration = Duration::from_millis(2);
+
+/// State the callback publishes back to the main thread.
+struct AudioStatus {
+    /// Id of the last score that played to its natural end.
+    finished_score: AtomicU32,
+    /// Buffers that arrived after the previous one had run out.
+    underruns: AtomicU64,
+}
+
 // ---------------------------------------------------------------------------
 // SDL3 audio callback
 // ---------------------------------------------------------------------------
 
 /// SDL3 audio stream callback wrapper.
 ///
-/// `instruments` lives here (owned by the callback, not behind the Mutex)
-/// so we can pass `&instruments` to both the sequencer tick and the voice
-/// mixer without any unsafe aliasing.
+/// Owns the sequencer, the SFX channel and the instruments outright, so the
+/// render path never locks; the main thread talks to it only via `commands`.
 struct SynthCallback {
-    state: Arc<Mutex<SequencerState>>,
+    seq: SequencerState,
     instruments: Instruments,
-    sfx: Arc<Mutex<SfxChannel>>,
+    sfx: SfxChannel,
+    commands: spsc::Consumer<AudioCommand>,
+    status: Arc<AudioStatus>,
+    /// Id of the score currently loaded into `seq`.
+    score_id: u32,
+    /// Wall-clock time at which the PCM delivered so far finishes playing.
+    buffered_until: Option<Instant>,
+    /// Interleaved PCM handed to SDL, kept between callbacks.
+    out: Vec<i16>,
     /// When true, use nearest-neighbor instead of linear interpolation in the PCM mixer.
     no_interpolation: bool,
 }
 
+impl SynthCallback {
+    /// Apply every queued command, oldest first.
+    fn drain_commands(&mut self) {
+        while let Some(cmd) = self.commands.pop() {
+            match cmd {
+                AudioCommand::PlayScore { tracks, id } => {
+                    let [t0, t1, t2, t3] = tracks;
+                    self.seq.play_score(t0, t1, t2, t3, &self.instruments);
+                    self.score_id = id;
+                }
+                AudioCommand::StopScore => self.seq.stop_score(),
+                AudioCommand::SetTempo(tempo) => self.seq.tempo = tempo,
+                AudioCommand::SetCaveMode(cave) => self.seq.cave_mode = cave,
+                AudioCommand::PlaySfx(data) => self.sfx.trigger(data),
+            }
+        }
+    }
+
+    /// Render `out.len() / 2` (≤ [`MIX_BLOCK`]) interleaved stereo frames.
+    fn render_block(&mut self, out: &mut [i16]) {
+        render_block(&mut self.seq, &mut self.sfx, &self.instruments, self.no_interpolation, out);
+    }
+
+    /// Count an underrun if this request arrived after the previously
+    /// delivered PCM ran out, then extend the estimate by `frames`.
+    ///
+    /// SDL does not report device starvation to callbacks, so this tracks the
+    /// wall-clock span of audio handed over so far; a request that comes in
+    /// past its end means the device had nothing left to play.
+    fn track_underrun(&mut self, frames: usize) {
+        let now = Instant::now();
+        let start = match self.buffered_until {
+            Some(until) if now > until + UNDERRUN_SLACK => {
+                self.status.underruns.fetch_add(1, Ordering::Relaxed);
+                now
+            }
+            Some(until) => until.max(now),
+            None => now,
+        };
+        let span = Duration::from_secs_f64(frames as f64 / SAMPLE_RATE as f64);
+        self.buffered_until = Some(start + span);
+    }
+}
+
 impl AudioCallback<i16> for SynthCallback {
     /// Called by SDL3 when the audio stream needs more data.
     ///
@@ -746,104 +964,24 @@ impl AudioCallback<i16> for SynthCallback {
             return;
         }
 
-        let mut out = vec![0i16; total_frames * 2];
-
-        let mut st = match self.state.lock() {
-            Ok(g) => g,
-            Err(_) => {
-                let _ = stream.put_data_i16(&out);
-                return;
-            }
-        };
-
-        let inst = &self.instruments;
-        // out is interleaved stereo: [L0, R0, L1, R1, ...]
-        // Work in frames (stereo pairs) to keep VBL timing consistent.
-        let mut frame_pos = 0usize;
-
-        while frame_pos < total_frames {
-            // How many frames until the next VBL tick?
-            let until_vbl = st.samples_to_vbl;
-
-            if until_vbl <= 0.0 {
-                // Fire a VBL tick (sequencer advances)
-                st.vbl_tick(inst);
-                st.samples_to_vbl += SAMPLES_PER_VBL;
-                continue;
-            }
-
-            // Render frames up to the next VBL boundary.
-            let chunk_frames = (until_vbl.floor() as usize)
-                .min(total_frames - frame_pos)
-                .max(1);
-
-            // Per-side mono scratch buffers.
-            // Amiga Paula hardware DAC routing (not sequential by number):
-            //   channels 0 and 3 → Left DAC
-            //   channels 1 and 2 → Right DAC
-            // This interleaved arrangement was used to reduce cross-talk between
-            // adjacent chip traces.  Getting it wrong groups two voices that the
-            // composer intended to be on separate sides onto the same side, causing
-            // phase cancellation on harmonically related melodic lines.
-            // A bleed of STEREO_BLEED to the opposite side centres the soundstage
-            // while preserving the original left/right bias of the hardware.
-            let mut left_buf = vec![0.0f32; chunk_frames];
-            let mut right_buf = vec![0.0f32; chunk_frames];
-
-            // Voices 0 and 3: left-primary, right-bleed
-            st.voices[0].mix_stereo(
-                &mut left_buf,
-                &mut right_buf,
-                inst,
-                self.no_interpolation,
-                STEREO_PRIMARY,
-                STEREO_BLEED,
-            );
-            st.voices[3].mix_stereo(
-                &mut left_buf,
-                &mut right_buf,
-                inst,
-                self.no_interpolation,
-                STEREO_PRIMARY,
-                STEREO_BLEED,
-            );
-            // Voices 1 and 2: right-primary, left-bleed
-            st.voices[1].mix_stereo(
-                &mut right_buf,
-                &mut left_buf,
-                inst,
-                self.no_interpolation,
-                STEREO_PRIMARY,
-                STEREO_BLEED,
-            );
-            st.voices[2].mix_stereo(
-                &mut right_buf,
-                &mut left_buf,
-                inst,
-                self.no_interpolation,
-                STEREO_PRIMARY,
-                STEREO_BLEED,
-            );
-
-            // Mix any active SFX (independent of the 4 music voices; centred stereo).
-            if let Ok(mut sfx) = self.sfx.lock() {
-                sfx.mix_into(&mut left_buf, &mut right_buf, chunk_frames);
-            }
+        self.track_underrun(total_frames);
+        self.drain_commands();
 
-            // Interleave left/right into the output buffer.
-            // Scale f32 [-1.0, 1.0] → i16 [-32767, 32767].
-            for i in 0..chunk_frames {
-                let base = (frame_pos + i) * 2;
-                out[base] = (left_buf[i].clamp(-1.0, 1.0) * i16::MAX as f32) as i16;
-                out[base + 1] = (right_buf[i].clamp(-1.0, 1.0) * i16::MAX as f32) as i16;
-            }
+        // Reused across callbacks; only grows if SDL asks for a larger buffer.
+        let mut out = std::mem::take(&mut self.out);
+        out.clear();
+        out.resize(total_frames * 2, 0);
+        render_frames(&mut self.seq, &mut self.sfx, &self.instruments, self.no_interpolation, &mut out);
 
-            frame_pos += chunk_frames;
-            st.samples_to_vbl -= chunk_frames as f64;
+        if self.seq.score_finished() {
+            self.status
+                .finished_score
+                .store(self.score_id, Ordering::Release);
         }
 
         // Push the rendered PCM into the SDL3 audio stream.
         let _ = stream.put_data_i16(&out);
+        self.out = out;
     }
 }
 
@@ -853,14 +991,27 @@ impl AudioCallback<i16> for SynthCallback {
 
 /// The top-level audio system.  Create with [`AudioSystem::new`], then call
 /// [`AudioSystem::play_score`] to start music.
+///
+/// Lives on the main thread.  Control calls only queue an [`AudioCommand`];
+/// queries answer from state mirrored here when the command was sent, plus
+/// the atomics in [`AudioStatus`] for what only the callback can know.
 pub struct AudioSystem {
-    state: Arc<Mutex<SequencerState>>,
-    instruments: Instruments,
-    sfx: Arc<Mutex<SfxChannel>>,
+    commands: spsc::Producer<AudioCommand>,
+    status: Arc<AudioStatus>,
     _stream: AudioStreamWithCallback<SynthCallback>,
     song_library: Option<SongLibrary>,
-    music_enabled: Arc<Mutex<bool>>,
-    sfx_enabled: Arc<Mutex<bool>>,
+    /// Decoded PCM for each of the 6 effects; `None` until `load_samples`.
+    sfx_samples: [Option<Arc<Vec<i8>>>; SFX_COUNT],
+    /// Id of the most recently queued score (0 = none yet).
+    score_id: Cell<u32>,
+    playing: Cell<bool>,
+    current_group: Cell<Option<usize>>,
+    cave_mode: Cell<bool>,
+    music_enabled: Cell<bool>,
+    sfx_enabled: Cell<bool>,
+    /// Commands dropped on a full queue since the last report.
+    dropped_commands: Cell<u64>,
+    last_drop_report: Cell<Option<Instant>>,
 }
 
 impl AudioSystem {
@@ -881,22 +1032,22 @@ impl AudioSystem {
             format: Some(AudioFormat::s16_sys()),
         };
 
-        let state = Arc::new(Mutex::new(SequencerState::new()));
-        let state_cb = Arc::clone(&state);
-        // Clone instruments for the callback; the original is kept for play_score
-        let instruments_cb = instruments.clone();
-
-        let sfx = Arc::new(Mutex::new(SfxChannel::new()));
-        let sfx_cb = Arc::clone(&sfx);
-
-        let music_enabled = Arc::new(Mutex::new(true));
-        let sfx_enabled = Arc::new(Mutex::new(true));
+        let (commands, commands_cb) = spsc::channel(COMMAND_QUEUE_LEN);
+        let status = Arc::new(AudioStatus {
+            finished_score: AtomicU32::new(0),
+            underruns: AtomicU64::new(0),
+        });
 
         let stream = audio_subsystem
             .open_playback_stream(&spec, SynthCallback {
-                state: state_cb,
-                instruments: instruments_cb,
-                sfx: sfx_cb,
+                seq: SequencerState::new(),
+                instruments,
+                sfx: SfxChannel::new(),
+                commands: commands_cb,
+                status: Arc::clone(&status),
+                score_id: 0,
+                buffered_until: None,
+                out: Vec::new(),
                 no_interpolation,
             })
             .map_err(|e| e.to_string())?;
@@ -904,71 +1055,89 @@ impl AudioSystem {
         stream.resume().map_err(|e| e.to_string())?;
 
         Ok(AudioSystem {
-            state,
-            instruments,
-            sfx,
+            commands,
+            status,
             _stream: stream,
             song_library: None,
-            music_enabled,
-            sfx_enabled,
+            sfx_samples: Default::default(),
+            score_id: Cell::new(0),
+            playing: Cell::new(false),
+            current_group: Cell::new(None),
+            cave_mode: Cell::new(false),
+            music_enabled: Cell::new(true),
+            sfx_enabled: Cell::new(true),
+            dropped_commands: Cell::new(0),
+            last_drop_report: Cell::new(None),
         })
     }
 
+    /// Queue `cmd` for the audio callback without blocking.
+    fn send(&self, cmd: AudioCommand) {
+        if self.commands.push(cmd).is_err() {
+            self.dropped_commands.set(self.dropped_commands.get() + 1);
+        }
+    }
+
+    /// Number of commands dropped on a full queue since the last report, or
+    /// `None` if there were none or the last report was under
+    /// `DROP_REPORT_INTERVAL` ago.
+    pub fn take_dropped_commands(&self) -> Option<u64> {
+        let dropped = self.dropped_commands.get();
+        let now = Instant::now();
+        let due = self.last_drop_report.get().is_none_or(|t| now - t >= DROP_REPORT_INTERVAL);
+        if dropped == 0 || !due {
+            return None;
+        }
+        self.dropped_commands.set(0);
+        self.last_drop_report.set(Some(now));
+        Some(dropped)
+    }
+
     /// Start playing four tracks from the beginning (mirrors `_playscore`).
     ///
-    /// Typically called with `library.intro_tracks()` for the intro music.
-    pub fn play_score(&self, tracks: [Arc<Track>; 4]) {
-        let [t0, t1, t2, t3] = tracks;
-        if let Ok(mut st) = self.state.lock() {
-            st.play_score(t0, t1, t2, t3, &self.instruments);
-        }
+    /// Typically called with `library.compiled_intro()` for the intro music.
+    pub fn play_score(&self, tracks: [Arc<CompiledTrack>; 4]) {
+        self.queue_score(tracks, None);
+    }
+
+    fn queue_score(&self, tracks: [Arc<CompiledTrack>; 4], group: Option<usize>) {
+        // Ids start at 1 so a fresh status (finished_score == 0) never matches.
+        let id = self.score_id.get().wrapping_add(1).max(1);
+        self.score_id.set(id);
+        self.playing.set(true);
+        self.current_group.set(group);
+        self.send(AudioCommand::PlayScore { tracks, id });
     }
 
     /// Stop all playback immediately (mirrors `_stopscore`).
     pub fn stop_score(&self) {
-        if let Ok(mut st) = self.state.lock() {
-            st.stop_score();
-        }
+        self.playing.set(false);
+        self.current_group.set(None);
+        self.send(AudioCommand::StopScore);
     }
 
     /// Play a song group by index (0–6).  Each group is four voices occupying
     /// four consecutive track slots.  Group 3 is the intro music.
     /// Returns `false` if the group is not present in the library.
     pub fn play_group(&self, group: usize, library: &SongLibrary) -> bool {
-        let tracks = match library.group(group) {
-            Some(t) => t.map(|tr| Arc::new(tr.clone())),
-            None => return false,
-        };
-        if let Ok(mut st) = self.state.lock() {
-            let [t0, t1, t2, t3] = tracks;
-            st.play_score(t0, t1, t2, t3, &self.instruments);
-            st.current_group = Some(group);
-        }
+        let Some(tracks) = library.compiled_group(group) else { return false; };
+        self.queue_score(tracks, Some(group));
         true
     }
 
     /// Return the song group currently being played (0–6), or `None` if stopped.
     pub fn current_group(&self) -> Option<usize> {
-        self.state
-            .lock()
-            .ok()
-            .and_then(|st| if !st.nosound { st.current_group } else { None })
+        self.current_group.get()
     }
 
     /// Change the current tempo (mirrors `_set_tempo`).
     pub fn set_tempo(&self, tempo: u32) {
-        if let Ok(mut st) = self.state.lock() {
-            st.tempo = tempo;
-        }
+        self.send(AudioCommand::SetTempo(tempo));
     }
 
     /// Return `true` if any voice is currently playing.
     pub fn is_playing(&self) -> bool {
-        if let Ok(st) = self.state.lock() {
-            !st.nosound
-        } else {
-            false
-        }
+        self.playing.get()
     }
 
     /// Return `true` when the score has played to its natural end.
@@ -979,11 +1148,14 @@ impl AudioSystem {
     /// lets callers wait for the PCM already queued in the SDL3 audio buffer
     /// to drain before transitioning, rather than cutting audio short.
     pub fn is_score_finished(&self) -> bool {
-        if let Ok(st) = self.state.lock() {
-            !st.nosound && st.voices.iter().all(|v| v.trak_ptr.is_none())
-        } else {
-            false
-        }
+        self.playing.get()
+            && self.status.finished_score.load(Ordering::Acquire) == self.score_id.get()
+    }
+
+    /// Number of audio buffers that arrived after the device had already run
+    /// out of queued PCM, since the stream was opened.
+    pub fn underruns(&self) -> u64 {
+        self.status.underruns.load(Ordering::Relaxed)
     }
 
     /// Attach a [`SongLibrary`] to enable [`set_score`](Self::set_score).
@@ -1023,14 +1195,13 @@ impl AudioSystem {
     /// instead of the default `(wave=1, vol=0)`.  This mirrors the `new_wave[10] = 0x0307`
     /// write that `fmain.c` performs on entering region 9 (cave).
     pub fn set_cave_mode(&self, cave: bool) {
-        if let Ok(mut st) = self.state.lock() {
-            st.cave_mode = cave;
-        }
+        self.cave_mode.set(cave);
+        self.send(AudioCommand::SetCaveMode(cave));
     }
 
     /// Return `true` if the cave instrument override is active.
     pub fn is_cave_mode(&self) -> bool {
-        self.state.lock().ok().map_or(false, |st| st.cave_mode)
+        self.cave_mode.get()
     }
     ///
     /// Format (from `read_sample()` in `fmain.c`): six contiguous records,
@@ -1048,10 +1219,6 @@ impl AudioSystem {
             }
         };
 
-        let mut sfx = self
-            .sfx
-            .lock()
-            .map_err(|e| format!("sfx lock poisoned: {e}"))?;
         let mut cursor = 0usize;
         for i in 0..SFX_COUNT {
             if cursor + 4 > data.len() {
@@ -1073,7 +1240,7 @@ impl AudioSystem {
                 .iter()
                 .map(|&b| b as i8)
                 .collect();
-            sfx.samples[i] = Some(Arc::new(pcm));
+            self.sfx_samples[i] = Some(Arc::new(pcm));
             cursor += len;
         }
         Ok(())
@@ -1086,20 +1253,16 @@ impl AudioSystem {
     /// This method respects the SFX enable flag (SPEC §25.5 GAME, Sound toggle).
     pub fn play_sfx(&self, sfx_id: u8) {
         // Check if SFX is enabled
-        if let Ok(enabled) = self.sfx_enabled.lock() {
-            if !*enabled {
-                return;
-            }
+        if !self.sfx_enabled.get() {
+            return;
         }
 
         let id = sfx_id as usize;
         if id >= SFX_COUNT {
             return;
         }
-        if let Ok(mut sfx) = self.sfx.lock() {
-            if let Some(data) = sfx.samples[id].clone() {
-                sfx.active = Some(SfxPlayback { data, pos: 0.0 });
-            }
+        if let Some(data) = self.sfx_samples[id].clone() {
+            self.send(AudioCommand::PlaySfx(data));
         }
     }
 
@@ -1107,9 +1270,7 @@ impl AudioSystem {
     /// When disabled, stops current playback; when enabled, caller must
     /// call `set_score()` to resume appropriate mood music.
     pub fn set_music_enabled(&self, enabled: bool) {
-        if let Ok(mut flag) = self.music_enabled.lock() {
-            *flag = enabled;
-        }
+        self.music_enabled.set(enabled);
         if !enabled {
             self.stop_score();
         }
@@ -1117,19 +1278,17 @@ impl AudioSystem {
 
     /// Return true if music playback is enabled.
     pub fn is_music_enabled(&self) -> bool {
-        self.music_enabled.lock().ok().map_or(true, |f| *f)
+        self.music_enabled.get()
     }
 
     /// Enable or disable sound effects (SPEC §25.5 GAME, Sound toggle).
     pub fn set_sfx_enabled(&self, enabled: bool) {
-        if let Ok(mut flag) = self.sfx_enabled.lock() {
-            *flag = enabled;
-        }
+        self.sfx_enabled.set(enabled);
     }
 
     /// Return true if sound effects are enabled.
     pub fn is_sfx_enabled(&self) -> bool {
-        self.sfx_enabled.lock().ok().map_or(true, |f| *f)
+        self.sfx_enabled.get()
     }
 }
 
@@ -1226,8 +1385,7 @@ mod tests {
         let songs = load_songs();
         let mut st = SequencerState::new();
 
-        let intro = songs.intro_tracks().expect("intro tracks must exist");
-        let tracks = intro.map(|t| Arc::new(t.clone()));
+        let tracks = songs.compiled_intro().expect("intro tracks must exist");
         let [t0, t1, t2, t3] = tracks;
         st.play_score(t0, t1, t2, t3, &inst);
 
@@ -1248,8 +1406,7 @@ mod tests {
         let songs = load_songs();
         let mut st = SequencerState::new();
 
-        let intro = songs.intro_tracks().expect("intro tracks must exist");
-        let tracks = intro.map(|t| Arc::new(t.clone()));
+        let tracks = songs.compiled_intro().expect("intro tracks must exist");
         let [t0, t1, t2, t3] = tracks;
         st.play_score(t0, t1, t2, t3, &inst);
 
@@ -1268,8 +1425,7 @@ mod tests {
         let songs = load_songs();
         let mut st = SequencerState::new();
 
-        let intro = songs.intro_tracks().expect("intro tracks must exist");
-        let tracks = intro.map(|t| Arc::new(t.clone()));
+        let tracks = songs.compiled_intro().expect("intro tracks must exist");
         let [t0, t1, t2, t3] = tracks;
         st.play_score(t0, t1, t2, t3, &inst);
 
@@ -1330,6 +1486,164 @@ mod tests {
         );
     }
 
+    fn test_callback(inst: Instruments) -> (spsc::Producer<AudioCommand>, SynthCallback) {
+        let (tx, rx) = spsc::channel(COMMAND_QUEUE_LEN);
+        let cb = SynthCallback {
+            seq: SequencerState::new(),
+            instruments: inst,
+            sfx: SfxChannel::new(),
+            commands: rx,
+            status: Arc::new(AudioStatus {
+                finished_score: AtomicU32::new(0),
+                underruns: AtomicU64::new(0),
+            }),
+            score_id: 0,
+            buffered_until: None,
+            out: Vec::new(),
+            no_interpolation: false,
+        };
+        (tx, cb)
+    }
+
+    #[test]
+    fn test_callback_applies_queued_commands_in_order() {
+        let songs = load_songs();
+        let (tx, mut cb) = test_callback(load_instruments());
+        let tracks = songs.compiled_intro().expect("intro tracks must exist");
+
+        assert!(tx.push(AudioCommand::SetCaveMode(true)).is_ok());
+        assert!(tx.push(AudioCommand::PlayScore { tracks, id: 7 }).is_ok());
+        assert!(tx.push(AudioCommand::SetTempo(90)).is_ok());
+        let blip = Arc::new(vec![64i8; 16]);
+        assert!(tx.push(AudioCommand::PlaySfx(blip)).is_ok());
+        cb.drain_commands();
+        assert!(!cb.seq.nosound);
+        assert!(cb.seq.cave_mode);
+        assert_eq!(cb.seq.tempo, 90, "SetTempo after PlayScore must win");
+        assert_eq!(cb.score_id, 7);
+        assert!(cb.sfx.active.is_some());
+
+        assert!(tx.push(AudioCommand::StopScore).is_ok());
+        cb.drain_commands();
+        assert!(cb.seq.nosound);
+        assert!(cb.commands.pop().is_none());
+    }
+
+    #[test]
+    fn test_late_request_counts_as_underrun() {
+        let (_tx, mut cb) = test_callback(Instruments::parse(&[]));
+        // 441 frames = 10 ms of audio.
+        cb.track_underrun(441);
+        cb.track_underrun(441);
+        assert_eq!(cb.status.underruns.load(Ordering::Relaxed), 0);
+        std::thread::sleep(Duration::from_millis(40));
+        cb.track_underrun(441);
+        assert_eq!(cb.status.underruns.load(Ordering::Relaxed), 1);
+    }
+
+    /// The per-sample mixer `render` replaced, kept as a reference.
+    fn reference_mix(v: &mut Voice, buf: &mut [f32], inst: &Instruments) {
+        const NOISE_FLOOR: f32 = 1.0 / 65536.0;
+        const DECLICK_RATE: f32 = 1.0 / 64.0;
+        const LP_ALPHA: f32 = 0.487;
+        let target = if v.playing && v.wave_len > 0 && v.volume > 0 {
+            v.volume as f32 / 64.0 * 0.5
+        } else {
+            0.0
+        };
+        if v.declick < NOISE_FLOOR && target < NOISE_FLOOR && v.lp_state.abs() < NOISE_FLOOR {
+            v.declick = 0.0;
+            v.lp_state = 0.0;
+            return;
+        }
+        let wf = &inst.waveforms[v.wave_num];
+        let (start, len) = (v.wave_start, v.wave_len);
+        for o in buf.iter_mut() {
+            if v.declick < target {
+                v.declick = (v.declick + DECLICK_RATE).min(target);
+            } else if v.declick > target {
+                v.declick = (v.declick - DECLICK_RATE).max(target);
+            }
+            let raw = if v.playing && len > 0 && v.volume > 0 {
+                let int_part = v.phase as usize;
+                let frac = (v.phase - int_part as f64) as f32;
+                let s0 = wf[start + int_part] as f32;
+                let s1 = wf[start + (int_part + 1) % len] as f32;
+                v.phase += v.phase_inc;
+                if v.phase >= len as f64 {
+                    v.phase -= len as f64;
+                }
+                (s0 + frac * (s1 - s0)) / 128.0
+            } else {
+                0.0
+            };
+            v.lp_state = LP_ALPHA * raw + (1.0 - LP_ALPHA) * v.lp_state;
+            *o += v.lp_state * v.declick;
+        }
+    }
+
+    #[test]
+    fn test_block_mixer_matches_per_sample_reference() {
+        let inst = load_instruments();
+        let mut fast = Voice::new();
+        let mut slow = Voice::new();
+        for v in [&mut fast, &mut slow] {
+            v.vol_num = 4;
+            v.trigger_note(40, &inst); // short loop, crosses wrap often
+            v.volume = 48;
+        }
+        // Attack and sustain across several blocks, then release tail.
+        let mut want = vec![0.0f32; 1500];
+        let mut got = vec![0.0f32; 1500];
+        reference_mix(&mut slow, &mut want[..700], &inst);
+        fast.mix_into(&mut got[..700], &inst, false);
+        slow.playing = false;
+        fast.playing = false;
+        reference_mix(&mut slow, &mut want[700..], &inst);
+        fast.mix_into(&mut got[700..], &inst, false);
+
+        assert!(want.iter().any(|&s| s.abs() > 0.01));
+        let worst = want
+            .iter()
+            .zip(&got)
+            .map(|(a, b)| (a - b).abs())
+            .fold(0.0f32, f32::max);
+        assert!(worst < 1e-5, "block mixer diverges by {worst}");
+    }
+
+    #[test]
+    fn test_render_block_mixes_sfx_centred_without_music() {
+        let (tx, mut cb) = test_callback(Instruments::parse(&[]));
+        let blip = Arc::new(vec![127i8; 64]);
+        assert!(tx.push(AudioCommand::PlaySfx(blip)).is_ok());
+        cb.drain_commands();
+        let mut out = [0i16; 2 * 8];
+        cb.render_block(&mut out);
+        let expected = (127.0 / 128.0 * SFX_AMPLITUDE * i16::MAX as f32) as i16;
+        assert!(out.iter().all(|&s| s == expected), "{out:?}");
+    }
+
+    #[test]
+    fn test_render_score_matches_the_callback_path() {
+        let inst = load_instruments();
+        let songs = load_songs();
+        let intro = songs.compiled_intro().expect("intro tracks");
+        let frames = 4 * MIX_BLOCK + 17;
+        let offline = render_score(intro.clone(), &inst, false, frames);
+        assert_eq!(offline.len(), frames * 2);
+        assert!(offline.iter().any(|&s| s != 0), "intro renders silence");
+
+        let mut seq = SequencerState::new();
+        let [t0, t1, t2, t3] = intro;
+        seq.play_score(t0, t1, t2, t3, &inst);
+        let mut sfx = SfxChannel::new();
+        let mut live = vec![0i16; frames * 2];
+        for chunk in live.chunks_mut(2 * 300) {
+            render_frames(&mut seq, &mut sfx, &inst, false, chunk);
+        }
+        assert_eq!(offline, live);
+    }
+
     // T2-AUDIO-MUSIC-TOGGLE and T2-AUDIO-SFX-TOGGLE tests (SPEC §25.5 GAME)
 
     // Note: Full AudioSystem tests require SDL3 audio device initialization,
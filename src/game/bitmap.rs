@@ -1,10 +1,12 @@
 // Classes and utilities for working with bitmaps and bitplanes
 
-use std::cell::RefCell;
+use std::sync::OnceLock;
 
 use serde::Deserialize;
 
 use crate::game::colors::Palette;
+use crate::game::palette_lut;
+use crate::game::planar;
 
 #[derive(Deserialize, Debug, Clone)]
 pub struct BitMap {
@@ -14,9 +16,9 @@ pub struct BitMap {
     pub stride: usize, // bytes per row
     pub planes: Vec<Vec<u8>>,
 
-    // Optimization: cached index buffer
+    // Optimization: cached index buffer (one palette index per pixel, depth <= 5)
     #[serde(skip)]
-    index_buffer: RefCell<Option<Vec<usize>>>,
+    index_buffer: OnceLock<Vec<u8>>,
 }
 
 impl BitMap {
@@ -30,7 +32,7 @@ impl BitMap {
             depth: 0,
             stride: 0,
             planes: Vec::new(),
-            index_buffer: RefCell::new(None),
+            index_buffer: OnceLock::new(),
         }
     }
 
@@ -49,13 +51,13 @@ impl BitMap {
             depth,
             stride,
             planes,
-            index_buffer: RefCell::new(None),
+            index_buffer: OnceLock::new(),
         }
     }
 
     /// Invalidate the cached index buffer (call after modifying plane data).
-    pub fn invalidate_cache(&self) {
-        *self.index_buffer.borrow_mut() = None;
+    pub fn invalidate_cache(&mut self) {
+        self.index_buffer.take();
     }
 
     /**
@@ -82,7 +84,7 @@ impl BitMap {
             depth: depth,
             stride: stride,
             planes: Vec::with_capacity(depth),
-            index_buffer: RefCell::new(None),
+            index_buffer: OnceLock::new(),
         };
 
         let plane_size = stride * height;
@@ -129,7 +131,7 @@ impl BitMap {
             depth: depth,
             stride: stride,
             planes: Vec::with_capacity(depth),
-            index_buffer: RefCell::new(None),
+            index_buffer: OnceLock::new(),
         };
 
         let plane_size = stride * height;
@@ -165,7 +167,7 @@ impl BitMap {
             depth: depth,
             stride: ((width + 15) >> 3) & !1_usize,
             planes: Vec::with_capacity(depth),
-            index_buffer: RefCell::new(None),
+            index_buffer: OnceLock::new(),
         };
 
         let plane_size = bitmap.stride * height;
@@ -219,45 +221,33 @@ impl BitMap {
                 color_table[key_index] = 0x00000000;
             }
         }
-
-        // optimization: reverse iterate over the planes and build an index buffer directly from plane data
-        if self.index_buffer.borrow().is_none() {
-            // build index buffer
-            let mut index_buffer: Vec<usize> = Vec::with_capacity(self.width * self.height);
-            for yy in 0..self.height {
-                for xx in 0..self.width {
-                    let mut pixel_index: usize = 0;
-                    for pp in 0..self.depth {
-                        let plane = &self.planes[pp];
-                        let byte_index = yy * self.stride + (xx >> 3);
-                        let bit_index = 7 - (xx & 0x07);
-                        let bit = (plane[byte_index] >> bit_index) & 0x01;
-                        pixel_index |= (bit as usize) << pp;
+        let lut = palette_lut::rgba32_lut(&color_table);
+
+        // optimization: build an index buffer directly from plane data, once
+        let indices = self.index_buffer.get_or_init(|| {
+            let mut index_buffer: Vec<u8> = vec![0; self.width * self.height];
+            if self.width > 0 {
+                for (yy, dst) in index_buffer.chunks_exact_mut(self.width).enumerate() {
+                    let row_start = yy * self.stride;
+                    let mut planes: [&[u8]; planar::MAX_PLANES] = [&[]; planar::MAX_PLANES];
+                    for (row, plane) in planes.iter_mut().zip(&self.planes[..self.depth]) {
+                        *row = &plane[row_start..row_start + self.stride];
                     }
-                    index_buffer.push(pixel_index);
+                    planar::row_to_chunky(&planes[..self.depth], dst);
                 }
             }
-            // cache it
-            *self.index_buffer.borrow_mut() = Some(index_buffer);
-        }
-
-        // now build the pixel buffer from the index buffer and color table
-        let index_buffer = self.index_buffer.borrow();
-        let indices = index_buffer.as_ref().unwrap();
+            index_buffer
+        });
 
         // since stride may not match (esp if we're copying into a larger pixmap), we have to write row by row
         for row in 0..self.height {
             let row_start = row * self.width;
             let pixel_row_start = row * stride;
-            for col in 0..self.width {
-                let color_index = indices[row_start + col];
-                let color = color_table[color_index];
-                let pixel_offset = pixel_row_start + col * 4;
-                pixels[pixel_offset + 0] = ((color >> 24) & 0xFF) as u8; // R
-                pixels[pixel_offset + 1] = ((color >> 16) & 0xFF) as u8; // G
-                pixels[pixel_offset + 2] = ((color >> 8) & 0xFF) as u8; // B
-                pixels[pixel_offset + 3] = (color & 0xFF) as u8; // A
-            }
+            palette_lut::convert(
+                &indices[row_start..row_start + self.width],
+                &lut,
+                &mut pixels[pixel_row_start..pixel_row_start + self.width * 4],
+            );
         }
 
         Ok(())
@@ -0,0 +1,396 @@
+//! Decode cache: de-planarised ADF graphics in one memory-mapped file.
+//!
+//! `pack_bundle` (src/bin) runs the normal loaders once and writes their
+//! output here: chunky sprite sheets and per-region tile atlases, so the game
+//! copies them out of the mapping instead of de-planarising at startup and on
+//! every region change.  Only those two decoders are cached.  faery.toml
+//! still goes through serde at every launch, and palettes, songs and the
+//! location/object tables load as before; they cost little next to the
+//! planar decode.  Sections are copied into the usual owned `SpriteSheet` /
+//! `TileAtlas` values rather than used in place.
+//!
+//! Layout (all integers little-endian):
+//!
+//! ```text
+//! header   magic "FMRSBNDL", version u32, section count u32, fingerprint u64
+//! table    count × { kind u32, key u32, offset u64, len u64 }
+//! sections each starting on a SECTION_ALIGN boundary
+//! ```
+//!
+//! The fingerprint hashes every input of the bundled decoders (the ADF image
+//! and the faery.toml block locations).  A bundle whose version or
+//! fingerprint does not match is stale; [`Bundle::open`] rejects it and
+//! callers fall back to decoding from the ADF.
+
+use anyhow::{bail, Context, Result};
+use std::fs::File;
+use std::path::Path;
+
+use crate::game::adf::AdfDisk;
+use crate::game::game_library::GameLibrary;
+use crate::game::region_cache::RegionSource;
+use crate::game::sprites::SpriteSheet;
+use crate::game::tile_atlas::{TileAtlas, TOTAL_TILES};
+
+pub const MAGIC: [u8; 8] = *b"FMRSBNDL";
+/// Bump whenever a bundled decoder's output or a section layout changes.
+pub const BUNDLE_VERSION: u32 = 1;
+/// Section payloads start on this boundary so pixel data can be read in
+/// aligned chunks straight from the mapping.
+pub const SECTION_ALIGN: usize = 16;
+/// Where the game looks for a bundle when faery.toml's `[disk]` names none.
+pub const DEFAULT_BUNDLE_PATH: &str = "game/fmain.bundle";
+
+const HEADER_LEN: usize = 24;
+const ENTRY_LEN: usize = 24;
+
+/// What a section holds; its `key` says which one.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+#[repr(u32)]
+pub enum SectionKind {
+    /// Key: cfile index.  `{ num_frames u32, frame_h u32 }` then the pixels.
+    SpriteSheet = 1,
+    /// Key: region number.  `mask_type[TOTAL_TILES]`, `maptag[TOTAL_TILES]`,
+    /// then the pixels.
+    TileAtlas = 2,
+}
+
+#[derive(Debug, Clone, Copy)]
+struct Entry {
+    kind: u32,
+    key: u32,
+    offset: usize,
+    len: usize,
+}
+
+/// Backing bytes of an open bundle.
+enum Storage {
+    Owned(Vec<u8>),
+    Mapped(memmap2::Mmap),
+}
+
+pub struct Bundle {
+    data: Storage,
+    entries: Vec<Entry>,
+}
+
+fn read_u32(b: &[u8], at: usize) -> u32 {
+    u32::from_le_bytes(b[at..at + 4].try_into().unwrap())
+}
+
+fn read_u64(b: &[u8], at: usize) -> u64 {
+    u64::from_le_bytes(b[at..at + 8].try_into().unwrap())
+}
+
+impl Bundle {
+    /// Open the bundle at `path`, memory-mapped when the platform allows it.
+    /// Fails if the file is malformed, from another format version, or was
+    /// built from different sources than `fingerprint` describes.
+    pub fn open(path: &Path, fingerprint: u64) -> Result<Self> {
+        let file = File::open(path)
+            .with_context(|| format!("failed to read bundle: {}", path.display()))?;
+        // SAFETY: the mapping is read-only.  Another process rewriting the
+        // file while we run would change what the slices observe; the bundle
+        // is a build artefact replaced only by `pack_bundle`, which writes a
+        // new file and renames it over the old one, so the mapped inode is
+        // never modified in place.
+        let data = match unsafe { memmap2::Mmap::map(&file) } {
+            Ok(map) => Storage::Mapped(map),
+            Err(_) => Storage::Owned(
+                std::fs::read(path)
+                    .with_context(|| format!("failed to read bundle: {}", path.display()))?,
+            ),
+        };
+        Self::from_storage(data, fingerprint)
+    }
+
+    /// Parse a bundle held in memory (useful for testing).
+    pub fn from_bytes(data: Vec<u8>, fingerprint: u64) -> Result<Self> {
+        Self::from_storage(Storage::Owned(data), fingerprint)
+    }
+
+    fn from_storage(data: Storage, fingerprint: u64) -> Result<Self> {
+        let mut bundle = Bundle { data, entries: Vec::new() };
+        let bytes = bundle.bytes();
+        if bytes.len() < HEADER_LEN || bytes[..8] != MAGIC {
+            bail!("not a data bundle");
+        }
+        let version = read_u32(bytes, 8);
+        if version != BUNDLE_VERSION {
+            bail!("bundle version {} (expected {})", version, BUNDLE_VERSION);
+        }
+        if read_u64(bytes, 16) != fingerprint {
+            bail!("bundle is stale: built from different game data");
+        }
+        let count = read_u32(bytes, 12) as usize;
+        let table_end = HEADER_LEN + count * ENTRY_LEN;
+        if table_end > bytes.len() {
+            bail!("bundle section table truncated");
+        }
+        let mut entries = Vec::with_capacity(count);
+        for i in 0..count {
+            let at = HEADER_LEN + i * ENTRY_LEN;
+            let entry = Entry {
+                kind: read_u32(bytes, at),
+                key: read_u32(bytes, at + 4),
+                offset: read_u64(bytes, at + 8) as usize,
+                len: read_u64(bytes, at + 16) as usize,
+            };
+            if entry.offset % SECTION_ALIGN != 0
+                || entry.offset.checked_add(entry.len).map_or(true, |end| end > bytes.len())
+            {
+                bail!("bundle section {} out of bounds", i);
+            }
+            entries.push(entry);
+        }
+        bundle.entries = entries;
+        Ok(bundle)
+    }
+
+    /// True when the bundle is served from a memory mapping.
+    pub fn is_mapped(&self) -> bool {
+        matches!(self.data, Storage::Mapped(_))
+    }
+
+    fn bytes(&self) -> &[u8] {
+        match &self.data {
+            Storage::Owned(v) => v,
+            Storage::Mapped(m) => m,
+        }
+    }
+
+    pub fn section_count(&self) -> usize {
+        self.entries.len()
+    }
+
+    /// Payload of the `kind` section for `key`.
+    pub fn section(&self, kind: SectionKind, key: u32) -> Option<&[u8]> {
+        let e = self.entries.iter().find(|e| e.kind == kind as u32 && e.key == key)?;
+        Some(&self.bytes()[e.offset..e.offset + e.len])
+    }
+
+    /// The sprite sheet for `cfile_idx`, if bundled and well-formed.
+    pub fn sprite_sheet(&self, cfile_idx: u8) -> Option<SpriteSheet> {
+        let data = self.section(SectionKind::SpriteSheet, cfile_idx as u32)?;
+        let num_frames = read_u32(data.get(..8)?, 0) as usize;
+        let frame_h = read_u32(data, 4) as usize;
+        let pixels = &data[8..];
+        if pixels.len() != num_frames * frame_h * crate::game::sprites::SPRITE_W {
+            return None;
+        }
+        Some(SpriteSheet { cfile_idx, pixels: pixels.to_vec(), num_frames, frame_h })
+    }
+
+    /// The tile atlas for `region`, if bundled and well-formed.
+    pub fn tile_atlas(&self, region: u8) -> Option<TileAtlas> {
+        let data = self.section(SectionKind::TileAtlas, region as u32)?;
+        if data.len() != 2 * TOTAL_TILES + TOTAL_TILES * crate::game::tile_atlas::TILE_PIXELS {
+            return None;
+        }
+        let (mask_type, rest) = data.split_at(TOTAL_TILES);
+        let (maptag, pixels) = rest.split_at(TOTAL_TILES);
+        Some(TileAtlas {
+            pixels: pixels.to_vec(),
+            mask_type: mask_type.try_into().unwrap(),
+            maptag: maptag.try_into().unwrap(),
+        })
+    }
+}
+
+/// Collects sections and writes them out as a bundle.
+#[derive(Default)]
+pub struct BundleWriter {
+    sections: Vec<(SectionKind, u32, Vec<u8>)>,
+}
+
+impl BundleWriter {
+    pub fn add(&mut self, kind: SectionKind, key: u32, payload: Vec<u8>) {
+        self.sections.push((kind, key, payload));
+    }
+
+    pub fn add_sprite_sheet(&mut self, sheet: &SpriteSheet) {
+        let mut payload = Vec::with_capacity(8 + sheet.pixels.len());
+        payload.extend_from_slice(&(sheet.num_frames as u32).to_le_bytes());
+        payload.extend_from_slice(&(sheet.frame_h as u32).to_le_bytes());
+        payload.extend_from_slice(&sheet.pixels);
+        self.add(SectionKind::SpriteSheet, sheet.cfile_idx as u32, payload);
+    }
+
+    pub fn add_tile_atlas(&mut self, region: u8, atlas: &TileAtlas) {
+        let mut payload = Vec::with_capacity(2 * TOTAL_TILES + atlas.pixels.len());
+        payload.extend_from_slice(&atlas.mask_type);
+        payload.extend_from_slice(&atlas.maptag);
+        payload.extend_from_slice(&atlas.pixels);
+        self.add(SectionKind::TileAtlas, region as u32, payload);
+    }
+
+    /// Serialise the header, section table and padded payloads.
+    pub fn to_bytes(&self, fingerprint: u64) -> Vec<u8> {
+        let align = |n: usize| n.div_ceil(SECTION_ALIGN) * SECTION_ALIGN;
+        let mut out = Vec::new();
+        out.extend_from_slice(&MAGIC);
+        out.extend_from_slice(&BUNDLE_VERSION.to_le_bytes());
+        out.extend_from_slice(&(self.sections.len() as u32).to_le_bytes());
+        out.extend_from_slice(&fingerprint.to_le_bytes());
+
+        let mut offset = align(HEADER_LEN + self.sections.len() * ENTRY_LEN);
+        for (kind, key, payload) in &self.sections {
+            out.extend_from_slice(&(*kind as u32).to_le_bytes());
+            out.extend_from_slice(&key.to_le_bytes());
+            out.extend_from_slice(&(offset as u64).to_le_bytes());
+            out.extend_from_slice(&(payload.len() as u64).to_le_bytes());
+            offset = align(offset + payload.len());
+        }
+        for (_, _, payload) in &self.sections {
+            out.resize(align(out.len()), 0);
+            out.extend_from_slice(payload);
+        }
+        out
+    }
+
+    /// Write the bundle to `path` via a temporary file and a rename, so a
+    /// running game never maps a half-written bundle.
+    pub fn write(&self, path: &Path, fingerprint: u64) -> Result<()> {
+        let mut tmp = path.as_os_str().to_owned();
+        tmp.push(".tmp");
+        std::fs::write(&tmp, self.to_bytes(fingerprint))
+            .with_context(|| format!("failed to write bundle: {}", path.display()))?;
+        std::fs::rename(&tmp, path)
+            .with_context(|| format!("failed to write bundle: {}", path.display()))?;
+        Ok(())
+    }
+}
+
+/// 64-bit FNV-1a, eight bytes per step.  Also hashes world state for the
+/// input journal's divergence checks.
+pub struct Fingerprint(pub u64);
+
+impl Fingerprint {
+    pub fn new() -> Self {
+        Fingerprint(0xcbf2_9ce4_8422_2325)
+    }
+
+    pub fn word(&mut self, w: u64) {
+        self.0 = (self.0 ^ w).wrapping_mul(0x0000_0100_0000_01b3);
+    }
+
+    pub fn bytes(&mut self, b: &[u8]) {
+        self.word(b.len() as u64);
+        let mut chunks = b.chunks_exact(8);
+        for c in &mut chunks {
+            self.word(u64::from_le_bytes(c.try_into().unwrap()));
+        }
+        let mut tail = [0u8; 8];
+        tail[..chunks.remainder().len()].copy_from_slice(chunks.remainder());
+        self.word(u64::from_le_bytes(tail));
+    }
+}
+
+/// Hash of everything the bundled sections are decoded from: the whole ADF
+/// image and each region's block locations from faery.toml.
+pub fn source_fingerprint(adf: &AdfDisk, game_lib: &GameLibrary) -> u64 {
+    let mut h = Fingerprint::new();
+    h.word(BUNDLE_VERSION as u64);
+    h.bytes(adf.load_blocks(0, adf.num_blocks() as u32));
+    for region in 0..=u8::MAX {
+        if let Some(src) = RegionSource::from_library(game_lib, region) {
+            h.word(region as u64);
+            for block in [src.sector_block, src.terra_block, src.terra2_block]
+                .into_iter()
+                .chain(src.image_blocks)
+            {
+                h.word(block as u64);
+            }
+        }
+    }
+    h.0
+}
+
+/// Bundle path named by faery.toml's `[disk]`, or [`DEFAULT_BUNDLE_PATH`].
+pub fn bundle_path(game_lib: &GameLibrary) -> &str {
+    game_lib
+        .disk
+        .as_ref()
+        .and_then(|d| d.bundle.as_deref())
+        .unwrap_or(DEFAULT_BUNDLE_PATH)
+}
+
+/// Open the bundle for `adf` and `game_lib`, or explain why it can't be used.
+pub fn open_for(adf: &AdfDisk, game_lib: &GameLibrary) -> Result<Bundle> {
+    Bundle::open(Path::new(bundle_path(game_lib)), source_fingerprint(adf, game_lib))
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::game::sprites::SPRITE_W;
+    use crate::game::tile_atlas::TILE_PIXELS;
+
+    fn sheet() -> SpriteSheet {
+        SpriteSheet {
+            cfile_idx: 5,
+            pixels: (0..3 * 2 * SPRITE_W).map(|i| (i % 32) as u8).collect(),
+            num_frames: 3,
+            frame_h: 2,
+        }
+    }
+
+    fn atlas() -> TileAtlas {
+        TileAtlas {
+            pixels: (0..TOTAL_TILES * TILE_PIXELS).map(|i| (i * 7 % 32) as u8).collect(),
+            mask_type: std::array::from_fn(|i| (i % 8) as u8),
+            maptag: std::array::from_fn(|i| i as u8),
+        }
+    }
+
+    #[test]
+    fn sections_round_trip_aligned() {
+        let mut w = BundleWriter::default();
+        w.add_sprite_sheet(&sheet());
+        w.add_tile_atlas(9, &atlas());
+        let b = Bundle::from_bytes(w.to_bytes(42), 42).unwrap();
+        assert_eq!(b.section_count(), 2);
+
+        let s = b.sprite_sheet(5).unwrap();
+        assert_eq!((s.num_frames, s.frame_h), (3, 2));
+        assert_eq!(s.pixels, sheet().pixels);
+        let a = b.tile_atlas(9).unwrap();
+        assert_eq!(a.pixels, atlas().pixels);
+        assert_eq!(a.mask_type, atlas().mask_type);
+        assert_eq!(a.maptag, atlas().maptag);
+
+        assert!(b.sprite_sheet(4).is_none());
+        assert!(b.tile_atlas(3).is_none());
+        for e in &b.entries {
+            assert_eq!(e.offset % SECTION_ALIGN, 0);
+        }
+    }
+
+    #[test]
+    fn stale_or_damaged_bundles_are_rejected() {
+        let mut w = BundleWriter::default();
+        w.add_sprite_sheet(&sheet());
+        let bytes = w.to_bytes(7);
+        assert!(Bundle::from_bytes(bytes.clone(), 8).is_err(), "fingerprint mismatch");
+
+        let mut old = bytes.clone();
+        old[8..12].copy_from_slice(&(BUNDLE_VERSION + 1).to_le_bytes());
+        assert!(Bundle::from_bytes(old, 7).is_err(), "version mismatch");
+
+        let truncated = bytes[..bytes.len() - 1].to_vec();
+        assert!(Bundle::from_bytes(truncated, 7).is_err(), "section past the end");
+        assert!(Bundle::from_bytes(b"FMRSBN".to_vec(), 7).is_err());
+    }
+
+    #[test]
+    fn fingerprint_tracks_the_adf() {
+        let lib: GameLibrary =
+            toml::from_str(&std::fs::read_to_string("faery.toml").unwrap()).unwrap();
+        let a = AdfDisk::from_bytes(vec![0u8; 4 * crate::game::adf::BLOCK_SIZE]);
+        let mut changed = vec![0u8; 4 * crate::game::adf::BLOCK_SIZE];
+        changed[1000] = 1;
+        let b = AdfDisk::from_bytes(changed);
+        assert_eq!(source_fingerprint(&a, &lib), source_fingerprint(&a, &lib));
+        assert_ne!(source_fingerprint(&a, &lib), source_fingerprint(&b, &lib));
+    }
+}
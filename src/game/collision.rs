@@ -72,6 +72,18 @@ pub fn px_to_terrain_type(world: &WorldData, x: i32, y: i32) -> u8 {
     (world.terra_mem[base + 1] >> 4) & 0xF
 }
 
+/// Terrain type at pixel (x, y) — same result as `px_to_terrain_type`, read
+/// from the world's packed terrain grid.  Points off the grid take the
+/// reference lookup, which also handles negative and clamped coordinates.
+#[inline]
+pub fn terrain_at(world: &WorldData, x: i32, y: i32) -> u8 {
+    let gy = if world.region_num >= 8 { y - 0x8000 } else { y };
+    match world.terrain_grid().get(x, gy) {
+        Some(t) => t,
+        None => px_to_terrain_type(world, x, y),
+    }
+}
+
 /// Hard-blocking terrain for right foot (x+4, y+2): type==1 or >=10.
 pub fn is_hard_block_right(terrain: u8) -> bool {
     terrain == 1 || terrain >= 10
@@ -90,8 +102,8 @@ pub fn proxcheck(world: Option<&WorldData>, x: i32, y: i32) -> bool {
         Some(w) => w,
         None => return true,
     };
-    let right_terrain = px_to_terrain_type(world, x + 4, y + 2);
-    let left_terrain = px_to_terrain_type(world, x - 4, y + 2);
+    let right_terrain = terrain_at(world, x + 4, y + 2);
+    let left_terrain = terrain_at(world, x - 4, y + 2);
     !is_hard_block_right(right_terrain) && !is_hard_block_left(left_terrain)
 }
 
@@ -160,8 +172,8 @@ pub fn hero_proxcheck(world: Option<&WorldData>, x: i32, y: i32, has_crystal: bo
         Some(w) => w,
         None => return true,
     };
-    let mut rt = px_to_terrain_type(world, x + 4, y + 2);
-    let mut lt = px_to_terrain_type(world, x - 4, y + 2);
+    let mut rt = terrain_at(world, x + 4, y + 2);
+    let mut lt = terrain_at(world, x - 4, y + 2);
     if rt == 8 || rt == 9 || (has_crystal && rt == 12) {
         rt = 0;
     }
@@ -340,6 +352,48 @@ mod tests {
         // All-zero world: tiles bytes are 0, so every position is passable.
         assert!(proxcheck(Some(&world), 256, 256));
     }
+
+    /// Fill every terrain table with LCG noise.
+    fn noisy_world(region_num: u8, seed: u32) -> WorldData {
+        let mut state = seed;
+        let mut next = move || {
+            state = state.wrapping_mul(1_103_515_245).wrapping_add(12_345);
+            (state >> 16) as u8
+        };
+        let mut world = WorldData::empty();
+        world.region_num = region_num;
+        world.map_mem.iter_mut().for_each(|b| *b = next());
+        world.sector_mem.iter_mut().for_each(|b| *b = next());
+        world.terra_mem.iter_mut().for_each(|b| *b = next());
+        world
+    }
+
+    #[test]
+    fn terrain_grid_matches_reference_lookup() {
+        for (region_num, seed) in [(3u8, 1u32), (9, 2)] {
+            let mut world = noisy_world(region_num, seed);
+            let base = if region_num >= 8 { 0x8000 } else { 0 };
+            // Includes off-grid points: negatives, past the map edge, and
+            // indoor rows beyond the loaded strip.
+            let check = |world: &WorldData| {
+                for y in (-40..0x9000).step_by(29) {
+                    for x in (-40..0x8100).step_by(61) {
+                        assert_eq!(
+                            terrain_at(world, x, base + y),
+                            px_to_terrain_type(world, x, base + y),
+                            "region {region_num} at ({x}, {y})",
+                        );
+                    }
+                }
+            };
+            check(&world);
+            // Door-style tile replacement must be reflected in the grid.
+            for imx in (0..2048).step_by(97) {
+                world.set_tile_at_image(imx, imx % 256, imx as u8);
+            }
+            check(&world);
+        }
+    }
 }
 
 #[cfg(test)]
@@ -185,7 +185,35 @@ pub fn rand4(tick: u32) -> usize {
     (h as usize >> 16) & 3
 }
 
+/// The simulation's random stream, standing in for the original's global
+/// `rand()` seed.  Lives in `Resources` and is saved with the game, so a
+/// journal replays the same rolls.
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct GameRng {
+    pub seed: u32,
+}
+
+impl GameRng {
+    /// Next 16-bit value.
+    pub fn next(&mut self) -> u32 {
+        self.seed = self.seed.wrapping_mul(1103515245).wrapping_add(12345);
+        self.seed >> 16
+    }
+
+    /// Random `0..max` (0 when `max` is 0).
+    pub fn below(&mut self, max: u32) -> u32 {
+        if max == 0 { 0 } else { self.next() % max }
+    }
+
+    /// `rand() & mask`, as the original `bitrand(mask)`.
+    pub fn bits(&mut self, mask: u32) -> u32 {
+        self.next() & mask
+    }
+}
+
 /// Simple pseudo-random number for damage rolls (no external crate dependency).
+/// Seeded from the clock: only for the legacy `GameState` paths and effects;
+/// the ECS simulation draws from `Resources::rng`.
 pub fn melee_rand(max: u32) -> u32 {
     if max == 0 {
         return 0;
@@ -215,11 +243,11 @@ pub fn bitrand_damage(weapon_index: u8) -> i16 {
 /// Compute weapon tip position with jitter (ports fmain.c newx/newy + rand8() - 3).
 /// `wt` is the weapon value (after cap).
 /// Returns (tip_x, tip_y) in world coordinates.
-pub fn weapon_tip(abs_x: i32, abs_y: i32, facing: Direction, wt: i16) -> (i32, i32) {
+pub fn weapon_tip(abs_x: i32, abs_y: i32, facing: Direction, wt: i16, rng: &mut GameRng) -> (i32, i32) {
     let offset = (wt * 2) as i32;
     let (ox, oy) = facing.push_offset(offset);
-    let jitter_x = (melee_rand(8) as i32) - 3;
-    let jitter_y = (melee_rand(8) as i32) - 3;
+    let jitter_x = (rng.below(8) as i32) - 3;
+    let jitter_y = (rng.below(8) as i32) - 3;
     (abs_x + ox + jitter_x, abs_y + oy + jitter_y)
 }
 
@@ -591,16 +619,26 @@ mod tests {
         }
     }
 
+    #[test]
+    fn game_rng_repeats_from_a_seed() {
+        let mut a = GameRng { seed: 99 };
+        let mut b = a;
+        let rolls: Vec<u32> = (0..16).map(|_| a.below(8)).collect();
+        assert_eq!(rolls, (0..16).map(|_| b.below(8)).collect::<Vec<_>>());
+        assert!(rolls.iter().any(|&r| r != rolls[0]));
+        assert!(rolls.iter().all(|&r| r < 8));
+    }
+
     #[test]
     fn test_weapon_tip_offset_north() {
-        let (tx, ty) = weapon_tip(100, 100, Direction::N, 3);
+        let (tx, ty) = weapon_tip(100, 100, Direction::N, 3, &mut GameRng::default());
         assert!(ty < 100, "north tip_y={} should be < 100", ty);
         assert!((tx - 100).abs() <= 4, "north tip_x={} too far from 100", tx);
     }
 
     #[test]
     fn test_weapon_tip_offset_east() {
-        let (tx, ty) = weapon_tip(100, 100, Direction::E, 3);
+        let (tx, ty) = weapon_tip(100, 100, Direction::E, 3, &mut GameRng { seed: 7 });
         assert!(tx > 100, "east tip_x={} should be > 100", tx);
         assert!((ty - 100).abs() <= 4, "east tip_y={} too far from 100", ty);
     }
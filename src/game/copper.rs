@@ -2,7 +2,13 @@
 //!
 //! On the Amiga, the copper coprocessor modifies COLOR registers each scanline
 //! to create gradients (sky) and shimmer effects (water). We simulate this
-//! in software by adjusting palette entries per scanline group.
+//! in software by adjusting palette entries per scanline group: the list is
+//! resolved into one full LUT per scanline that changes a colour
+//! ([`CopperList::lut_bands`]), and the conversion kernel switches between
+//! them ([`crate::game::palette_lut::convert_rows`]).
+
+use crate::game::palette::{amiga_color_to_rgba, Palette};
+use crate::game::palette_lut::{argb8888_lut, LutBand};
 
 /// A simulated copper instruction: at `scanline`, change color register
 /// `color_reg` to `color` (12-bit Amiga color: 0x0RGB).
@@ -14,6 +20,7 @@ pub struct CopperInstruction {
 }
 
 /// A copper list is a sequence of instructions applied top-to-bottom.
+#[derive(Debug, Clone)]
 pub struct CopperList {
     instructions: Vec<CopperInstruction>,
 }
@@ -40,6 +47,28 @@ impl CopperList {
             .filter(move |i| i.scanline <= scanline)
     }
 
+    /// Resolve the list against the display palette `base` into one ARGB8888
+    /// LUT per distinct scanline, ascending.  Each band carries every change
+    /// made at or above its scanline; later instructions win on ties.
+    pub fn lut_bands(&self, base: &Palette) -> Vec<LutBand> {
+        if self.instructions.is_empty() {
+            return Vec::new();
+        }
+        let mut sorted: Vec<&CopperInstruction> = self.instructions.iter().collect();
+        sorted.sort_by_key(|i| i.scanline);
+        let mut lut = argb8888_lut(base);
+        let mut bands: Vec<LutBand> = Vec::new();
+        for ins in sorted {
+            lut[(ins.color_reg & 31) as usize] = amiga_color_to_rgba(ins.color);
+            let row = ins.scanline as usize;
+            match bands.last_mut() {
+                Some(band) if band.row == row => band.lut = lut,
+                _ => bands.push(LutBand { row, lut }),
+            }
+        }
+        bands
+    }
+
     /// Parse a raw copper list from bytes.
     /// Format: pairs of u16 big-endian: (WAIT_or_MOVE, data)
     /// WAIT: high bit of first word is 0, encodes scanline in bits 8-15
@@ -79,3 +108,23 @@ impl Default for CopperList {
         Self::new()
     }
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn lut_bands_accumulate_in_scanline_order() {
+        let mut list = CopperList::new();
+        list.add(20, 1, 0x000F);
+        list.add(5, 0, 0x0F00);
+        list.add(20, 1, 0x00F0);
+        let base = [0xFF00_0000u32; 32];
+        let bands = list.lut_bands(&base);
+        assert_eq!(bands.iter().map(|b| b.row).collect::<Vec<_>>(), [5, 20]);
+        assert_eq!(bands[0].lut[0], 0xFFFF_0000);
+        assert_eq!(bands[0].lut[1], 0xFF00_0000);
+        assert_eq!(bands[1].lut[0], 0xFFFF_0000, "earlier changes carry down");
+        assert_eq!(bands[1].lut[1], 0xFF00_FF00, "the later instruction wins");
+    }
+}
@@ -27,6 +27,11 @@ pub enum MagicEffect {
 
 pub const DEFAULT_TICK_RATE_HZ: u32 = 15;
 
+/// Ticks per presented frame for `/turbo` with no count.
+pub const DEFAULT_TURBO_TICKS: u32 = 32;
+/// Upper bound for `/turbo <k>`.
+pub const MAX_TURBO_TICKS: u32 = 1000;
+
 bitflags! {
     #[derive(Debug, Clone, Copy, PartialEq, Eq, Default)]
     pub struct GodModeFlags: u8 {
@@ -141,4 +146,15 @@ pub enum DebugCommand {
     SetTickRate {
         hz: u32,
     },
+    /// Turbo mode: run this many ticks per presented frame regardless of the
+    /// tick clock. 0 = off.
+    SetTurbo {
+        ticks_per_frame: u32,
+    },
+    /// Turn the stage profiler (tick systems + render passes) on or off.
+    SetProfiling {
+        enabled: bool,
+    },
+    /// Clear all profiler samples and totals.
+    ResetProfiler,
 }
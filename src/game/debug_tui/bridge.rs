@@ -5,20 +5,28 @@
 //! Label helpers used by both panels and command-dump output live here too.
 //!
 //! This module is **always compiled**, even when the `debug-tui` feature is
-//! disabled: `main.rs` constructs `DebugSnapshot` values as part of its
-//! normal game-loop plumbing, and the stub console still consumes them.
+//! disabled: `main.rs` keeps a `DebugSnapshot` up to date as part of its
+//! normal game-loop plumbing, and the stub console still consumes it.
 //! The ratatui-dependent rendering lives in `view.rs` / `commands.rs` which
 //! are feature-gated.
+//!
+//! The console thread never sees whole snapshots: [`SnapshotDiff`] reduces
+//! each one to the [`SnapshotDelta`]s since the last, and [`apply_delta`]
+//! rebuilds the snapshot on the far side.
+
+use std::fmt::Write as _;
+use std::mem;
 
 use crate::game::actor::{Actor, ActorKind, ActorState, Goal, Tactic};
 use crate::game::day_phase::DayPhase;
 use crate::game::direction::Direction;
 use crate::game::ecs::components::{
-    ActorMotion, AiState, CarrierMount, CombatState, EnemyKind, Facing, Health, HeroStats, Loot,
-    Position,
+    ActorMotion, AiState, BrotherKind, CarrierMount, CombatState, EnemyKind, Facing, Health,
+    HeroStats, Inventory, Loot, Position,
 };
 use crate::game::ecs::resources::{NarrEvent, NarrativeQueue, Resources};
 use crate::game::npc::{Npc, NpcState};
+use crate::game::profiler::StageSummary;
 
 // Re-export the command / log types the spec places in bridge.rs. They
 // actually live in sibling modules for history reasons; the re-export is
@@ -26,6 +34,7 @@ use crate::game::npc::{Npc, NpcState};
 #[allow(unused_imports)]
 pub use crate::game::debug_command::{
     BrotherId, DebugCommand, GodModeFlags, MagicEffect, StatId, DEFAULT_TICK_RATE_HZ,
+    DEFAULT_TURBO_TICKS, MAX_TURBO_TICKS,
 };
 #[allow(unused_imports)]
 pub use crate::game::debug_log::{DebugLogEntry, LogCategory};
@@ -33,8 +42,8 @@ pub use crate::game::debug_log::{DebugLogEntry, LogCategory};
 // ── Status snapshot ──────────────────────────────────────────────────────────
 
 /// Lightweight game-state snapshot for the status header.
-/// Built by main.rs each frame when the console is active.
-#[derive(Debug, Clone, Default)]
+/// Kept up to date in place by main.rs each frame when the console is active.
+#[derive(Debug, Clone, Default, PartialEq)]
 pub struct DebugSnapshot {
     pub fps: f64,
     pub tps: f64,
@@ -47,7 +56,7 @@ pub struct DebugSnapshot {
     pub game_ticks: u64,
     pub paused: bool,
     pub is_paused: bool,
-    pub scene_name: Option<String>,
+    pub scene_name: Option<&'static str>,
     pub hero_x: u16,
     pub hero_y: u16,
     pub brother: u8,
@@ -74,7 +83,7 @@ pub struct DebugSnapshot {
     pub vfx_palette_xfade: bool,
 
     // Time-of-day period derived from day_phase.
-    pub time_period: String,
+    pub time_period: &'static str,
 
     // Quest state (for `/quest` command — DEBUG_SPEC §DebugSnapshot Data Model).
     pub princess_captive: bool,
@@ -108,11 +117,11 @@ pub struct DebugSnapshot {
     /// Weapon slot currently equipped on the hero (`actors[0].weapon`).
     pub hero_weapon: u8,
     /// Human-readable name of the hero's weapon (Dirk/Mace/Sword/Bow/Wand/…).
-    pub hero_weapon_name: String,
+    pub hero_weapon_name: &'static str,
     /// Hero ActorState encoded (see actor_state_u8).
     pub hero_state_u8: u8,
     /// Human-readable hero state (WALKING, FIGHT, …).
-    pub hero_state_name: String,
+    pub hero_state_name: &'static str,
     /// Hero facing direction 0..=7 (0=N, clockwise).
     pub hero_facing: u8,
     /// Hero environ value (−3..=2); see SPEC §9.5.
@@ -120,7 +129,7 @@ pub struct DebugSnapshot {
     /// Carrier index currently ridden (0 none / 1 raft / 2 turtle / 3 swan / 4 dragon).
     pub active_carrier: i16,
     /// Active carrier human-readable label.
-    pub active_carrier_name: String,
+    pub active_carrier_name: &'static str,
     /// Light-timer tick count (Green Jewel spell).
     pub jewel_timer: u16,
     /// Crystal Orb secret-timer tick count.
@@ -141,21 +150,25 @@ pub struct DebugSnapshot {
     pub missile_count: u8,
     /// Count of visible ground-item actors (slots 7..=19).
     pub item_count: u8,
+
+    // ── Profiler panel (`/prof`) ───────────────────────────────────────
+    /// Per-stage timings; empty while profiling is off.
+    pub profile: Vec<StageSummary>,
 }
 
 /// Hero-specific extras for the top-row debug panels.
-#[derive(Debug, Clone, Default)]
+#[derive(Debug, Clone, Copy, Default)]
 pub struct HeroExtras {
     /// `15 + brave/4` — current cap for hero HP.
     pub max_vitality: i16,
     /// Weapon slot currently equipped on the hero.
     pub hero_weapon: u8,
     /// Human-readable name of the hero's weapon (Dirk/Mace/Sword/Bow/Wand/…).
-    pub hero_weapon_name: String,
+    pub hero_weapon_name: &'static str,
     /// Hero ActorState encoded (see `actor_state_u8`).
     pub hero_state_u8: u8,
     /// Human-readable hero state (WALKING, FIGHT, …).
-    pub hero_state_name: String,
+    pub hero_state_name: &'static str,
     /// Hero facing direction 0..=7 (0=N, clockwise).
     pub hero_facing: u8,
     /// Hero environ value (−3..=2); see SPEC §9.5.
@@ -163,7 +176,7 @@ pub struct HeroExtras {
     /// Carrier index currently ridden (0 none / 1 raft / 2 turtle / 3 swan / 4 dragon).
     pub active_carrier: i16,
     /// Active carrier human-readable label.
-    pub active_carrier_name: String,
+    pub active_carrier_name: &'static str,
     /// Light-timer tick count (Green Jewel spell).
     pub jewel_timer: u16,
     /// Crystal Orb secret-timer tick count.
@@ -174,7 +187,7 @@ pub struct HeroExtras {
 
 /// Per-actor snapshot for the Actor Watch panel and `/actors` dump.
 /// See DEBUG_SPECIFICATION.md §DebugSnapshot Data Model for field semantics.
-#[derive(Debug, Clone, Default)]
+#[derive(Debug, Clone, Copy, Default, PartialEq)]
 pub struct ActorSnapshot {
     pub slot: u8,
     pub actor_type: u8,
@@ -229,6 +242,146 @@ impl ActorSnapshot {
     }
 }
 
+// ── Change-only updates ──────────────────────────────────────────────────────
+
+/// One change to the console's copy of the snapshot.
+#[derive(Debug, Clone, PartialEq)]
+pub enum SnapshotDelta {
+    /// Forget everything held; a full set of deltas follows.
+    Reset,
+    /// Every scalar field at once.  The boxed snapshot's lists are empty.
+    Header(Box<DebugSnapshot>),
+    Stuff(Vec<u8>),
+    NarrativePreview(Vec<String>),
+    Profile(Vec<StageSummary>),
+    ActorAdded(ActorSnapshot),
+    ActorChanged(ActorSnapshot),
+    ActorRemoved { slot: u8 },
+}
+
+/// The list fields of a snapshot, moved aside so the scalar rest can be
+/// compared and copied as one header.
+#[derive(Debug, Default)]
+struct SnapshotLists {
+    actors: Vec<ActorSnapshot>,
+    stuff: Vec<u8>,
+    narrative_preview: Vec<String>,
+    profile: Vec<StageSummary>,
+}
+
+impl SnapshotLists {
+    fn take(snap: &mut DebugSnapshot) -> Self {
+        Self {
+            actors: mem::take(&mut snap.actors),
+            stuff: mem::take(&mut snap.stuff),
+            narrative_preview: mem::take(&mut snap.narrative_preview),
+            profile: mem::take(&mut snap.profile),
+        }
+    }
+
+    fn restore(self, snap: &mut DebugSnapshot) {
+        snap.actors = self.actors;
+        snap.stuff = self.stuff;
+        snap.narrative_preview = self.narrative_preview;
+        snap.profile = self.profile;
+    }
+}
+
+/// Game-side record of the snapshot as the console last saw it.
+#[derive(Debug, Default)]
+pub struct SnapshotDiff {
+    /// Scalar fields as sent; the lists here are always empty.
+    header: DebugSnapshot,
+    lists: SnapshotLists,
+    /// Open the next diff with [`SnapshotDelta::Reset`].
+    resync: bool,
+}
+
+impl SnapshotDiff {
+    /// Forget what was sent: the next [`diff`](Self::diff) resets the console
+    /// and sends `current` in full.  Used when deltas were dropped.
+    pub fn reset(&mut self) {
+        self.header = DebugSnapshot::default();
+        self.lists.actors.clear();
+        self.lists.stuff.clear();
+        self.lists.narrative_preview.clear();
+        self.lists.profile.clear();
+        self.resync = true;
+    }
+
+    /// Emit the deltas from the last snapshot passed here to `current`.  An
+    /// unchanged snapshot emits and allocates nothing.  `current` is borrowed
+    /// mutably only to move its lists aside while the header is compared; it
+    /// is left as it was.
+    pub fn diff(&mut self, current: &mut DebugSnapshot, mut emit: impl FnMut(SnapshotDelta)) {
+        if mem::take(&mut self.resync) {
+            emit(SnapshotDelta::Reset);
+        }
+
+        let lists = SnapshotLists::take(current);
+        if *current != self.header {
+            self.header.clone_from(current);
+            emit(SnapshotDelta::Header(Box::new(current.clone())));
+        }
+
+        if lists.stuff != self.lists.stuff {
+            self.lists.stuff.clone_from(&lists.stuff);
+            emit(SnapshotDelta::Stuff(lists.stuff.clone()));
+        }
+        if lists.narrative_preview != self.lists.narrative_preview {
+            self.lists.narrative_preview.clone_from(&lists.narrative_preview);
+            emit(SnapshotDelta::NarrativePreview(lists.narrative_preview.clone()));
+        }
+        if lists.profile != self.lists.profile {
+            self.lists.profile.clone_from(&lists.profile);
+            emit(SnapshotDelta::Profile(lists.profile.clone()));
+        }
+
+        if lists.actors != self.lists.actors {
+            // At most 20 slots, so a linear search per slot is cheapest.
+            for actor in &lists.actors {
+                match self.lists.actors.iter().find(|a| a.slot == actor.slot) {
+                    None => emit(SnapshotDelta::ActorAdded(*actor)),
+                    Some(sent) if sent != actor => emit(SnapshotDelta::ActorChanged(*actor)),
+                    Some(_) => {}
+                }
+            }
+            for sent in &self.lists.actors {
+                if !lists.actors.iter().any(|a| a.slot == sent.slot) {
+                    emit(SnapshotDelta::ActorRemoved { slot: sent.slot });
+                }
+            }
+            self.lists.actors.clone_from(&lists.actors);
+        }
+
+        lists.restore(current);
+    }
+}
+
+/// Replay one [`SnapshotDelta`] onto the console's snapshot.  Actors stay
+/// sorted by slot, as the game side builds them.
+pub fn apply_delta(snap: &mut DebugSnapshot, delta: SnapshotDelta) {
+    match delta {
+        SnapshotDelta::Reset => *snap = DebugSnapshot::default(),
+        SnapshotDelta::Header(header) => {
+            let lists = SnapshotLists::take(snap);
+            *snap = *header;
+            lists.restore(snap);
+        }
+        SnapshotDelta::Stuff(stuff) => snap.stuff = stuff,
+        SnapshotDelta::NarrativePreview(lines) => snap.narrative_preview = lines,
+        SnapshotDelta::Profile(stages) => snap.profile = stages,
+        SnapshotDelta::ActorAdded(actor) | SnapshotDelta::ActorChanged(actor) => {
+            match snap.actors.iter().position(|a| a.slot >= actor.slot) {
+                Some(i) if snap.actors[i].slot == actor.slot => snap.actors[i] = actor,
+                Some(i) => snap.actors.insert(i, actor),
+                None => snap.actors.push(actor),
+            }
+        }
+        SnapshotDelta::ActorRemoved { slot } => snap.actors.retain(|a| a.slot != slot),
+    }
+}
+
 // ── ECS → DebugSnapshot conversion helpers ──────────────────────────────────
 
 /// Build a vector of `ActorSnapshot` values from the ECS world.
@@ -241,6 +394,18 @@ pub fn build_ecs_actor_snapshots(
     max_actors: usize,
 ) -> Vec<ActorSnapshot> {
     let mut actors = Vec::with_capacity(max_actors.min(20));
+    fill_ecs_actor_snapshots(world, hero_entity, max_actors, &mut actors);
+    actors
+}
+
+/// [`build_ecs_actor_snapshots`] into an existing vector, reusing its storage.
+pub fn fill_ecs_actor_snapshots(
+    world: &hecs::World,
+    hero_entity: hecs::Entity,
+    max_actors: usize,
+    actors: &mut Vec<ActorSnapshot>,
+) {
+    actors.clear();
 
     // Hero as slot 0.
     let hero_ok = (
@@ -294,8 +459,6 @@ pub fn build_ecs_actor_snapshots(
         });
         slot += 1;
     }
-
-    actors
 }
 
 /// Extract hero-specific extras for the debug top-row panels.
@@ -316,13 +479,13 @@ pub fn build_ecs_hero_extras(
     if let (Some(stats), Some(combat), Some(facing), Some(motion), Some(carrier)) = hero_ok {
         extras.max_vitality = 15 + (stats.brave / 4);
         extras.hero_weapon = combat.weapon;
-        extras.hero_weapon_name = weapon_short_name(combat.weapon).to_string();
+        extras.hero_weapon_name = weapon_short_name(combat.weapon);
         extras.hero_state_u8 = actor_state_u8(&combat.state);
-        extras.hero_state_name = actor_state_name(extras.hero_state_u8).to_string();
+        extras.hero_state_name = actor_state_name(extras.hero_state_u8);
         extras.hero_facing = facing.dir as u8;
         extras.hero_environ = motion.environ;
         extras.active_carrier = carrier.active_carrier;
-        extras.active_carrier_name = carrier_name(carrier.active_carrier).to_string();
+        extras.active_carrier_name = carrier_name(carrier.active_carrier);
     }
 
     extras.jewel_timer = res.clock.light_timer.max(0) as u16;
@@ -334,22 +497,101 @@ pub fn build_ecs_hero_extras(
 
 /// Build a short text preview of the next `count` pending narrative events.
 pub fn build_ecs_narrative_preview(queue: &NarrativeQueue, count: usize) -> Vec<String> {
-    queue
-        .pending
-        .iter()
-        .take(count)
-        .map(|event| match event {
-            NarrEvent::Placard { text, .. } => format!("PLACARD: {}", text),
-            NarrEvent::WaitTicks(t) => format!("WAIT: {} ticks", t),
+    let mut preview = Vec::new();
+    fill_ecs_narrative_preview(queue, count, &mut preview);
+    preview
+}
+
+/// [`build_ecs_narrative_preview`] into existing lines, rewriting each
+/// `String` in place so an unchanged queue reuses every buffer.
+pub fn fill_ecs_narrative_preview(queue: &NarrativeQueue, count: usize, preview: &mut Vec<String>) {
+    let n = queue.pending.len().min(count);
+    preview.truncate(n);
+    preview.resize_with(n, String::new);
+    for (line, event) in preview.iter_mut().zip(&queue.pending) {
+        line.clear();
+        let _ = match event {
+            NarrEvent::Placard { text, .. } => write!(line, "PLACARD: {}", text),
+            NarrEvent::WaitTicks(t) => write!(line, "WAIT: {} ticks", t),
             NarrEvent::TeleportHero { x, y, region } => {
-                format!("TELEPORT: ({},{}) region {}", x, y, region)
+                write!(line, "TELEPORT: ({},{}) region {}", x, y, region)
             }
             NarrEvent::SwapObjectId { object_index, new_id } => {
-                format!("SWAP: object {} -> {}", object_index, new_id)
+                write!(line, "SWAP: object {} -> {}", object_index, new_id)
             }
-            NarrEvent::ApplyRewards => "REWARDS".to_string(),
-        })
-        .collect()
+            NarrEvent::ApplyRewards => line.write_str("REWARDS"),
+        };
+    }
+}
+
+/// Refresh every gameplay field of `snap` from the ECS world.  Buffers are
+/// reused, so a frame where nothing moved allocates nothing.  Frame-rate,
+/// clock, audio and profiler fields are the caller's.
+pub fn update_ecs_snapshot(snap: &mut DebugSnapshot, world: &hecs::World, res: &Resources) {
+    let hero = res.hero_entity;
+
+    // daynight 0..24000 ≡ 24 h; hour = daynight * 24 / 24000
+    let daynight = res.clock.daynight;
+    snap.game_day = res.clock.game_days;
+    snap.game_hour = daynight as u32 * 24 / 24000;
+    snap.game_minute = (daynight as u32 * 24 * 60 / 24000) % 60;
+    snap.daynight = daynight;
+    snap.lightlevel = res.clock.lightlevel;
+    snap.day_phase = match daynight / 2000 {
+        0..=3 => DayPhase::Midnight,
+        4..=5 => DayPhase::Morning,
+        6..=8 => DayPhase::Midday,
+        _ => DayPhase::Evening,
+    };
+
+    (snap.hero_x, snap.hero_y) = world
+        .get::<&Position>(hero)
+        .map(|p| (p.x as u16, p.y as u16))
+        .unwrap_or((0, 0));
+    snap.brother = world.get::<&BrotherKind>(hero).map(|b| b.id).unwrap_or(0);
+    let (vitality, hunger, fatigue, brave, luck, kind, wealth) = world
+        .get::<&HeroStats>(hero)
+        .map(|s| (s.vitality, s.hunger, s.fatigue, s.brave, s.luck, s.kind, s.wealth))
+        .unwrap_or_default();
+    snap.vitality = vitality;
+    snap.hunger = hunger;
+    snap.fatigue = fatigue;
+    snap.brave = brave as u16;
+    snap.luck = luck;
+    snap.kind = kind;
+    snap.wealth = wealth as u16;
+    snap.region_num = res.region.region_num;
+
+    let extras = build_ecs_hero_extras(world, hero, res);
+    snap.max_vitality = extras.max_vitality;
+    snap.hero_weapon = extras.hero_weapon;
+    snap.hero_weapon_name = extras.hero_weapon_name;
+    snap.hero_state_u8 = extras.hero_state_u8;
+    snap.hero_state_name = extras.hero_state_name;
+    snap.hero_facing = extras.hero_facing;
+    snap.hero_environ = extras.hero_environ;
+    snap.active_carrier = extras.active_carrier;
+    snap.active_carrier_name = extras.active_carrier_name;
+    snap.jewel_timer = extras.jewel_timer;
+    snap.orb_timer = extras.orb_timer;
+    snap.freeze_timer = extras.freeze_timer;
+
+    snap.stuff.clear();
+    if let Ok(inv) = world.get::<&Inventory>(hero) {
+        snap.stuff.extend_from_slice(&inv.stuff);
+    }
+    fill_ecs_actor_snapshots(world, hero, 20, &mut snap.actors);
+
+    snap.princess_captive = res.quest.princess_rescues < 3;
+    snap.princess_rescues = res.quest.princess_rescues as u16;
+    snap.statues_collected = res.quest.statues_collected;
+    snap.has_writ = res.quest.writ_obtained;
+    snap.has_talisman = res.quest.talisman_obtained;
+
+    snap.narrative_pending_count = res.narrative.pending.len() as u32;
+    snap.narrative_active = res.narrative.active.is_some();
+    snap.narrative_timer = res.narrative.active_ticks;
+    fill_ecs_narrative_preview(&res.narrative, 3, &mut snap.narrative_preview);
 }
 
 fn actor_kind_u8(k: &ActorKind) -> u8 {
@@ -424,12 +666,12 @@ fn tactic_u8(t: &Tactic) -> u8 {
 
 /// Human-readable label for a `DayPhase` variant — used to populate
 /// `DebugSnapshot::time_period` (spec §DebugSnapshot Data Model).
-pub fn day_phase_label(phase: DayPhase) -> String {
+pub fn day_phase_label(phase: DayPhase) -> &'static str {
     match phase {
-        DayPhase::Midnight => "Night".to_string(),
-        DayPhase::Morning => "Morning".to_string(),
-        DayPhase::Midday => "Midday".to_string(),
-        DayPhase::Evening => "Evening".to_string(),
+        DayPhase::Midnight => "Night",
+        DayPhase::Morning => "Morning",
+        DayPhase::Midday => "Midday",
+        DayPhase::Evening => "Evening",
     }
 }
 
@@ -610,8 +852,9 @@ mod tests {
     use crate::game::npc::{NpcState, RACE_ENEMY, RACE_NORMAL};
 
     use super::{
-        actor_state_u8, build_ecs_actor_snapshots, build_ecs_hero_extras,
-        build_ecs_narrative_preview, carrier_name, weapon_short_name,
+        actor_state_u8, apply_delta, build_ecs_actor_snapshots, build_ecs_hero_extras,
+        build_ecs_narrative_preview, carrier_name, fill_ecs_narrative_preview, weapon_short_name,
+        ActorSnapshot, DebugSnapshot, SnapshotDelta, SnapshotDiff,
     };
 
     fn hero_stats() -> HeroStats {
@@ -774,4 +1017,89 @@ mod tests {
         assert_eq!(preview[1], "WAIT: 5 ticks");
         assert_eq!(preview[2], "TELEPORT: (7,8) region 9");
     }
+
+    #[test]
+    fn test_narrative_preview_reuses_lines() {
+        let mut queue = NarrativeQueue::new();
+        queue.push(NarrEvent::WaitTicks(5));
+        queue.push(NarrEvent::ApplyRewards);
+        let mut preview = vec!["stale".to_string(); 4];
+        fill_ecs_narrative_preview(&queue, 3, &mut preview);
+        assert_eq!(preview, ["WAIT: 5 ticks", "REWARDS"]);
+        let first = preview[0].as_ptr();
+        fill_ecs_narrative_preview(&queue, 3, &mut preview);
+        assert_eq!(preview[0].as_ptr(), first);
+    }
+
+    fn actor(slot: u8, abs_x: u16) -> ActorSnapshot {
+        ActorSnapshot { slot, abs_x, ..Default::default() }
+    }
+
+    fn replay(diff: &mut SnapshotDiff, game: &mut DebugSnapshot, console: &mut DebugSnapshot) -> Vec<SnapshotDelta> {
+        let mut deltas = Vec::new();
+        diff.diff(game, |d| deltas.push(d));
+        for d in deltas.iter().cloned() {
+            apply_delta(console, d);
+        }
+        deltas
+    }
+
+    #[test]
+    fn test_snapshot_diff_sends_only_changes() {
+        let mut diff = SnapshotDiff::default();
+        let mut console = DebugSnapshot::default();
+        let mut game = DebugSnapshot {
+            game_ticks: 7,
+            scene_name: Some("Gameplay"),
+            stuff: vec![1, 2, 3],
+            actors: vec![actor(0, 10), actor(1, 20), actor(2, 30)],
+            ..DebugSnapshot::default()
+        };
+
+        let first = replay(&mut diff, &mut game, &mut console);
+        assert_eq!(console, game);
+        assert_eq!(first.len(), 5); // header, stuff, three actors
+        assert_eq!(game.actors.len(), 3, "diff leaves the snapshot intact");
+
+        assert!(replay(&mut diff, &mut game, &mut console).is_empty());
+
+        game.actors[1].abs_x = 21;
+        game.actors.remove(2);
+        game.actors.push(actor(3, 40));
+        let deltas = replay(&mut diff, &mut game, &mut console);
+        assert_eq!(
+            deltas,
+            [
+                SnapshotDelta::ActorChanged(actor(1, 21)),
+                SnapshotDelta::ActorAdded(actor(3, 40)),
+                SnapshotDelta::ActorRemoved { slot: 2 },
+            ]
+        );
+        assert_eq!(console, game);
+
+        game.game_ticks += 1;
+        let deltas = replay(&mut diff, &mut game, &mut console);
+        assert!(matches!(deltas[..], [SnapshotDelta::Header(_)]));
+        assert_eq!(console, game);
+    }
+
+    #[test]
+    fn test_snapshot_diff_reset_resends_everything() {
+        let mut diff = SnapshotDiff::default();
+        let mut game = DebugSnapshot {
+            vitality: 12,
+            actors: vec![actor(0, 1), actor(1, 2)],
+            ..DebugSnapshot::default()
+        };
+        let mut console = DebugSnapshot::default();
+        replay(&mut diff, &mut game, &mut console);
+
+        // The console missed an update: its copy has an actor the game dropped.
+        game.actors.pop();
+        console.actors.push(actor(5, 9));
+        diff.reset();
+        let deltas = replay(&mut diff, &mut game, &mut console);
+        assert_eq!(deltas[0], SnapshotDelta::Reset);
+        assert_eq!(console, game);
+    }
 }
@@ -5,9 +5,10 @@
 //! Feature-gated behind `debug-tui`; compiled together with `view.rs`.
 
 use super::bridge::*;
-use super::view::DebugConsole;
+use super::view::ConsoleView;
+use crate::game::profiler::StageSummary;
 
-impl DebugConsole {
+impl ConsoleView {
     pub(super) fn execute_command(&mut self, raw: &str) {
         let parts: Vec<&str> = raw.split_whitespace().collect();
         if parts.is_empty() {
@@ -90,6 +91,8 @@ impl DebugConsole {
                 ));
             }
             "/filter" => self.cmd_filter(args),
+            "/prof" => self.cmd_prof(args),
+            "/turbo" => self.cmd_turbo(args),
             _ => {
                 self.log(format!("Unknown command: {}  (type /help for list)", cmd));
             }
@@ -137,6 +140,8 @@ impl DebugConsole {
                 "/clear"| "cls"     => "/clear — clear the log.",
                 "/filter"|"filter"  => "/filter — open interactive category toggle (Up/Down or Tab to move, Space to toggle, Enter/Esc to close).\n  /filter all     enable every category.\n  /filter none    disable every category.\n  /filter reset   defaults (noisy categories off).\n  /filter +CAT -CAT  toggle by name (combat, movement, ai, ...).",
                 "/watch"| "watch"   => "/watch — toggle the actor watch panel between collapsed and expanded (same as Ctrl+W).",
+                "/prof" | "prof"    => "/prof — toggle the profiler panel; stages are timed only while it is shown.\n  /prof dump   print the profile table to the log.\n  /prof reset  clear all samples.",
+                "/turbo"| "turbo"   => "/turbo [k|off] — run k (default 32) ticks per presented frame, drawing only the last; sound effects are muted.\n  /turbo off   back to the normal tick rate.",
                 "/pause"| "pause"   => "/pause — freeze the game loop (actors + physics). Daynight still ticks unless /time hold. Shortcut: Ctrl+P.",
                 "/resume"|"resume"  => "/resume — unfreeze the game loop (alias: /unpause). Shortcut: Ctrl+P.",
                 "/step" | "step"    => "/step [n] — while paused, advance exactly 1 (or n) frame(s).",
@@ -182,6 +187,8 @@ impl DebugConsole {
             "  /clear         clear this log",
             "  /filter [...]  show/adjust log categories",
             "  /watch         toggle actor watch panel (also: Ctrl+W)",
+            "  /prof [dump|reset]  toggle stage profiler panel / log table / clear",
+            "  /turbo [k|off] fast-forward k ticks per frame (default 32)",
             "  /pause         freeze game loop (also: Ctrl+P)",
             "  /resume        unfreeze game loop (also: Ctrl+P)",
             "  /step [n]      advance 1 (or n) frame(s) while paused",
@@ -194,6 +201,54 @@ impl DebugConsole {
         }
     }
 
+    fn cmd_prof(&mut self, args: &[&str]) {
+        match args.first().map(|s| s.to_ascii_lowercase()).as_deref() {
+            Some("dump") => {
+                if self.status.profile.is_empty() {
+                    self.log("No profile samples (profiler off — /prof to enable).");
+                }
+                for line in profile_lines(&self.status.profile) {
+                    self.log(line);
+                }
+            }
+            Some("reset") => {
+                self.push_cmd(DebugCommand::ResetProfiler);
+                self.log("Profiler samples cleared.");
+            }
+            None => {
+                self.prof_visible = !self.prof_visible;
+                self.push_cmd(DebugCommand::SetProfiling {
+                    enabled: self.prof_visible,
+                });
+                self.log(format!(
+                    "Profiler {}.",
+                    if self.prof_visible { "on" } else { "off" }
+                ));
+            }
+            _ => self.log("Usage: /prof [dump|reset]"),
+        }
+    }
+
+    fn cmd_turbo(&mut self, args: &[&str]) {
+        let ticks = match args.first().map(|s| s.to_ascii_lowercase()).as_deref() {
+            None => DEFAULT_TURBO_TICKS,
+            Some("off") => 0,
+            Some(n) => match n.parse::<u32>() {
+                Ok(n) => n.min(MAX_TURBO_TICKS),
+                Err(_) => {
+                    self.log("Usage: /turbo [k|off]");
+                    return;
+                }
+            },
+        };
+        self.push_cmd(DebugCommand::SetTurbo { ticks_per_frame: ticks });
+        if ticks == 0 {
+            self.log("Turbo off.");
+        } else {
+            self.log(format!("Turbo: {} ticks per frame.", ticks));
+        }
+    }
+
     fn cmd_max_stats(&mut self) {
         use StatId::*;
         for (s, v) in &[
@@ -912,6 +967,27 @@ pub(super) fn format_log_entry(entry: &DebugLogEntry) -> String {
     }
 }
 
+/// Profiler table: a header row plus one row per stage, times in microseconds.
+pub(super) fn profile_lines(profile: &[StageSummary]) -> Vec<String> {
+    let us = |d: std::time::Duration| d.as_secs_f64() * 1e6;
+    let mut out = Vec::with_capacity(profile.len() + 1);
+    out.push(format!(
+        "{:<14} {:>9} {:>9} {:>9} {:>9}",
+        "stage (us)", "last", "min", "avg", "p99"
+    ));
+    for s in profile {
+        out.push(format!(
+            "{:<14} {:>9.1} {:>9.1} {:>9.1} {:>9.1}",
+            s.name,
+            us(s.last),
+            us(s.min),
+            us(s.avg),
+            us(s.p99)
+        ));
+    }
+    out
+}
+
 /// DBG-LOG-08: render one line per category for the interactive /filter modal.
 pub(super) fn filter_modal_lines(
     cursor: usize,
@@ -943,7 +1019,7 @@ mod tests {
         }
     }
 
-    /// Mimics `DebugConsole::log_entry` for testing without allocating a
+    /// Mimics `ConsoleView::log_entry` for testing without allocating a
     /// terminal.  Kept in sync with the real implementation above.
     fn push(entries: &mut Vec<DebugLogEntry>, entry: DebugLogEntry) {
         for line in entry.text.split('\n') {
@@ -993,6 +1069,27 @@ mod tests {
         assert_eq!(entries[2].text, "line c");
     }
 
+    #[test]
+    fn profile_lines_formats_one_row_per_stage() {
+        use std::time::Duration;
+        let stage = StageSummary {
+            name: "movement",
+            calls: 3,
+            total: Duration::from_micros(30),
+            min: Duration::from_micros(8),
+            avg: Duration::from_micros(10),
+            p99: Duration::from_nanos(12_500),
+            last: Duration::from_micros(9),
+        };
+        let lines = profile_lines(&[stage]);
+        assert_eq!(lines.len(), 2);
+        assert!(lines[0].starts_with("stage (us)"));
+        assert_eq!(
+            lines[1],
+            "movement             9.0       8.0      10.0      12.5"
+        );
+    }
+
     #[test]
     fn format_log_entry_general_no_tick() {
         let e = make_entry(LogCategory::General, 0, "hello");
@@ -0,0 +1,307 @@
+//! Game-side handle for the debug console. Feature-gated behind `debug-tui`.
+//!
+//! The console itself (`ConsoleView`) runs on a dedicated "debug-tui" thread
+//! with its own input loop, redrawing at most `redraw_hz` times a second
+//! and only when something changed, so the terminal never costs the game a
+//! frame.  `DebugConsole` is what the main loop holds: each status snapshot
+//! is diffed against the last one sent and only the changes travel, along
+//! with log lines, over a bounded channel.  Requests typed into the console
+//! come back on a second channel and wait here until the main loop takes
+//! them.
+
+use std::collections::VecDeque;
+use std::io;
+use std::sync::mpsc::{self, Receiver, Sender, SyncSender, TryRecvError, TrySendError};
+use std::thread::JoinHandle;
+use std::time::{Duration, Instant};
+
+use super::bridge::{DebugCommand, DebugLogEntry, DebugSnapshot, LogCategory, SnapshotDelta, SnapshotDiff};
+use super::view::{ConsoleView, MAX_LOG_LINES};
+
+/// Updates in flight to the console thread.  When the queue fills, log
+/// lines wait in the handle and the snapshot is resent from scratch once
+/// there is room again.
+const UPDATE_QUEUE_LEN: usize = 256;
+
+/// Game → console.
+pub(super) enum ConsoleUpdate {
+    Snapshot(SnapshotDelta),
+    Log(DebugLogEntry),
+}
+
+/// Console → game: everything `ConsoleView` queues for the main loop.
+enum ConsoleRequest {
+    Command(DebugCommand),
+    PlaySong(usize),
+    StopSong,
+    CaveMode(bool),
+    Pause(bool),
+    Step(u32),
+    Quit,
+}
+
+pub struct DebugConsole {
+    /// `None` only while dropping, which is what stops the console thread.
+    updates: Option<SyncSender<ConsoleUpdate>>,
+    requests: Receiver<ConsoleRequest>,
+    worker: Option<JoinHandle<()>>,
+
+    sent: SnapshotDiff,
+    /// Deltas were dropped on a full queue; resend everything next time.
+    resync: bool,
+    /// Log lines that did not fit in the queue yet.
+    held_logs: VecDeque<DebugLogEntry>,
+
+    // Requests received from the console, waiting for the main loop.
+    pending_commands: Vec<DebugCommand>,
+    song_group_requested: Option<usize>,
+    stop_requested: bool,
+    cave_mode_requested: Option<bool>,
+    quit_requested: bool,
+    pause_request: Option<bool>,
+    step_request: u32,
+}
+
+impl DebugConsole {
+    /// Take over the terminal and start the console thread.  The terminal is
+    /// set up here so failures are reported to the caller.
+    pub fn new(redraw_hz: u32) -> Result<Self, io::Error> {
+        let view = ConsoleView::new()?;
+        let interval = Duration::from_secs(1) / redraw_hz.max(1);
+        let (updates, update_rx) = mpsc::sync_channel(UPDATE_QUEUE_LEN);
+        let (request_tx, requests) = mpsc::channel();
+        let worker = std::thread::Builder::new()
+            .name("debug-tui".into())
+            .spawn(move || run(view, update_rx, request_tx, interval))?;
+        Ok(Self {
+            updates: Some(updates),
+            requests,
+            worker: Some(worker),
+            sent: SnapshotDiff::default(),
+            resync: false,
+            held_logs: VecDeque::new(),
+            pending_commands: Vec::new(),
+            song_group_requested: None,
+            stop_requested: false,
+            cave_mode_requested: None,
+            quit_requested: false,
+            pause_request: None,
+            step_request: 0,
+        })
+    }
+
+    /// Send the console whatever changed in `status` since the last call.
+    /// `status` is only borrowed mutably for the comparison and comes back
+    /// as it was; reuse it between frames so unchanged state costs nothing.
+    pub fn update_status(&mut self, status: &mut DebugSnapshot) {
+        // Logs sent earlier must land first; try again next frame.
+        if !self.flush_logs() {
+            return;
+        }
+        let Some(updates) = &self.updates else { return };
+        if std::mem::take(&mut self.resync) {
+            self.sent.reset();
+        }
+        let mut full = false;
+        self.sent.diff(status, |delta| {
+            if !full && updates.try_send(ConsoleUpdate::Snapshot(delta)).is_err() {
+                full = true;
+            }
+        });
+        self.resync = full;
+    }
+
+    /// Queue a categorized entry for the scrolling log.
+    pub fn log_entry(&mut self, entry: DebugLogEntry) {
+        self.held_logs.push_back(entry);
+        // The console keeps no more than this either.
+        if self.held_logs.len() > MAX_LOG_LINES {
+            self.held_logs.pop_front();
+        }
+        self.flush_logs();
+    }
+
+    /// Alias for [`log_entry`]; the intent is that the main loop drains
+    /// gameplay-emitted entries into the console via this method.
+    pub fn ingest(&mut self, entry: DebugLogEntry) {
+        self.log_entry(entry);
+    }
+
+    /// Push a plain-text message to the scrolling log. Compatibility wrapper
+    /// for call sites that produce user-facing command feedback; messages are
+    /// tagged as [`LogCategory::General`] with `timestamp_ticks = 0`.
+    pub fn log(&mut self, msg: impl Into<String>) {
+        self.log_entry(DebugLogEntry {
+            category: LogCategory::General,
+            timestamp_ticks: 0,
+            text: msg.into(),
+        });
+    }
+
+    /// Drain pending debug commands for the main loop to apply.
+    pub fn drain_commands(&mut self) -> Vec<DebugCommand> {
+        self.receive_requests();
+        self.pending_commands.drain(..).collect()
+    }
+
+    /// Returns and clears any queued pause/resume request.
+    pub fn take_pause_request(&mut self) -> Option<bool> {
+        self.pause_request.take()
+    }
+
+    /// Returns and clears the queued step budget (ticks to advance while paused).
+    pub fn take_step_request(&mut self) -> u32 {
+        std::mem::take(&mut self.step_request)
+    }
+
+    /// Returns and clears any song group play request.
+    pub fn take_song_request(&mut self) -> Option<usize> {
+        self.song_group_requested.take()
+    }
+
+    /// Returns and clears any stop-music request.
+    pub fn take_stop_request(&mut self) -> bool {
+        std::mem::take(&mut self.stop_requested)
+    }
+
+    /// Returns and clears any cave-mode toggle request.
+    pub fn take_cave_mode_request(&mut self) -> Option<bool> {
+        self.cave_mode_requested.take()
+    }
+
+    /// Returns true if the user requested quit via Ctrl+C / Ctrl+Q in the console.
+    pub fn take_quit_request(&mut self) -> bool {
+        std::mem::take(&mut self.quit_requested)
+    }
+
+    /// Collect requests the console thread has sent since the last call.
+    /// Returns true if there were any.  Call once per main-loop iteration.
+    pub fn poll_input(&mut self) -> bool {
+        self.receive_requests()
+    }
+
+    /// Hand over log lines still waiting for room in the queue.  The console
+    /// thread redraws on its own schedule.
+    pub fn render(&mut self) {
+        self.flush_logs();
+    }
+
+    fn receive_requests(&mut self) -> bool {
+        let mut any = false;
+        while let Ok(request) = self.requests.try_recv() {
+            any = true;
+            match request {
+                ConsoleRequest::Command(cmd) => self.pending_commands.push(cmd),
+                ConsoleRequest::PlaySong(group) => self.song_group_requested = Some(group),
+                ConsoleRequest::StopSong => self.stop_requested = true,
+                ConsoleRequest::CaveMode(on) => self.cave_mode_requested = Some(on),
+                ConsoleRequest::Pause(pause) => self.pause_request = Some(pause),
+                ConsoleRequest::Step(n) => self.step_request = self.step_request.saturating_add(n),
+                ConsoleRequest::Quit => self.quit_requested = true,
+            }
+        }
+        any
+    }
+
+    /// Send held log lines; false if some are still waiting.
+    fn flush_logs(&mut self) -> bool {
+        let Some(updates) = &self.updates else { return false };
+        while let Some(entry) = self.held_logs.pop_front() {
+            match updates.try_send(ConsoleUpdate::Log(entry)) {
+                Ok(()) => {}
+                Err(TrySendError::Full(update)) => {
+                    if let ConsoleUpdate::Log(entry) = update {
+                        self.held_logs.push_front(entry);
+                    }
+                    return false;
+                }
+                Err(TrySendError::Disconnected(_)) => {
+                    self.held_logs.clear();
+                    return false;
+                }
+            }
+        }
+        true
+    }
+}
+
+impl Drop for DebugConsole {
+    fn drop(&mut self) {
+        // Closing the queue ends the console thread, and dropping its view
+        // restores the terminal; wait for that before the process moves on.
+        self.updates = None;
+        if let Some(worker) = self.worker.take() {
+            let _ = worker.join();
+        }
+    }
+}
+
+/// Console thread: apply updates, handle keys, redraw at most once per
+/// `interval` and only when something changed.
+fn run(
+    mut view: ConsoleView,
+    updates: Receiver<ConsoleUpdate>,
+    requests: Sender<ConsoleRequest>,
+    interval: Duration,
+) {
+    let mut dirty = true;
+    let mut next_frame = Instant::now();
+    loop {
+        loop {
+            match updates.try_recv() {
+                Ok(update) => {
+                    view.apply(update);
+                    dirty = true;
+                }
+                Err(TryRecvError::Empty) => break,
+                Err(TryRecvError::Disconnected) => return,
+            }
+        }
+
+        let now = Instant::now();
+        if dirty && now >= next_frame {
+            view.render();
+            dirty = false;
+            next_frame = now + interval;
+        }
+
+        // Block on input until the next frame is due; updates that arrive
+        // meanwhile are picked up at the same cadence.
+        let wait = if dirty { next_frame.saturating_duration_since(now) } else { interval };
+        if view.poll_input(wait) {
+            dirty = true;
+            if forward_requests(&mut view, &requests).is_err() {
+                return;
+            }
+        }
+    }
+}
+
+fn forward_requests(
+    view: &mut ConsoleView,
+    requests: &Sender<ConsoleRequest>,
+) -> Result<(), mpsc::SendError<ConsoleRequest>> {
+    for cmd in view.drain_commands() {
+        requests.send(ConsoleRequest::Command(cmd))?;
+    }
+    if let Some(group) = view.take_song_request() {
+        requests.send(ConsoleRequest::PlaySong(group))?;
+    }
+    if view.take_stop_request() {
+        requests.send(ConsoleRequest::StopSong)?;
+    }
+    if let Some(on) = view.take_cave_mode_request() {
+        requests.send(ConsoleRequest::CaveMode(on))?;
+    }
+    if let Some(pause) = view.take_pause_request() {
+        requests.send(ConsoleRequest::Pause(pause))?;
+    }
+    let steps = view.take_step_request();
+    if steps > 0 {
+        requests.send(ConsoleRequest::Step(steps))?;
+    }
+    if view.take_quit_request() {
+        requests.send(ConsoleRequest::Quit)?;
+    }
+    Ok(())
+}
@@ -1,6 +1,6 @@
-//! Debug TUI module — split into `bridge` (always compiled), `view` +
-//! `commands` (feature-gated rendering/dispatch), and `stub` (no-op when
-//! the `debug-tui` feature is disabled).
+//! Debug TUI module — split into `bridge` (always compiled), `console` +
+//! `view` + `commands` (feature-gated thread handle, rendering and
+//! dispatch), and `stub` (no-op when the `debug-tui` feature is disabled).
 //!
 //! See `DEBUG_SPECIFICATION.md` §Architecture.
 
@@ -10,9 +10,11 @@ pub use bridge::*;
 #[cfg(feature = "debug-tui")]
 mod commands;
 #[cfg(feature = "debug-tui")]
+mod console;
+#[cfg(feature = "debug-tui")]
 mod view;
 #[cfg(feature = "debug-tui")]
-pub use view::DebugConsole;
+pub use console::DebugConsole;
 
 #[cfg(not(feature = "debug-tui"))]
 mod stub;
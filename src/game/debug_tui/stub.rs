@@ -14,7 +14,7 @@ pub struct DebugConsole {
 }
 
 impl DebugConsole {
-    pub fn new() -> Result<Self, io::Error> {
+    pub fn new(_redraw_hz: u32) -> Result<Self, io::Error> {
         eprintln!(
             "warning: --debug requested but binary built without `debug-tui` feature; \
              no debug console will open. Rebuild with default features (or \
@@ -26,7 +26,7 @@ impl DebugConsole {
         ))
     }
 
-    pub fn update_status(&mut self, _status: DebugSnapshot) {}
+    pub fn update_status(&mut self, _status: &mut DebugSnapshot) {}
     pub fn log_entry(&mut self, _entry: DebugLogEntry) {}
     pub fn ingest(&mut self, _entry: DebugLogEntry) {}
     pub fn log(&mut self, _msg: impl Into<String>) {}
@@ -1,11 +1,15 @@
-//! Debug TUI view layer: the `DebugConsole` struct, input polling, and
+//! Debug TUI view layer: the `ConsoleView` struct, input polling, and
 //! ratatui rendering. Feature-gated behind `debug-tui`.
 //!
-//! The impl for `DebugConsole` is split across this file and `commands.rs`
+//! `ConsoleView` lives on the console thread (see `console.rs`); the game
+//! loop only ever talks to it through the `DebugConsole` handle.
+//!
+//! The impl for `ConsoleView` is split across this file and `commands.rs`
 //! (command dispatch + individual `/cmd` handlers). Both files live in the
 //! same `debug_tui` module, so private fields are visible to each other.
 
 use std::io::{self, Stdout};
+use std::time::Duration;
 
 use crossterm::{
     event::{self, Event, KeyCode, KeyEventKind, KeyModifiers},
@@ -22,11 +26,12 @@ use ratatui::{
 };
 
 use super::bridge::*;
-use super::commands::{filter_log_entries, filter_modal_lines, format_log_entry};
+use super::console::ConsoleUpdate;
+use super::commands::{filter_log_entries, filter_modal_lines, format_log_entry, profile_lines};
 
 pub(super) const MAX_LOG_LINES: usize = 1000;
 
-pub struct DebugConsole {
+pub(super) struct ConsoleView {
     pub(super) terminal: Terminal<CrosstermBackend<Stdout>>,
 
     // Log output
@@ -55,6 +60,9 @@ pub struct DebugConsole {
     /// Actor Watch panel display mode (DBG-LAYOUT-07). false = collapsed (default).
     pub(super) watch_expanded: bool,
 
+    /// Profiler panel shown (`/prof`). Stage timing is enabled while true.
+    pub(super) prof_visible: bool,
+
     /// Active log categories used to filter the log panel render (DBG-LOG-05).
     /// Seeded from `LogCategory::default_enabled()` per DEBUG_SPEC §Log Categories.
     pub(super) active_categories: std::collections::HashSet<LogCategory>,
@@ -68,7 +76,7 @@ pub struct DebugConsole {
     pub(super) status: DebugSnapshot,
 }
 
-impl DebugConsole {
+impl ConsoleView {
     pub fn new() -> Result<Self, io::Error> {
         enable_raw_mode()?;
         let mut stdout = io::stdout();
@@ -101,6 +109,7 @@ impl DebugConsole {
             pause_request: None,
             step_request: 0,
             watch_expanded: false,
+            prof_visible: false,
             active_categories: LogCategory::ALL
                 .iter()
                 .copied()
@@ -111,9 +120,12 @@ impl DebugConsole {
         })
     }
 
-    /// Update the status snapshot shown in the header.
-    pub fn update_status(&mut self, status: DebugSnapshot) {
-        self.status = status;
+    /// Apply one update from the game side.
+    pub fn apply(&mut self, update: ConsoleUpdate) {
+        match update {
+            ConsoleUpdate::Snapshot(delta) => apply_delta(&mut self.status, delta),
+            ConsoleUpdate::Log(entry) => self.log_entry(entry),
+        }
     }
 
     /// Push a categorized entry to the scrolling log. Primary API for gameplay-emitted logs.
@@ -137,12 +149,6 @@ impl DebugConsole {
         }
     }
 
-    /// Alias for [`log_entry`]; the intent is that the main loop drains
-    /// gameplay-emitted entries into the console via this method.
-    pub fn ingest(&mut self, entry: DebugLogEntry) {
-        self.log_entry(entry);
-    }
-
     /// Push a plain-text message to the scrolling log. Compatibility wrapper
     /// for call sites that produce user-facing command feedback; messages are
     /// tagged as [`LogCategory::General`] with `timestamp_ticks = 0`.
@@ -197,10 +203,10 @@ impl DebugConsole {
 
     // ── Input polling ─────────────────────────────────────────────────────────
 
-    /// Non-blocking input poll. Returns true if an event was processed.
-    /// Call once per main-loop iteration.
-    pub fn poll_input(&mut self) -> bool {
-        if !event::poll(std::time::Duration::ZERO).unwrap_or(false) {
+    /// Wait up to `timeout` for one input event. Returns true if an event was
+    /// processed.
+    pub fn poll_input(&mut self, timeout: Duration) -> bool {
+        if !event::poll(timeout).unwrap_or(false) {
             return false;
         }
         let Ok(ev) = event::read() else { return false };
@@ -384,13 +390,25 @@ impl DebugConsole {
         let _ = self.terminal.draw(|f| {
             let area = f.area();
 
-            // Layout: status header (6) | actor-watch (1 collapsed / 6 expanded) | log (fills) | prompt (3)
+            // Layout: status header (6) | actor-watch (1 collapsed / 6 expanded)
+            //         | profiler (hidden unless /prof) | log (fills) | prompt (3)
             let watch_height: u16 = if self.watch_expanded { 6 } else { 1 };
+            let prof_lines = if self.prof_visible {
+                profile_lines(&status.profile)
+            } else {
+                Vec::new()
+            };
+            let prof_height: u16 = if self.prof_visible {
+                (prof_lines.len() as u16 + 2).min(area.height / 3).max(3)
+            } else {
+                0
+            };
             let chunks = Layout::default()
                 .direction(Direction::Vertical)
                 .constraints([
                     Constraint::Length(6),
                     Constraint::Length(watch_height),
+                    Constraint::Length(prof_height),
                     Constraint::Min(3),
                     Constraint::Length(3),
                 ])
@@ -443,7 +461,7 @@ impl DebugConsole {
                     styled_label("Fat:"),
                     Span::raw(format!("{}  ", status.fatigue)),
                     styled_label("Wpn:"),
-                    Span::raw(status.hero_weapon_name.clone()),
+                    Span::raw(status.hero_weapon_name),
                 ]),
                 Line::from(vec![
                     styled_label("State: "),
@@ -489,7 +507,7 @@ impl DebugConsole {
                 Line::from(vec![styled_label("Env: "), Span::raw(env_str)]),
                 Line::from(vec![
                     styled_label("Carrier: "),
-                    Span::raw(status.active_carrier_name.clone()),
+                    Span::raw(status.active_carrier_name),
                 ]),
             ];
             let geo_widget = Paragraph::new(geo_text)
@@ -567,7 +585,7 @@ impl DebugConsole {
                 Line::from(vec![
                     styled_label("Time: "),
                     Span::raw(format!("{}  ", status.daynight)),
-                    Span::styled(status.time_period.clone(), Style::default().fg(Color::Cyan)),
+                    Span::styled(status.time_period, Style::default().fg(Color::Cyan)),
                 ]),
                 Line::from(vec![
                     styled_label("Light: "),
@@ -657,8 +675,23 @@ impl DebugConsole {
                 f.render_widget(watch_widget, chunks[1]);
             }
 
+            // ── Profiler ──────────────────────────────────────────────────
+            if self.prof_visible {
+                let text: Vec<Line> = if status.profile.is_empty() {
+                    vec![Line::raw("waiting for samples…")]
+                } else {
+                    prof_lines.into_iter().map(Line::raw).collect()
+                };
+                let prof_widget = Paragraph::new(text).block(
+                    Block::default()
+                        .borders(Borders::ALL)
+                        .title(" Profiler  [/prof dump | /prof reset] "),
+                );
+                f.render_widget(prof_widget, chunks[2]);
+            }
+
             // ── Log ───────────────────────────────────────────────────────
-            let log_height = chunks[2].height.saturating_sub(2) as usize; // subtract borders
+            let log_height = chunks[3].height.saturating_sub(2) as usize; // subtract borders
             let total = filtered_entries.len();
             let top_offset = if total <= log_height {
                 0
@@ -679,13 +712,13 @@ impl DebugConsole {
                 )
                 .wrap(Wrap { trim: false })
                 .scroll((top_offset as u16, 0));
-            f.render_widget(log_widget, chunks[2]);
+            f.render_widget(log_widget, chunks[3]);
 
             // ── Prompt ────────────────────────────────────────────────────
             let prompt_widget = Paragraph::new(input.as_str())
                 .block(Block::default().borders(Borders::ALL).title(" Command "))
                 .wrap(Wrap { trim: false });
-            f.render_widget(prompt_widget, chunks[3]);
+            f.render_widget(prompt_widget, chunks[4]);
 
             // ── DBG-LOG-08: interactive /filter modal overlay ──────────────
             if let Some(cursor) = self.filter_interactive {
@@ -714,7 +747,7 @@ impl DebugConsole {
     }
 }
 
-impl Drop for DebugConsole {
+impl Drop for ConsoleView {
     fn drop(&mut self) {
         // Restore terminal unconditionally; ignore errors during teardown.
         let _ = disable_raw_mode();
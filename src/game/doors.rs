@@ -371,6 +371,29 @@ pub fn doorfind_exit(table: &[DoorEntry], hero_x: u16, hero_y: u16) -> Option<Do
     None
 }
 
+/// Regions reachable through doors within `radius` px of the hero, for asset prefetch.
+/// Matches the same side of each door that doorfind/doorfind_exit would:
+/// outdoor (region < 8) by src coords → dst_region, indoor by dst coords → src_region.
+pub fn regions_near_doors(
+    table: &[DoorEntry],
+    region_num: u8,
+    hero_x: u16,
+    hero_y: u16,
+    radius: u16,
+) -> impl Iterator<Item = u8> + '_ {
+    table.iter().filter_map(move |d| {
+        let (x, y, dest) = if region_num < 8 {
+            if d.src_region != region_num {
+                return None;
+            }
+            (d.src_x, d.src_y, d.dst_region)
+        } else {
+            (d.dst_x, d.dst_y, d.src_region)
+        };
+        (hero_x.abs_diff(x) <= radius && hero_y.abs_diff(y) <= radius).then_some(dest)
+    })
+}
+
 /// Compute the indoor spawn position when entering a door from outside.
 /// Mirrors fmain.c outdoor entry case: position placed just inside the door opening.
 pub fn entry_spawn(door: &DoorEntry) -> (u16, u16) {
@@ -403,6 +426,22 @@ pub fn exit_spawn(door: &DoorEntry) -> (u16, u16) {
 mod tests {
     use super::*;
 
+    #[test]
+    fn regions_near_doors_uses_entry_side() {
+        let table = [
+            DoorEntry { src_region: 0, src_x: 0x1000, src_y: 0x2000, dst_region: 8,
+                        dst_x: 0x9000, dst_y: 0x8000, door_type: CAVE },
+            DoorEntry { src_region: 1, src_x: 0x1000, src_y: 0x2000, dst_region: 9,
+                        dst_x: 0x9100, dst_y: 0x8000, door_type: CAVE },
+        ];
+        let near: Vec<u8> = regions_near_doors(&table, 0, 0x1040, 0x1FC0, 0x60).collect();
+        assert_eq!(near, vec![8]);
+        assert_eq!(regions_near_doors(&table, 0, 0x1100, 0x2000, 0x60).count(), 0);
+        // Indoors: match by dst coords and lead back to the outdoor src_region.
+        let near: Vec<u8> = regions_near_doors(&table, 8, 0x9000, 0x8020, 0x60).collect();
+        assert_eq!(near, vec![0]);
+    }
+
     #[test]
     fn test_doorfind_no_match() {
         let table = [DoorEntry {
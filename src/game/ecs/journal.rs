@@ -0,0 +1,461 @@
+//! Input journal: record a play session and replay it bit-exactly.
+//!
+//! Gameplay only reads input through the per-tick direction/fire state and
+//! the menu/view events `EcsScene::apply_input` handles, and every random
+//! roll comes from the tick counter or from `Resources::rng`, both of which
+//! are part of the saved state.  So a session is reproduced by the state it
+//! started from plus those inputs, tick by tick.
+//!
+//! File layout (integers are LEB128 varints unless noted):
+//!
+//! ```text
+//! "FMRSJRNL" version hash_interval save_len save[save_len]
+//! record*
+//! ```
+//!
+//! `save` is the starting state in save-file encoding
+//! (`persist::ecs_save_to_bytes`).  Each record starts with a tag byte:
+//!
+//! | tag                      | payload      | meaning                                 |
+//! |--------------------------|--------------|-----------------------------------------|
+//! | `10fd dddd`              | varint ticks | hold direction `d`, fire `f` for `ticks` |
+//! | `01kk kkkk`              | kind's arg   | [`JournalEvent`] before the next tick   |
+//! | `0010 0000`              | u64 LE       | [`state_hash`] after the ticks so far   |
+//!
+//! Input is run-length encoded, so a held direction costs two or three bytes
+//! however long it is held.  A hash every `hash_interval` ticks (0 = none)
+//! pinpoints where a replay first diverges.  A journal cut short by a crash
+//! reads back up to its last complete record.
+
+use std::fs::File;
+use std::io::{self, BufWriter, Write};
+use std::path::Path;
+
+use anyhow::{bail, Context};
+
+use crate::game::bundle::Fingerprint;
+use crate::game::direction::Direction;
+use crate::game::ecs::components::{Facing, Health, Position};
+use crate::game::ecs::scene::EcsScene;
+use crate::game::game_library::GameLibrary;
+use crate::game::persist;
+use crate::game::scene::SceneResult;
+
+pub const MAGIC: &[u8; 8] = b"FMRSJRNL";
+pub const JOURNAL_VERSION: u32 = 1;
+/// Ticks between state hashes unless asked otherwise (ten seconds of play).
+pub const DEFAULT_HASH_INTERVAL: u32 = 300;
+
+const TAG_INPUT: u8 = 0x80;
+const TAG_EVENT: u8 = 0x40;
+const TAG_HASH: u8 = 0x20;
+const FIRE_BIT: u8 = 0x20;
+const DIR_MASK: u8 = 0x1f;
+
+/// A scene input that is not part of the per-tick direction/fire state.
+/// Menu slots are display slots (0..12).
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum JournalEvent {
+    /// Menu keyboard shortcut byte (letters, space, F1-F7 as 10-16).
+    MenuKey(u8),
+    MenuPress(u8),
+    MenuRelease(u8),
+    /// Pointer moved onto a slot while a menu button is held.
+    MenuHover(u8),
+    /// Pointer left the menu with a button held.
+    MenuCancel,
+    /// Any key or click closing the inventory view.
+    DismissView,
+}
+
+impl JournalEvent {
+    fn kind(self) -> (u8, Option<u8>) {
+        match self {
+            JournalEvent::MenuKey(b) => (0, Some(b)),
+            JournalEvent::MenuPress(s) => (1, Some(s)),
+            JournalEvent::MenuRelease(s) => (2, Some(s)),
+            JournalEvent::MenuHover(s) => (3, Some(s)),
+            JournalEvent::MenuCancel => (4, None),
+            JournalEvent::DismissView => (5, None),
+        }
+    }
+
+    fn from_kind(kind: u8, arg: &mut impl FnMut() -> anyhow::Result<u8>) -> anyhow::Result<Self> {
+        Ok(match kind {
+            0 => JournalEvent::MenuKey(arg()?),
+            1 => JournalEvent::MenuPress(arg()?),
+            2 => JournalEvent::MenuRelease(arg()?),
+            3 => JournalEvent::MenuHover(arg()?),
+            4 => JournalEvent::MenuCancel,
+            5 => JournalEvent::DismissView,
+            _ => bail!("unknown journal event kind {kind}"),
+        })
+    }
+}
+
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum JournalRecord {
+    Input { dir: Direction, fire: bool, ticks: u32 },
+    Event(JournalEvent),
+    Hash(u64),
+}
+
+fn put_varint(out: &mut impl Write, mut v: u64) -> io::Result<()> {
+    let mut buf = [0u8; 10];
+    let mut n = 0;
+    loop {
+        let byte = (v & 0x7f) as u8;
+        v >>= 7;
+        if v == 0 {
+            buf[n] = byte;
+            n += 1;
+            break;
+        }
+        buf[n] = byte | 0x80;
+        n += 1;
+    }
+    out.write_all(&buf[..n])
+}
+
+fn input_byte(dir: Direction, fire: bool) -> u8 {
+    TAG_INPUT | if fire { FIRE_BIT } else { 0 } | (dir as u8 & DIR_MASK)
+}
+
+/// Streams a journal as the session runs.  Dropping it writes out the
+/// input run still open.
+pub struct JournalWriter<W: Write = BufWriter<File>> {
+    out: W,
+    hash_interval: u32,
+    /// Input byte and length of the run being extended.
+    run: Option<(u8, u32)>,
+    ticks: u64,
+}
+
+impl JournalWriter {
+    pub fn create(path: &Path, save: &[u8], hash_interval: u32) -> anyhow::Result<Self> {
+        let file = File::create(path)
+            .with_context(|| format!("creating input journal {}", path.display()))?;
+        Ok(JournalWriter::new(BufWriter::new(file), save, hash_interval)?)
+    }
+}
+
+impl<W: Write> JournalWriter<W> {
+    pub fn new(mut out: W, save: &[u8], hash_interval: u32) -> io::Result<Self> {
+        out.write_all(MAGIC)?;
+        put_varint(&mut out, JOURNAL_VERSION as u64)?;
+        put_varint(&mut out, hash_interval as u64)?;
+        put_varint(&mut out, save.len() as u64)?;
+        out.write_all(save)?;
+        Ok(JournalWriter { out, hash_interval, run: None, ticks: 0 })
+    }
+
+    /// Ticks recorded so far.
+    pub fn ticks(&self) -> u64 {
+        self.ticks
+    }
+
+    /// Record one tick's direction and fire state.
+    pub fn tick(&mut self, dir: Direction, fire: bool) -> io::Result<()> {
+        let byte = input_byte(dir, fire);
+        match &mut self.run {
+            Some((b, n)) if *b == byte && *n < u32::MAX => *n += 1,
+            _ => {
+                self.end_run()?;
+                self.run = Some((byte, 1));
+            }
+        }
+        self.ticks += 1;
+        Ok(())
+    }
+
+    /// Record an input applied before the next tick.
+    pub fn event(&mut self, event: JournalEvent) -> io::Result<()> {
+        self.end_run()?;
+        let (kind, arg) = event.kind();
+        self.out.write_all(&[TAG_EVENT | kind])?;
+        if let Some(arg) = arg {
+            self.out.write_all(&[arg])?;
+        }
+        Ok(())
+    }
+
+    /// True when a state hash is due after the tick just recorded.
+    pub fn wants_hash(&self) -> bool {
+        self.hash_interval > 0 && self.ticks % self.hash_interval as u64 == 0
+    }
+
+    pub fn hash(&mut self, hash: u64) -> io::Result<()> {
+        self.end_run()?;
+        self.out.write_all(&[TAG_HASH])?;
+        self.out.write_all(&hash.to_le_bytes())
+    }
+
+    /// Write out everything recorded so far.
+    pub fn flush(&mut self) -> io::Result<()> {
+        self.end_run()?;
+        self.out.flush()
+    }
+
+    fn end_run(&mut self) -> io::Result<()> {
+        if let Some((byte, ticks)) = self.run.take() {
+            self.out.write_all(&[byte])?;
+            put_varint(&mut self.out, ticks as u64)?;
+        }
+        Ok(())
+    }
+}
+
+impl<W: Write> Drop for JournalWriter<W> {
+    fn drop(&mut self) {
+        let _ = self.flush();
+    }
+}
+
+/// A decoded journal.
+#[derive(Debug, Clone, PartialEq)]
+pub struct Journal {
+    pub hash_interval: u32,
+    /// Starting state in save-file encoding.
+    pub save: Vec<u8>,
+    pub records: Vec<JournalRecord>,
+}
+
+struct Reader<'a> {
+    data: &'a [u8],
+    pos: usize,
+    /// A read ran past the end of the data.
+    truncated: bool,
+}
+
+impl<'a> Reader<'a> {
+    fn byte(&mut self) -> anyhow::Result<u8> {
+        Ok(self.bytes(1)?[0])
+    }
+
+    fn varint(&mut self) -> anyhow::Result<u64> {
+        let mut v = 0u64;
+        for shift in (0..64).step_by(7) {
+            let b = self.byte()?;
+            v |= u64::from(b & 0x7f) << shift;
+            if b & 0x80 == 0 {
+                return Ok(v);
+            }
+        }
+        bail!("input journal varint too long")
+    }
+
+    fn bytes(&mut self, n: usize) -> anyhow::Result<&'a [u8]> {
+        let end = self.pos.checked_add(n).filter(|&e| e <= self.data.len());
+        self.truncated = end.is_none();
+        let end = end.context("input journal truncated")?;
+        let out = &self.data[self.pos..end];
+        self.pos = end;
+        Ok(out)
+    }
+
+    fn record(&mut self) -> anyhow::Result<JournalRecord> {
+        let tag = self.byte()?;
+        Ok(if tag & TAG_INPUT != 0 {
+            let ticks = u32::try_from(self.varint()?).context("input run too long")?;
+            JournalRecord::Input {
+                dir: Direction::from(tag & DIR_MASK),
+                fire: tag & FIRE_BIT != 0,
+                ticks,
+            }
+        } else if tag & TAG_EVENT != 0 {
+            JournalRecord::Event(JournalEvent::from_kind(tag & !TAG_EVENT, &mut || self.byte())?)
+        } else if tag == TAG_HASH {
+            JournalRecord::Hash(u64::from_le_bytes(self.bytes(8)?.try_into().unwrap()))
+        } else {
+            bail!("bad input journal record tag {tag:#04x}")
+        })
+    }
+}
+
+impl Journal {
+    pub fn open(path: &Path) -> anyhow::Result<Self> {
+        let data = std::fs::read(path)
+            .with_context(|| format!("reading input journal {}", path.display()))?;
+        Self::from_bytes(&data)
+            .with_context(|| format!("reading input journal {}", path.display()))
+    }
+
+    pub fn from_bytes(data: &[u8]) -> anyhow::Result<Self> {
+        let mut r = Reader { data, pos: 0, truncated: false };
+        if r.bytes(MAGIC.len()).ok() != Some(MAGIC.as_slice()) {
+            bail!("not an input journal");
+        }
+        let version = r.varint()?;
+        if version != JOURNAL_VERSION as u64 {
+            bail!("input journal version {version}, expected {JOURNAL_VERSION}");
+        }
+        let hash_interval = u32::try_from(r.varint()?).context("bad hash interval")?;
+        let save_len = usize::try_from(r.varint()?).context("bad save length")?;
+        let save = r.bytes(save_len)?.to_vec();
+
+        let mut records = Vec::new();
+        while r.pos < data.len() {
+            match r.record() {
+                Ok(rec) => records.push(rec),
+                // A crash mid-write leaves a partial last record.
+                Err(_) if r.truncated => break,
+                Err(e) => return Err(e),
+            }
+        }
+        Ok(Journal { hash_interval, save, records })
+    }
+
+    /// Ticks covered by the journal.
+    pub fn ticks(&self) -> u64 {
+        self.records
+            .iter()
+            .map(|r| match r {
+                JournalRecord::Input { ticks, .. } => *ticks as u64,
+                _ => 0,
+            })
+            .sum()
+    }
+}
+
+/// Hash of the simulated state: everything a save holds, plus the tick
+/// counter and every entity's position, facing and health.  Entities are
+/// visited in `hecs` storage order, which the same spawn sequence
+/// reproduces.
+pub fn state_hash(scene: &EcsScene) -> u64 {
+    let mut h = Fingerprint::new();
+    h.bytes(&persist::ecs_save_to_bytes(scene));
+    h.word(scene.res.clock.tick_counter as u64);
+    for (pos, facing, health) in scene
+        .world
+        .query::<(&Position, Option<&Facing>, Option<&Health>)>()
+        .iter()
+    {
+        h.word((pos.x.to_bits() as u64) << 32 | pos.y.to_bits() as u64);
+        let dir = facing.map_or(0xff, |f| f.dir as u64);
+        let vitality = health.map_or(0xffff, |v| v.vitality as u16 as u64);
+        h.word(dir << 16 | vitality);
+    }
+    h.0
+}
+
+/// Where a replay first disagreed with its journal.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct Divergence {
+    pub tick: u64,
+    pub expected: u64,
+    pub actual: u64,
+}
+
+#[derive(Default)]
+pub struct ReplayReport {
+    pub ticks: u64,
+    pub checkpoints: u32,
+    pub divergence: Option<Divergence>,
+    /// Set when the session ended in game over or quit.
+    pub result: Option<SceneResult>,
+}
+
+/// Feed `journal`'s recorded inputs to `scene` tick by tick, stopping at the
+/// first hash mismatch.  The scene must already be at the journal's starting
+/// state (`EcsScene::begin_replay`).
+pub fn replay(scene: &mut EcsScene, game_lib: &GameLibrary, journal: &Journal) -> ReplayReport {
+    let mut report = ReplayReport::default();
+    for record in &journal.records {
+        match *record {
+            JournalRecord::Event(event) => scene.apply_input(event),
+            JournalRecord::Input { dir, fire, ticks } => {
+                for _ in 0..ticks {
+                    report.ticks += 1;
+                    if let Some(result @ (SceneResult::GameOver | SceneResult::Quit)) =
+                        scene.step_headless(game_lib, dir, fire)
+                    {
+                        report.result = Some(result);
+                        return report;
+                    }
+                }
+            }
+            JournalRecord::Hash(expected) => {
+                report.checkpoints += 1;
+                let actual = state_hash(scene);
+                if actual != expected {
+                    report.divergence = Some(Divergence { tick: report.ticks, expected, actual });
+                    return report;
+                }
+            }
+        }
+    }
+    report
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn round_trips_runs_events_and_hashes() {
+        let mut bytes = Vec::new();
+        {
+            let mut w = JournalWriter::new(&mut bytes, b"SAVE", 4).unwrap();
+            for _ in 0..200 {
+                w.tick(Direction::NE, false).unwrap();
+            }
+            w.event(JournalEvent::MenuKey(b'T')).unwrap();
+            w.event(JournalEvent::DismissView).unwrap();
+            w.tick(Direction::NE, false).unwrap();
+            w.tick(Direction::None, true).unwrap();
+            w.hash(0x0123_4567_89ab_cdef).unwrap();
+            w.tick(Direction::W, true).unwrap();
+        }
+        // 200 ticks of one input cost a tag and a two-byte varint.
+        let header = MAGIC.len() + 3 + 4;
+        assert_eq!(bytes.len(), header + 3 + 2 + 1 + 2 + 2 + 9 + 2);
+
+        let j = Journal::from_bytes(&bytes).unwrap();
+        assert_eq!(j.hash_interval, 4);
+        assert_eq!(j.save, b"SAVE");
+        assert_eq!(j.ticks(), 203);
+        assert_eq!(
+            j.records,
+            [
+                JournalRecord::Input { dir: Direction::NE, fire: false, ticks: 200 },
+                JournalRecord::Event(JournalEvent::MenuKey(b'T')),
+                JournalRecord::Event(JournalEvent::DismissView),
+                JournalRecord::Input { dir: Direction::NE, fire: false, ticks: 1 },
+                JournalRecord::Input { dir: Direction::None, fire: true, ticks: 1 },
+                JournalRecord::Hash(0x0123_4567_89ab_cdef),
+                JournalRecord::Input { dir: Direction::W, fire: true, ticks: 1 },
+            ]
+        );
+    }
+
+    #[test]
+    fn hash_is_due_every_interval() {
+        let mut w = JournalWriter::new(Vec::new(), &[], 3).unwrap();
+        let due: Vec<bool> = (0..6)
+            .map(|_| {
+                w.tick(Direction::S, false).unwrap();
+                w.wants_hash()
+            })
+            .collect();
+        assert_eq!(due, [false, false, true, false, false, true]);
+        assert!(!JournalWriter::new(Vec::new(), &[], 0).unwrap().wants_hash());
+    }
+
+    #[test]
+    fn truncated_tail_is_dropped_and_bad_tags_rejected() {
+        let mut bytes = Vec::new();
+        {
+            let mut w = JournalWriter::new(&mut bytes, &[], 0).unwrap();
+            w.tick(Direction::E, false).unwrap();
+            w.hash(7).unwrap();
+        }
+        let cut = &bytes[..bytes.len() - 3];
+        assert_eq!(Journal::from_bytes(cut).unwrap().records.len(), 1);
+
+        let mut bad = bytes.clone();
+        bad.push(0x01);
+        bad.push(0x00);
+        assert!(Journal::from_bytes(&bad).is_err());
+        assert!(Journal::from_bytes(b"FMRSJRNX").is_err());
+    }
+}
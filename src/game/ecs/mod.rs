@@ -4,9 +4,13 @@
 pub mod components;
 pub mod debug_commands;
 pub mod events;
+pub mod journal;
 pub mod resources;
 pub mod scene;
+#[cfg(test)]
+pub mod schedule;
 pub mod spawn;
 pub mod systems;
+pub mod worker;
 
 
@@ -1,8 +1,11 @@
 //! Global singleton resources — non-entity game state shared by all systems.
 
-use hecs::Entity;
+use hecs::{CommandBuffer, Entity, World};
 use crate::game::debug_command::GodModeFlags;
-use crate::game::ecs::events::Events;
+use crate::game::ecs::components::{
+    ActorMotion, AiState, ArenaDummy, Enemy, EnemyKind, Facing, Health, Loot, Position, Speed,
+};
+use crate::game::ecs::events::{DamageEvent, Events};
 use crate::game::gfx_effects::{WitchEffect, TeleportEffect};
 
 // ── Clock ────────────────────────────────────────────────────────────────────
@@ -170,6 +173,8 @@ pub struct PaletteState {
     pub transition:          Option<PaletteTransition>,
     pub textcolors:          Palette,
     pub compass_regions:     Vec<(i32, i32, i32, i32)>,
+    /// ARGB8888 LUT for `current_palette`, rebuilt lazily when it changes.
+    pub lut:                 crate::game::palette_lut::PaletteLut,
 }
 
 impl Default for PaletteState {
@@ -181,6 +186,7 @@ impl Default for PaletteState {
             transition:          None,
             textcolors:          [0u32; 32],
             compass_regions:     Vec::new(),
+            lut:                 crate::game::palette_lut::PaletteLut::default(),
         }
     }
 }
@@ -211,13 +217,38 @@ pub struct MapData {
 
 // ── Sprite sheets ─────────────────────────────────────────────────────────────
 
-/// Loaded cfile sprite sheets. Replaced on each region transition.
+/// Loaded cfile sprite sheets. Read-only once loaded, so `Resources` holds
+/// them behind an `Arc` that headless batch runs share between scenes.
 #[derive(Default)]
 pub struct SpriteSheets {
     pub sheets:         Vec<Option<crate::game::sprites::SpriteSheet>>,
     pub object_sprites: Option<crate::game::sprites::SpriteSheet>,
 }
 
+impl SpriteSheets {
+    /// Decode the player (0-2), enemy (4-12) and setfig (13-17) sheets plus
+    /// the object sprites.  Sheets present in `bundle` are copied from it
+    /// instead of being decoded from the ADF.
+    pub fn load(adf: &crate::game::adf::AdfDisk, bundle: Option<&crate::game::bundle::Bundle>) -> Self {
+        use crate::game::sprites::SpriteSheet;
+        let bundled = |cfile_idx: u8| bundle.and_then(|b| b.sprite_sheet(cfile_idx));
+        let mut sheets: Vec<_> = (0..18).map(|_| None).collect();
+        for cfile_idx in Self::CHARACTER_CFILES {
+            sheets[cfile_idx as usize] =
+                bundled(cfile_idx).or_else(|| SpriteSheet::load(adf, cfile_idx));
+        }
+        SpriteSheets {
+            sheets,
+            object_sprites: bundled(Self::OBJECT_CFILE).or_else(|| SpriteSheet::load_objects(adf)),
+        }
+    }
+
+    /// Character sheets loaded at `SPRITE_H`.
+    pub const CHARACTER_CFILES: [u8; 17] = [0, 1, 2, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17];
+    /// The object sheet (`OBJ_SPRITE_H` rows per frame).
+    pub const OBJECT_CFILE: u8 = 3;
+}
+
 // ── Encounter context ─────────────────────────────────────────────────────────
 
 /// Static lookup tables used by EncounterSystem.
@@ -299,6 +330,227 @@ pub struct VfxState {
     pub teleport_effect: TeleportEffect,
 }
 
+// ── Spatial index ─────────────────────────────────────────────────────────────
+
+/// Side of one spatial-index cell, in world pixels.
+pub const SPATIAL_CELL: i32 = 64;
+
+/// One indexed enemy position.
+#[derive(Debug, Clone, Copy)]
+pub struct SpatialEntry {
+    pub entity: Entity,
+    pub x: f32,
+    pub y: f32,
+}
+
+/// Uniform-grid index over `Enemy` positions, rebuilt by `systems::spatial`
+/// after each pass that moves or spawns enemies.
+///
+/// `entries()` keeps hecs query order, and `query_box` reports matches in
+/// that order, so systems that stop at the first hit (or index "the next
+/// enemy") see exactly what their former linear scans saw.
+#[derive(Debug, Default)]
+pub struct SpatialIndex {
+    entries: Vec<SpatialEntry>,
+    /// Entry indices sorted by (cell key, index).
+    order: Vec<u32>,
+    /// Cell key of each element of `order`.
+    keys: Vec<u32>,
+}
+
+impl SpatialIndex {
+    fn cell(v: f32) -> u32 {
+        (v as i32).div_euclid(SPATIAL_CELL).clamp(0, 0xFFFF) as u32
+    }
+
+    /// Row-major cell key: one row of cells is a contiguous key range.
+    fn key(cx: u32, cy: u32) -> u32 {
+        cy << 16 | cx
+    }
+
+    pub fn rebuild(&mut self, world: &World) {
+        self.entries.clear();
+        self.entries.extend(
+            world
+                .query::<(Entity, &Position)>()
+                .with::<&Enemy>()
+                .iter()
+                .map(|(entity, p)| SpatialEntry { entity, x: p.x, y: p.y }),
+        );
+        let entries = &self.entries;
+        let key_of = |i: u32| {
+            let e = &entries[i as usize];
+            Self::key(Self::cell(e.x), Self::cell(e.y))
+        };
+        self.order.clear();
+        self.order.extend(0..entries.len() as u32);
+        self.order.sort_unstable_by_key(|&i| (key_of(i), i));
+        self.keys.clear();
+        self.keys.extend(self.order.iter().map(|&i| key_of(i)));
+    }
+
+    /// All indexed enemies in query order.
+    pub fn entries(&self) -> &[SpatialEntry] {
+        &self.entries
+    }
+
+    /// Replace `out` with the indices (into `entries()`, ascending) of every
+    /// entry within `half_w`/`half_h` of (x, y) on each axis.  Callers apply
+    /// their own exact range test; the box only has to contain it.
+    pub fn query_box(&self, x: f32, y: f32, half_w: f32, half_h: f32, out: &mut Vec<usize>) {
+        out.clear();
+        self.any_index_in_box(x, y, half_w, half_h, |i| {
+            out.push(i);
+            false
+        });
+        out.sort_unstable();
+    }
+
+    /// True if `pred` holds for any entry within the box.  Entries are visited
+    /// in cell order, not query order, so only use this where order is moot.
+    pub fn any_in_box(
+        &self,
+        x: f32,
+        y: f32,
+        half_w: f32,
+        half_h: f32,
+        mut pred: impl FnMut(&SpatialEntry) -> bool,
+    ) -> bool {
+        self.any_index_in_box(x, y, half_w, half_h, |i| pred(&self.entries[i]))
+    }
+
+    fn any_index_in_box(
+        &self,
+        x: f32,
+        y: f32,
+        half_w: f32,
+        half_h: f32,
+        mut pred: impl FnMut(usize) -> bool,
+    ) -> bool {
+        let (cx0, cx1) = (Self::cell(x - half_w), Self::cell(x + half_w));
+        (Self::cell(y - half_h)..=Self::cell(y + half_h)).any(|cy| {
+            let lo = self.keys.partition_point(|&k| k < Self::key(cx0, cy));
+            let hi = self.keys.partition_point(|&k| k <= Self::key(cx1, cy));
+            self.order[lo..hi].iter().any(|&i| {
+                let e = &self.entries[i as usize];
+                (e.x - x).abs() <= half_w && (e.y - y).abs() <= half_h && pred(i as usize)
+            })
+        })
+    }
+}
+
+// ── Actor kinematics ──────────────────────────────────────────────────────────
+
+/// The components `ActorKinematics` mirrors; every active enemy has them all
+/// (see `spawn_enemy`).
+type KinematicsQuery<'a> = (
+    Entity,
+    &'a mut Position,
+    &'a mut Facing,
+    &'a mut ActorMotion,
+    &'a mut AiState,
+    &'a EnemyKind,
+    &'a Health,
+    &'a Speed,
+    &'a Loot,
+);
+
+/// Structure-of-arrays copy of the hot enemy components, for the AI and
+/// movement passes.
+///
+/// `gather` fills one row per non-dummy enemy in hecs query order; a system
+/// then walks the columns by row index instead of looking components up per
+/// entity, and `scatter` writes the mutable columns (position, facing,
+/// environ, AI state) back in the same order.  Rows are only meaningful
+/// between the two calls of one system, with no spawns or despawns between.
+#[derive(Default)]
+pub struct ActorKinematics {
+    pub entity:   Vec<Entity>,
+    pub x:        Vec<f32>,
+    pub y:        Vec<f32>,
+    pub facing:   Vec<crate::game::direction::Direction>,
+    pub environ:  Vec<i8>,
+    pub ai:       Vec<AiState>,
+    pub race:     Vec<u8>,
+    pub speed:    Vec<u8>,
+    pub vitality: Vec<i16>,
+    pub weapon:   Vec<u8>,
+}
+
+impl ActorKinematics {
+    pub fn len(&self) -> usize {
+        self.entity.len()
+    }
+
+    pub fn gather(&mut self, world: &mut World) {
+        self.entity.clear();
+        self.x.clear();
+        self.y.clear();
+        self.facing.clear();
+        self.environ.clear();
+        self.ai.clear();
+        self.race.clear();
+        self.speed.clear();
+        self.vitality.clear();
+        self.weapon.clear();
+        for (entity, pos, facing, motion, ai, kind, health, speed, loot) in world
+            .query_mut::<KinematicsQuery<'_>>()
+            .with::<&Enemy>()
+            .without::<&ArenaDummy>()
+        {
+            self.entity.push(entity);
+            self.x.push(pos.x);
+            self.y.push(pos.y);
+            self.facing.push(facing.dir);
+            self.environ.push(motion.environ);
+            self.ai.push(ai.clone());
+            self.race.push(kind.race);
+            self.speed.push(speed.speed);
+            self.vitality.push(health.vitality);
+            self.weapon.push(loot.weapon);
+        }
+    }
+
+    pub fn scatter(&self, world: &mut World) {
+        let rows = world
+            .query_mut::<KinematicsQuery<'_>>()
+            .with::<&Enemy>()
+            .without::<&ArenaDummy>();
+        for (i, (entity, pos, facing, motion, ai, ..)) in rows.into_iter().enumerate() {
+            debug_assert_eq!(self.entity.get(i), Some(&entity), "kinematics rows out of step");
+            pos.x = self.x[i];
+            pos.y = self.y[i];
+            facing.dir = self.facing[i];
+            motion.environ = self.environ[i];
+            ai.clone_from(&self.ai[i]);
+        }
+    }
+}
+
+// ── Tick scratch ──────────────────────────────────────────────────────────────
+
+/// Reusable per-tick buffers.  Systems clear and refill these instead of
+/// collecting into fresh Vecs, so once capacities settle a tick does not touch
+/// the heap.  Nothing here survives from one system to the next.
+#[derive(Default)]
+pub struct TickScratch {
+    /// Entities to visit, collected up front to avoid mid-loop borrow conflicts.
+    pub entities: Vec<Entity>,
+    /// `SpatialIndex::query_box` results.
+    pub near: Vec<usize>,
+    /// Actor positions for blocking tests.
+    pub points: Vec<(f32, f32)>,
+    /// Actor positions for `actor_collides`.
+    pub blockers: Vec<(i32, i32)>,
+    /// Damage events being applied; swapped with `Events::damage`.
+    pub damage: Vec<DamageEvent>,
+    /// Deferred despawns (and other structural changes), applied by the
+    /// queuing system once its queries are done.
+    pub commands: CommandBuffer,
+    /// Enemy component columns for the AI and movement passes.
+    pub kinematics: ActorKinematics,
+}
+
 // ── Narrative ─────────────────────────────────────────────────────────────────
 
 /// Narrative events for scripted sequences and dialogue.
@@ -399,7 +651,7 @@ pub struct Resources {
     pub camera:    CameraState,
     pub palette:   PaletteState,
     pub map:       MapData,
-    pub sprites:   SpriteSheets,
+    pub sprites:   std::sync::Arc<SpriteSheets>,
     pub encounter: EncounterContext,
     pub vfx:       VfxState,
     pub events:    Events,
@@ -432,6 +684,12 @@ pub struct Resources {
     pub zones: Vec<crate::game::game_library::ZoneConfig>,
     /// Pending region transition — set by RegionSystem, consumed by EcsScene.
     pub pending_transition: Option<crate::game::ecs::events::RegionTransitionEvent>,
+    /// Enemy positions by grid cell, for neighbour queries.
+    pub spatial: SpatialIndex,
+    /// Reusable buffers for systems' temporary lists.
+    pub scratch: TickScratch,
+    /// Every random roll the systems make that is not keyed to the tick.
+    pub rng: crate::game::combat::GameRng,
 }
 
 impl Resources {
@@ -449,7 +707,7 @@ impl Resources {
             camera:         CameraState::default(),
             palette:        PaletteState::default(),
             map:            MapData::default(),
-            sprites:        SpriteSheets::default(),
+            sprites:        std::sync::Arc::default(),
             encounter:      EncounterContext::default(),
             vfx:            VfxState::default(),
             events:         Events::default(),
@@ -465,6 +723,9 @@ impl Resources {
             adf:                 None,
             zones:               Vec::new(),
             pending_transition:  None,
+            spatial:             SpatialIndex::default(),
+            scratch:             TickScratch::default(),
+            rng:                 crate::game::combat::GameRng::default(),
         }
     }
 }
@@ -610,4 +871,68 @@ mod tests {
         quest2_mut.princess_rescues = 3;
         assert_ne!(quest1, quest2_mut);
     }
+
+    #[test]
+    fn spatial_query_matches_linear_scan_in_query_order() {
+        use crate::game::ecs::components::{Enemy, Position};
+        let mut world = hecs::World::new();
+        let mut state = 7u32;
+        for _ in 0..300 {
+            state = state.wrapping_mul(1_103_515_245).wrapping_add(12_345);
+            let x = (state >> 8) % 2000;
+            state = state.wrapping_mul(1_103_515_245).wrapping_add(12_345);
+            let y = (state >> 8) % 2000;
+            world.spawn((Enemy, Position::new(x as f32, y as f32)));
+        }
+        // Non-enemies are not indexed.
+        world.spawn((Position::new(500.0, 500.0),));
+        let mut index = SpatialIndex::default();
+        index.rebuild(&world);
+        assert_eq!(index.entries().len(), 300);
+
+        let linear: Vec<Position> = world
+            .query::<&Position>()
+            .with::<&Enemy>()
+            .iter()
+            .map(|p| *p)
+            .collect();
+        let mut hits = Vec::new();
+        for (qx, qy, hw, hh) in [(500.0, 500.0, 300.0, 300.0), (0.0, 0.0, 11.0, 9.0), (1999.0, 3.5, 70.0, 1.0)] {
+            index.query_box(qx, qy, hw, hh, &mut hits);
+            let expected: Vec<usize> = linear
+                .iter()
+                .enumerate()
+                .filter(|(_, p)| (p.x - qx).abs() <= hw && (p.y - qy).abs() <= hh)
+                .map(|(i, _)| i)
+                .collect();
+            assert_eq!(hits, expected, "box around ({qx}, {qy})");
+        }
+    }
+
+    #[test]
+    fn kinematics_scatter_writes_rows_back_to_their_entities() {
+        use crate::game::direction::Direction;
+        use crate::game::ecs::spawn::{spawn_arena_dummy, spawn_enemy};
+        use crate::game::npc::NpcState;
+        let mut world = hecs::World::new();
+        let a = spawn_enemy(&mut world, 10.0, 20.0, 1, 0, 5, 0, 0, 2, 0, 0);
+        let dummy = spawn_arena_dummy(&mut world, 50.0, 50.0, 0, 10, 0);
+        let b = spawn_enemy(&mut world, 30.0, 40.0, 1, 3, 7, 0, 0, 2, 0, 0);
+        let mut kin = ActorKinematics::default();
+        kin.gather(&mut world);
+        // Dummies are not tabled; rows keep query order.
+        assert_eq!(kin.entity, vec![a, b]);
+        assert_eq!((kin.x[1], kin.y[1], kin.race[1], kin.vitality[1]), (30.0, 40.0, 3, 7));
+
+        kin.x[1] = 33.0;
+        kin.facing[0] = Direction::W;
+        kin.environ[1] = 5;
+        kin.ai[0].state = NpcState::Walking;
+        kin.scatter(&mut world);
+        assert_eq!(world.get::<&Position>(b).unwrap().x, 33.0);
+        assert_eq!(world.get::<&Facing>(a).unwrap().dir, Direction::W);
+        assert_eq!(world.get::<&ActorMotion>(b).unwrap().environ, 5);
+        assert_eq!(world.get::<&AiState>(a).unwrap().state, NpcState::Walking);
+        assert_eq!(world.get::<&Position>(dummy).unwrap().x, 50.0);
+    }
 }
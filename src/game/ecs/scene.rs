@@ -15,15 +15,20 @@ use crate::game::colors::RGB4;
 use crate::game::debug_tui::DebugConsole;
 use crate::game::direction::Direction;
 use crate::game::ecs::components::{Bones, BrotherKind, HeroStats, Inventory, Position, SetFig, WorldObj};
-use crate::game::ecs::resources::Resources;
+use crate::game::ecs::journal::{self, JournalEvent, JournalWriter};
+use crate::game::ecs::resources::{Resources, SpriteSheets};
 use crate::game::ecs::spawn::{spawn_bones, spawn_hero};
 use crate::game::ecs::systems;
+use crate::game::ecs::worker::Worker;
 use crate::game::game_library::GameLibrary;
 use crate::game::map_renderer::{MAP_DST_H, MAP_DST_W};
 use crate::game::magic::{magic_dispatch_ecs, MagicResult, ITEM_BLUE_STONE};
-use crate::game::menu::{MenuAction, MenuState};
+use crate::game::menu::{ButtonRender, MenuAction, MenuState};
 use crate::game::shop::{buy_slot_ecs, BuyOutcome, BuyResult};
+use crate::game::sprites::FrameSource;
 use crate::game::palette::{amiga_color_to_rgba, Palette, PALETTE_SIZE};
+use crate::game::profiler::Profiler;
+use crate::game::region_cache::{RegionCache, RegionSource, SharedRegions};
 use crate::game::scene::{Scene, SceneResources, SceneResult};
 
 use super::debug_commands;
@@ -99,6 +104,28 @@ impl InputState {
         self.right = x > 0;
     }
 
+    /// Replace all input sources with a scripted direction and fire state
+    /// (headless runs, where no SDL events arrive).
+    fn set_scripted(&mut self, dir: Direction, fire: bool) {
+        let (up, down, left, right) = match dir {
+            Direction::N  => (true,  false, false, false),
+            Direction::NE => (true,  false, false, true),
+            Direction::E  => (false, false, false, true),
+            Direction::SE => (false, true,  false, true),
+            Direction::S  => (false, true,  false, false),
+            Direction::SW => (false, true,  true,  false),
+            Direction::W  => (false, false, true,  false),
+            Direction::NW => (true,  false, true,  false),
+            Direction::None => (false, false, false, false),
+        };
+        *self = Self::new();
+        self.up = up;
+        self.down = down;
+        self.left = left;
+        self.right = right;
+        self.fire_keyboard = fire;
+    }
+
     /// Decode 8-way direction from current input flags.
     fn to_direction(&self) -> Direction {
         match (self.up, self.down, self.left, self.right) {
@@ -115,6 +142,15 @@ impl InputState {
     }
 }
 
+/// Run one schedule entry, charging its time to `$name` when profiling is on.
+macro_rules! timed {
+    ($scene:ident, $name:literal, $call:expr) => {{
+        let start = $scene.profiler.start();
+        $call;
+        $scene.profiler.record($name, start);
+    }};
+}
+
 /// ECS-based gameplay scene (Plan D skeleton).
 ///
 /// Owns the `hecs::World` and the singleton `Resources`. Each call to
@@ -127,10 +163,56 @@ const PLAYFIELD_LORES_W:  u32 = 288;
 const PLAYFIELD_LORES_H:  u32 = 140;
 const PLAYFIELD_CANVAS_W: u32 = PLAYFIELD_LORES_W * 2;
 const PLAYFIELD_CANVAS_H: u32 = PLAYFIELD_LORES_H * 2;
-const HIBAR_NATIVE_H:     u32 = 57;
+const HIBAR_NATIVE_H:     u32 = crate::game::render_resources::HIBAR_TEX_H;
 const HIBAR_H:            u32 = HIBAR_NATIVE_H * 2;
 const HIBAR_Y:            i32 = CANVAS_MARGIN_Y + PLAYFIELD_CANVAS_H as i32 + 6;
 
+/// Images drawn by gameplay (the hibar background).
+pub const IMAGES: &[&str] = &["hiscreen"];
+
+/// Read-only assets loaded once and shared by every `EcsScene` in a batch of
+/// headless runs: the ADF image, the decoded sprite sheets and a region store
+/// that decodes each region once for all scenes.  A current data bundle, when
+/// there is one, stands in for the sprite and tile decoders.
+pub struct SharedAssets {
+    pub adf:     std::sync::Arc<crate::game::adf::AdfDisk>,
+    pub sprites: std::sync::Arc<SpriteSheets>,
+    pub regions: std::sync::Arc<SharedRegions>,
+}
+
+impl SharedAssets {
+    pub fn load(game_lib: &GameLibrary) -> anyhow::Result<Self> {
+        let adf = crate::game::adf::AdfDisk::open(std::path::Path::new(adf_path(game_lib)))?;
+        let bundle = crate::game::bundle::open_for(&adf, game_lib).ok().map(std::sync::Arc::new);
+        let sprites = SpriteSheets::load(&adf, bundle.as_deref());
+        Ok(SharedAssets {
+            adf:     std::sync::Arc::new(adf),
+            sprites: std::sync::Arc::new(sprites),
+            regions: std::sync::Arc::new(SharedRegions::with_bundle(bundle)),
+        })
+    }
+}
+
+fn adf_path(game_lib: &GameLibrary) -> &str {
+    game_lib
+        .disk
+        .as_ref()
+        .map(|d| d.adf.as_str())
+        .unwrap_or("game/image")
+}
+
+/// Inputs of the last hibar repaint.  `render_hibar` redraws the cached
+/// texture only when the current frame's key differs.
+#[derive(PartialEq)]
+struct HibarKey {
+    /// Brave, luck, kind, vitality, wealth.
+    stats:         [i16; 5],
+    buttons:       Vec<ButtonRender>,
+    messages_rev:  u64,
+    compass_arrow: usize,
+    textcolors:    crate::game::ecs::resources::Palette,
+}
+
 pub struct EcsScene {
     pub world:          World,
     pub res:            Resources,
@@ -143,22 +225,73 @@ pub struct EcsScene {
     adf:                Option<std::sync::Arc<crate::game::adf::AdfDisk>>,
     /// RGB4 base palette used as input to fade_page() for day/night computation.
     base_colors:        Option<crate::game::colors::Palette>,
+    /// Faded `base_colors` pages, one per lighting step seen so far.
+    fade_table:         crate::game::palette_fader::FadeTable,
     /// Scroll-area message queue (up to 4 visible at once, most recent last).
     messages:           Vec<String>,
+    /// Bumped whenever `messages` changes, so the hibar knows to repaint.
+    messages_rev:       u64,
+    /// What the hibar texture currently shows; `None` forces a repaint.
+    hibar_key:          Option<HibarKey>,
+    /// `map_view::bigdraw_into` target for the Bird Totem overview, kept
+    /// between frames.
+    overview_buf:       Vec<u32>,
     /// Menu bar state: mode, enabled buttons, key/click dispatch.
     menu:               MenuState,
     /// Set to true when the player chooses Quit from the Game menu.
     quit_requested:     bool,
     /// Menu actions queued from handle_event() (runs outside ECS borrow).
     pending_menu_actions: Vec<MenuAction>,
+    /// What the next frame is drawn from (front) and the buffer the end of
+    /// the next tick batch fills (back); `capture_snapshot()` swaps them, so
+    /// both keep their draw-list buffers across frames.
+    snapshot:           RenderSnapshot,
+    next_snapshot:      RenderSnapshot,
+    /// Pipelined mode (`--pipeline`): `update()` draws the last captured
+    /// snapshot and leaves its ticks to `present()`, which runs them on a
+    /// worker thread while the canvas presents.  Input reaches the screen
+    /// one frame later than in the default mode.
+    pub pipelined:      bool,
+    /// Runs the deferred tick batches; started by the first pipelined present.
+    sim_worker:         Option<Worker>,
+    /// Ticks handed to `update()` that `present()` has yet to run.
+    deferred_ticks:     u32,
+    /// Result of a deferred tick batch, returned by the next `update()`.
+    deferred_result:    Option<SceneResult>,
+    /// Decoded region assets (LRU) plus the background prefetch worker.
+    region_cache:       RegionCache,
+    /// Assets shared with other scenes; `load_world()` takes them from here
+    /// instead of opening and decoding its own copies.
+    shared:             Option<std::sync::Arc<SharedAssets>>,
+    /// Per-stage timings for the tick schedule and render passes; disabled
+    /// until the debug console (`/prof`) or the headless runner turns it on.
+    pub profiler:       Profiler,
+    /// Run the collision/door/zone batch (`run_shared_batch`) on a worker
+    /// thread.  Off by default: the batch is cheaper than the hand-off.
+    pub parallel_systems: bool,
+    /// Started by the first parallel batch and kept for later ticks.
+    stage_worker: Option<Worker>,
+    /// Turbo (`/turbo`): run every tick `update()` is handed instead of
+    /// capping the batch, and mute sound effects.  Only the last tick of a
+    /// batch is drawn.
+    pub turbo: bool,
     /// If true, emit BrotherSuccession on the first update() call to trigger julian_start placard.
     /// Set to false when launched with --skip-intro.
     show_start_placard: bool,
     /// True until the first update() call has been processed.
     first_update: bool,
+    /// Input journal being written (`--record`).
+    journal:            Option<JournalWriter>,
+    /// Journal path and hash interval, waiting for the world to load.
+    journal_request:    Option<(std::path::PathBuf, u32)>,
 
 }
 
+// Pipelined `present()` lends the scene (and the `Sync` GameLibrary) to the
+// sim worker for each tick batch.
+fn _assert_send<T: Send>() {}
+const _: fn() = _assert_send::<EcsScene>;
+
 impl EcsScene {
     /// Construct a new `EcsScene`, spawning the hero at the location specified
     /// in `faery.toml` for brother 0 (Julian).  Falls back to `(100, 100)` if
@@ -234,15 +367,40 @@ impl EcsScene {
             adf_load_done: false,
             adf: None,
             base_colors: None,
+            fade_table: crate::game::palette_fader::FadeTable::default(),
             messages: Vec::new(),
+            messages_rev: 0,
+            hibar_key: None,
+            overview_buf: Vec::new(),
             menu: MenuState::new(),
             quit_requested: false,
             pending_menu_actions: Vec::new(),
+            snapshot: RenderSnapshot::default(),
+            next_snapshot: RenderSnapshot::default(),
+            pipelined: false,
+            sim_worker: None,
+            deferred_ticks: 0,
+            deferred_result: None,
+            region_cache: RegionCache::default(),
+            shared: None,
+            profiler: Profiler::default(),
+            parallel_systems: false,
+            stage_worker: None,
+            turbo: false,
             show_start_placard,
             first_update: true,
+            journal: None,
+            journal_request: None,
         }
     }
 
+    /// Take the ADF, sprite sheets and decoded regions from `shared` instead
+    /// of loading private copies.  Must be called before the world loads.
+    pub fn with_shared_assets(mut self, shared: std::sync::Arc<SharedAssets>) -> Self {
+        self.shared = Some(shared);
+        self
+    }
+
 
     /// Return the id of the next living brother after `dead_id` in succession order
     /// (0→1→2), skipping any brother already represented by a Bones entity in the world.
@@ -346,6 +504,7 @@ impl EcsScene {
     /// Drain message and speech events from the current tick into the message queue.
     /// Called from `update()` after each tick so `game_lib` is available for narr lookup.
     fn drain_messages(&mut self, game_lib: &GameLibrary) {
+        let len_before = self.messages.len();
         // Plain text messages.
         for ev in self.res.events.message.drain(..) {
             self.messages.push(ev.text);
@@ -357,6 +516,9 @@ impl EcsScene {
             // TODO(Plan I): Route Talk-action speech to narrative.push(Placard{..})
             // Proximity-triggered speech should continue using scroll messages.
         }
+        if self.messages.len() != len_before {
+            self.messages_rev += 1;
+        }
         // Trim to 64 messages — the hibar only shows the last 4.
         if self.messages.len() > 64 {
             let overflow = self.messages.len() - 64;
@@ -391,12 +553,12 @@ impl EcsScene {
 
     /// Route a MenuAction emitted by MenuState to the appropriate ECS operation.
     /// Returns true if the scene should quit.
-    fn dispatch_menu_action(&mut self, action: MenuAction, game_lib: &GameLibrary, _resources: &mut SceneResources<'_, '_>) -> bool {
+    fn dispatch_menu_action(&mut self, action: MenuAction, game_lib: &GameLibrary) -> bool {
         match action {
             MenuAction::SwitchMode(_) => {}
 
             MenuAction::Inventory => {
-                self.res.view.viewstatus = 1;
+                self.res.view.viewstatus = 4;
             }
 
             MenuAction::Take => {
@@ -530,65 +692,50 @@ impl EcsScene {
     fn load_world(&mut self, game_lib: &GameLibrary) {
         self.adf_load_done = true;
 
-        let adf_path = game_lib
-            .disk
-            .as_ref()
-            .map(|d| d.adf.as_str())
-            .unwrap_or("game/image");
-
-        let adf_raw = match crate::game::adf::AdfDisk::open(std::path::Path::new(adf_path)) {
-            Ok(a) => a,
-            Err(e) => { self.res.diag_log.push(format!("EcsScene: AdfDisk::open failed: {e}")); return; }
+        let (adf, bundle) = match &self.shared {
+            Some(shared) => {
+                // No prefetch worker: the shared store decodes on first use.
+                self.region_cache.set_shared(shared.regions.clone());
+                (shared.adf.clone(), None)
+            }
+            None => {
+                let adf_raw = match crate::game::adf::AdfDisk::open(std::path::Path::new(adf_path(game_lib))) {
+                    Ok(a) => a,
+                    Err(e) => { self.res.diag_log.push(format!("EcsScene: AdfDisk::open failed: {e}")); return; }
+                };
+                // A missing or stale bundle just means decoding from the ADF.
+                let bundle = match crate::game::bundle::open_for(&adf_raw, game_lib) {
+                    Ok(b) => Some(std::sync::Arc::new(b)),
+                    Err(e) => { self.res.diag_log.push(format!("EcsScene: data bundle not used: {e:#}")); None }
+                };
+                if let Some(b) = &bundle {
+                    self.region_cache.set_bundle(b.clone());
+                }
+                let adf = std::sync::Arc::new(adf_raw);
+                self.region_cache.start_prefetcher(adf.clone());
+                (adf, bundle)
+            }
         };
-        let adf = std::sync::Arc::new(adf_raw);
         self.adf = Some(adf.clone());
         self.res.adf = Some(adf.clone());
 
+        // WorldData, tile atlas and shadow/mask tables, via the region cache.
         let region = self.res.region.region_num;
-        let world_result = game_lib.find_region_config(region).map(|cfg| {
-            let map_blocks: Vec<u32> = if region < 8 {
-                [0u8, 2, 4, 6]
-                    .iter()
-                    .filter_map(|&r| game_lib.find_region_config(r))
-                    .map(|c| c.map_block)
-                    .collect()
-            } else {
-                vec![cfg.map_block]
-            };
-            crate::game::world_data::WorldData::load(
-                &adf,
-                region,
-                cfg.sector_block,
-                &map_blocks,
-                cfg.terra_block,
-                cfg.terra2_block,
-                &cfg.image_blocks,
-            )
-        });
-
-        let world = match world_result {
-            Some(Ok(w)) => w,
-            Some(Err(e)) => { self.res.diag_log.push(format!("EcsScene: WorldData::load failed: {e}")); return; }
-            None => { self.res.diag_log.push(format!("EcsScene: no region config for region {region}")); return; }
+        let Some(source) = RegionSource::from_library(game_lib, region) else {
+            self.res.diag_log.push(format!("EcsScene: no region config for region {region}"));
+            return;
         };
-
-        // Shadow memory bitmask for sprite depth masking.
-        let shadow_mem = game_lib.disk.as_ref()
-            .filter(|d| d.shadow_count > 0)
-            .map(|d| crate::game::world_data::load_shadow_mem(&adf, d.shadow_block, d.shadow_count))
-            .unwrap_or_default();
-
-        let renderer = crate::game::map_renderer::MapRenderer::new(&world, shadow_mem.clone());
+        let assets = match self.region_cache.get(&source, &adf) {
+            Ok(a) => a,
+            Err(e) => { self.res.diag_log.push(format!("EcsScene: WorldData::load failed: {e}")); return; }
+        };
+        let (world, renderer) = assets.instantiate();
 
         // Sprite sheets: player (0-2), enemies (4-12), setfigs (13-17).
-        while self.res.sprites.sheets.len() < 18 {
-            self.res.sprites.sheets.push(None);
-        }
-        for cfile_idx in [0u8, 1, 2, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17] {
-            self.res.sprites.sheets[cfile_idx as usize] =
-                crate::game::sprites::SpriteSheet::load(&adf, cfile_idx);
-        }
-        self.res.sprites.object_sprites = crate::game::sprites::SpriteSheet::load_objects(&adf);
+        self.res.sprites = match &self.shared {
+            Some(shared) => shared.sprites.clone(),
+            None => std::sync::Arc::new(SpriteSheets::load(&adf, bundle.as_deref())),
+        };
 
         // Palette.
         self.base_colors = build_base_colors_palette(game_lib, region);
@@ -609,6 +756,7 @@ impl EcsScene {
         self.snap_camera();
 
         self.res.diag_log.push(format!("EcsScene: world loaded for region {region}"));
+        self.start_journal();
     }
 
     /// Perform a full region transition: despawn old actors, load new world data,
@@ -628,18 +776,17 @@ impl EcsScene {
         use crate::game::ecs::components::WorldObj;
 
         // 1. Despawn all Enemy, SetFig, and GroundItem entities.
-        let to_despawn: Vec<hecs::Entity> = {
-            let enemies: Vec<hecs::Entity> = self
-                .world.query::<(hecs::Entity, &Enemy)>().iter().map(|(e, _)| e).collect();
-            let setfigs: Vec<hecs::Entity> = self
-                .world.query::<(hecs::Entity, &SetFig)>().iter().map(|(e, _)| e).collect();
-            let items: Vec<hecs::Entity> = self
-                .world.query::<(hecs::Entity, &GroundItem)>().iter().map(|(e, _)| e).collect();
-            enemies.into_iter().chain(setfigs).chain(items).collect()
-        };
-        for e in to_despawn {
-            let _ = self.world.despawn(e);
+        let cmd = &mut self.res.scratch.commands;
+        for (e, _) in self.world.query::<(hecs::Entity, &Enemy)>().iter() {
+            cmd.despawn(e);
         }
+        for (e, _) in self.world.query::<(hecs::Entity, &SetFig)>().iter() {
+            cmd.despawn(e);
+        }
+        for (e, _) in self.world.query::<(hecs::Entity, &GroundItem)>().iter() {
+            cmd.despawn(e);
+        }
+        cmd.run_on(&mut self.world);
 
         // 2. Load WorldData + MapRenderer.
         let adf = match self.adf.as_ref() {
@@ -647,39 +794,16 @@ impl EcsScene {
             None => { self.res.diag_log.push("reload_region: no ADF loaded".to_string()); return; }
         };
 
-        let world_result = game_lib.find_region_config(region).map(|cfg| {
-            let map_blocks: Vec<u32> = if region < 8 {
-                [0u8, 2, 4, 6]
-                    .iter()
-                    .filter_map(|&r| game_lib.find_region_config(r))
-                    .map(|c| c.map_block)
-                    .collect()
-            } else {
-                vec![cfg.map_block]
-            };
-            crate::game::world_data::WorldData::load(
-                &adf,
-                region,
-                cfg.sector_block,
-                &map_blocks,
-                cfg.terra_block,
-                cfg.terra2_block,
-                &cfg.image_blocks,
-            )
-        });
-
-        let world_data = match world_result {
-            Some(Ok(w)) => w,
-            Some(Err(e)) => { self.res.diag_log.push(format!("reload_region: WorldData::load failed: {e}")); return; }
-            None => { self.res.diag_log.push(format!("reload_region: no region config for {region}")); return; }
+        // Usually already decoded by the prefetcher; otherwise loads here.
+        let Some(source) = RegionSource::from_library(game_lib, region) else {
+            self.res.diag_log.push(format!("reload_region: no region config for {region}"));
+            return;
         };
-
-        let shadow_mem = game_lib.disk.as_ref()
-            .filter(|d| d.shadow_count > 0)
-            .map(|d| crate::game::world_data::load_shadow_mem(&adf, d.shadow_block, d.shadow_count))
-            .unwrap_or_default();
-
-        let renderer = crate::game::map_renderer::MapRenderer::new(&world_data, shadow_mem);
+        let assets = match self.region_cache.get(&source, &adf) {
+            Ok(a) => a,
+            Err(e) => { self.res.diag_log.push(format!("reload_region: WorldData::load failed: {e}")); return; }
+        };
+        let (world_data, renderer) = assets.instantiate();
 
         // 3a. Spawn SetFig NPCs (ob_stat=3) from the world object list for this region.
         // Setfigs live in game_lib.objects — NOT in the NPC carrier table.
@@ -780,6 +904,29 @@ impl EcsScene {
         }
     }
 
+    /// Queue background loads for regions behind doors near the hero, so the
+    /// transition in `reload_region` finds them already decoded.
+    fn prefetch_nearby_regions(&mut self, game_lib: &GameLibrary) {
+        /// Look-ahead distance in world px (several ticks of walking).
+        const PREFETCH_RADIUS: u16 = 0x60;
+        let Ok(pos) = self.world.get::<&Position>(self.res.hero_entity).map(|p| *p) else { return; };
+        let nearby = crate::game::doors::regions_near_doors(
+            &self.res.map.doors,
+            self.res.region.region_num,
+            pos.x as u16,
+            pos.y as u16,
+            PREFETCH_RADIUS,
+        );
+        for region in nearby {
+            if region != self.res.region.region_num && !self.region_cache.contains(region) {
+                if let Some(source) = RegionSource::from_library(game_lib, region) {
+                    self.region_cache.prefetch(&source);
+                }
+            }
+        }
+        self.region_cache.poll();
+    }
+
     fn snap_camera(&mut self) {
         if let Ok(pos) = self.world.get::<&crate::game::ecs::components::Position>(self.res.hero_entity) {
             const CX: f32 = 144.0;
@@ -790,18 +937,116 @@ impl EcsScene {
         }
     }
 
-    /// Compose the map framebuf, blit sprites into it, then copy to the SDL canvas.
-    fn render_map(&mut self, canvas: &mut Canvas<Window>) {
-        let map_x = self.res.camera.map_x as u16;
-        let map_y = self.res.camera.map_y as u16;
+    /// Capture what `render_map` draws from the simulation — camera, hero
+    /// sector and the Y-sorted actor draw list — into the back snapshot, then
+    /// make it the front one.
+    fn capture_snapshot(&mut self) {
+        use crate::game::ecs::components::Position;
+        let snap = &mut self.next_snapshot;
+        snap.map_x = self.res.camera.map_x as u16;
+        snap.map_y = self.res.camera.map_y as u16;
+        // Used by mask type 3 (bridge): when hero_sector == 48 the bridge tiles don't
+        // mask the hero (fmain.c:3149-3179, should_mask_tile case 3).
+        snap.hero_sector = self.world
+            .get::<&Position>(self.res.hero_entity)
+            .ok()
+            .and_then(|pos| self.res.map.world.as_ref()
+                .map(|w| w.sector_at_pos(pos.x, pos.y)))
+            .unwrap_or(0);
+        collect_actor_draws(
+            &mut snap.draws,
+            &self.world,
+            self.res.hero_entity,
+            &self.res.sprites.sheets,
+            self.res.sprites.object_sprites.as_ref(),
+            self.res.clock.cycle as usize,
+            snap.map_x,
+            snap.map_y,
+            self.res.encounter.hero_dying_countdown,
+            self.res.encounter.dying,
+        );
+        snap.captured = true;
+        std::mem::swap(&mut self.snapshot, &mut self.next_snapshot);
+    }
+
+    /// Run a batch of gameplay ticks and capture the snapshot the next frame
+    /// draws.  Returns the first tick result that ends the batch early.
+    fn simulate(&mut self, ticks: u32, game_lib: &GameLibrary) -> Option<SceneResult> {
+        let mut result = None;
+        for _ in 0..ticks {
+            // The next tick clears the event queues, so a death mid-batch
+            // must be handled before the batch goes on.
+            result = self.tick(game_lib);
+            if result.is_some() {
+                break;
+            }
+        }
+        let start = self.profiler.start();
+        self.capture_snapshot();
+        self.profiler.record("snapshot", start);
+        result
+    }
+
+    /// Compose the map framebuf, blit sprites into it, then copy to the SDL canvas
+    /// through the persistent `playfield` streaming texture.  Draws the front
+    /// snapshot; the map itself comes from `res.map`, which only region loads
+    /// change.
+    ///
+    /// With a `gpu` backend the same frame is drawn from tile and sprite
+    /// textures instead; copper-banded frames still take the software path,
+    /// whose per-row palettes the textures cannot express.
+    fn render_map(
+        &mut self,
+        canvas: &mut Canvas<Window>,
+        playfield: &mut Texture,
+        gpu: Option<&mut crate::game::gpu_playfield::GpuPlayfield>,
+    ) {
+        let snap = &self.snapshot;
+        let (map_x, map_y, hero_sector) = (snap.map_x, snap.map_y, snap.hero_sector);
+
+        self.res.palette.lut.sync(&self.res.palette.current_palette);
+        if let Some(gpu) = gpu.filter(|_| self.res.palette.lut.bands().is_empty()) {
+            let (Some(renderer), Some(world_data)) =
+                (self.res.map.renderer.as_ref(), self.res.map.world.as_ref())
+            else {
+                return;
+            };
+            let start = self.profiler.start();
+            let minimap = crate::game::map_view::genmini_scrolled(map_x >> 4, map_y >> 5, world_data);
+            let frame = crate::game::gpu_playfield::PlayfieldFrame {
+                atlas: &renderer.atlas,
+                masks: &renderer.masks,
+                sprites: &self.res.sprites,
+                lut: self.res.palette.lut.lut(),
+                minimap: &minimap,
+                ox: (map_x & 0xF) as i32,
+                oy: (map_y & 0x1F) as i32,
+                hero_sector,
+            };
+            let placement = crate::game::gpu_playfield::PlayfieldPlacement {
+                origin: (PLAYFIELD_X, PLAYFIELD_Y),
+                scale: (
+                    (PLAYFIELD_CANVAS_W / PLAYFIELD_LORES_W) as i32,
+                    (PLAYFIELD_CANVAS_H / PLAYFIELD_LORES_H) as i32,
+                ),
+                size: (PLAYFIELD_LORES_W as i32, PLAYFIELD_LORES_H as i32),
+            };
+            let drawn = gpu.draw(canvas, &frame, placement, snap.draws.iter());
+            self.profiler.record("gpu_playfield", start);
+            if drawn {
+                return;
+            }
+        }
 
         // Step 1: compose tiles into the indexed framebuf.
+        let start = self.profiler.start();
         if let (Some(renderer), Some(world_data)) = (
             self.res.map.renderer.as_mut(),
             self.res.map.world.as_ref(),
         ) {
             renderer.compose(map_x, map_y, world_data);
         }
+        self.profiler.record("compose", start);
 
         if self.res.map.renderer.as_ref().map_or(true, |r| r.framebuf.is_empty()) {
             return;
@@ -811,72 +1056,41 @@ impl EcsScene {
         // Masking is interleaved with blitting (back-to-front) so each closer sprite
         // draws over the terrain re-stamped by sprites behind it — matching the
         // original save_blit → mask_blit → shape_blit per-actor pass (fmain.c:2412-2609).
-        let cycle       = self.res.clock.cycle as usize;
-        let hero_entity = self.res.hero_entity;
-
-        // Compute hero sector before mutably borrowing the renderer (both live in res.map).
-        // Used by mask type 3 (bridge): when hero_sector == 48 the bridge tiles don't
-        // mask the hero (fmain.c:3149-3179, should_mask_tile case 3).
-        use crate::game::ecs::components::Position;
-        let hero_sector = self.world
-            .get::<&Position>(hero_entity)
-            .ok()
-            .and_then(|pos| self.res.map.world.as_ref()
-                .map(|w| w.sector_at_pos(pos.x, pos.y)))
-            .unwrap_or(0);
-
+        let start = self.profiler.start();
         if let Some(renderer) = self.res.map.renderer.as_mut() {
-            blit_actors_inner(
-                &self.world,
-                hero_entity,
+            blit_actor_draws(
+                &self.snapshot.draws,
                 &self.res.sprites.sheets,
                 self.res.sprites.object_sprites.as_ref(),
-                cycle,
-                map_x,
-                map_y,
                 hero_sector,
                 renderer,
-                self.res.encounter.hero_dying_countdown,
-                self.res.encounter.dying,
             );
         }
+        self.profiler.record("actor_blit", start);
 
-        // Step 3: convert indexed framebuf to RGBA and blit to canvas.
-        let pal = &self.res.palette.current_palette;
+        // Step 3: convert indexed framebuf to ARGB in place in the streaming
+        // playfield texture, then blit it to the canvas. No per-frame allocation
+        // or texture creation — the texture lives as long as RenderResources.
+        let start = self.profiler.start();
+        let palette_lut = &self.res.palette.lut;
         let framebuf = &self.res.map.renderer.as_ref().unwrap().framebuf;
-        let mut rgb_buf: Vec<u8> = Vec::with_capacity(framebuf.len() * 4);
-        for &idx in framebuf {
-            let rgba = pal[(idx & 31) as usize];
-            // ARGB8888 little-endian: bytes are [B, G, R, A]
-            rgb_buf.push((rgba & 0xFF) as u8);
-            rgb_buf.push(((rgba >> 8) & 0xFF) as u8);
-            rgb_buf.push(((rgba >> 16) & 0xFF) as u8);
-            rgb_buf.push(0xFF);
-        }
-
-        {
-            let tc = canvas.texture_creator();
-            if let Ok(surface) = sdl3::surface::Surface::from_data(
-                &mut rgb_buf,
-                MAP_DST_W,
-                MAP_DST_H,
-                MAP_DST_W * 4,
-                sdl3::pixels::PixelFormat::ARGB8888,
-            ) {
-                if let Ok(mut tex) = tc.create_texture_from_surface(&surface) {
-                    tex.set_scale_mode(sdl3::render::ScaleMode::Nearest);
-                    let src = sdl3::rect::Rect::new(0, 0, PLAYFIELD_LORES_W, PLAYFIELD_LORES_H);
-                    let dst = sdl3::rect::Rect::new(
-                        PLAYFIELD_X, PLAYFIELD_Y, PLAYFIELD_CANVAS_W, PLAYFIELD_CANVAS_H,
-                    );
-                    let _ = canvas.copy(&tex, src, dst);
-                }
-            }
+        let row_w = MAP_DST_W as usize;
+        let locked = playfield.with_lock(None, |pixels: &mut [u8], pitch: usize| {
+            crate::game::palette_lut::convert_rows(
+                framebuf, row_w, pitch, palette_lut.lut(), palette_lut.bands(), pixels,
+            );
+        });
+        self.profiler.record("argb_convert", start);
+        if locked.is_ok() {
+            let src = sdl3::rect::Rect::new(0, 0, PLAYFIELD_LORES_W, PLAYFIELD_LORES_H);
+            let dst = sdl3::rect::Rect::new(
+                PLAYFIELD_X, PLAYFIELD_Y, PLAYFIELD_CANVAS_W, PLAYFIELD_CANVAS_H,
+            );
+            let _ = canvas.copy(playfield, src, dst);
         }
-        drop(rgb_buf);
     }
 
-    /// Render the inventory overlay (viewstatus == 1).
+    /// Render the inventory overlay (viewstatus == 4).
     ///
     /// Mirrors `render_inventory_items_page` (fmain.c:3120-3145):
     /// - Each inv_list[] slot is placed at `(xoff + INV_ICON_X_OFFSET, yoff)` in lores coords.
@@ -910,7 +1124,9 @@ impl EcsScene {
             Some(s) => s,
             None => return,
         };
-        let pal = self.res.palette.current_palette;
+        // Colour 31 is the sprite key colour: transparent in the icon textures.
+        let mut lut = crate::game::palette_lut::argb8888_lut(&self.res.palette.current_palette);
+        lut[31] = 0;
 
         for slot in 0..INV_LIST.len() {
             let count = stuff[slot];
@@ -936,18 +1152,10 @@ impl EcsScene {
             let img_height = entry.img_height as usize;
 
             // Build the ARGB pixel buffer once per slot (same icon data for every copy).
-            let mut rgba_buf: Vec<u8> = Vec::with_capacity(SPRITE_W * img_height * 4);
-            for row in img_off..(img_off + img_height).min(OBJ_SPRITE_H) {
-                for col in 0..SPRITE_W {
-                    let idx = frame_pixels[row * SPRITE_W + col];
-                    let transparent = idx == 31;
-                    let color = if transparent { 0u32 } else { pal[(idx & 31) as usize] };
-                    rgba_buf.push((color & 0xFF) as u8);
-                    rgba_buf.push(((color >> 8) & 0xFF) as u8);
-                    rgba_buf.push(((color >> 16) & 0xFF) as u8);
-                    rgba_buf.push(if transparent { 0 } else { 0xFF });
-                }
-            }
+            let row_end = (img_off + img_height).min(OBJ_SPRITE_H).max(img_off);
+            let icon = frame_pixels.get(img_off * SPRITE_W..row_end * SPRITE_W).unwrap_or(&[]);
+            let mut rgba_buf: Vec<u8> = vec![0u8; SPRITE_W * img_height * 4];
+            crate::game::palette_lut::convert(icon, &lut, &mut rgba_buf);
 
             let tc = canvas.texture_creator();
             for copy in 0..copies {
@@ -976,6 +1184,51 @@ impl EcsScene {
         }
     }
 
+    /// Render the Bird Totem overview (viewstatus == 1): one lores pixel
+    /// per tile column and two per tile row, centred on the hero, drawn
+    /// through the playfield texture.
+    fn render_overview(&mut self, canvas: &mut Canvas<Window>, playfield: &mut Texture) {
+        use crate::game::map_view::{bigdraw_into, BIGDRAW_COLS, BIGDRAW_ROWS};
+
+        let Some(world_data) = self.res.map.world.as_ref() else { return };
+        let Ok((hero_x, hero_y)) = self.world
+            .get::<&Position>(self.res.hero_entity)
+            .map(|p| (p.x as u16, p.y as u16))
+        else {
+            return;
+        };
+        self.overview_buf.resize(BIGDRAW_COLS * BIGDRAW_ROWS, 0);
+        bigdraw_into(hero_x, hero_y, world_data, &mut self.overview_buf);
+
+        let overview = &self.overview_buf;
+        let locked = playfield.with_lock(None, |pixels: &mut [u8], pitch: usize| {
+            for (row, line) in overview.chunks_exact(BIGDRAW_COLS).enumerate() {
+                let out = &mut pixels[row * pitch..row * pitch + BIGDRAW_COLS * 4];
+                for (px, &argb) in out.chunks_exact_mut(4).zip(line) {
+                    px.copy_from_slice(&argb.to_ne_bytes());
+                }
+            }
+        });
+        if locked.is_err() {
+            return;
+        }
+        // 70 of the 72 rows fill the playfield at two lores lines per row.
+        let rows = PLAYFIELD_LORES_H / 2;
+        let skip = (BIGDRAW_ROWS as u32 - rows) / 2;
+        let src = sdl3::rect::Rect::new(0, skip as i32, BIGDRAW_COLS as u32, rows);
+        let dst = sdl3::rect::Rect::new(
+            PLAYFIELD_X, PLAYFIELD_Y, PLAYFIELD_CANVAS_W, PLAYFIELD_CANVAS_H,
+        );
+        let _ = canvas.copy(playfield, src, dst);
+
+        // Hero marker on the centre tile.
+        let (cell_w, cell_h) = (PLAYFIELD_CANVAS_W / BIGDRAW_COLS as u32, PLAYFIELD_CANVAS_H / rows);
+        let marker_x = PLAYFIELD_X + (BIGDRAW_COLS as i32 / 2) * cell_w as i32;
+        let marker_y = PLAYFIELD_Y + (BIGDRAW_ROWS as i32 / 2 - skip as i32) * cell_h as i32;
+        canvas.set_draw_color(sdl3::pixels::Color::RGB(255, 255, 255));
+        canvas.fill_rect(sdl3::rect::Rect::new(marker_x, marker_y, cell_w, cell_h)).ok();
+    }
+
     /// Render centered placard overlay for narrative events (viewstatus == 2).
     fn render_placard(&self, canvas: &mut Canvas<Window>, resources: &SceneResources<'_, '_>) {
         use crate::game::ecs::resources::NarrEvent;
@@ -1021,120 +1274,137 @@ impl EcsScene {
         resources: &mut SceneResources<'_, '_>,
     ) {
         // Gather hero stats from the ECS world.
-        let (brave, luck, kind, vitality, wealth) =
+        let stats =
             match self.world.get::<&crate::game::ecs::components::HeroStats>(self.res.hero_entity) {
-                Ok(s) => (s.brave, s.luck, s.kind, s.vitality, s.wealth),
+                Ok(s) => [s.brave, s.luck, s.kind, s.vitality, s.wealth],
                 Err(_) => return,
             };
 
+        // Everything drawn below; the cached texture is repainted only when it
+        // differs from the last paint.  print_options() also refreshes the
+        // menu's click mapping, so it runs every frame either way.
+        let key = HibarKey {
+            stats,
+            buttons:       self.menu.print_options(),
+            messages_rev:  self.messages_rev,
+            compass_arrow: compass_dir_index(self.input.to_direction()),
+            textcolors:    self.res.palette.textcolors,
+        };
+        if self.hibar_key.as_ref() != Some(&key) {
+            self.paint_hibar(canvas, resources, &key);
+            self.hibar_key = Some(key);
+        }
+        canvas.copy(
+            &*resources.hibar,
+            sdl3::rect::Rect::new(0, 0, 640, HIBAR_NATIVE_H),
+            sdl3::rect::Rect::new(0, HIBAR_Y, 640, HIBAR_H),
+        ).ok();
+    }
+
+    /// Repaint the hibar render target from `key`.
+    fn paint_hibar(
+        &self,
+        canvas: &mut Canvas<Window>,
+        resources: &mut SceneResources<'_, '_>,
+        key: &HibarKey,
+    ) {
+        let [brave, luck, kind, vitality, wealth] = key.stats;
+
         // Last 4 messages visible in the scroll area.
         let msg_count = self.messages.len().min(4);
         let msg_start = self.messages.len().saturating_sub(4);
-        let msgs_visible: Vec<&str> = self.messages[msg_start..].iter().map(|s| s.as_str()).collect();
+        let msgs_visible = &self.messages[msg_start..];
 
-        let hiscreen_opt = resources.find_image("hiscreen");
+        let hiscreen_opt = resources
+            .image_name_map
+            .get("hiscreen")
+            .map(|&idx| &resources.image_textures[idx]);
         let amber_font   = resources.amber_font;
         let topaz_font   = resources.topaz_font;
         let compass_normal    = resources.compass_normal;
         let compass_highlight = resources.compass_highlight;
 
-        // Current input direction → compass arrow index.
-        let input_dir = self.input.to_direction();
-        let compass_arrow = compass_dir_index(input_dir);
+        let compass_arrow = key.compass_arrow;
         let compass_regions = &self.res.palette.compass_regions;
+        let textcolors = &key.textcolors;
+        let buttons = &key.buttons;
 
-        // Snapshot textcolors and build button list before entering the closure
-        // (can't borrow self.menu and self.res simultaneously inside the closure).
-        let textcolors = self.res.palette.textcolors;
-        let buttons = self.menu.print_options();
-
-        let tc = canvas.texture_creator();
-        if let Ok(mut hibar_tex) =
-            tc.create_texture_target(sdl3::pixels::PixelFormat::RGBA32, 640, HIBAR_NATIVE_H)
-        {
-            hibar_tex.set_scale_mode(sdl3::render::ScaleMode::Nearest);
-            let _ = canvas.with_texture_canvas(&mut hibar_tex, |hc| {
-                hc.set_draw_color(sdl3::pixels::Color::RGB(0, 0, 0));
-                hc.clear();
+        let _ = canvas.with_texture_canvas(resources.hibar, |hc| {
+            hc.set_draw_color(sdl3::pixels::Color::RGB(0, 0, 0));
+            hc.clear();
 
-                if let Some(hiscreen) = hiscreen_opt {
-                    hiscreen.draw_scaled(hc, sdl3::rect::Rect::new(0, 0, 640, HIBAR_NATIVE_H));
-                } else {
-                    hc.set_draw_color(sdl3::pixels::Color::RGB(80, 60, 20));
-                    hc.fill_rect(sdl3::rect::Rect::new(0, 0, 640, HIBAR_NATIVE_H)).ok();
-                }
+            if let Some(hiscreen) = hiscreen_opt {
+                hiscreen.draw_scaled(hc, sdl3::rect::Rect::new(0, 0, 640, HIBAR_NATIVE_H));
+            } else {
+                hc.set_draw_color(sdl3::pixels::Color::RGB(80, 60, 20));
+                hc.fill_rect(sdl3::rect::Rect::new(0, 0, 640, HIBAR_NATIVE_H)).ok();
+            }
 
-                // Draw menu buttons: 2 columns × 6 rows in the right side
-                // of the HI bar (spec §25.3, _discovery/menu-system.md).
-                // Even slots at x=430, odd at x=482; y = (j/2)*9 + 8 (baseline).
-                // Pixel-perfect: two JAM2 Text() calls per entry —
-                //   1) 6-space background field at (x, y)
-                //   2) 5-char label at (x+4, y) with 4px left margin
-                for btn in &buttons {
-                    let j = btn.display_slot;
-                    let col_x = if j % 2 == 0 { 430 } else { 482 };
-                    let baseline_y = (j / 2) as i32 * 9 + 8;
-
-                    let bg_rgba = textcolors.get(btn.bg_color as usize).copied().unwrap_or(0xFF000000);
-                    let bg = (
-                        ((bg_rgba >> 16) & 0xFF) as u8,
-                        ((bg_rgba >> 8)  & 0xFF) as u8,
-                        (bg_rgba & 0xFF)          as u8,
-                    );
-                    let fg_rgba = textcolors.get(btn.fg_color as usize).copied().unwrap_or(0xFFFFFFFF);
-                    let fg = (
-                        ((fg_rgba >> 16) & 0xFF) as u8,
-                        ((fg_rgba >> 8)  & 0xFF) as u8,
-                        (fg_rgba & 0xFF)          as u8,
-                    );
+            // Draw menu buttons: 2 columns × 6 rows in the right side
+            // of the HI bar (spec §25.3, _discovery/menu-system.md).
+            // Even slots at x=430, odd at x=482; y = (j/2)*9 + 8 (baseline).
+            // Pixel-perfect: two JAM2 Text() calls per entry —
+            //   1) 6-space background field at (x, y)
+            //   2) 5-char label at (x+4, y) with 4px left margin
+            for btn in buttons {
+                let j = btn.display_slot;
+                let col_x = if j % 2 == 0 { 430 } else { 482 };
+                let baseline_y = (j / 2) as i32 * 9 + 8;
+
+                let bg_rgba = textcolors.get(btn.bg_color as usize).copied().unwrap_or(0xFF000000);
+                let bg = (
+                    ((bg_rgba >> 16) & 0xFF) as u8,
+                    ((bg_rgba >> 8)  & 0xFF) as u8,
+                    (bg_rgba & 0xFF)          as u8,
+                );
+                let fg_rgba = textcolors.get(btn.fg_color as usize).copied().unwrap_or(0xFFFFFFFF);
+                let fg = (
+                    ((fg_rgba >> 16) & 0xFF) as u8,
+                    ((fg_rgba >> 8)  & 0xFF) as u8,
+                    (fg_rgba & 0xFF)          as u8,
+                );
 
-                    // Background field: 6 spaces at (x, y) — fills 6×char_w × y_size.
-                    topaz_font.render_string_with_bg("      ", hc, col_x, baseline_y, bg, fg);
-                    // Label text: 5 chars at (x+4, y) — 4px left margin.
-                    topaz_font.render_string_with_bg(&btn.text, hc, col_x + 4, baseline_y, bg, fg);
-                }
+                // Background field: 6 spaces at (x, y) — fills 6×char_w × y_size.
+                topaz_font.render_string_with_bg("      ", hc, col_x, baseline_y, bg, fg);
+                // Label text: 5 chars at (x+4, y) — 4px left margin.
+                topaz_font.render_string_with_bg(&btn.text, hc, col_x + 4, baseline_y, bg, fg);
+            }
 
-                amber_font.set_color_mod(0xAA, 0x55, 0x00);
-                amber_font.render_string(&format!("Brv:{:3}", brave), hc, 14, 52);
-                amber_font.render_string(&format!("Lck:{:3}", luck), hc, 90, 52);
-                amber_font.render_string(&format!("Knd:{:3}", kind), hc, 168, 52);
-                amber_font.render_string(&format!("Vit:{:3}", vitality), hc, 245, 52);
-                amber_font.render_string(&format!("Wlth:{:3}", wealth), hc, 321, 52);
-
-                // Scroll messages (up to 4, bottom-anchored at y=42).
-                for (i, msg) in msgs_visible.iter().enumerate() {
-                    let line_from_bottom = (msg_count - 1 - i) as i32;
-                    let y = 42 - line_from_bottom * 10;
-                    amber_font.render_string(msg, hc, 16, y);
-                }
-                amber_font.set_color_mod(255, 255, 255);
-
-                // Compass.
-                const COMPASS_X: i32 = 567;
-                const COMPASS_SRC_Y: i32 = 15;
-                const COMPASS_SRC_W: u32 = 48;
-                const COMPASS_SRC_H: u32 = 24;
-                let compass_dest = sdl3::rect::Rect::new(COMPASS_X, COMPASS_SRC_Y, COMPASS_SRC_W, COMPASS_SRC_H);
-                if let Some(normal_tex) = compass_normal {
-                    hc.copy(normal_tex, None, compass_dest).ok();
-                }
-                if compass_arrow < compass_regions.len() {
-                    let (rx, ry, rw, rh) = compass_regions[compass_arrow];
-                    if rw > 1 || rh > 1 {
-                        if let Some(hl_tex) = compass_highlight {
-                            let src = sdl3::rect::Rect::new(rx, ry, rw as u32, rh as u32);
-                            let dst = sdl3::rect::Rect::new(COMPASS_X + rx, COMPASS_SRC_Y + ry, rw as u32, rh as u32);
-                            hc.copy(hl_tex, src, dst).ok();
-                        }
+            amber_font.set_color_mod(0xAA, 0x55, 0x00);
+            amber_font.render_string(&format!("Brv:{:3}", brave), hc, 14, 52);
+            amber_font.render_string(&format!("Lck:{:3}", luck), hc, 90, 52);
+            amber_font.render_string(&format!("Knd:{:3}", kind), hc, 168, 52);
+            amber_font.render_string(&format!("Vit:{:3}", vitality), hc, 245, 52);
+            amber_font.render_string(&format!("Wlth:{:3}", wealth), hc, 321, 52);
+
+            // Scroll messages (up to 4, bottom-anchored at y=42).
+            for (i, msg) in msgs_visible.iter().enumerate() {
+                let line_from_bottom = (msg_count - 1 - i) as i32;
+                let y = 42 - line_from_bottom * 10;
+                amber_font.render_string(msg, hc, 16, y);
+            }
+            amber_font.set_color_mod(255, 255, 255);
+
+            // Compass.
+            const COMPASS_X: i32 = 567;
+            const COMPASS_SRC_Y: i32 = 15;
+            const COMPASS_SRC_W: u32 = 48;
+            const COMPASS_SRC_H: u32 = 24;
+            let compass_dest = sdl3::rect::Rect::new(COMPASS_X, COMPASS_SRC_Y, COMPASS_SRC_W, COMPASS_SRC_H);
+            if let Some(normal_tex) = compass_normal {
+                hc.copy(normal_tex, None, compass_dest).ok();
+            }
+            if compass_arrow < compass_regions.len() {
+                let (rx, ry, rw, rh) = compass_regions[compass_arrow];
+                if rw > 1 || rh > 1 {
+                    if let Some(hl_tex) = compass_highlight {
+                        let src = sdl3::rect::Rect::new(rx, ry, rw as u32, rh as u32);
+                        let dst = sdl3::rect::Rect::new(COMPASS_X + rx, COMPASS_SRC_Y + ry, rw as u32, rh as u32);
+                        hc.copy(hl_tex, src, dst).ok();
                     }
                 }
-            });
-            canvas.copy(
-                &hibar_tex,
-                sdl3::rect::Rect::new(0, 0, 640, HIBAR_NATIVE_H),
-                sdl3::rect::Rect::new(0, HIBAR_Y, 640, HIBAR_H),
-            ).ok();
-        }; // semicolon: drops Result<Texture> temporary before tc is dropped
+            }
+        });
     }
 
     /// Read hero Inventory + HeroStats and update MenuState enabled flags.
@@ -1152,48 +1422,58 @@ impl EcsScene {
         self.res.events.clear();
 
         // ── System schedule (mirrors order in systems/mod.rs) ────────────────
-        systems::clock::run(&mut self.world, &mut self.res);
+        timed!(self, "clock", systems::clock::run(&mut self.world, &mut self.res));
 
         // Palette update every 4 ticks or when dirty (SPEC §17.5).
         let daynight = self.res.clock.daynight;
         if (daynight & 3) == 0 || self.res.palette.dirty {
             self.res.palette.dirty = false;
-            if let Some(base) = self.base_colors.clone() {
+            if let Some(base) = &self.base_colors {
                 let lightlevel    = self.res.clock.lightlevel;
                 let light_on      = self.res.clock.light_timer > 0;
                 let secret_active = self.res.region.region_num == 9
                     && self.res.clock.secret_timer > 0;
                 self.res.palette.current_palette = compute_current_palette(
-                    &base, self.res.region.region_num, lightlevel, light_on, secret_active,
+                    &mut self.fade_table, base, self.res.region.region_num,
+                    lightlevel, light_on, secret_active,
                 );
             }
         }
-        systems::input::run(&mut self.world, &mut self.res);
+        timed!(self, "input", systems::input::run(&mut self.world, &mut self.res));
         self.update_menu_options();
         // sleep system not yet ported — skipped
         self.res.input_direction = self.input.to_direction();
         self.res.input_fire      = self.input.fire();
-        systems::movement::run(&mut self.world, &mut self.res);
-        systems::carrier::run(&mut self.world, &mut self.res);
-        systems::collision::run(&self.world, &mut self.res);
-        systems::door::run(&self.world, &mut self.res, game_lib);
-        systems::zone::run(&self.world, &mut self.res);
-        systems::npc_ai::run(&mut self.world, &mut self.res);
-        systems::npc_movement::run(&mut self.world, &mut self.res);
-        systems::combat::run(&mut self.world, &mut self.res);
-        systems::damage::run(&mut self.world, &mut self.res);
-        systems::missile::run(&mut self.world, &mut self.res);
-        systems::encounter::run(&mut self.world, &mut self.res);
-        systems::proximity::run(&self.world, &mut self.res);
-        systems::item::run(&mut self.world, &mut self.res);
-        systems::narrative::run(&mut self.world, &mut self.res);
-        systems::death::run(&mut self.world, &mut self.res);
-        systems::region::run(&mut self.world, &mut self.res, game_lib);
+        timed!(self, "movement", systems::movement::run(&mut self.world, &mut self.res));
+        timed!(self, "carrier", systems::carrier::run(&mut self.world, &mut self.res));
+        timed!(self, "spatial", systems::spatial::run(&self.world, &mut self.res));
+        if self.parallel_systems {
+            timed!(self, "collision+door+zone", self.run_shared_batch());
+        } else {
+            timed!(self, "collision", systems::collision::run(&self.world, &mut self.res));
+            timed!(self, "door", systems::door::run(&self.world, &mut self.res, game_lib));
+            timed!(self, "zone", systems::zone::run(&self.world, &mut self.res));
+        }
+        timed!(self, "npc_ai", systems::npc_ai::run(&mut self.world, &mut self.res));
+        timed!(self, "npc_movement", systems::npc_movement::run(&mut self.world, &mut self.res));
+        timed!(self, "spatial", systems::spatial::run(&self.world, &mut self.res));
+        timed!(self, "combat", systems::combat::run(&mut self.world, &mut self.res));
+        timed!(self, "damage", systems::damage::run(&mut self.world, &mut self.res));
+        timed!(self, "missile", systems::missile::run(&mut self.world, &mut self.res));
+        timed!(self, "encounter", systems::encounter::run(&mut self.world, &mut self.res));
+        timed!(self, "spatial", systems::spatial::run(&self.world, &mut self.res));
+        timed!(self, "proximity", systems::proximity::run(&self.world, &mut self.res));
+        timed!(self, "item", systems::item::run(&mut self.world, &mut self.res));
+        timed!(self, "narrative", systems::narrative::run(&mut self.world, &mut self.res));
+        timed!(self, "death", systems::death::run(&mut self.world, &mut self.res));
+        timed!(self, "region", systems::region::run(&mut self.world, &mut self.res, game_lib));
 
         // Apply any pending region transition (set by RegionSystem above).
         if let Some(ev) = self.res.pending_transition.take() {
-            self.reload_region(ev.new_region, ev.dest_x, ev.dest_y, game_lib);
+            timed!(self, "reload_region",
+                self.reload_region(ev.new_region, ev.dest_x, ev.dest_y, game_lib));
         }
+        timed!(self, "prefetch", self.prefetch_nearby_regions(game_lib));
 
         // ── Debug command dispatch ────────────────────────────────────────────
         if let Some(console) = &mut self.console {
@@ -1202,6 +1482,173 @@ impl EcsScene {
             }
         }
     }
+
+    /// Run collision, door and zone as one hand-written batch: the door and
+    /// zone checks run on the stage worker while collision runs here, then
+    /// the results are applied in `run_tick`'s order, so the tick matches the
+    /// sequential path exactly.  The three only read the World and write
+    /// disjoint `Resources`; the `schedule` tests check that claim against
+    /// the declared access.
+    fn run_shared_batch(&mut self) {
+        if self.stage_worker.is_none() {
+            match Worker::start("stage-worker") {
+                Ok(worker) => self.stage_worker = Some(worker),
+                Err(e) => {
+                    // Run this batch inline and the following ones sequentially.
+                    self.res.diag_log.push(format!("EcsScene: stage worker not started: {e}"));
+                    self.parallel_systems = false;
+                }
+            }
+        }
+        let world = &self.world;
+        let hero = self.res.hero_entity;
+        let spatial = &self.res.spatial;
+        let doors = &self.res.map.doors;
+        let transitioned = &self.res.map.transitioned_doors;
+        let region_num = self.res.region.region_num;
+        let zones = &self.res.zones;
+        let checks = move || {
+            (
+                systems::door::check(world, doors, transitioned, region_num, hero),
+                systems::zone::check(world, zones, hero),
+            )
+        };
+        let collision = || systems::collision::check(world, spatial, hero);
+        let ((door_hit, zone), battleflag) = match &self.stage_worker {
+            Some(worker) => worker.join(checks, collision),
+            None => (checks(), collision()),
+        };
+        if let Some(battleflag) = battleflag {
+            systems::collision::apply(&mut self.res, battleflag);
+        }
+        if let Some(hit) = door_hit {
+            systems::door::apply(&mut self.res, hit);
+        }
+        if let Some(zc) = zone {
+            systems::zone::apply(&mut self.res, zc);
+        }
+    }
+
+    /// Advance one gameplay tick without a window, feeding `direction` and
+    /// `fire` as the player's input.  Loads the world on first use, then runs
+    /// the same tick/drain sequence as `update()`.  Returns the placard or
+    /// game-over result `update()` would have handed to the scene loop.
+    pub fn step_headless(
+        &mut self,
+        game_lib: &GameLibrary,
+        direction: Direction,
+        fire: bool,
+    ) -> Option<SceneResult> {
+        if !self.adf_load_done {
+            self.load_world(game_lib);
+        }
+        for action in std::mem::take(&mut self.pending_menu_actions) {
+            if self.dispatch_menu_action(action, game_lib) {
+                return Some(SceneResult::Quit);
+            }
+        }
+        self.input.set_scripted(direction, fire);
+        self.tick(game_lib)
+    }
+
+    /// One tick as `update()` and `step_headless()` run it: record the input,
+    /// run the schedule, hand out its messages and deaths, then record a
+    /// state hash when one is due.
+    fn tick(&mut self, game_lib: &GameLibrary) -> Option<SceneResult> {
+        let (direction, fire) = (self.input.to_direction(), self.input.fire());
+        self.record(|j| j.tick(direction, fire));
+        self.run_tick(game_lib);
+        self.drain_messages(game_lib);
+        let result = self.drain_brother_deaths(game_lib);
+        if self.journal.as_ref().is_some_and(|j| j.wants_hash()) {
+            let hash = journal::state_hash(self);
+            self.record(|j| j.hash(hash));
+        }
+        result
+    }
+
+    /// Apply a menu or view input, recording it when a journal is open.
+    /// Pointer moves only reach the journal while a menu button is held;
+    /// otherwise they change nothing.
+    pub fn apply_input(&mut self, event: JournalEvent) {
+        if !matches!(event, JournalEvent::MenuHover(_) | JournalEvent::MenuCancel) || self.menu.is_holding() {
+            self.record(|j| j.event(event));
+        }
+        match event {
+            JournalEvent::MenuKey(byte) => {
+                let action = self.menu.handle_key(byte);
+                self.pending_menu_actions.push(action);
+            }
+            JournalEvent::MenuPress(slot) => {
+                self.menu.handle_mouse_down(slot as usize);
+            }
+            JournalEvent::MenuRelease(slot) => {
+                let action = self.menu.handle_mouse_up(slot as usize);
+                if action != MenuAction::None {
+                    self.pending_menu_actions.push(action);
+                }
+            }
+            JournalEvent::MenuHover(slot) => {
+                self.menu.handle_mouse_move_while_held(slot as usize);
+            }
+            JournalEvent::MenuCancel => self.menu.cancel_press(),
+            JournalEvent::DismissView => self.res.view.viewstatus = 0,
+        }
+    }
+
+    /// Record this session's input to `path`, hashing the simulated state
+    /// every `hash_interval` ticks.  Recording starts once the world is
+    /// loaded (now, if it already is).
+    pub fn record_journal(&mut self, path: impl Into<std::path::PathBuf>, hash_interval: u32) {
+        self.journal_request = Some((path.into(), hash_interval));
+        if self.adf_load_done {
+            self.start_journal();
+        }
+    }
+
+    fn start_journal(&mut self) {
+        let Some((path, hash_interval)) = self.journal_request.take() else { return };
+        let save = crate::game::persist::ecs_save_to_bytes(self);
+        // Continue from the state as the journal holds it (positions are
+        // whole pixels in a save), so live and replayed runs start equal.
+        if let Err(e) = self.restore_journal_start(&save) {
+            self.res.diag_log.push(format!("EcsScene: input journal not started: {e:#}"));
+            return;
+        }
+        match JournalWriter::create(&path, &save, hash_interval) {
+            Ok(writer) => {
+                self.journal = Some(writer);
+                self.res.diag_log.push(format!("EcsScene: recording input to {}", path.display()));
+            }
+            Err(e) => self.res.diag_log.push(format!("EcsScene: {e:#}")),
+        }
+    }
+
+    /// Prepare to replay a journal: load the world if needed, then restore
+    /// the journal's starting state.
+    pub fn begin_replay(&mut self, game_lib: &GameLibrary, save: &[u8]) -> anyhow::Result<()> {
+        if !self.adf_load_done {
+            self.load_world(game_lib);
+        }
+        self.restore_journal_start(save)
+    }
+
+    fn restore_journal_start(&mut self, save: &[u8]) -> anyhow::Result<()> {
+        // Loading forces a full redraw (viewstatus 99); play goes on as it was.
+        let viewstatus = self.res.view.viewstatus;
+        crate::game::persist::ecs_load_from_bytes(save, self)?;
+        self.res.view.viewstatus = viewstatus;
+        Ok(())
+    }
+
+    /// Run `write` on the open journal; an I/O error closes it.
+    fn record(&mut self, write: impl FnOnce(&mut JournalWriter) -> std::io::Result<()>) {
+        let Some(writer) = &mut self.journal else { return };
+        if let Err(e) = write(writer) {
+            self.res.diag_log.push(format!("EcsScene: input journal closed: {e}"));
+            self.journal = None;
+        }
+    }
 }
 
 /// Map current game state to a music group index (0–6).
@@ -1227,12 +1674,17 @@ impl EcsScene {
     /// Drain pending SFX events and update the music mood every 4 ticks
     /// (gameloop-113).  Mirrors the audio block in the old `GameplayScene::update`.
     fn run_audio(&mut self, resources: &mut SceneResources<'_, '_>) {
-        // Drain queued SFX events.
+        // Drain queued SFX events (muted in turbo: only the last tick of each
+        // batch would be heard).
+        let sfx_audio = if self.turbo { None } else { resources.audio };
         for ev in self.res.events.sfx.drain(..) {
-            if let Some(audio) = resources.audio {
+            if let Some(audio) = sfx_audio {
                 audio.play_sfx(ev.sfx_id);
             }
         }
+        if let Some(dropped) = resources.audio.and_then(|a| a.take_dropped_commands()) {
+            self.res.diag_log.push(format!("audio: command queue full; {dropped} command(s) dropped"));
+        }
 
         // Evaluate mood every 4 ticks (gameloop-113).
         self.mood_tick += 1;
@@ -1273,8 +1725,8 @@ impl Scene for EcsScene {
         use sdl3::keyboard::Keycode;
         match event {
             Event::KeyDown { keycode: Some(kc), repeat: false, .. } => {
-                if self.res.view.viewstatus == 1 {
-                    self.res.view.viewstatus = 0;
+                if matches!(self.res.view.viewstatus, 1 | 4) {
+                    self.apply_input(JournalEvent::DismissView);
                     return true;
                 }
                 match kc {
@@ -1312,8 +1764,7 @@ impl Scene for EcsScene {
                             }
                         };
                         if let Some(byte) = menu_byte {
-                            let action = self.menu.handle_key(byte);
-                            self.pending_menu_actions.push(action);
+                            self.apply_input(JournalEvent::MenuKey(byte));
                             true
                         } else {
                             false
@@ -1362,8 +1813,8 @@ impl Scene for EcsScene {
             // Gamepad left stick → aggregate into direction.
             Event::ControllerAxisMotion { axis, value, .. } => {
                 // Clear inventory view on any interaction
-                if self.res.view.viewstatus == 1 {
-                    self.res.view.viewstatus = 0;
+                if matches!(self.res.view.viewstatus, 1 | 4) {
+                    self.apply_input(JournalEvent::DismissView);
                     return true;
                 }
                 use sdl3::gamepad::Axis;
@@ -1386,8 +1837,8 @@ impl Scene for EcsScene {
             }
             Event::MouseButtonDown { x, y, mouse_btn, .. } => {
                 // Clear inventory view on any interaction
-                if self.res.view.viewstatus == 1 {
-                    self.res.view.viewstatus = 0;
+                if matches!(self.res.view.viewstatus, 1 | 4) {
+                    self.apply_input(JournalEvent::DismissView);
                     return true;
                 }
                 let nx = *x as i32;
@@ -1408,7 +1859,7 @@ impl Scene for EcsScene {
                     let display_slot = (row as usize) * 2 + col;
                     if display_slot < 12 {
                         // Start tracking press for click-and-hold behavior
-                        self.menu.handle_mouse_down(display_slot);
+                        self.apply_input(JournalEvent::MenuPress(display_slot as u8));
                         return true;
                     }
                 }
@@ -1416,8 +1867,8 @@ impl Scene for EcsScene {
             }
             Event::MouseButtonUp { x, y, mouse_btn, .. } => {
                 // Clear inventory view on any interaction
-                if self.res.view.viewstatus == 1 {
-                    self.res.view.viewstatus = 0;
+                if matches!(self.res.view.viewstatus, 1 | 4) {
+                    self.apply_input(JournalEvent::DismissView);
                     return true;
                 }
                 // Release right-click fire.
@@ -1433,15 +1884,12 @@ impl Scene for EcsScene {
                     let row = (ny - 2) / 9;
                     let display_slot = (row as usize) * 2 + col;
                     if display_slot < 12 {
-                        let action = self.menu.handle_mouse_up(display_slot);
-                        if action != MenuAction::None {
-                            self.pending_menu_actions.push(action);
-                        }
+                        self.apply_input(JournalEvent::MenuRelease(display_slot as u8));
                         return true;
                     }
                 }
                 // Released outside menu region - cancel any pending press
-                self.menu.cancel_press();
+                self.apply_input(JournalEvent::MenuCancel);
                 false
             }
             Event::MouseMotion { x, y, .. } => {
@@ -1453,11 +1901,11 @@ impl Scene for EcsScene {
                     let row = (ny - 2) / 9;
                     let display_slot = (row as usize) * 2 + col;
                     // Let menu handle re-hover logic (re-activate committed slot, cancel if different)
-                    self.menu.handle_mouse_move_while_held(display_slot);
+                    self.apply_input(JournalEvent::MenuHover(display_slot as u8));
                     return true;
                 } else {
                     // Mouse moved completely out of menu region - cancel any press
-                    self.menu.cancel_press();
+                    self.apply_input(JournalEvent::MenuCancel);
                     return true;
                 }
             }
@@ -1473,10 +1921,16 @@ impl Scene for EcsScene {
         game_lib: &GameLibrary,
         resources: &mut SceneResources<'_, '_>,
     ) -> SceneResult {
+        // A batch that ran during the last present() ended the scene.
+        if let Some(result) = self.deferred_result.take() {
+            return result;
+        }
+
         // Drain menu actions queued from handle_event() (runs outside ECS borrow).
         let pending: Vec<MenuAction> = std::mem::take(&mut self.pending_menu_actions);
+        let dispatched = !pending.is_empty();
         for action in pending {
-            if self.dispatch_menu_action(action, game_lib, resources) {
+            if self.dispatch_menu_action(action, game_lib) {
                 return SceneResult::Quit;
             }
         }
@@ -1501,16 +1955,21 @@ impl Scene for EcsScene {
             self.load_world(game_lib);
         }
 
-        // Run gameplay ticks (capped to avoid spiral-of-death).
+        // Run gameplay ticks (capped to avoid spiral-of-death, except in turbo
+        // where the caller hands over a fixed batch per frame).
         // No .max(1) — when delta_ticks is 0 (e.g. at 15 Hz every other 30fps
         // frame), we skip the tick entirely rather than running at double speed.
-        let ticks = delta_ticks.min(4);
-        for _ in 0..ticks {
-            self.run_tick(game_lib);
-            self.drain_messages(game_lib);
-        }
-
-        if let Some(result) = self.drain_brother_deaths(game_lib) {
+        let ticks = if self.turbo { delta_ticks } else { delta_ticks.min(4) };
+        if self.pipelined {
+            // Draw the snapshot the previous batch left; this frame's ticks
+            // run in present(), overlapping the vsync wait.  A frame with no
+            // batch of its own (paused) or with menu actions applied just now
+            // is captured here, as the sequential path would.
+            self.deferred_ticks += ticks;
+            if ticks == 0 || dispatched || !self.snapshot.captured {
+                self.capture_snapshot();
+            }
+        } else if let Some(result) = self.simulate(ticks, game_lib) {
             return result;
         }
 
@@ -1520,11 +1979,15 @@ impl Scene for EcsScene {
         canvas.set_draw_color(sdl3::pixels::Color::RGB(0, 0, 0));
         canvas.clear();
         if self.res.view.viewstatus == 1 {
+            self.render_overview(canvas, resources.playfield);
+        } else if self.res.view.viewstatus == 4 {
             self.render_inventory(canvas);
         } else {
-            self.render_map(canvas);
+            self.render_map(canvas, resources.playfield, resources.gpu_playfield.as_deref_mut());
         }
+        let start = self.profiler.start();
         self.render_hibar(canvas, resources);
+        self.profiler.record("hibar", start);
 
         // Render narrative placard overlay if active.
         if self.res.view.viewstatus == 2 {
@@ -1542,6 +2005,48 @@ impl Scene for EcsScene {
         SceneResult::Continue
     }
 
+    /// In pipelined mode, run the ticks `update()` deferred on the sim worker
+    /// while the main thread blocks in the canvas present.  The drawn frame
+    /// is already on the canvas, so the two share nothing.
+    fn present(&mut self, canvas: &mut Canvas<Window>, game_lib: &GameLibrary) {
+        let ticks = std::mem::take(&mut self.deferred_ticks);
+        let start = self.profiler.start();
+        if !self.pipelined || ticks == 0 {
+            canvas.present();
+            self.profiler.record("present", start);
+            return;
+        }
+        if self.sim_worker.is_none() {
+            match Worker::start("sim-worker") {
+                Ok(worker) => self.sim_worker = Some(worker),
+                Err(e) => self.res.diag_log.push(format!("EcsScene: sim worker not started: {e}")),
+            }
+        }
+        // Taken out for the batch so the job can borrow the whole scene.
+        let Some(worker) = self.sim_worker.take() else {
+            canvas.present();
+            self.profiler.record("present", start);
+            self.deferred_result = self.simulate(ticks, game_lib);
+            return;
+        };
+        let (result, presented) = worker.join(
+            || self.simulate(ticks, game_lib),
+            || {
+                canvas.present();
+                start.map(|t| t.elapsed())
+            },
+        );
+        self.sim_worker = Some(worker);
+        if let Some(elapsed) = presented {
+            self.profiler.record_sample("present", elapsed);
+        }
+        self.deferred_result = result;
+    }
+
+    fn images(&self) -> &'static [&'static str] {
+        IMAGES
+    }
+
     fn as_any(&self) -> &dyn Any {
         self
     }
@@ -1702,11 +2207,60 @@ fn hero_dying_statelist_index(countdown: u8, facing: Direction) -> usize {
     }
 }
 
-/// Blit all visible actors (hero, enemies, setfigs) into the indexed framebuf,
-/// interleaving per-sprite depth masking immediately after each blit.
-/// Must be called after `MapRenderer::compose()` and before palette conversion.
-/// Sprites are Y-sorted (painter's algorithm) before blitting.
-fn blit_actors_inner(
+/// One queued actor draw. Holds a (sheet, frame) reference instead of a copy of
+/// the pixels; the frame is resolved from the loaded sheets at blit time.
+struct PendingDraw {
+    sprite: crate::game::sprite_mask::BlittedSprite,
+    source: FrameSource,
+    frame:  usize,
+    /// Insertion order, used as the Y-sort tiebreak.
+    seq:    u32,
+}
+
+/// What one frame of `render_map` draws, captured at the end of a tick batch.
+#[derive(Default)]
+struct RenderSnapshot {
+    map_x:       u16,
+    map_y:       u16,
+    hero_sector: u16,
+    draws:       ActorDrawList,
+    /// False until the first capture.
+    captured:    bool,
+}
+
+/// Reusable pending-draw list filled by `collect_actor_draws`.
+#[derive(Default)]
+struct ActorDrawList {
+    draws: Vec<PendingDraw>,
+}
+
+impl ActorDrawList {
+    fn clear(&mut self) {
+        self.draws.clear();
+    }
+
+    fn push(&mut self, source: FrameSource, frame: usize, sprite: crate::game::sprite_mask::BlittedSprite) {
+        let seq = self.draws.len() as u32;
+        self.draws.push(PendingDraw { sprite, source, frame, seq });
+    }
+
+    /// Sort back-to-front by ground line, keeping insertion order among equal
+    /// grounds (weapon-behind, body, weapon-on-top). In place, no allocation.
+    fn sort(&mut self) {
+        self.draws.sort_unstable_by_key(|d| (d.sprite.ground, d.seq));
+    }
+
+    /// Draws in blit order, as `(source, frame, sprite)`.
+    fn iter(&self) -> impl Iterator<Item = (FrameSource, usize, &crate::game::sprite_mask::BlittedSprite)> {
+        self.draws.iter().map(|d| (d.source, d.frame, &d.sprite))
+    }
+}
+
+/// Queue all visible actors (hero, enemies, setfigs) into `draws`, Y-sorted
+/// back-to-front (painter's algorithm).  `draws` is a caller-owned scratch
+/// list reused across frames.
+fn collect_actor_draws(
+    draws: &mut ActorDrawList,
     world: &World,
     hero_entity: hecs::Entity,
     sheets: &[Option<crate::game::sprites::SpriteSheet>],
@@ -1714,8 +2268,6 @@ fn blit_actors_inner(
     cycle: usize,
     map_x: u16,
     map_y: u16,
-    hero_sector: u16,
-    renderer: &mut crate::game::map_renderer::MapRenderer,
     hero_dying_countdown: u8,
     encounter_dying: bool,
 ) {
@@ -1731,11 +2283,10 @@ fn blit_actors_inner(
     let fb_w = MAP_DST_W as i32;
     let fb_h = MAP_DST_H as i32;
 
-    // Pending draws: (descriptor, owned pixel data).
-    // Collected from all actor passes, then Y-sorted (ground ascending) before blitting
-    // so that actors further back (lower ground-line Y) render behind closer actors.
-    // Matches the original bubble-sort at fmain.c:2367-2393.
-    let mut pending: Vec<(BlittedSprite, Vec<u8>)> = Vec::new();
+    // Pending draws are collected from all actor passes, then Y-sorted (ground ascending)
+    // before blitting so that actors further back (lower ground-line Y) render behind
+    // closer actors. Matches the original bubble-sort at fmain.c:2367-2393.
+    draws.clear();
 
     // ── Hero ──────────────────────────────────────────────────────────────────
     type HeroQuery<'a> = (
@@ -1750,7 +2301,7 @@ fn blit_actors_inner(
     let mut hero_q = world.query_one::<HeroQuery<'_>>(hero_entity);
     if let Ok((_, pos, facing_c, motion_opt, combat_opt, frust_opt, brother_opt)) = hero_q.get() {
         let cfile_idx: usize = brother_opt.map(|b: &BrotherKind| b.id as usize).unwrap_or(0).min(2);
-        if let Some(Some(ref sheet)) = sheets.get(cfile_idx) {
+        if let Some(Some(_)) = sheets.get(cfile_idx) {
             let (rel_x, rel_y) = actor_rel_pos(pos.x, pos.y, map_x, map_y);
             let environ: i8 = motion_opt.map(|m: &ActorMotion| m.environ).unwrap_or(0);
             let combat_state: Option<&ActorState> = combat_opt.map(|c: &CombatState| &c.state);
@@ -1773,18 +2324,14 @@ fn blit_actors_inner(
                 if rel_x > -(SPRITE_W as i32) && rel_x < fb_w
                     && bub_y > -(bub_rows as i32) && bub_y < fb_h
                 {
-                    if let Some(obj_sheet) = object_sprites {
-                        if let Some(fp) = obj_sheet.frame_pixels(bubble_inum) {
-                            pending.push((BlittedSprite {
-                                screen_x: rel_x,
-                                screen_y: bub_y,
-                                width:    SPRITE_W,
-                                height:   bub_rows,
-                                ground:   rel_y + SPRITE_H as i32,
-                                is_falling: false,
-                            }, fp.to_vec()));
-                        }
-                    }
+                    draws.push(FrameSource::Objects, bubble_inum, BlittedSprite {
+                        screen_x: rel_x,
+                        screen_y: bub_y,
+                        width:    SPRITE_W,
+                        height:   bub_rows,
+                        ground:   rel_y + SPRITE_H as i32,
+                        is_falling: false,
+                    });
                 }
             } else {
                 // Normal actor render with optional environ Y-shift.
@@ -1877,46 +2424,40 @@ fn blit_actors_inner(
                     };
 
                     // Weapon behind body: push weapon first so it renders under the body.
-                    // Uses same ground value — stable sort preserves insertion order.
+                    // Uses same ground value — the sort's `seq` tiebreak preserves insertion order.
                     if draw_weapon && weapon_behind {
                         if let Some(obj_sheet) = object_sprites {
-                            if let Some(wp) = obj_sheet.frame_pixels(wpn_frame) {
-                                pending.push((BlittedSprite {
-                                    screen_x: rel_x + wpn_dx,
-                                    screen_y: draw_y + wpn_dy,
-                                    width:    SPRITE_W,
-                                    height:   obj_sheet.frame_h,
-                                    ground:   rel_y + SPRITE_H as i32,
-                                    is_falling: false,
-                                }, wp.to_vec()));
-                            }
+                            draws.push(FrameSource::Objects, wpn_frame, BlittedSprite {
+                                screen_x: rel_x + wpn_dx,
+                                screen_y: draw_y + wpn_dy,
+                                width:    SPRITE_W,
+                                height:   obj_sheet.frame_h,
+                                ground:   rel_y + SPRITE_H as i32,
+                                is_falling: false,
+                            });
                         }
                     }
 
-                    if let Some(fp) = sheet.frame_pixels(body_frame) {
-                        pending.push((BlittedSprite {
-                            screen_x: rel_x,
-                            screen_y: draw_y,
-                            width:    SPRITE_W,
-                            height:   body_rows,
-                            ground:   rel_y + SPRITE_H as i32,
-                            is_falling: false,
-                        }, fp.to_vec()));
-                    }
+                    draws.push(FrameSource::Cfile(cfile_idx), body_frame, BlittedSprite {
+                        screen_x: rel_x,
+                        screen_y: draw_y,
+                        width:    SPRITE_W,
+                        height:   body_rows,
+                        ground:   rel_y + SPRITE_H as i32,
+                        is_falling: false,
+                    });
 
                     // Weapon on top: push weapon after body so it renders over it.
                     if draw_weapon && !weapon_behind {
                         if let Some(obj_sheet) = object_sprites {
-                            if let Some(wp) = obj_sheet.frame_pixels(wpn_frame) {
-                                pending.push((BlittedSprite {
-                                    screen_x: rel_x + wpn_dx,
-                                    screen_y: draw_y + wpn_dy,
-                                    width:    SPRITE_W,
-                                    height:   obj_sheet.frame_h,
-                                    ground:   rel_y + SPRITE_H as i32,
-                                    is_falling: false,
-                                }, wp.to_vec()));
-                            }
+                            draws.push(FrameSource::Objects, wpn_frame, BlittedSprite {
+                                screen_x: rel_x + wpn_dx,
+                                screen_y: draw_y + wpn_dy,
+                                width:    SPRITE_W,
+                                height:   obj_sheet.frame_h,
+                                ground:   rel_y + SPRITE_H as i32,
+                                is_falling: false,
+                            });
                         }
                     }
                 }
@@ -2001,42 +2542,36 @@ fn blit_actors_inner(
 
         if draw_weapon && weapon_behind {
             if let Some(obj_sheet) = object_sprites {
-                if let Some(wp) = obj_sheet.frame_pixels(wpn_frame) {
-                    pending.push((BlittedSprite {
-                        screen_x: rel_x + wpn_dx,
-                        screen_y: draw_y + wpn_dy,
-                        width:    SPRITE_W,
-                        height:   obj_sheet.frame_h,
-                        ground:   rel_y + SPRITE_H as i32,
-                        is_falling: false,
-                    }, wp.to_vec()));
-                }
+                draws.push(FrameSource::Objects, wpn_frame, BlittedSprite {
+                    screen_x: rel_x + wpn_dx,
+                    screen_y: draw_y + wpn_dy,
+                    width:    SPRITE_W,
+                    height:   obj_sheet.frame_h,
+                    ground:   rel_y + SPRITE_H as i32,
+                    is_falling: false,
+                });
             }
         }
 
-        if let Some(fp) = sheet.frame_pixels(frame) {
-            pending.push((BlittedSprite {
-                screen_x: rel_x,
-                screen_y: draw_y,
-                width:    SPRITE_W,
-                height:   body_rows,
-                ground:   rel_y + SPRITE_H as i32,
-                is_falling: false,
-            }, fp.to_vec()));
-        }
+        draws.push(FrameSource::Cfile(cfile_idx), frame, BlittedSprite {
+            screen_x: rel_x,
+            screen_y: draw_y,
+            width:    SPRITE_W,
+            height:   body_rows,
+            ground:   rel_y + SPRITE_H as i32,
+            is_falling: false,
+        });
 
         if draw_weapon && !weapon_behind {
             if let Some(obj_sheet) = object_sprites {
-                if let Some(wp) = obj_sheet.frame_pixels(wpn_frame) {
-                    pending.push((BlittedSprite {
-                        screen_x: rel_x + wpn_dx,
-                        screen_y: draw_y + wpn_dy,
-                        width:    SPRITE_W,
-                        height:   obj_sheet.frame_h,
-                        ground:   rel_y + SPRITE_H as i32,
-                        is_falling: false,
-                    }, wp.to_vec()));
-                }
+                draws.push(FrameSource::Objects, wpn_frame, BlittedSprite {
+                    screen_x: rel_x + wpn_dx,
+                    screen_y: draw_y + wpn_dy,
+                    width:    SPRITE_W,
+                    height:   obj_sheet.frame_h,
+                    ground:   rel_y + SPRITE_H as i32,
+                    is_falling: false,
+                });
             }
         }
     }
@@ -2048,7 +2583,7 @@ fn blit_actors_inner(
         let k = (obj.ob_id & 0x7f) as usize;
         let Some(entry) = crate::game::sprites::SETFIG_TABLE.get(k) else { continue; };
         let cfile_idx = entry.cfile_entry as usize;
-        let Some(Some(ref sheet)) = sheets.get(cfile_idx) else { continue; };
+        let Some(Some(_)) = sheets.get(cfile_idx) else { continue; };
         let (rel_x, rel_y) = actor_rel_pos(pos.x, pos.y, map_x, map_y);
         if rel_x <= -(SPRITE_W as i32) || rel_x >= fb_w
             || rel_y <= -(SPRITE_H as i32) || rel_y >= fb_h
@@ -2056,16 +2591,14 @@ fn blit_actors_inner(
             continue;
         }
         // Idle pose for this setfig type is SETFIG_TABLE[k].image_base.
-        if let Some(fp) = sheet.frame_pixels(entry.image_base as usize) {
-            pending.push((BlittedSprite {
-                screen_x: rel_x,
-                screen_y: rel_y,
-                width:    SPRITE_W,
-                height:   SPRITE_H,
-                ground:   rel_y + SPRITE_H as i32,
-                is_falling: false,
-            }, fp.to_vec()));
-        }
+        draws.push(FrameSource::Cfile(cfile_idx), entry.image_base as usize, BlittedSprite {
+            screen_x: rel_x,
+            screen_y: rel_y,
+            width:    SPRITE_W,
+            height:   SPRITE_H,
+            ground:   rel_y + SPRITE_H as i32,
+            is_falling: false,
+        });
     }
 
     // ── Good Fairy ────────────────────────────────────────────────────────────
@@ -2080,31 +2613,44 @@ fn blit_actors_inner(
         }
         // OBJECTS sheet frames 100/101 alternating (reference/_discovery/brother-succession.md).
         let frame_inum = 100 + (cycle & 1);
-        if let Some(obj_sheet) = object_sprites {
-            if let Some(fp) = obj_sheet.frame_pixels(frame_inum) {
-                pending.push((BlittedSprite {
-                    screen_x: rel_x,
-                    screen_y: rel_y,
-                    width:    SPRITE_W,
-                    height:   OBJ_SPRITE_H,
-                    ground:   rel_y + OBJ_SPRITE_H as i32,
-                    is_falling: false,
-                }, fp.to_vec()));
-            }
-        }
+        draws.push(FrameSource::Objects, frame_inum, BlittedSprite {
+            screen_x: rel_x,
+            screen_y: rel_y,
+            width:    SPRITE_W,
+            height:   OBJ_SPRITE_H,
+            ground:   rel_y + OBJ_SPRITE_H as i32,
+            is_falling: false,
+        });
     }
 
-    // ── Y-sort, blit, and mask (interleaved per sprite) ───────────────────────
+    // ── Y-sort ────────────────────────────────────────────────────────────────
     // Sort back-to-front by ground-line Y (ascending) — painter's algorithm.
     // Mirrors fmain.c:2367-2393 bubble sort on anim_index[] by Y coordinate.
-    pending.sort_by_key(|(s, _)| s.ground);
+    draws.sort();
+}
+
+/// Blit the queued actors into the indexed framebuf, interleaving per-sprite
+/// depth masking immediately after each blit.
+/// Must be called after `MapRenderer::compose()` and before palette conversion.
+fn blit_actor_draws(
+    draws: &ActorDrawList,
+    sheets: &[Option<crate::game::sprites::SpriteSheet>],
+    object_sprites: Option<&crate::game::sprites::SpriteSheet>,
+    hero_sector: u16,
+    renderer: &mut crate::game::map_renderer::MapRenderer,
+) {
+    let fb_w = MAP_DST_W as i32;
+    let fb_h = MAP_DST_H as i32;
 
     // Blit and mask each sprite in order: closer sprites draw over both the
     // farther sprite's pixels AND any terrain re-stamped by the farther sprite's mask.
     // This matches the original per-actor save_blit → mask_blit → shape_blit loop.
-    for (sprite, pixels) in pending {
-        blit_sprite_to_framebuf(&pixels, sprite.screen_x, sprite.screen_y, sprite.height, &mut renderer.framebuf, fb_w, fb_h);
-        crate::game::sprite_mask::apply_sprite_mask(renderer, &sprite, hero_sector, 0);
+    for draw in &draws.draws {
+        let sheet = draw.source.sheet(sheets, object_sprites);
+        let Some(pixels) = sheet.and_then(|s| s.frame_pixels(draw.frame)) else { continue; };
+        let sprite = &draw.sprite;
+        blit_sprite_to_framebuf(pixels, sprite.screen_x, sprite.screen_y, sprite.height, &mut renderer.framebuf, fb_w, fb_h);
+        crate::game::sprite_mask::apply_sprite_mask(renderer, sprite, hero_sector, 0);
     }
 }
 
@@ -2147,7 +2693,9 @@ fn build_base_colors_palette(
 
 /// Recompute the display palette from base colors + current lighting state.
 /// Mirrors `GameplayScene::compute_current_palette` (SPEC §17.5–17.6).
+/// Faded pages come from `fades`, so each lighting step is faded only once.
 fn compute_current_palette(
+    fades: &mut crate::game::palette_fader::FadeTable,
     base: &crate::game::colors::Palette,
     region_num: u8,
     lightlevel: u16,
@@ -2156,11 +2704,7 @@ fn compute_current_palette(
 ) -> Palette {
     if region_num >= 8 {
         // Indoors: full brightness; jewel tint applied by fade_page.
-        let faded = crate::game::palette_fader::fade_page(100, 100, 100, true, light_on, base);
-        let mut pal = [0xFF808080_u32; PALETTE_SIZE];
-        for (i, entry) in faded.colors.iter().enumerate().take(PALETTE_SIZE) {
-            pal[i] = amiga_color_to_rgba(entry.color);
-        }
+        let mut pal = *fades.get(100, 100, 100, true, light_on, base);
         pal[31] = amiga_color_to_rgba(match (region_num, secret_active) {
             (9, true)  => 0x00f0,
             (9, false) => 0x0445,
@@ -2173,11 +2717,7 @@ fn compute_current_palette(
     let r_pct = (ll - 80 + boost) as i16;
     let g_pct = (ll - 61) as i16;
     let b_pct = (ll - 62) as i16;
-    let faded = crate::game::palette_fader::fade_page(r_pct, g_pct, b_pct, true, light_on, base);
-    let mut out = [0xFF808080_u32; PALETTE_SIZE];
-    for (i, entry) in faded.colors.iter().enumerate().take(PALETTE_SIZE) {
-        out[i] = amiga_color_to_rgba(entry.color);
-    }
+    let mut out = *fades.get(r_pct, g_pct, b_pct, true, light_on, base);
     out[31] = amiga_color_to_rgba(match region_num { 4 => 0x0980, _ => 0x0bdf });
     out
 }
@@ -2203,12 +2743,30 @@ pub fn new_for_test() -> EcsScene {
         adf_load_done: false,
         adf: None,
         base_colors: None,
+        fade_table: crate::game::palette_fader::FadeTable::default(),
         messages: Vec::new(),
+        messages_rev: 0,
+        hibar_key: None,
+        overview_buf: Vec::new(),
         menu: MenuState::new(),
         quit_requested: false,
         pending_menu_actions: Vec::new(),
+        snapshot: RenderSnapshot::default(),
+        next_snapshot: RenderSnapshot::default(),
+        pipelined: false,
+        sim_worker: None,
+        deferred_ticks: 0,
+        deferred_result: None,
+        region_cache: RegionCache::default(),
+        shared: None,
+        profiler: Profiler::default(),
+        parallel_systems: false,
+        stage_worker: None,
+        turbo: false,
         show_start_placard: false,
         first_update: false,
+        journal: None,
+        journal_request: None,
     }
 }
 
@@ -2629,4 +3187,116 @@ mod tests {
             .expect("hero must have CombatState component");
         assert_eq!(cs.weapon, 1, "Dirk (weapon=1) must be equipped at game start");
     }
+
+    // Equal ground lines must keep push order (weapon-behind, body, weapon-on-top),
+    // and the list must keep its buffer across frames.
+    #[test]
+    fn actor_draw_list_sort_is_stable_and_reuses_buffer() {
+        use crate::game::sprite_mask::BlittedSprite;
+        let at = |ground: i32| BlittedSprite {
+            screen_x: 0, screen_y: 0, width: 16, height: 32, ground, is_falling: false,
+        };
+        let mut draws = ActorDrawList::default();
+        for (frame, ground) in [(0, 50), (1, 10), (2, 50), (3, 10), (4, 50)] {
+            draws.push(FrameSource::Objects, frame, at(ground));
+        }
+        draws.sort();
+        let order: Vec<usize> = draws.draws.iter().map(|d| d.frame).collect();
+        assert_eq!(order, vec![1, 3, 0, 2, 4]);
+
+        let cap = draws.draws.capacity();
+        draws.clear();
+        draws.push(FrameSource::Cfile(0), 7, at(0));
+        assert_eq!(draws.draws.capacity(), cap);
+    }
+
+    // The render stage draws the front snapshot while the next batch fills
+    // the back one; each capture flips them.
+    #[test]
+    fn capture_snapshot_flips_front_and_back() {
+        let mut scene = new_for_test();
+        scene.res.camera.map_x = 1000.0;
+        scene.res.camera.map_y = 2000.0;
+        scene.capture_snapshot();
+        assert!(scene.snapshot.captured);
+        assert!(!scene.next_snapshot.captured);
+        assert_eq!((scene.snapshot.map_x, scene.snapshot.map_y), (1000, 2000));
+
+        scene.res.camera.map_x = 1016.0;
+        scene.capture_snapshot();
+        assert_eq!(scene.snapshot.map_x, 1016);
+        assert_eq!(scene.next_snapshot.map_x, 1000);
+    }
+
+    // schedule::SCHEDULE writes down run_tick's stages; it must list them in
+    // the order (and as often) as a tick actually runs them.
+    #[test]
+    fn schedule_table_matches_run_tick() {
+        use crate::game::ecs::schedule::SCHEDULE;
+        let mut scene = new_for_test();
+        let game_lib = load_game_lib();
+        scene.profiler.set_enabled(true);
+        scene.run_tick(&game_lib);
+        // Bookkeeping after the last system, not part of the schedule.
+        let ran: Vec<(&str, u64)> = scene.profiler.summary().iter()
+            .filter(|s| !matches!(s.name, "reload_region" | "prefetch"))
+            .map(|s| (s.name, s.calls))
+            .collect();
+        let mut declared: Vec<(&str, u64)> = Vec::new();
+        for stage in SCHEDULE {
+            match declared.iter_mut().find(|(name, _)| *name == stage.name) {
+                Some((_, calls)) => *calls += 1,
+                None => declared.push((stage.name, 1)),
+            }
+        }
+        assert_eq!(ran, declared);
+    }
+    /// A hero in reach of three enemies; the same every time it is built.
+    fn fight_scene() -> (EcsScene, Vec<hecs::Entity>) {
+        use crate::game::ecs::components::{Facing, HeroStats};
+        let mut scene = new_for_test();
+        scene.adf_load_done = true;
+        let hero = scene.res.hero_entity;
+        scene.world.get::<&mut HeroStats>(hero).unwrap().vitality = 100;
+        scene.world.get::<&mut CombatState>(hero).unwrap().weapon = 1;
+        scene.world.get::<&mut Facing>(hero).unwrap().dir = Direction::E;
+        let enemies = [(106.0, 200.0), (110.0, 196.0), (108.0, 203.0)]
+            .iter()
+            .map(|&(x, y)| spawn_enemy(&mut scene.world, x, y, 1, 0, 40, 0, 0, 3, 0, 0))
+            .collect();
+        (scene, enemies)
+    }
+
+    /// A recorded fight replays with every state hash matching, so the
+    /// combat rolls come from saved state rather than the clock.
+    #[test]
+    fn recorded_fight_replays_bit_exactly() {
+        use crate::game::ecs::components::Health;
+        let game_lib = load_game_lib();
+        let dir = tempfile::tempdir().unwrap();
+        let path = dir.path().join("fight.fjr");
+
+        let (mut live, _) = fight_scene();
+        live.res.rng.seed = 0x1234_5678;
+        live.record_journal(&path, 1);
+        let ticks = 60u64;
+        for tick in 0..ticks {
+            live.step_headless(&game_lib, Direction::E, tick % 16 < 12);
+        }
+        let live_hash = journal::state_hash(&live);
+        live.journal = None;
+
+        let journal = journal::Journal::open(&path).unwrap();
+        let (mut replayed, enemies) = fight_scene();
+        replayed.begin_replay(&game_lib, &journal.save).unwrap();
+        let report = journal::replay(&mut replayed, &game_lib, &journal);
+        assert_eq!(report.divergence, None);
+        assert_eq!((report.ticks, report.checkpoints as u64), (ticks, ticks));
+        assert_eq!(journal::state_hash(&replayed), live_hash);
+
+        let hurt = enemies.iter()
+            .filter(|&&e| replayed.world.get::<&Health>(e).map_or(true, |h| h.vitality < 40))
+            .count();
+        assert!(hurt > 0, "the run should have landed blows");
+    }
 }
@@ -0,0 +1,253 @@
+//! Declared data access for the gameplay tick, for tests only.
+//!
+//! `EcsScene::run_tick` calls its systems in a hand-written order, and its one
+//! concurrent step is hand-written too: `run_shared_batch` runs the door and
+//! zone checks on a helper thread while collision runs on the caller.  Nothing
+//! here drives that.  `SCHEDULE` writes down each stage's components and
+//! `Resources` items, read off the systems' code by hand (nothing checks them
+//! against what a system really touches), and `batches()` groups consecutive
+//! stages that share no data with a writer.  The tests use the two to confirm
+//! that collision, door and zone are the only such group, i.e. that the
+//! hand-written pair gives the same result as the sequential order.  Stages
+//! that take `&mut World` are exclusive and always stand alone.
+
+use std::ops::Range;
+
+/// One component type or `Resources` item a stage can touch.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+#[repr(u8)]
+pub enum Data {
+    // Components.
+    Position,
+    Health,
+    EnemyKind,
+    Inventory,
+    CarrierMount,
+    WorldObj,
+    // Resources.
+    Spatial,
+    Scratch,
+    Battleflag,
+    RegionNum,
+    Xtype,
+    Doors,
+    TransitionedDoors,
+    Zones,
+    EncounterZone,
+    LastSpeech,
+    RegionEvents,
+    ZoneEvents,
+    SpeechEvents,
+}
+
+impl Data {
+    const fn bit(self) -> u64 {
+        1 << self as u8
+    }
+}
+
+const fn mask(data: &[Data]) -> u64 {
+    let mut m = 0;
+    let mut i = 0;
+    while i < data.len() {
+        m |= data[i].bit();
+        i += 1;
+    }
+    m
+}
+
+/// What one stage reads and writes.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct Access {
+    reads: u64,
+    writes: u64,
+    /// Needs `&mut World`; conflicts with everything.
+    exclusive: bool,
+}
+
+impl Access {
+    pub const EXCLUSIVE: Access = Access { reads: 0, writes: 0, exclusive: true };
+
+    /// Read-only World access reading `reads` and writing `writes`.
+    pub const fn shared(reads: &[Data], writes: &[Data]) -> Access {
+        Access { reads: mask(reads), writes: mask(writes), exclusive: false }
+    }
+
+    /// True if the two stages must keep their relative order.
+    pub fn conflicts(&self, other: &Access) -> bool {
+        self.exclusive
+            || other.exclusive
+            || self.writes & (other.reads | other.writes) != 0
+            || other.writes & self.reads != 0
+    }
+}
+
+/// One named stage of the tick.
+#[derive(Debug, Clone, Copy)]
+pub struct Stage {
+    pub name: &'static str,
+    pub access: Access,
+}
+
+const fn exclusive(name: &'static str) -> Stage {
+    Stage { name, access: Access::EXCLUSIVE }
+}
+
+const fn shared(name: &'static str, reads: &[Data], writes: &[Data]) -> Stage {
+    Stage { name, access: Access::shared(reads, writes) }
+}
+
+const SPATIAL: Stage = shared(
+    "spatial",
+    &[Data::Position],
+    &[Data::Spatial],
+);
+
+/// The stages of `EcsScene::run_tick` in execution order (the scene's
+/// `schedule_table_matches_run_tick` test keeps the two in step).
+pub const SCHEDULE: &[Stage] = &[
+    exclusive("clock"),
+    exclusive("input"),
+    exclusive("movement"),
+    exclusive("carrier"),
+    SPATIAL,
+    shared(
+        "collision",
+        &[Data::Position, Data::Health, Data::Spatial],
+        &[Data::Battleflag],
+    ),
+    shared(
+        "door",
+        &[Data::Position, Data::CarrierMount, Data::Inventory, Data::RegionNum, Data::Doors],
+        &[Data::TransitionedDoors, Data::RegionEvents],
+    ),
+    shared(
+        "zone",
+        &[Data::Position, Data::Zones],
+        &[Data::EncounterZone, Data::Xtype, Data::ZoneEvents],
+    ),
+    exclusive("npc_ai"),
+    exclusive("npc_movement"),
+    SPATIAL,
+    exclusive("combat"),
+    exclusive("damage"),
+    exclusive("missile"),
+    exclusive("encounter"),
+    SPATIAL,
+    shared(
+        "proximity",
+        &[Data::Position, Data::EnemyKind, Data::WorldObj, Data::Spatial],
+        &[Data::Scratch, Data::LastSpeech, Data::SpeechEvents],
+    ),
+    exclusive("item"),
+    exclusive("narrative"),
+    exclusive("death"),
+    exclusive("region"),
+];
+
+/// Split `stages` into runs of consecutive, mutually non-conflicting stages.
+pub fn batches(stages: &[Stage]) -> Vec<Range<usize>> {
+    let mut out: Vec<Range<usize>> = Vec::new();
+    for (i, stage) in stages.iter().enumerate() {
+        match out.last_mut() {
+            Some(batch) if stages[batch.clone()].iter().all(|s| !s.access.conflicts(&stage.access)) => {
+                batch.end = i + 1;
+            }
+            _ => out.push(i..i + 1),
+        }
+    }
+    out
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn names(stages: &[Stage], r: &Range<usize>) -> Vec<&'static str> {
+        stages[r.clone()].iter().map(|s| s.name).collect()
+    }
+
+    #[test]
+    fn exclusive_stages_run_alone() {
+        let stages = [
+            shared("a", &[Data::Position], &[]),
+            exclusive("b"),
+            shared("c", &[Data::Position], &[]),
+        ];
+        let b = batches(&stages);
+        assert_eq!(b, vec![0..1, 1..2, 2..3]);
+    }
+
+    #[test]
+    fn writers_split_batches_but_keep_order() {
+        let stages = [
+            shared("reader", &[Data::Spatial], &[]),
+            shared("other_reader", &[Data::Spatial], &[Data::Battleflag]),
+            shared("writer", &[], &[Data::Spatial]),
+            shared("late_reader", &[Data::Spatial], &[]),
+        ];
+        let b = batches(&stages);
+        assert_eq!(b, vec![0..2, 2..3, 3..4]);
+        // Batches cover every stage exactly once, in order.
+        assert_eq!(b.iter().flat_map(|r| r.clone()).collect::<Vec<_>>(), [0, 1, 2, 3]);
+    }
+
+    #[test]
+    fn threaded_shared_checks_match_sequential_runs() {
+        use crate::game::ecs::components::{HeroStats, Inventory};
+        use crate::game::ecs::resources::Resources;
+        use crate::game::ecs::spawn::{spawn_enemy, spawn_hero};
+        use crate::game::ecs::systems::{collision, door, spatial, zone};
+        use crate::game::game_library::ZoneConfig;
+
+        let mut world = hecs::World::new();
+        let stats = HeroStats { vitality: 100, brave: 0, luck: 0, kind: 0,
+                                wealth: 0, hunger: 0, fatigue: 0, gold: 0 };
+        let hero = spawn_hero(&mut world, 1000.0, 1000.0, 0, stats, Inventory::empty());
+        spawn_enemy(&mut world, 1100.0, 1050.0, 1, 0, 20, 0, 0, 3, 5, 0);
+        let fresh = || {
+            let mut res = Resources::new(hero);
+            res.zones = vec![ZoneConfig {
+                label: String::new(), etype: 3,
+                x1: 900, y1: 900, x2: 1200, y2: 1200, v1: 0, v2: 0, v3: 0,
+            }];
+            spatial::run(&world, &mut res);
+            res
+        };
+
+        let mut sequential = fresh();
+        collision::run(&world, &mut sequential);
+        zone::run(&world, &mut sequential);
+
+        let mut threaded = fresh();
+        let (battleflag, zc) = std::thread::scope(|s| {
+            let zc = s.spawn(|| zone::check(&world, &threaded.zones, hero));
+            let battleflag = collision::check(&world, &threaded.spatial, hero);
+            (battleflag, zc.join().unwrap())
+        });
+        let hit = door::check(&world, &threaded.map.doors, &threaded.map.transitioned_doors,
+                              threaded.region.region_num, hero);
+        collision::apply(&mut threaded, battleflag.unwrap());
+        zone::apply(&mut threaded, zc.unwrap());
+        assert!(hit.is_none());
+
+        assert!(sequential.region.battleflag);
+        assert_eq!(threaded.region.battleflag, sequential.region.battleflag);
+        assert_eq!(threaded.region.xtype, sequential.region.xtype);
+        assert_eq!(threaded.encounter.last_zone, sequential.encounter.last_zone);
+        assert_eq!(threaded.encounter.in_encounter_zone, sequential.encounter.in_encounter_zone);
+        assert_eq!(threaded.events.zone.len(), sequential.events.zone.len());
+    }
+
+    #[test]
+    fn collision_door_and_zone_share_a_batch() {
+        let b = batches(SCHEDULE);
+        let grouped: Vec<Vec<&str>> = b
+            .iter()
+            .filter(|r| r.len() > 1)
+            .map(|r| names(SCHEDULE, r))
+            .collect();
+        assert_eq!(grouped, vec![vec!["collision", "door", "zone"]]);
+        assert_eq!(SCHEDULE.len(), 21);
+    }
+}
@@ -1,29 +1,31 @@
 //! CollisionSystem — computes battleflag from entity proximity.
 //! Does NOT perform movement collision (that's in MovementSystem/NpcMovementSystem).
 
-use hecs::World;
-use crate::game::ecs::components::{Enemy, Position, Health};
-use crate::game::ecs::resources::Resources;
+use hecs::{Entity, World};
+use crate::game::ecs::components::{Position, Health};
+use crate::game::ecs::resources::{Resources, SpatialIndex};
 
 /// Distance threshold for battleflag (original: 300px each axis, not Euclidean).
 const BATTLE_RANGE: f32 = 300.0;
 
 pub fn run(world: &World, res: &mut Resources) {
-    let hero_pos = match world.get::<&Position>(res.hero_entity) {
-        Ok(p) => *p,
-        Err(_) => return,
-    };
+    if let Some(battleflag) = check(world, &res.spatial, res.hero_entity) {
+        apply(res, battleflag);
+    }
+}
 
-    let battleflag = world
-        .query::<(&Position, &Health)>()
-        .with::<&Enemy>()
-        .iter()
-        .any(|(pos, health)| {
-            !health.is_dead()
-                && (pos.x - hero_pos.x).abs() < BATTLE_RANGE
-                && (pos.y - hero_pos.y).abs() < BATTLE_RANGE
-        });
+/// Read-only half of `run`: the new battleflag, or `None` without a hero.
+/// Safe to call alongside the other shared stages (see `schedule`).
+pub fn check(world: &World, spatial: &SpatialIndex, hero: Entity) -> Option<bool> {
+    let hero_pos = world.get::<&Position>(hero).ok().map(|p| *p)?;
+    Some(spatial.any_in_box(hero_pos.x, hero_pos.y, BATTLE_RANGE, BATTLE_RANGE, |e| {
+        (e.x - hero_pos.x).abs() < BATTLE_RANGE
+            && (e.y - hero_pos.y).abs() < BATTLE_RANGE
+            && world.get::<&Health>(e.entity).map_or(false, |health| !health.is_dead())
+    }))
+}
 
+pub fn apply(res: &mut Resources, battleflag: bool) {
     res.region.battleflag = battleflag;
 }
 
@@ -33,6 +35,7 @@ mod tests {
     use crate::game::ecs::components::*;
     use crate::game::ecs::resources::Resources;
     use crate::game::ecs::spawn::*;
+    use crate::game::ecs::systems::spatial;
     use super::run;
 
     fn hero_stats() -> HeroStats {
@@ -47,6 +50,7 @@ mod tests {
         let mut res = Resources::new(hero);
         // Enemy within 300px
         spawn_enemy(&mut world, 150.0, 150.0, 1, 0, 20, 0, 0, 3, 5, 0);
+        spatial::run(&world, &mut res);
         run(&world, &mut res);
         assert!(res.region.battleflag);
     }
@@ -57,6 +61,7 @@ mod tests {
         let hero = spawn_hero(&mut world, 100.0, 100.0, 0, hero_stats(), Inventory::empty());
         let mut res = Resources::new(hero);
         res.region.battleflag = true;
+        spatial::run(&world, &mut res);
         run(&world, &mut res);
         assert!(!res.region.battleflag);
     }
@@ -68,6 +73,7 @@ mod tests {
         let mut res = Resources::new(hero);
         // Enemy > 300px away
         spawn_enemy(&mut world, 500.0, 500.0, 1, 0, 20, 0, 0, 3, 5, 0);
+        spatial::run(&world, &mut res);
         run(&world, &mut res);
         assert!(!res.region.battleflag);
     }
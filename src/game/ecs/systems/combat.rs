@@ -10,7 +10,7 @@ use crate::game::ecs::components::{
 use crate::game::npc::NpcState;
 use crate::game::ecs::events::{DamageEvent, SpeechEvent};
 use crate::game::actor::ActorState;
-use crate::game::combat::{weapon_tip, combat_reach, bitrand};
+use crate::game::combat::{weapon_tip, combat_reach};
 
 pub fn run(world: &mut World, res: &mut Resources) {
     if res.clock.freeze_timer > 0 {
@@ -34,7 +34,7 @@ pub fn run(world: &mut World, res: &mut Resources) {
 
         // fmain.c:2245 — touch attack (code >= 8) clamps wt to 5 before computing strike distance.
         let wt = if weapon_code >= 8 { 5i16 } else { weapon_code as i16 };
-        let (sx_i, sy_i) = weapon_tip(hx as i32, hy as i32, hfacing, wt);
+        let (sx_i, sy_i) = weapon_tip(hx as i32, hy as i32, hfacing, wt, &mut res.rng);
         let (sx, sy) = (sx_i as f32, sy_i as f32);
         let reach = combat_reach(true, brave, res.clock.tick_counter);
 
@@ -81,9 +81,9 @@ pub fn run(world: &mut World, res: &mut Resources) {
 
             // Touch attack (code >= 8): clamp wt to 5 before the bonus (fmain.c:2244).
             let amount = if weapon_code >= 8 {
-                5 + bitrand(2) as i16
+                5 + res.rng.bits(2) as i16
             } else {
-                weapon_code as i16 + bitrand(2) as i16
+                weapon_code as i16 + res.rng.bits(2) as i16
             };
 
             res.events.damage.push(DamageEvent {
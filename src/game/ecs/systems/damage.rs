@@ -10,10 +10,13 @@ use crate::game::npc::NpcState;
 /// Drain `res.events.damage`, reduce target vitality, and trigger death when
 /// vitality reaches zero or below.
 pub fn run(world: &mut World, res: &mut Resources) {
-    let events: Vec<DamageEvent> = res.events.damage.drain(..).collect();
-    for ev in events {
+    // Swap the queue with the scratch buffer so both keep their capacity.
+    let mut events = std::mem::take(&mut res.scratch.damage);
+    std::mem::swap(&mut events, &mut res.events.damage);
+    for ev in events.drain(..) {
         apply_damage(world, res, ev);
     }
+    res.scratch.damage = events;
 }
 
 fn apply_damage(world: &mut World, res: &mut Resources, ev: DamageEvent) {
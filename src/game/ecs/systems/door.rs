@@ -2,48 +2,69 @@
 //! Port of door bump/walk-through logic from gameplay_scene (input.rs lines 460–511).
 //! See docs/spec/doors-buildings.md.
 
-use hecs::World;
+use std::collections::HashSet;
+use hecs::{Entity, World};
+use crate::game::doors::DoorEntry;
 use crate::game::ecs::components::{CarrierMount, Inventory, Position};
+use crate::game::ecs::events::RegionTransitionEvent;
 use crate::game::ecs::resources::Resources;
 
 pub fn run(world: &World, res: &mut Resources, _game_lib: &crate::game::game_library::GameLibrary) {
+    let hit = check(
+        world,
+        &res.map.doors,
+        &res.map.transitioned_doors,
+        res.region.region_num,
+        res.hero_entity,
+    );
+    if let Some(hit) = hit {
+        apply(res, hit);
+    }
+}
+
+pub fn apply(res: &mut Resources, (idx, ev): (usize, RegionTransitionEvent)) {
+    res.map.transitioned_doors.insert(idx);
+    res.events.region.push(ev);
+}
+
+/// Read-only half of `run`: the index of the door the hero walked through and
+/// the transition it triggers, if any.  Safe to call alongside the other
+/// shared stages (see `schedule`).
+pub fn check(
+    world: &World,
+    doors: &[DoorEntry],
+    transitioned_doors: &HashSet<usize>,
+    region_num: u8,
+    hero: Entity,
+) -> Option<(usize, RegionTransitionEvent)> {
     // fmain.c:1859 — no door use while mounted on a carrier (raft/turtle/swan/dragon).
-    if let Ok(mount) = world.get::<&CarrierMount>(res.hero_entity) {
+    if let Ok(mount) = world.get::<&CarrierMount>(hero) {
         if mount.riding != 0 {
-            return;
+            return None;
         }
     }
 
     // 1. Get hero position
-    let hero_pos = match world.get::<&Position>(res.hero_entity) {
-        Ok(p) => *p,
-        Err(_) => return,
-    };
+    let hero_pos = world.get::<&Position>(hero).ok().map(|p| *p)?;
     let hero_x = hero_pos.x as u16;
     let hero_y = hero_pos.y as u16;
 
-    // 2. Choose doorfind_binary() vs doorfind_exit() based on res.region.region_num
-    let region_num = res.region.region_num;
-    let hit = if region_num < 8 {
+    // 2. Choose doorfind_binary() vs doorfind_exit() based on region_num
+    let door = if region_num < 8 {
         // outdoor: binary search by source coords (doorlist sorted by src_x)
-        crate::game::doors::doorfind_binary(&res.map.doors, region_num, hero_x, hero_y)
+        crate::game::doors::doorfind_binary(doors, region_num, hero_x, hero_y)
     } else {
         // indoor: find by destination coords (exit)
-        crate::game::doors::doorfind_exit(&res.map.doors, hero_x, hero_y)
-    };
-
-    let door = match hit {
-        Some(d) => d,
-        None => return,
-    };
+        crate::game::doors::doorfind_exit(doors, hero_x, hero_y)
+    }?;
 
     // fmain.c:1881 — DESERT oasis gates require 5 gold statues (stuff[25] >= 5).
     if door.door_type == crate::game::doors::DESERT {
-        let has_statues = world.get::<&Inventory>(res.hero_entity)
+        let has_statues = world.get::<&Inventory>(hero)
             .map(|inv| inv.stuff[25] >= 5)
             .unwrap_or(false);
         if !has_statues {
-            return;
+            return None;
         }
     }
 
@@ -54,27 +75,23 @@ pub fn run(world: &World, res: &mut Resources, _game_lib: &crate::game::game_lib
     // doorfind_exit already applies its own guard for the indoor-exit path.
     if region_num < 8 {
         if door.door_type & 1 != 0 {
-            if hero_y & 0x10 != 0 { return; }
+            if hero_y & 0x10 != 0 { return None; }
         } else if hero_x & 15 > 6 {
-            return;
+            return None;
         }
     }
 
-    // 3. Find the index of this door in res.map.doors to deduplicate
-    let idx = match res.map.doors.iter().position(|d| {
+    // 3. Find the index of this door in the door table to deduplicate
+    let idx = doors.iter().position(|d| {
         d.src_region == door.src_region
             && d.src_x == door.src_x
             && d.src_y == door.src_y
-    }) {
-        Some(i) => i,
-        None => return,
-    };
+    })?;
 
-    // 4. Skip if transition already emitted for this door
-    if res.map.transitioned_doors.contains(&idx) {
-        return;
+    // 4. Skip if transition already emitted for this door (run() records it)
+    if transitioned_doors.contains(&idx) {
+        return None;
     }
-    res.map.transitioned_doors.insert(idx);
 
     // 5. Compute spawn position and destination region.
     // Entering (outdoor→indoor): spawn at dst coords, go to dst_region.
@@ -87,12 +104,12 @@ pub fn run(world: &World, res: &mut Resources, _game_lib: &crate::game::game_lib
         (door.src_region, x, y)
     };
 
-    // 6. Emit region transition event
-    res.events.region.push(crate::game::ecs::events::RegionTransitionEvent {
+    // 6. Region transition event for run() to emit
+    Some((idx, RegionTransitionEvent {
         new_region,
         dest_x: spawn_x as f32,
         dest_y: spawn_y as f32,
-    });
+    }))
 }
 
 #[cfg(test)]
@@ -125,7 +125,7 @@ fn handle_search(world: &mut World, res: &mut Resources, entity: hecs::Entity) {
             }
             // Bow (code 4): also grant a random arrow bundle (rand8()+2 = 2..9).
             if weapon == 4 {
-                let arrows = crate::game::combat::bitrand(7) as u8 + 2;
+                let arrows = res.rng.bits(7) as u8 + 2;
                 if let Ok(mut inv) = world.get::<&mut Inventory>(res.hero_entity) {
                     inv.stuff[8] = inv.stuff[8].saturating_add(arrows);
                 }
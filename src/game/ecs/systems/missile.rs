@@ -3,10 +3,10 @@
 //! See docs/spec/combat.md.
 
 use hecs::World;
-use crate::game::ecs::components::{Missile, MissileMotion, MissileKind, Position, Enemy};
+use crate::game::ecs::components::{Missile, MissileMotion, MissileKind, Position};
 use crate::game::ecs::resources::Resources;
 use crate::game::ecs::events::DamageEvent;
-use crate::game::combat::{MissileType, melee_rand};
+use crate::game::combat::MissileType;
 
 /// Maximum missile flight time in ticks (fmain.c: missile dies after 40 ticks).
 const MAX_FLIGHT_TICKS: u8 = 40;
@@ -15,26 +15,18 @@ const WORLD_MAX: i32 = 32768;
 
 pub fn run(world: &mut World, res: &mut Resources) {
     // Collect all missile entities first to avoid borrow conflicts.
-    let missiles: Vec<hecs::Entity> = world
-        .query::<(hecs::Entity, &Missile)>()
-        .iter()
-        .map(|(e, _)| e)
-        .collect();
+    let missiles = &mut res.scratch.entities;
+    missiles.clear();
+    missiles.extend(world.query::<(hecs::Entity, &Missile)>().iter().map(|(e, _)| e));
 
     // Snapshot hero position.
     let hero_pos = world.get::<&Position>(res.hero_entity).ok().map(|p| *p);
 
-    // Snapshot enemy positions for hit detection.
-    let enemies: Vec<(hecs::Entity, Position)> = world
-        .query::<(hecs::Entity, &Position)>()
-        .with::<&Enemy>()
-        .iter()
-        .map(|(e, p)| (e, *p))
-        .collect();
+    // Expired and spent missiles are despawned after the loop.
+    let scratch = &mut res.scratch;
+    let to_despawn = &mut scratch.commands;
 
-    let mut to_despawn: Vec<hecs::Entity> = Vec::new();
-
-    for entity in missiles {
+    for &entity in &scratch.entities {
         // Read current missile state.
         let (motion, kind, pos) = {
             let mut q = world.query_one::<(&MissileMotion, &MissileKind, &Position)>(entity);
@@ -46,7 +38,7 @@ pub fn run(world: &mut World, res: &mut Resources) {
 
         // Age expiry: missile dies after 40 ticks (fmain.c:2274).
         if motion.time_of_flight > MAX_FLIGHT_TICKS {
-            to_despawn.push(entity);
+            to_despawn.despawn(entity);
             continue;
         }
 
@@ -59,7 +51,7 @@ pub fn run(world: &mut World, res: &mut Resources) {
         let ix = new_x as i32;
         let iy = new_y as i32;
         if ix < 0 || ix > WORLD_MAX || iy < 0 || iy > WORLD_MAX {
-            to_despawn.push(entity);
+            to_despawn.despawn(entity);
             continue;
         }
 
@@ -79,19 +71,22 @@ pub fn run(world: &mut World, res: &mut Resources) {
         };
 
         if kind.is_friendly {
-            // Friendly missile: check hits on enemies.
-            for (enemy_ent, enemy_pos) in &enemies {
-                let dx = (new_x - enemy_pos.x).abs() as i32;
-                let dy = (new_y - enemy_pos.y).abs() as i32;
+            // Friendly missile: check hits on enemies near the new position.
+            let r = radius as f32;
+            res.spatial.query_box(new_x, new_y, r, r, &mut scratch.near);
+            for &i in &scratch.near {
+                let enemy = res.spatial.entries()[i];
+                let dx = (new_x - enemy.x).abs() as i32;
+                let dy = (new_y - enemy.y).abs() as i32;
                 if dx.max(dy) < radius {
-                    let damage = (melee_rand(8) as i16) + 4;
+                    let damage = (res.rng.below(8) as i16) + 4;
                     res.events.damage.push(DamageEvent {
-                        target: *enemy_ent,
+                        target: enemy.entity,
                         amount: damage,
                         weapon: 0,
                         is_friendly_fire: false,
                     });
-                    to_despawn.push(entity);
+                    to_despawn.despawn(entity);
                     break;
                 }
             }
@@ -100,22 +95,20 @@ pub fn run(world: &mut World, res: &mut Resources) {
             let dx = (new_x - hpos.x).abs() as i32;
             let dy = (new_y - hpos.y).abs() as i32;
             if dx.max(dy) < radius {
-                let damage = (melee_rand(8) as i16) + 4;
+                let damage = (res.rng.below(8) as i16) + 4;
                 res.events.damage.push(DamageEvent {
                     target: res.hero_entity,
                     amount: damage,
                     weapon: 0,
                     is_friendly_fire: false,
                 });
-                to_despawn.push(entity);
+                to_despawn.despawn(entity);
             }
         }
     }
 
     // Despawn expired/hit missiles.
-    for entity in to_despawn {
-        let _ = world.despawn(entity);
-    }
+    res.scratch.commands.run_on(world);
 }
 
 #[cfg(test)]
@@ -125,6 +118,7 @@ mod tests {
     use crate::game::ecs::resources::Resources;
     use crate::game::ecs::spawn::{spawn_hero, spawn_enemy, spawn_missile};
     use crate::game::combat::MissileType;
+    use crate::game::ecs::systems::spatial;
     use super::run;
 
     fn hero_stats() -> HeroStats {
@@ -175,6 +169,7 @@ mod tests {
         // Place enemy at 108, 100 so dist = 4 < 6 → hit.
         let enemy = spawn_enemy(&mut world, 108.0, 100.0, 1, 0, 50, 0, 0, 3, 0, 0);
         let m = spawn_missile(&mut world, 100.0, 100.0, 4.0, 0.0, 0, MissileType::Arrow, true);
+        spatial::run(&world, &mut res);
         run(&mut world, &mut res);
         assert!(!res.events.damage.is_empty(), "Friendly missile should hit enemy");
         assert_eq!(res.events.damage[0].target, enemy);
@@ -1,7 +1,9 @@
 //! Gameplay systems. Each module contains one `pub fn run(...)`.
-//! Execution order: clock → input → sleep → movement → carrier →
-//! collision → door → zone → npc_ai → npc_movement → combat →
-//! missile → encounter → proximity → item → narrative → death → region.
+//! Execution order: clock → input → sleep → movement → carrier → spatial →
+//! collision → door → zone → npc_ai → npc_movement → spatial → combat →
+//! missile → encounter → spatial → proximity → item → narrative → death → region.
+//! Each stage's data access is written down in `ecs::schedule` (checked by
+//! tests only); keep both in sync.
 
 pub mod clock;
 pub mod input;
@@ -21,4 +23,5 @@ pub mod item;
 pub mod narrative;
 pub mod death;
 pub mod region;
+pub mod spatial;
 pub mod render;
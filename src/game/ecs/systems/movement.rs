@@ -52,7 +52,7 @@ pub fn run(world: &mut World, res: &mut Resources) {
     // Sample terrain at CURRENT position — used by update_environ every tick
     // (fmain.c:1741 / still_step, fmain.c:1636 / walk_step both read j here).
     let j_current = map_ref.map(|w| {
-        crate::game::collision::px_to_terrain_type(w, old_x as i32, old_y as i32)
+        crate::game::collision::terrain_at(w, old_x as i32, old_y as i32)
     }).unwrap_or(0);
 
     let dir = res.input_direction;
@@ -91,24 +91,24 @@ pub fn run(world: &mut World, res: &mut Resources) {
 
     // Collect positions of solid NPCs: living enemies and all stationary SetFig characters.
     // Queried once per tick and passed into the probe closure to avoid re-borrowing world.
-    let npc_positions: Vec<(f32, f32)> = {
-        let mut v: Vec<(f32, f32)> = world
+    let npc_positions = &mut res.scratch.points;
+    npc_positions.clear();
+    npc_positions.extend(
+        world
             .query::<(&Position, &Health)>()
             .with::<&Enemy>()
             .iter()
             .filter_map(|(pos, hp)| {
                 if hp.vitality > 0 { Some((pos.x, pos.y)) } else { None }
-            })
-            .collect();
-        v.extend(
-            world
-                .query::<&Position>()
-                .with::<&SetFig>()
-                .iter()
-                .map(|pos| (pos.x, pos.y)),
-        );
-        v
-    };
+            }),
+    );
+    npc_positions.extend(
+        world
+            .query::<&Position>()
+            .with::<&SetFig>()
+            .iter()
+            .map(|pos| (pos.x, pos.y)),
+    );
 
     // Diagonal input: try primary direction, then CW deviate (+1), then CCW (-1).
     //   NW blocked → try N or W; produces wall-sliding along the free axis.
@@ -134,7 +134,7 @@ pub fn run(world: &mut World, res: &mut Resources) {
             // terrain is drier, decrement k by 1 and skip the position commit entirely.
             // update_environ is also skipped this tick ("goto raise" in the original).
             let j_dest = map_ref.map(|w| {
-                crate::game::collision::px_to_terrain_type(w, new_x as i32, new_y as i32)
+                crate::game::collision::terrain_at(w, new_x as i32, new_y as i32)
             }).unwrap_or(0);
             let ramp_out = environ > 2 && (
                 j_dest == 0
@@ -198,9 +198,9 @@ pub fn run(world: &mut World, res: &mut Resources) {
             let (px, py) = step_pos(old_x, old_y, dir, speed);
             let door_probe = map_ref.and_then(|w| {
                 let cx = px as i32; let cy = py as i32;
-                if crate::game::collision::px_to_terrain_type(w, cx, cy) == 15 { Some((cx, cy)) }
-                else if crate::game::collision::px_to_terrain_type(w, cx + 4, cy + 2) == 15 { Some((cx + 4, cy + 2)) }
-                else if crate::game::collision::px_to_terrain_type(w, cx - 4, cy + 2) == 15 { Some((cx - 4, cy + 2)) }
+                if crate::game::collision::terrain_at(w, cx, cy) == 15 { Some((cx, cy)) }
+                else if crate::game::collision::terrain_at(w, cx + 4, cy + 2) == 15 { Some((cx + 4, cy + 2)) }
+                else if crate::game::collision::terrain_at(w, cx - 4, cy + 2) == 15 { Some((cx - 4, cy + 2)) }
                 else { None }
             });
             if let Some((dpx, dpy)) = door_probe {
@@ -2,13 +2,12 @@
 //! Port of update_actors() AI pass and tick_npc() from gameplay_scene/actors.rs
 //! and game/npc_ai.rs.
 //!
-//! This system writes AiState and Facing for each enemy.
+//! This system writes AiState and Facing for each enemy, working on the
+//! `ActorKinematics` columns rather than per-entity lookups.
 //! It does NOT write Position (that is NpcMovementSystem's job).
 
 use hecs::{Entity, World};
-use crate::game::ecs::components::{
-    Enemy, ArenaDummy, Position, Facing, AiState, EnemyKind, Health, HeroStats, Loot,
-};
+use crate::game::ecs::components::{Enemy, Position, AiState, HeroStats};
 use crate::game::ecs::resources::Resources;
 use crate::game::actor::Goal;
 use crate::game::npc::NpcState;
@@ -30,14 +29,6 @@ pub fn run(world: &mut World, res: &mut Resources) {
     let xtype = res.region.xtype;
     let turtle_eggs = false; // SPEC-GAP: not yet tracked in Resources
 
-    // Snapshot enemy positions for follow/evade targeting (Entity, x, y).
-    let positions: Vec<(Entity, f32, f32)> = world
-        .query::<(Entity, &Position)>()
-        .with::<&Enemy>()
-        .iter()
-        .map(|(e, p)| (e, p.x, p.y))
-        .collect();
-
     // Find leader entity: first active hostile.
     let leader_entity: Option<Entity> = {
         let mut found = None;
@@ -52,83 +43,65 @@ pub fn run(world: &mut World, res: &mut Resources) {
         found
     };
 
-    // Collect entities to tick (avoid mid-loop borrow conflicts).
-    let enemies: Vec<Entity> = world
-        .query::<(Entity, &AiState)>()
-        .with::<&Enemy>()
-        .without::<&ArenaDummy>()
-        .iter()
-        .map(|(e, _)| e)
-        .collect();
-
-    for entity in enemies {
-        // Read race, state, health, and weapon without holding a borrow.
-        let (race, state, vitality, weapon) = {
-            let mut q = world.query_one::<(&EnemyKind, &AiState, &Health, &Loot)>(entity);
-            match q.get() {
-                Ok((k, ai, health, loot)) => {
-                    (k.race, ai.state.clone(), health.vitality, loot.weapon)
-                }
-                Err(_) => continue,
-            }
-        };
+    // The AI pass moves nobody, so the leader's position holds for the whole pass.
+    let leader_xy = leader_entity
+        .and_then(|le| world.get::<&Position>(le).ok().map(|p| (p.x, p.y)));
+
+    let kin = &mut res.scratch.kinematics;
+    kin.gather(world);
+
+    for i in 0..kin.len() {
+        let entity = kin.entity[i];
+        let race = kin.race[i];
 
-        if matches!(state, NpcState::Dead | NpcState::Dying | NpcState::Sinking) { continue; }
+        if matches!(kin.ai[i].state, NpcState::Dead | NpcState::Dying | NpcState::Sinking) { continue; }
 
         // Freeze gate: hostile NPCs (race < 7) skip AI when frozen.
         if freeze && race < 7 { continue; }
         // SETFIG races (>= 0x80) skip the goal FSM entirely.
         if race >= 0x80 { continue; }
 
-        let pos = match world.get::<&Position>(entity) {
-            Ok(p) => *p,
-            Err(_) => continue,
-        };
-
-        // Build position list of other enemies (for flocking/evade).
-        let others: Vec<(f32, f32)> = positions
-            .iter()
-            .filter(|(e, _, _)| *e != entity)
-            .map(|(_, x, y)| (*x, *y))
-            .collect();
+        // Other enemies for flocking/evade; do_tactic reads at most the
+        // first two, in spawn (query) order.
+        let mut others = [(0.0, 0.0); 2];
+        let mut n_others = 0;
+        for e in res.spatial.entries().iter().filter(|e| e.entity != entity).take(2) {
+            others[n_others] = (e.x, e.y);
+            n_others += 1;
+        }
 
         let is_leader = leader_entity == Some(entity);
-        let leader_pos = leader_entity
-            .filter(|&le| le != entity)
-            .and_then(|le| world.get::<&Position>(le).ok().map(|p| (p.x, p.y)));
-
-        // Get mutable references and run the AI tick.
-        if let (Ok(mut ai), Ok(mut facing)) = (
-            world.get::<&mut AiState>(entity),
-            world.get::<&mut Facing>(entity),
-        ) {
-            tick_npc_ecs(
-                &mut ai,
-                &mut facing,
-                pos.x, pos.y,
-                hero_pos.x, hero_pos.y,
-                hero_dead,
-                is_leader,
-                leader_pos,
-                &others,
-                tick,
-                xtype,
-                turtle_eggs,
-                freeze,
-                vitality,
-                weapon,
-                race,
-            );
-
-            // Advance fight-animation substate via trans_list (fmain.c:1712).
-            if matches!(ai.state, NpcState::Fighting) {
-                let s = ai.fight_substate as usize;
-                ai.fight_substate = TRANS_LIST[s][rand4(tick)];
-            } else {
-                ai.fight_substate = 0;
-            }
+        let leader_pos = leader_xy.filter(|_| !is_leader);
+
+        let ai = &mut kin.ai[i];
+        tick_npc_ecs(
+            ai,
+            &mut kin.facing[i],
+            kin.x[i], kin.y[i],
+            hero_pos.x, hero_pos.y,
+            hero_dead,
+            is_leader,
+            leader_pos,
+            &others[..n_others],
+            tick,
+            xtype,
+            turtle_eggs,
+            freeze,
+            kin.vitality[i],
+            kin.weapon[i],
+            race,
+        );
+
+        // Advance fight-animation substate via trans_list (fmain.c:1712).
+        if matches!(ai.state, NpcState::Fighting) {
+            let s = ai.fight_substate as usize;
+            ai.fight_substate = TRANS_LIST[s][rand4(tick)];
+        } else {
+            ai.fight_substate = 0;
         }
     }
+
+    kin.scatter(world);
 }
 
 #[cfg(test)]
@@ -138,6 +111,7 @@ mod tests {
     use crate::game::ecs::components::*;
     use crate::game::ecs::resources::Resources;
     use crate::game::ecs::spawn::*;
+    use crate::game::ecs::systems::spatial;
     use crate::game::npc::{NpcState, RACE_ENEMY};
     use super::run;
 
@@ -155,6 +129,7 @@ mod tests {
         let enemy = spawn_enemy(&mut world, 100.0, 100.0, 1,
             0 /* race < 7 = hostile */, 20, 0, 0, 3, 0, 0);
         world.get::<&mut AiState>(enemy).unwrap().state = NpcState::Still;
+        spatial::run(&world, &mut res);
         run(&mut world, &mut res);
         // Hostile NPC (race < 7) skips AI when frozen — state unchanged
         let state = world.get::<&AiState>(enemy).unwrap().state.clone();
@@ -169,6 +144,7 @@ mod tests {
         let mut res = Resources::new(hero);
         res.clock.freeze_timer = 0;
         spawn_enemy(&mut world, 100.0, 100.0, 1, 0, 20, 0, 0, 3, 5, 0);
+        spatial::run(&world, &mut res);
         run(&mut world, &mut res); // should not panic
     }
 
@@ -184,6 +160,7 @@ mod tests {
         let enemy = spawn_enemy(&mut world, 100.0, 100.0, 1,
             RACE_ENEMY, 20, 1, 0, 2, 0, 0);
         world.get::<&mut AiState>(enemy).unwrap().goal = Goal::Attack1;
+        spatial::run(&world, &mut res);
         run(&mut world, &mut res);
         let goal = world.get::<&AiState>(enemy).unwrap().goal.clone();
         assert_eq!(goal, Goal::Attack1,
@@ -1,12 +1,11 @@
 //! NpcMovementSystem — executes movement for Walking enemy entities.
 //! Port of update_actors() movement pass from gameplay_scene/actors.rs.
+//! Works on the `ActorKinematics` columns rather than per-entity lookups.
 
 use hecs::World;
 use crate::game::collision::{apply_update_environ, speed_for_environ, EnvironTransition};
-use crate::game::collision::px_to_terrain_type;
-use crate::game::ecs::components::{
-    ActorMotion, AiState, ArenaDummy, Enemy, EnemyKind, Facing, FrustFlag, Position, Speed,
-};
+use crate::game::collision::terrain_at;
+use crate::game::ecs::components::{FrustFlag, Position};
 use crate::game::ecs::resources::Resources;
 use crate::game::npc::{NpcState, RACE_SNAKE, RACE_WRAITH};
 
@@ -18,35 +17,19 @@ pub fn run(world: &mut World, res: &mut Resources) {
         Err(_) => return,
     };
 
-    // Snapshot all enemy positions for collision avoidance.
-    let snapshot: Vec<(hecs::Entity, f32, f32)> = world
-        .query::<(hecs::Entity, &Position)>()
-        .with::<&Enemy>()
-        .iter()
-        .map(|(e, p)| (e, p.x, p.y))
-        .collect();
-
-    // Collect all active (non-dead, non-dummy) enemies for the environ + movement pass.
-    let enemies: Vec<hecs::Entity> = world
-        .query::<(hecs::Entity, &AiState)>()
-        .with::<&Enemy>()
-        .without::<&ArenaDummy>()
-        .iter()
-        .filter(|(_, ai)| !matches!(ai.state, NpcState::Dead))
-        .map(|(e, _)| e)
-        .collect();
+    // All active (non-dummy) enemies, as columns; dead ones are skipped below.
+    let scratch = &mut res.scratch;
+    let kin = &mut scratch.kinematics;
+    kin.gather(world);
 
     let world_data = res.map.world.as_ref();
     let mut any_moved = false;
 
-    for entity in enemies {
-        let (npc_state, race, old_x, old_y, old_environ) = {
-            let mut q = world.query_one::<(&AiState, &EnemyKind, &Position, &ActorMotion)>(entity);
-            match q.get() {
-                Ok((ai, k, p, m)) => (ai.state.clone(), k.race, p.x, p.y, m.environ),
-                Err(_) => continue,
-            }
-        };
+    for i in 0..kin.len() {
+        if matches!(kin.ai[i].state, NpcState::Dead) { continue; }
+        let entity = kin.entity[i];
+        let race = kin.race[i];
+        let (old_x, old_y, old_environ) = (kin.x[i], kin.y[i], kin.environ[i]);
 
         // update_environ runs every tick for every actor, regardless of movement state
         // (fmain.c actor_tick Phase 9 — walk_step/still_step both end with update_environ).
@@ -57,44 +40,30 @@ pub fn run(world: &mut World, res: &mut Resources) {
         let j = if zeroes_terrain || world_data.is_none() {
             0u8
         } else {
-            px_to_terrain_type(world_data.unwrap(), old_x as i32, old_y as i32)
+            terrain_at(world_data.unwrap(), old_x as i32, old_y as i32)
         };
 
+        let npc_state = &mut kin.ai[i].state;
+        let was_walking = matches!(npc_state, NpcState::Walking);
         let is_dying  = matches!(npc_state, NpcState::Dying | NpcState::Dead);
         let is_sinking = matches!(npc_state, NpcState::Sinking);
         let (new_k, transition) = apply_update_environ(j, old_environ, is_dying, is_sinking);
 
         // Write environ and apply state transitions.
-        if let Ok(mut motion) = world.get::<&mut ActorMotion>(entity) {
-            motion.environ = new_k;
-        }
+        kin.environ[i] = new_k;
         match transition {
-            EnvironTransition::EnterSink => {
-                if let Ok(mut ai) = world.get::<&mut AiState>(entity) {
-                    ai.state = NpcState::Sinking;
-                }
-            }
-            EnvironTransition::ExitSink | EnvironTransition::Drown => {
-                // Drown: k==30, stop moving (vitality damage is a SPEC-GAP, same as hero side).
-                if let Ok(mut ai) = world.get::<&mut AiState>(entity) {
-                    ai.state = NpcState::Still;
-                }
-            }
+            EnvironTransition::EnterSink => *npc_state = NpcState::Sinking,
+            // Drown: k==30, stop moving (vitality damage is a SPEC-GAP, same as hero side).
+            EnvironTransition::ExitSink | EnvironTransition::Drown => *npc_state = NpcState::Still,
             EnvironTransition::None => {}
         }
 
         // Only Walking NPCs attempt position updates.
-        if !matches!(npc_state, NpcState::Walking) {
+        if !was_walking {
             continue;
         }
 
-        let (facing_dir, base_speed) = {
-            let mut q = world.query_one::<(&Facing, &Speed)>(entity);
-            match q.get() {
-                Ok((f, s)) => (f.dir, s.speed),
-                Err(_) => continue,
-            }
-        };
+        let (facing_dir, base_speed) = (kin.facing[i], kin.speed[i]);
 
         // Speed from environ, scaled by the NPC's base speed ratio.
         // The base speed stored on the component is the spawn-time value (normally 2).
@@ -108,31 +77,37 @@ pub fn run(world: &mut World, res: &mut Resources) {
             (facing_dir, (base_speed as i32 * env_speed as i32) / 2)
         };
 
-        // Build collision list: hero + other enemies.
-        let others: Vec<(i32, i32)> = std::iter::once((hero_pos.x as i32, hero_pos.y as i32))
-            .chain(
-                snapshot.iter()
-                    .filter(|(e, _, _)| *e != entity)
-                    .map(|(_, x, y)| (*x as i32, *y as i32))
-            )
-            .collect();
+        // Build collision list: hero + other enemies within reach of any of
+        // the three trial steps.  res.spatial holds the positions from before
+        // this pass, as the old per-run snapshot did.
+        let reach = (step.abs() + 12) as f32;
+        res.spatial.query_box(old_x, old_y, reach, reach, &mut scratch.near);
+        let others = &mut scratch.blockers;
+        others.clear();
+        others.push((hero_pos.x as i32, hero_pos.y as i32));
+        others.extend(
+            scratch.near.iter()
+                .map(|&i| res.spatial.entries()[i])
+                .filter(|e| e.entity != entity)
+                .map(|e| (e.x as i32, e.y as i32))
+        );
 
         // walk_step deviation: try primary, then CW+1, then CCW-1 (fmain.c:1603-1626).
         let is_wraith = race == RACE_WRAITH;
         let committed = try_directions(
             move_dir, step, old_x, old_y,
-            world_data, &others, is_wraith,
+            world_data, others, is_wraith,
         );
 
         if let Some((new_x, new_y)) = committed {
-            if let Ok(mut pos) = world.get::<&mut Position>(entity) {
-                pos.x = new_x;
-                pos.y = new_y;
-                any_moved = true;
-            }
+            kin.x[i] = new_x;
+            kin.y[i] = new_y;
+            any_moved = true;
         }
     }
 
+    kin.scatter(world);
+
     // fmain.c: any NPC's successful walk resets the hero's frustflag.
     if any_moved {
         if let Ok(mut frust) = world.get::<&mut FrustFlag>(res.hero_entity) {
@@ -176,6 +151,7 @@ mod tests {
     use crate::game::ecs::spawn::*;
     use crate::game::npc::NpcState;
     use crate::game::direction::Direction;
+    use crate::game::ecs::systems::spatial;
     use super::{run, try_directions};
 
     fn hero_stats() -> HeroStats {
@@ -193,6 +169,7 @@ mod tests {
         world.get::<&mut AiState>(enemy).unwrap().state = NpcState::Walking;
         world.get::<&mut Facing>(enemy).unwrap().dir = Direction::E;
         world.get::<&mut Speed>(enemy).unwrap().speed = 3;
+        spatial::run(&world, &mut res);
         run(&mut world, &mut res);
         let new_x = world.get::<&Position>(enemy).unwrap().x;
         assert!(new_x > start_x, "NPC should move east: was {start_x}, now {new_x}");
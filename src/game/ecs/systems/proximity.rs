@@ -4,7 +4,7 @@
 
 use hecs::{Entity, World};
 use crate::game::collision::calc_dist;
-use crate::game::ecs::components::{Enemy, EnemyKind, Position, SetFig, WorldObj};
+use crate::game::ecs::components::{EnemyKind, Position, SetFig, WorldObj};
 use crate::game::ecs::events::SpeechEvent;
 use crate::game::ecs::resources::Resources;
 use crate::game::npc::{RACE_BEGGAR, RACE_NECROMANCER, RACE_WITCH};
@@ -26,9 +26,15 @@ pub fn run(world: &World, res: &mut Resources) {
     let mut best_dist = SPEECH_RANGE;
     let mut best: Option<(Entity, Option<SpeechEvent>)> = None;
 
-    // Check enemy NPCs.
-    for (entity, pos, kind) in world.query::<(Entity, &Position, &EnemyKind)>().with::<&Enemy>().iter() {
-        let d = calc_dist(hx, hy, pos.x as i32, pos.y as i32);
+    // Check enemy NPCs.  calc_dist never undercuts the larger axis offset by
+    // more than a third, so a 2×SPEECH_RANGE box holds every candidate.
+    let reach = (2 * SPEECH_RANGE) as f32;
+    res.spatial.query_box(hero_pos.x, hero_pos.y, reach, reach, &mut res.scratch.near);
+    for &i in &res.scratch.near {
+        let e = res.spatial.entries()[i];
+        let Ok(kind) = world.get::<&EnemyKind>(e.entity) else { continue };
+        let entity = e.entity;
+        let d = calc_dist(hx, hy, e.x as i32, e.y as i32);
         if d < best_dist {
             let speech_id = match kind.race {
                 RACE_BEGGAR       => Some(23),
@@ -0,0 +1,11 @@
+//! SpatialSystem — rebuilds `Resources::spatial` from current enemy positions.
+//! Scheduled after each pass that moves or spawns enemies, so the neighbour
+//! queries in collision, npc_ai, npc_movement, missile and proximity see the
+//! same positions their per-system snapshots used to capture.
+
+use hecs::World;
+use crate::game::ecs::resources::Resources;
+
+pub fn run(world: &World, res: &mut Resources) {
+    res.spatial.rebuild(world);
+}
@@ -2,30 +2,47 @@
 //! Port of zone check logic from gameplay_scene (scene_impl.rs lines 492–531).
 //! See docs/spec/ai-encounters.md.
 
-use hecs::World;
+use hecs::{Entity, World};
 use crate::game::ecs::components::Position;
 use crate::game::ecs::resources::Resources;
 use crate::game::ecs::events::ZoneEvent;
 use crate::game::game_library::ZoneConfig;
 use crate::game::zones;
 
-pub fn run(world: &World, res: &mut Resources) {
-    let hero_pos = match world.get::<&Position>(res.hero_entity) {
-        Ok(p) => *p,
-        Err(_) => return,
-    };
+/// Where the hero stands relative to the zone rectangles.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct ZoneCheck {
+    pub in_encounter_zone: bool,
+    pub current_zone: Option<usize>,
+}
 
+pub fn run(world: &World, res: &mut Resources) {
     // Zone rectangles populated on region load by EcsScene::load_world / reload_region.
-    let zones_list: &[ZoneConfig] = &res.zones;
+    if let Some(zc) = check(world, &res.zones, res.hero_entity) {
+        apply(res, zc);
+    }
+}
 
+/// Read-only half of `run`.  Safe to call alongside the other shared stages
+/// (see `schedule`).
+pub fn check(world: &World, zones_list: &[ZoneConfig], hero: Entity) -> Option<ZoneCheck> {
+    let hero_pos = world.get::<&Position>(hero).ok().map(|p| *p)?;
     let hx = hero_pos.x as u16;
     let hy = hero_pos.y as u16;
+    Some(ZoneCheck {
+        in_encounter_zone: zones::in_encounter_zone(zones_list, hx, hy),
+        current_zone: zones::find_zone(zones_list, hx, hy),
+    })
+}
+
+pub fn apply(res: &mut Resources, zc: ZoneCheck) {
+    let zones_list: &[ZoneConfig] = &res.zones;
 
     // Update encounter zone flag.
-    res.encounter.in_encounter_zone = zones::in_encounter_zone(zones_list, hx, hy);
+    res.encounter.in_encounter_zone = zc.in_encounter_zone;
 
     // Zone entry/exit detection — emit events when zone changes.
-    let current_zone = zones::find_zone(zones_list, hx, hy);
+    let current_zone = zc.current_zone;
     if current_zone != res.encounter.last_zone {
         // Emit exit event for previous zone.
         if let Some(prev_idx) = res.encounter.last_zone {
@@ -0,0 +1,130 @@
+//! A long-lived helper thread that runs one borrowed closure at a time.
+//!
+//! [`Worker::join`] is `std::thread::scope` with one spawned closure, minus
+//! the thread spawn: the closure is handed to a thread started once, and the
+//! call does not return (or unwind) until that closure has finished.  Used
+//! where the same small fork/join happens every tick or frame.
+
+use std::panic::{self, AssertUnwindSafe};
+use std::sync::mpsc::{channel, Receiver, Sender};
+use std::thread::JoinHandle;
+
+type Job = Box<dyn FnOnce() + Send + 'static>;
+
+pub struct Worker {
+    jobs:   Option<Sender<Job>>,
+    /// One message per job run; `Err` carries the job's panic.
+    done:   Receiver<std::thread::Result<()>>,
+    thread: Option<JoinHandle<()>>,
+}
+
+/// Blocks in `drop` until the worker has finished the job it was handed, so
+/// the job's borrows stay valid even if the calling thread unwinds.
+struct Pending<'w> {
+    done: &'w Receiver<std::thread::Result<()>>,
+    result: Option<std::thread::Result<()>>,
+}
+
+impl Pending<'_> {
+    fn wait(&mut self) {
+        if self.result.is_none() {
+            // A closed channel means the thread is gone, and the job with it.
+            self.result = Some(self.done.recv().unwrap_or(Ok(())));
+        }
+    }
+}
+
+impl Drop for Pending<'_> {
+    fn drop(&mut self) {
+        self.wait();
+    }
+}
+
+impl Worker {
+    pub fn start(name: &str) -> std::io::Result<Self> {
+        let (job_tx, job_rx) = channel::<Job>();
+        let (done_tx, done_rx) = channel();
+        let thread = std::thread::Builder::new().name(name.to_string()).spawn(move || {
+            for job in job_rx {
+                let result = panic::catch_unwind(AssertUnwindSafe(job));
+                if done_tx.send(result).is_err() {
+                    return;
+                }
+            }
+        })?;
+        Ok(Worker { jobs: Some(job_tx), done: done_rx, thread: Some(thread) })
+    }
+
+    /// Run `a` on the worker thread and `b` on this one; return both results
+    /// once both have finished.  A panic in `a` is resumed here.
+    pub fn join<'a, RA, RB>(
+        &self,
+        a: impl FnOnce() -> RA + Send + 'a,
+        b: impl FnOnce() -> RB,
+    ) -> (RA, RB)
+    where
+        RA: Send + 'a,
+    {
+        let mut out: Option<RA> = None;
+        let slot = &mut out;
+        let job: Box<dyn FnOnce() + Send + '_> = Box::new(move || *slot = Some(a()));
+        // SAFETY: only the lifetime is changed.  The job is either run
+        // inline below (worker gone) or handed to the worker, in which case
+        // `pending` blocks until the worker reports it finished, when this
+        // frame returns or unwinds.  Its borrows therefore never outlive
+        // this call.
+        let job: Job = unsafe { std::mem::transmute(job) };
+        let jobs = self.jobs.as_ref().expect("jobs is only taken in drop");
+        let ran_inline = match jobs.send(job) {
+            Ok(()) => None,
+            Err(returned) => {
+                (returned.0)();
+                Some(Ok(()))
+            }
+        };
+        let mut pending = Pending { done: &self.done, result: ran_inline };
+        let rb = b();
+        pending.wait();
+        if let Some(Err(payload)) = pending.result.replace(Ok(())) {
+            panic::resume_unwind(payload);
+        }
+        (out.expect("worker job did not run"), rb)
+    }
+}
+
+impl Drop for Worker {
+    fn drop(&mut self) {
+        // Closing the queue ends the thread.
+        self.jobs = None;
+        if let Some(thread) = self.thread.take() {
+            let _ = thread.join();
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn join_runs_both_sides_with_borrows() {
+        let worker = Worker::start("test-worker").unwrap();
+        let data = vec![1, 2, 3];
+        for round in 0..3 {
+            let sum = &data;
+            let (a, b) = worker.join(|| sum.iter().sum::<i32>() + round, || data.len());
+            assert_eq!((a, b), (6 + round, 3));
+        }
+    }
+
+    #[test]
+    fn worker_panic_reaches_the_caller() {
+        let worker = Worker::start("test-worker").unwrap();
+        let hit = panic::catch_unwind(AssertUnwindSafe(|| {
+            worker.join(|| panic!("boom"), || ());
+        }));
+        assert!(hit.is_err());
+        // The thread survives and takes the next job.
+        assert_eq!(worker.join(|| 1, || 2), (1, 2));
+    }
+}
@@ -1,4 +1,5 @@
 use crate::game::{
+    asset_cache::AssetCache,
     bitmap::BitMap,
     colors::Palette,
     cursor::CursorAsset,
@@ -9,7 +10,7 @@ use crate::game::{
 
 use serde::Deserialize;
 
-use std::{collections::HashMap, error::Error, fs, path::Path};
+use std::{collections::HashMap, error::Error, fs, path::Path, sync::Arc};
 
 /*
  * GameLibrary contains all the information needed in the game.
@@ -18,7 +19,9 @@ use std::{collections::HashMap, error::Error, fs, path::Path};
  * For now, this is implemented as a large TOML file containing data
  * extracted from the original source, with minor tweaks since we're
  * using modern systems with phat resources. Some assets are referenced
- * by path and loaded from files. All assets are loaded at startup.
+ * by path and loaded from files. Fonts are loaded at startup; images are
+ * decoded on first use into a shared cache (see `load_image`), which a
+ * background thread can fill ahead of time and scenes can release when done.
  */
 
 #[derive(Deserialize, Debug)]
@@ -92,6 +95,9 @@ pub struct ZoneConfig {
 #[derive(Debug, Deserialize)]
 pub struct DiskConfig {
     pub adf: String,
+    /// Precompiled data bundle written by `pack_bundle`; see `bundle.rs`.
+    #[serde(default)]
+    pub bundle: Option<String>,
     #[serde(default)]
     pub shadow_block: u32,
     #[serde(default)]
@@ -187,6 +193,8 @@ pub struct GameLibrary {
     placards: HashMap<String, Placard>,
     fonts: HashMap<String, FontAsset>,
     images: HashMap<String, ImageAsset>,
+    #[serde(skip)]
+    image_cache: Arc<AssetCache<IffImage>>,
     cursors: HashMap<String, CursorAsset>,
     copy_protect_junk: Vec<CopyProtectQuestion>,
     #[serde(default)]
@@ -210,6 +218,11 @@ pub struct GameLibrary {
     pub objects: Vec<ObjectConfig>,
 }
 
+// The library is shared read-only with worker threads (e.g. `sim_bench`
+// batches); keep every field `Sync`.
+fn _assert_sync<T: Sync>() {}
+const _: fn() = _assert_sync::<GameLibrary>;
+
 impl GameLibrary {
     // images
     pub fn get_image_count(&self) -> usize {
@@ -236,6 +249,48 @@ impl GameLibrary {
         self.images.get(name)
     }
 
+    /// Decoded image `name`, read from its file on first use.
+    pub fn load_image(&self, name: &str) -> Result<Arc<IffImage>, String> {
+        let asset = self
+            .images
+            .get(name)
+            .ok_or_else(|| format!("No image named {} in the game library", name))?;
+        self.image_cache
+            .get_or_load(name, || IffImage::load_from_file(Path::new(&asset.path)))
+    }
+
+    /// Decode `names` on a background thread so a later `load_image` hits the
+    /// cache.  Errors are left for the foreground `load_image` to report.
+    pub fn prewarm_images(&self, names: &[&str]) {
+        let pending: Vec<(String, String)> = names
+            .iter()
+            .filter(|name| !self.image_cache.contains(name))
+            .filter_map(|&name| Some((name.to_string(), self.images.get(name)?.path.clone())))
+            .collect();
+        if pending.is_empty() {
+            return;
+        }
+        let cache = Arc::clone(&self.image_cache);
+        let _ = std::thread::Builder::new()
+            .name("asset-prewarm".to_string())
+            .spawn(move || {
+                for (name, path) in pending {
+                    let _ = cache.get_or_load(&name, || IffImage::load_from_file(Path::new(&path)));
+                }
+            });
+    }
+
+    /// Release the decoded copies of `names`; they are re-read on next use.
+    pub fn evict_images(&self, names: &[&str]) {
+        for name in names {
+            self.image_cache.evict(name);
+        }
+    }
+
+    pub fn is_image_loaded(&self, name: &str) -> bool {
+        self.image_cache.contains(name)
+    }
+
     // color palettes
     pub fn get_palette_count(&self) -> usize {
         self.palettes.len()
@@ -336,15 +391,11 @@ pub fn load_game_library(lib_path: &Path) -> Result<GameLibrary, Box<dyn Error>>
     let config = fs::read_to_string(lib_path)?;
     let mut game_lib = toml::from_str::<GameLibrary>(&config)?;
 
-    // preload all file based assets
+    // fonts are needed by the first frame; images load on demand
     for font_asset in game_lib.fonts.values_mut() {
         font_asset.load()?;
     }
 
-    for image_asset in game_lib.images.values_mut() {
-        image_asset.image = Some(IffImage::load_from_file(Path::new(&image_asset.path))?);
-    }
-
     Ok(game_lib)
 }
 
@@ -391,4 +442,16 @@ mod tests {
         let global_count = r3.iter().filter(|o| o.region == 255).count();
         assert_eq!(global_count, globals.len());
     }
+
+    #[test]
+    fn images_decode_on_first_use() {
+        let lib = load_library();
+        assert!(!lib.is_image_loaded("winpic"));
+        let winpic = lib.load_image("winpic").expect("game/winpic should decode");
+        assert!(lib.is_image_loaded("winpic"));
+        assert!(Arc::ptr_eq(&winpic, &lib.load_image("winpic").unwrap()));
+        lib.evict_images(&["winpic"]);
+        assert!(!lib.is_image_loaded("winpic"));
+        assert!(lib.load_image("no_such_image").is_err());
+    }
 }
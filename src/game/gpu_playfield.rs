@@ -0,0 +1,268 @@
+//! GPU playfield backend (`--gpu-playfield`).
+//!
+//! Instead of composing the playfield into `MapRenderer::framebuf` and
+//! converting and uploading every pixel each frame, the region's tile atlas
+//! and the sprite sheets are uploaded once as textures and each frame is
+//! drawn as textured quads (`playfield_quads`), scaled to the window by the
+//! renderer.  SDL queues the copies into batched geometry.
+//!
+//! The 2D renderer has no palette shaders, so the textures hold LUT colours
+//! and are rewritten in place when the display palette changes (day/night
+//! fades step every few seconds at most).  Copper bands, which change the
+//! palette mid-frame, are left to the CPU path.
+
+use std::sync::Arc;
+
+use sdl3::pixels::PixelFormat;
+use sdl3::rect::Rect;
+use sdl3::render::{BlendMode, Canvas, ScaleMode, Texture, TextureCreator};
+use sdl3::video::{Window, WindowContext};
+
+use crate::game::ecs::resources::SpriteSheets;
+use crate::game::palette_lut::{Lut, LUT_SIZE};
+use crate::game::playfield_quads::{
+    self, build_quads, Layer, PlayfieldView, Quad, TILE_ATLAS_H, TILE_ATLAS_W,
+};
+use crate::game::sprite_mask::{BlittedSprite, SpriteMaskTable};
+use crate::game::sprites::{FrameSource, SpriteSheet};
+use crate::game::tile_atlas::{TileAtlas, TILE_H};
+
+/// The region's tile atlas as terrain and mask textures.
+struct TileTextures<'tex> {
+    atlas: Arc<TileAtlas>,
+    masks: Arc<SpriteMaskTable>,
+    terrain: Texture<'tex>,
+    masked: Texture<'tex>,
+    case6: Texture<'tex>,
+}
+
+/// One frame atlas per loaded sheet; the OBJECTS sheet comes last.
+struct SpriteTextures<'tex> {
+    sheets: Arc<SpriteSheets>,
+    textures: Vec<Option<Texture<'tex>>>,
+}
+
+impl<'tex> SpriteTextures<'tex> {
+    fn get(&self, source: FrameSource) -> Option<&Texture<'tex>> {
+        let slot = match source {
+            FrameSource::Cfile(idx) if idx < self.sheets.sheets.len() => idx,
+            FrameSource::Cfile(_) => return None,
+            FrameSource::Objects => self.sheets.sheets.len(),
+        };
+        self.textures.get(slot)?.as_ref()
+    }
+}
+
+/// Where and how large the playfield appears on the canvas.
+#[derive(Debug, Clone, Copy)]
+pub struct PlayfieldPlacement {
+    /// Canvas position of playfield pixel (0, 0).
+    pub origin: (i32, i32),
+    /// Canvas pixels per playfield pixel.
+    pub scale: (i32, i32),
+    /// Visible playfield size in playfield pixels.
+    pub size: (i32, i32),
+}
+
+/// One frame's inputs.
+pub struct PlayfieldFrame<'a> {
+    pub atlas: &'a Arc<TileAtlas>,
+    pub masks: &'a Arc<SpriteMaskTable>,
+    pub sprites: &'a Arc<SpriteSheets>,
+    pub lut: &'a Lut,
+    pub minimap: &'a [u16; crate::game::map_view::SCROLL_TILES],
+    pub ox: i32,
+    pub oy: i32,
+    pub hero_sector: u16,
+}
+
+pub struct GpuPlayfield<'tex> {
+    tex_maker: &'tex TextureCreator<WindowContext>,
+    tiles: Option<TileTextures<'tex>>,
+    sprites: Option<SpriteTextures<'tex>>,
+    /// LUT the textures above were filled through.
+    lut: Lut,
+    quads: Vec<Quad>,
+    texels: Vec<u8>,
+}
+
+impl<'tex> GpuPlayfield<'tex> {
+    pub fn new(tex_maker: &'tex TextureCreator<WindowContext>) -> Self {
+        GpuPlayfield {
+            tex_maker,
+            tiles: None,
+            sprites: None,
+            lut: [0; LUT_SIZE],
+            quads: Vec::new(),
+            texels: Vec::new(),
+        }
+    }
+
+    /// Draw `sprites` (back to front) over the terrain of `frame` at
+    /// `placement`.  Returns false if the textures could not be created, in
+    /// which case nothing was drawn.
+    pub fn draw<'s>(
+        &mut self,
+        canvas: &mut Canvas<Window>,
+        frame: &PlayfieldFrame<'_>,
+        placement: PlayfieldPlacement,
+        sprites: impl IntoIterator<Item = (FrameSource, usize, &'s BlittedSprite)>,
+    ) -> bool {
+        let recolour = self.lut != *frame.lut;
+        self.lut = *frame.lut;
+        if !self.sync_tiles(frame, recolour) || !self.sync_sprites(frame.sprites, recolour) {
+            return false;
+        }
+        let (Some(tiles), Some(sheets)) = (&self.tiles, &self.sprites) else { return false };
+
+        self.quads.clear();
+        let view = PlayfieldView {
+            minimap: frame.minimap,
+            ox: frame.ox,
+            oy: frame.oy,
+            masks: frame.masks,
+            hero_sector: frame.hero_sector,
+            size: placement.size,
+        };
+        build_quads(
+            &mut self.quads,
+            &view,
+            &frame.sprites.sheets,
+            frame.sprites.object_sprites.as_ref(),
+            sprites,
+        );
+
+        let (sx, sy) = placement.scale;
+        for q in &self.quads {
+            let texture = match q.layer {
+                Layer::Terrain => Some(&tiles.terrain),
+                Layer::Masked => Some(&tiles.masked),
+                Layer::Case6 => Some(&tiles.case6),
+                Layer::Sprite(source) => sheets.get(source),
+            };
+            let Some(texture) = texture else { continue };
+            let src = Rect::new(q.src.0, q.src.1, q.w as u32, q.h as u32);
+            let dst = Rect::new(
+                placement.origin.0 + q.dst.0 * sx,
+                placement.origin.1 + q.dst.1 * sy,
+                (q.w * sx) as u32,
+                (q.h * sy) as u32,
+            );
+            let _ = canvas.copy(texture, src, dst);
+        }
+        true
+    }
+
+    /// Make the tile textures match `frame`'s atlas and the current LUT.
+    fn sync_tiles(&mut self, frame: &PlayfieldFrame<'_>, recolour: bool) -> bool {
+        let current = self.tiles.as_ref().is_some_and(|t| {
+            Arc::ptr_eq(&t.atlas, frame.atlas) && Arc::ptr_eq(&t.masks, frame.masks)
+        });
+        if current && !recolour {
+            return true;
+        }
+        let atlas = frame.atlas.as_ref();
+        let masks = frame.masks.as_ref();
+        let layers: [&dyn Fn(usize) -> [u16; TILE_H]; 3] = [
+            &|_| [0xFFFF; TILE_H],
+            &|t| masks.tiles[t].rows,
+            &|_| masks.case6_rows,
+        ];
+        if current {
+            let tiles = self.tiles.as_mut().unwrap();
+            let textures = [&mut tiles.terrain, &mut tiles.masked, &mut tiles.case6];
+            for (texture, rows) in textures.into_iter().zip(layers) {
+                playfield_quads::tile_atlas_texels(atlas, &self.lut, rows, &mut self.texels);
+                if texture.update(None, &self.texels, TILE_ATLAS_W as usize * 4).is_err() {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        self.tiles = None;
+        let mut made = Vec::with_capacity(3);
+        for (i, rows) in layers.into_iter().enumerate() {
+            playfield_quads::tile_atlas_texels(atlas, &self.lut, rows, &mut self.texels);
+            // Terrain is opaque; the mask layers draw through alpha.
+            let blend = if i == 0 { BlendMode::None } else { BlendMode::Blend };
+            match upload(self.tex_maker, TILE_ATLAS_W, TILE_ATLAS_H, &self.texels, blend) {
+                Some(texture) => made.push(texture),
+                None => return false,
+            }
+        }
+        let [terrain, masked, case6]: [Texture<'tex>; 3] = match made.try_into() {
+            Ok(layers) => layers,
+            Err(_) => return false,
+        };
+        self.tiles = Some(TileTextures {
+            atlas: frame.atlas.clone(),
+            masks: frame.masks.clone(),
+            terrain,
+            masked,
+            case6,
+        });
+        true
+    }
+
+    /// Make the sprite textures match `sheets` and the current LUT.
+    fn sync_sprites(&mut self, sheets: &Arc<SpriteSheets>, recolour: bool) -> bool {
+        let current = self.sprites.as_ref().is_some_and(|s| Arc::ptr_eq(&s.sheets, sheets));
+        if current && !recolour {
+            return true;
+        }
+        let all: Vec<Option<&SpriteSheet>> = sheets
+            .sheets
+            .iter()
+            .map(Option::as_ref)
+            .chain([sheets.object_sprites.as_ref()])
+            .collect();
+        if current {
+            let textures = &mut self.sprites.as_mut().unwrap().textures;
+            for (texture, sheet) in textures.iter_mut().zip(&all) {
+                let (Some(texture), Some(sheet)) = (texture, sheet) else { continue };
+                playfield_quads::sheet_atlas_texels(sheet, &self.lut, &mut self.texels);
+                let pitch = playfield_quads::sheet_atlas_size(sheet).0 as usize * 4;
+                if texture.update(None, &self.texels, pitch).is_err() {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        self.sprites = None;
+        let mut textures = Vec::with_capacity(all.len());
+        for sheet in all {
+            let texture = match sheet {
+                Some(sheet) => {
+                    playfield_quads::sheet_atlas_texels(sheet, &self.lut, &mut self.texels);
+                    let (w, h) = playfield_quads::sheet_atlas_size(sheet);
+                    match upload(self.tex_maker, w, h, &self.texels, BlendMode::Blend) {
+                        Some(texture) => Some(texture),
+                        None => return false,
+                    }
+                }
+                None => None,
+            };
+            textures.push(texture);
+        }
+        self.sprites = Some(SpriteTextures { sheets: sheets.clone(), textures });
+        true
+    }
+}
+
+fn upload<'tex>(
+    tex_maker: &'tex TextureCreator<WindowContext>,
+    w: u32,
+    h: u32,
+    texels: &[u8],
+    blend: BlendMode,
+) -> Option<Texture<'tex>> {
+    let mut texture = tex_maker
+        .create_texture_static(Some(PixelFormat::ARGB8888), w, h)
+        .ok()?;
+    texture.set_scale_mode(ScaleMode::Nearest);
+    texture.set_blend_mode(blend);
+    texture.update(None, texels, w as usize * 4).ok()?;
+    Some(texture)
+}
@@ -12,9 +12,6 @@ use std::path::Path;
 pub struct ImageAsset {
     #[serde(rename = "file")]
     pub path: String,
-
-    #[serde(skip)]
-    pub image: Option<IffImage>,
 }
 
 /*
@@ -8,25 +8,25 @@ use sdl3::render::{Canvas, RenderTarget, Texture};
 use std::cell::RefCell;
 use std::rc::Weak;
 
-/// An image view inside a shared SDL3 texture atlas.
+/// An image view inside an SDL3 backing texture.
 ///
 /// `ImageTexture` converts an [`IffImage`] into a planar [`BitMap`] at
 /// construction time and from that point on is independent of the source
 /// asset — the `GameLibrary` lifetime does **not** propagate here.
 ///
 /// The `'tex` lifetime tracks the [`sdl3::render::TextureCreator`] that
-/// allocated the backing atlas texture.
+/// allocated the backing texture.
 pub struct ImageTexture<'tex> {
     bitmap: BitMap,
 
-    // Location of this image within the shared atlas texture.
+    // Location of this image within the backing texture.
     texture_bounds: Rect,
 
     // Cached RGBA32 pixel buffer; populated on first `update()` call.
     pixels_32: Vec<u8>,
     stride: usize,
 
-    // Weak reference to the shared backing texture (owned by the atlas).
+    // Weak reference to the backing texture (owned by `RenderResources`).
     texture: Weak<RefCell<Texture<'tex>>>,
 }
 
@@ -12,7 +12,7 @@ use crate::game::game_library::GameLibrary;
 use crate::game::page_flip::PageFlip;
 use crate::game::palette_fader::{FadeController, FadeResult};
 use crate::game::scene::{Scene, SceneResources, SceneResult};
-use crate::game::songs::Track;
+use crate::game::songs::CompiledTrack;
 use crate::game::viewport_zoom::ViewportZoom;
 
 /**
@@ -106,6 +106,9 @@ const PAGE_OVERLAYS: [PageOverlay; 3] = [
     }, // Kevin   (20 bytes * 8)
 ];
 
+/// Every image the intro draws: the book background plus the page overlays.
+pub const IMAGES: &[&str] = &["page0", "p1a", "p1b", "p2a", "p2b", "p3a", "p3b"];
+
 /// Portrait position: same for all pages (from original: unpackbrush(br1, &pageb, 4, 24))
 /// The original x=4 is a byte offset → 4 * 8 = 32 pixels.
 const PORTRAIT_X: i32 = 32;
@@ -153,13 +156,13 @@ pub struct IntroScene {
     /// Intro music tracks (tracks 12-15), to be started when the scene begins
     /// its visual sequence.  Mirrors the original: playscore() is called after
     /// the title text delay but before the zoom-in.
-    intro_tracks: Option<[Arc<Track>; 4]>,
+    intro_tracks: Option<[Arc<CompiledTrack>; 4]>,
     /// True once play_score() has been called (avoids calling it again on skip).
     music_started: bool,
 }
 
 impl IntroScene {
-    pub fn new(intro_tracks: Option<[Arc<Track>; 4]>) -> IntroScene {
+    pub fn new(intro_tracks: Option<[Arc<CompiledTrack>; 4]>) -> IntroScene {
         IntroScene {
             phase: IntroPhase::TitleText {
                 ticks_remaining: TITLE_HOLD_TICKS,
@@ -251,6 +254,10 @@ fn draw_page_overlays<T: sdl3::render::RenderTarget>(
 }
 
 impl Scene for IntroScene {
+    fn images(&self) -> &'static [&'static str] {
+        IMAGES
+    }
+
     fn as_any(&self) -> &dyn Any {
         self
     }
@@ -5,6 +5,7 @@
 //! live in GameState and are decremented each tick there.
 
 use crate::game::actor::ActorKind;
+use crate::game::combat::GameRng;
 use crate::game::game_state::GameState;
 use crate::game::ecs::components::{ArenaDummy, CarrierMount, Enemy, EnemyKind, Facing, Health, HeroStats, Inventory, Position};
 use crate::game::ecs::resources::Resources;
@@ -31,7 +32,8 @@ pub fn heal_cap(brave: i16) -> i16 {
 }
 
 /// Simple pseudo-random 0-7 for magic effects (ports rand8() pattern).
-/// Uses system time nanos similar to combat.rs melee_rand().
+/// Uses system time nanos similar to combat.rs melee_rand(); the ECS paths
+/// draw from `Resources::rng` instead.
 fn rand8() -> i16 {
     use std::time::SystemTime;
     let nanos = SystemTime::now()
@@ -237,7 +239,7 @@ pub fn magic_dispatch_ecs(item_idx: usize, world: &mut World, res: &mut Resource
             MagicResult::Applied
         }
         ITEM_GLASS_VIAL => {
-            let capped = apply_vial_heal_ecs(world, hero);
+            let capped = apply_vial_heal_ecs(world, hero, &mut res.rng);
             MagicResult::Healed { capped }
         }
         ITEM_CRYSTAL_ORB => {
@@ -311,12 +313,12 @@ fn stone_ring_effect_ecs(world: &mut World, res: &mut Resources, hero: hecs::Ent
     // TODO: drag the active carrier along with the hero (SPEC §21.7).
     // `res.carrier_entity` is not yet wired by the carrier system.
 
-    let capped = apply_vial_heal_ecs(world, hero);
+    let capped = apply_vial_heal_ecs(world, hero, &mut res.rng);
     MagicResult::StoneTeleport { capped }
 }
 
-fn apply_vial_heal_ecs(world: &mut World, hero: hecs::Entity) -> bool {
-    let heal = rand8() + 4;
+fn apply_vial_heal_ecs(world: &mut World, hero: hecs::Entity, rng: &mut GameRng) -> bool {
+    let heal = rng.below(8) as i16 + 4;
     if let Ok(mut stats) = world.get::<&mut HeroStats>(hero) {
         let cap = heal_cap(stats.brave);
         let raw = stats.vitality + heal;
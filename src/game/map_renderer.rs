@@ -1,9 +1,12 @@
 //! MapRenderer: combines TileAtlas and genmini() to blit the map viewport.
 
+use std::sync::Arc;
+
 use crate::game::map_view::{
     genmini_scrolled, SCROLL_TILES, SCROLL_TILES_H, SCROLL_TILES_W, VIEWPORT_TILES_H,
     VIEWPORT_TILES_W,
 };
+use crate::game::sprite_mask::SpriteMaskTable;
 use crate::game::tile_atlas::{TileAtlas, TILE_H, TILE_W};
 use crate::game::world_data::WorldData;
 
@@ -12,33 +15,71 @@ pub const MAP_DST_Y: i32 = 0;
 pub const MAP_DST_W: u32 = (TILE_W * VIEWPORT_TILES_W) as u32; // 304
 pub const MAP_DST_H: u32 = (TILE_H * VIEWPORT_TILES_H) as u32; // 192
 
+/// World pixel coordinates wrap at 0x8000 on both axes (2048 × 16 px, 1024 × 32 px).
+const WORLD_WRAP: i32 = 0x8000;
+
 pub struct MapRenderer {
-    pub atlas: TileAtlas,
+    /// Decoded tiles for the region; shared with the region cache.
+    pub atlas: Arc<TileAtlas>,
     /// Palette-index pixel buffer (MAP_DST_W × MAP_DST_H bytes).
+    /// Reset from `background` by every compose(), then sprites are blitted on top.
     pub framebuf: Vec<u8>,
+    /// Terrain-only (pre-sprite) palette-index buffer, same size as `framebuf`.
+    /// Retained across frames so compose() only redraws what changed.
+    pub background: Vec<u8>,
     /// Global shadow_mem bitmask table (12,288 bytes).
     pub shadow_mem: Vec<u8>,
+    /// Per-tile sprite occlusion masks resolved from `atlas` and `shadow_mem`.
+    pub masks: Arc<SpriteMaskTable>,
     /// Minimap tile indices from last compose() call (20×7 grid, row-major).
     pub last_minimap: [u16; SCROLL_TILES],
     /// Sub-tile pixel offsets from last compose().
     pub last_ox: i32,
     pub last_oy: i32,
+    /// Viewport origin (map_x, map_y) that `background` currently shows.
+    /// `None` forces a full redraw on the next compose().
+    bg_origin: Option<(u16, u16)>,
 }
 
 impl MapRenderer {
     pub fn new(world: &WorldData, shadow_mem: Vec<u8>) -> Self {
+        let atlas = TileAtlas::from_world_data(world);
+        let masks = SpriteMaskTable::build(&atlas, &shadow_mem);
+        Self::from_tables(Arc::new(atlas), Arc::new(masks), shadow_mem)
+    }
+
+    /// Build a renderer from already-decoded region tables (see `region_cache`).
+    pub fn from_tables(atlas: Arc<TileAtlas>, masks: Arc<SpriteMaskTable>, shadow_mem: Vec<u8>) -> Self {
         let buf_size = (MAP_DST_W * MAP_DST_H) as usize;
         MapRenderer {
-            atlas: TileAtlas::from_world_data(world),
+            atlas,
             framebuf: vec![0u8; buf_size],
+            background: vec![0u8; buf_size],
             shadow_mem,
+            masks,
             last_minimap: [0u16; SCROLL_TILES],
             last_ox: 0,
             last_oy: 0,
+            bg_origin: None,
         }
     }
 
+    /// Discard the retained background so the next compose() redraws every tile.
+    pub fn invalidate(&mut self) {
+        self.bg_origin = None;
+    }
+
     /// Compose the map into `framebuf` for the given viewport position.
+    ///
+    /// The terrain is maintained incrementally in `background`:
+    /// - same origin and minimap: no tile is redrawn;
+    /// - scroll smaller than the viewport: retained pixels are moved and only
+    ///   tiles touching the newly exposed strips (or whose index changed,
+    ///   e.g. after `WorldData::set_tile_at_image`) are redrawn;
+    /// - anything else: full redraw.
+    ///
+    /// `framebuf` is then reset from `background` so sprite blits and depth
+    /// masking always start from clean terrain.
     pub fn compose(&mut self, map_x: u16, map_y: u16, world: &WorldData) {
         let img_x = map_x >> 4;
         let img_y = map_y >> 5;
@@ -46,41 +87,140 @@ impl MapRenderer {
         let oy = (map_y & 0x1F) as i32;
         let minimap = genmini_scrolled(img_x, img_y, world);
 
-        self.framebuf.fill(0);
+        let mut dirty = [true; SCROLL_TILES];
+        if let Some((prev_x, prev_y)) = self.bg_origin {
+            let dx = wrap_delta(map_x, prev_x);
+            let dy = wrap_delta(map_y, prev_y);
+            if dx == 0 && dy == 0 {
+                for (d, (new, old)) in dirty.iter_mut().zip(minimap.iter().zip(self.last_minimap.iter())) {
+                    *d = new != old;
+                }
+            } else if dx.abs() < MAP_DST_W as i32 && dy.abs() < MAP_DST_H as i32 {
+                self.shift_background(dx, dy);
+                self.mark_retained_clean(&mut dirty, &minimap, (prev_x, prev_y), (img_x, img_y), (ox, oy), (dx, dy));
+            }
+        }
+
+        for ty in 0..SCROLL_TILES_H {
+            for tx in 0..SCROLL_TILES_W {
+                let i = ty * SCROLL_TILES_W + tx;
+                if dirty[i] {
+                    self.draw_tile(tx, ty, minimap[i], ox, oy);
+                }
+            }
+        }
+
         self.last_minimap = minimap;
         self.last_ox = ox;
         self.last_oy = oy;
+        self.bg_origin = Some((map_x, map_y));
+        self.framebuf.copy_from_slice(&self.background);
+    }
+
+    /// Move retained background pixels so that new `(x, y)` shows old `(x + dx, y + dy)`.
+    /// Rows are walked in the direction that never overwrites an unread source row.
+    fn shift_background(&mut self, dx: i32, dy: i32) {
+        let w = MAP_DST_W as i32;
+        let h = MAP_DST_H as i32;
+        let (x0, x1) = ((-dx).max(0), (w - dx).min(w));
+        let (y0, y1) = ((-dy).max(0), (h - dy).min(h));
+        if x0 >= x1 || y0 >= y1 {
+            return;
+        }
+        let len = (x1 - x0) as usize;
+        let buf = &mut self.background;
+        let mut copy_row = |y: i32| {
+            let src = ((y + dy) * w + x0 + dx) as usize;
+            let dst = (y * w + x0) as usize;
+            buf.copy_within(src..src + len, dst);
+        };
+        if dy > 0 {
+            (y0..y1).for_each(&mut copy_row);
+        } else {
+            (y0..y1).rev().for_each(&mut copy_row);
+        }
+    }
+
+    /// Clear `dirty` for every tile whose visible pixels were all carried over by
+    /// `shift_background` and whose tile index matches the previous minimap.
+    fn mark_retained_clean(
+        &self,
+        dirty: &mut [bool; SCROLL_TILES],
+        minimap: &[u16; SCROLL_TILES],
+        prev_origin: (u16, u16),
+        img: (u16, u16),
+        offset: (i32, i32),
+        delta: (i32, i32),
+    ) {
+        let w = MAP_DST_W as i32;
+        let h = MAP_DST_H as i32;
+        let (dx, dy) = delta;
+        // Retained region in new viewport coordinates.
+        let (rx0, rx1) = ((-dx).max(0), (w - dx).min(w));
+        let (ry0, ry1) = ((-dy).max(0), (h - dy).min(h));
+        let prev_img_x = prev_origin.0 >> 4;
+        let prev_img_y = prev_origin.1 >> 5;
+        // Tile-grid shift between the old and new minimaps (wraps like genmini).
+        let shift_x = img.0.wrapping_sub(prev_img_x) & 0x7ff;
+        let shift_y = img.1.wrapping_sub(prev_img_y) & 0x3ff;
+
         for ty in 0..SCROLL_TILES_H {
             for tx in 0..SCROLL_TILES_W {
-                let dst_x = tx as i32 * TILE_W as i32 - ox;
-                let dst_y = ty as i32 * TILE_H as i32 - oy;
-                if dst_x >= MAP_DST_W as i32 || dst_y >= MAP_DST_H as i32 {
+                let x0 = (tx as i32 * TILE_W as i32 - offset.0).max(0);
+                let x1 = (tx as i32 * TILE_W as i32 - offset.0 + TILE_W as i32).min(w);
+                let y0 = (ty as i32 * TILE_H as i32 - offset.1).max(0);
+                let y1 = (ty as i32 * TILE_H as i32 - offset.1 + TILE_H as i32).min(h);
+                let i = ty * SCROLL_TILES_W + tx;
+                if x0 >= x1 || y0 >= y1 {
+                    dirty[i] = false; // entirely off-screen
                     continue;
                 }
-                if dst_x + TILE_W as i32 <= 0 || dst_y + TILE_H as i32 <= 0 {
-                    continue;
+                if x0 < rx0 || x1 > rx1 || y0 < ry0 || y1 > ry1 {
+                    continue; // touches a newly exposed strip
                 }
-                let tile_idx = minimap[ty * SCROLL_TILES_W + tx] as usize;
-                let clamped = tile_idx.min(255);
-                let tile_pixels = self.atlas.tile_pixels(clamped);
-                for row in 0..TILE_H {
-                    let py = dst_y + row as i32;
-                    if py < 0 || py >= MAP_DST_H as i32 {
-                        continue;
-                    }
-                    let col_start = dst_x.max(0) as usize;
-                    let col_end = (dst_x + TILE_W as i32).min(MAP_DST_W as i32) as usize;
-                    let src_off = (col_start as i32 - dst_x) as usize;
-                    let len = col_end - col_start;
-                    let dst_base = py as usize * MAP_DST_W as usize;
-                    let src_start = row * TILE_W + src_off;
-                    // Background: all tiles
-                    self.framebuf[dst_base + col_start..dst_base + col_end]
-                        .copy_from_slice(&tile_pixels[src_start..src_start + len]);
+                let old_tx = (tx as u16).wrapping_add(shift_x) & 0x7ff;
+                let old_ty = (ty as u16).wrapping_add(shift_y) & 0x3ff;
+                if (old_tx as usize) < SCROLL_TILES_W && (old_ty as usize) < SCROLL_TILES_H {
+                    let old = self.last_minimap[old_ty as usize * SCROLL_TILES_W + old_tx as usize];
+                    dirty[i] = old != minimap[i];
                 }
             }
         }
     }
+
+    /// Blit one minimap tile into `background`, clipped to the viewport.
+    fn draw_tile(&mut self, tx: usize, ty: usize, tile_idx: u16, ox: i32, oy: i32) {
+        let dst_x = tx as i32 * TILE_W as i32 - ox;
+        let dst_y = ty as i32 * TILE_H as i32 - oy;
+        if dst_x >= MAP_DST_W as i32 || dst_y >= MAP_DST_H as i32 {
+            return;
+        }
+        if dst_x + TILE_W as i32 <= 0 || dst_y + TILE_H as i32 <= 0 {
+            return;
+        }
+        let clamped = (tile_idx as usize).min(255);
+        let tile_pixels = self.atlas.tile_pixels(clamped);
+        for row in 0..TILE_H {
+            let py = dst_y + row as i32;
+            if py < 0 || py >= MAP_DST_H as i32 {
+                continue;
+            }
+            let col_start = dst_x.max(0) as usize;
+            let col_end = (dst_x + TILE_W as i32).min(MAP_DST_W as i32) as usize;
+            let src_off = (col_start as i32 - dst_x) as usize;
+            let len = col_end - col_start;
+            let dst_base = py as usize * MAP_DST_W as usize;
+            let src_start = row * TILE_W + src_off;
+            self.background[dst_base + col_start..dst_base + col_end]
+                .copy_from_slice(&tile_pixels[src_start..src_start + len]);
+        }
+    }
+}
+
+/// Signed shortest distance from `old` to `new` on the 0x8000-wrapping world axis.
+fn wrap_delta(new: u16, old: u16) -> i32 {
+    let d = (new as i32 - old as i32).rem_euclid(WORLD_WRAP);
+    if d > WORLD_WRAP / 2 { d - WORLD_WRAP } else { d }
 }
 
 #[cfg(test)]
@@ -95,4 +235,88 @@ mod tests {
         renderer.compose(1600, 6400, &world);
         assert_eq!(renderer.framebuf.len(), (MAP_DST_W * MAP_DST_H) as usize);
     }
+
+    /// Full-redraw reference: the pre-incremental compose() algorithm.
+    fn reference_frame(renderer: &MapRenderer, map_x: u16, map_y: u16, world: &WorldData) -> Vec<u8> {
+        let mut fb = vec![0u8; (MAP_DST_W * MAP_DST_H) as usize];
+        let ox = (map_x & 0xF) as i32;
+        let oy = (map_y & 0x1F) as i32;
+        let minimap = genmini_scrolled(map_x >> 4, map_y >> 5, world);
+        for ty in 0..SCROLL_TILES_H {
+            for tx in 0..SCROLL_TILES_W {
+                let tile = renderer.atlas.tile_pixels((minimap[ty * SCROLL_TILES_W + tx] as usize).min(255));
+                for row in 0..TILE_H {
+                    for col in 0..TILE_W {
+                        let px = tx as i32 * TILE_W as i32 - ox + col as i32;
+                        let py = ty as i32 * TILE_H as i32 - oy + row as i32;
+                        if px >= 0 && py >= 0 && px < MAP_DST_W as i32 && py < MAP_DST_H as i32 {
+                            fb[(py * MAP_DST_W as i32 + px) as usize] = tile[row * TILE_W + col];
+                        }
+                    }
+                }
+            }
+        }
+        fb
+    }
+
+    /// World whose tiles all look different, so any misplaced pixel shows up.
+    fn patterned_world() -> WorldData {
+        let mut world = WorldData::empty();
+        for (i, b) in world.image_mem.iter_mut().enumerate() {
+            *b = (i as u32).wrapping_mul(2_654_435_761).rotate_left(7) as u8;
+        }
+        for (i, b) in world.sector_mem.iter_mut().enumerate() {
+            *b = (i * 37 + i / 128) as u8;
+        }
+        for (i, b) in world.map_mem.iter_mut().enumerate() {
+            *b = (i * 13) as u8;
+        }
+        world
+    }
+
+    #[test]
+    fn incremental_compose_matches_full_redraw() {
+        let mut world = patterned_world();
+        let mut renderer = MapRenderer::new(&world, Vec::new());
+        let mut pos: (u16, u16) = (0x1000, 0x2000);
+        // Per-frame camera steps: still, pixel scrolls, whole-tile scrolls,
+        // diagonals, large jumps, and world-edge wraps.
+        let steps: [(i32, i32); 14] = [
+            (0, 0), (1, 0), (0, 1), (-3, 2), (16, 0), (0, 32), (-16, -32),
+            (15, -31), (0, 0), (303, 0), (0, 191), (400, 0), (-0x2000, 9), (7, -5),
+        ];
+        for (n, &(dx, dy)) in steps.iter().cycle().take(60).enumerate() {
+            pos.0 = (pos.0 as i32 + dx).rem_euclid(WORLD_WRAP) as u16;
+            pos.1 = (pos.1 as i32 + dy).rem_euclid(WORLD_WRAP) as u16;
+            renderer.compose(pos.0, pos.1, &world);
+            assert!(
+                renderer.framebuf == reference_frame(&renderer, pos.0, pos.1, &world),
+                "frame {n} at {pos:?} differs from full redraw"
+            );
+            assert_eq!(renderer.framebuf, renderer.background);
+        }
+        // Camera crossing the wrap seam.
+        for &p in &[(0x7FF8u16, 0x7FF0u16), (0x0004, 0x0008), (0x7FFF, 0x0000)] {
+            renderer.compose(p.0, p.1, &world);
+            assert!(renderer.framebuf == reference_frame(&renderer, p.0, p.1, &world), "wrap at {p:?}");
+        }
+        // A tile mutation with a still camera must be picked up.
+        let (mx, my) = (0x7FFFu16, 0x0000u16);
+        let before = genmini_scrolled(mx >> 4, my >> 5, &world);
+        world.set_tile_at_image(((mx >> 4) as usize + 3) & 0x7ff, (my >> 5) as usize + 2, 0xAB);
+        assert_ne!(before, genmini_scrolled(mx >> 4, my >> 5, &world));
+        renderer.compose(mx, my, &world);
+        assert!(renderer.framebuf == reference_frame(&renderer, mx, my, &world), "tile mutation missed");
+    }
+
+    #[test]
+    fn compose_resets_sprite_pixels_when_camera_is_still() {
+        let world = patterned_world();
+        let mut renderer = MapRenderer::new(&world, Vec::new());
+        renderer.compose(512, 512, &world);
+        let clean = renderer.framebuf.clone();
+        renderer.framebuf[100] ^= 0x1F; // simulate a sprite blit
+        renderer.compose(512, 512, &world);
+        assert_eq!(renderer.framebuf, clean);
+    }
 }
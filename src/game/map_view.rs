@@ -5,7 +5,7 @@
 //! With the full overworld map loaded as a flat 128×128 sector array, no xreg/yreg
 //! region offsets are needed — tile coordinates map directly to absolute sector indices.
 
-use crate::game::world_data::WorldData;
+use crate::game::world_data::{OverviewRaster, WorldData};
 
 /// Viewport dimensions in tiles.
 pub const VIEWPORT_TILES_W: usize = 19;
@@ -79,33 +79,28 @@ pub const BIGDRAW_ROWS: usize = 72;
 /// Render a 288×72 overview bitmap (1 pixel per world tile) centred on hero position.
 /// Each pixel maps terra_mem[tile_idx*4+3] (color byte) to a green-tone ARGB8888 pixel.
 pub fn bigdraw(hero_x: u16, hero_y: u16, world: &WorldData) -> Vec<u32> {
-    let mut buf = vec![0xFF000020_u32; BIGDRAW_COLS * BIGDRAW_ROWS];
-    let center_tx = (hero_x >> 4) as i32;
-    let center_ty = (hero_y >> 5) as i32;
-    let start_tx = center_tx - (BIGDRAW_COLS as i32 / 2);
-    let start_ty = center_ty - (BIGDRAW_ROWS as i32 / 2);
-
-    for py in 0..BIGDRAW_ROWS {
-        for px in 0..BIGDRAW_COLS {
-            let tx = (start_tx + px as i32).rem_euclid(2048) as usize;
-            let ty = (start_ty + py as i32).rem_euclid(1024) as usize;
-            let xs = tx >> 4;
-            let ys = ty >> 3;
-            let lx = tx & 0xF;
-            let ly = ty & 0x7;
-            let sec = world.sector_at(xs, ys);
-            let tile_idx = world.tile_at(sec, lx, ly) as usize;
-            let base = tile_idx * 4;
-            let color_byte = if base + 3 < world.terra_mem.len() {
-                world.terra_mem[base + 3]
-            } else {
-                0
-            };
+    let mut buf = vec![0u32; BIGDRAW_COLS * BIGDRAW_ROWS];
+    bigdraw_into(hero_x, hero_y, world, &mut buf);
+    buf
+}
+
+/// `bigdraw` into a caller-owned `BIGDRAW_COLS × BIGDRAW_ROWS` buffer: a
+/// wrapping window onto the world's cached overview raster.
+pub fn bigdraw_into(hero_x: u16, hero_y: u16, world: &WorldData, buf: &mut [u32]) {
+    let overview = world.overview();
+    let start_tx = (hero_x >> 4) as i32 - (BIGDRAW_COLS as i32 / 2);
+    let start_ty = (hero_y >> 5) as i32 - (BIGDRAW_ROWS as i32 / 2);
+    let tx = start_tx.rem_euclid(OverviewRaster::COLS as i32) as usize;
+
+    for (py, out) in buf.chunks_exact_mut(BIGDRAW_COLS).take(BIGDRAW_ROWS).enumerate() {
+        let ty = (start_ty + py as i32).rem_euclid(OverviewRaster::ROWS as i32) as usize;
+        let line = overview.row(ty);
+        let window = line[tx..].iter().chain(line.iter());
+        for (px, &color_byte) in out.iter_mut().zip(window) {
             let c = (color_byte as u32 * 8).min(255);
-            buf[py * BIGDRAW_COLS + px] = 0xFF000000 | (c << 8);
+            *px = 0xFF000000 | (c << 8);
         }
     }
-    buf
 }
 
 #[cfg(test)]
@@ -133,4 +128,46 @@ mod tests {
         let buf = bigdraw(0, 0, &world);
         assert_eq!(buf.len(), BIGDRAW_COLS * BIGDRAW_ROWS);
     }
+
+    #[test]
+    fn bigdraw_tracks_tile_changes() {
+        let mut world = WorldData::empty();
+        for (i, b) in world.map_mem.iter_mut().enumerate() {
+            *b = (i % 7) as u8;
+        }
+        for (i, b) in world.sector_mem.iter_mut().enumerate() {
+            *b = (i * 13 % 256) as u8;
+        }
+        for (i, b) in world.terra_mem.iter_mut().enumerate() {
+            *b = (i * 5 % 32) as u8;
+        }
+        // Direct per-pixel lookup, as bigdraw computed it before the cache.
+        let reference = |world: &WorldData, hero_x: u16, hero_y: u16| -> Vec<u32> {
+            let start_tx = (hero_x >> 4) as i32 - (BIGDRAW_COLS as i32 / 2);
+            let start_ty = (hero_y >> 5) as i32 - (BIGDRAW_ROWS as i32 / 2);
+            (0..BIGDRAW_COLS * BIGDRAW_ROWS)
+                .map(|i| {
+                    let tx = (start_tx + (i % BIGDRAW_COLS) as i32).rem_euclid(2048) as usize;
+                    let ty = (start_ty + (i / BIGDRAW_COLS) as i32).rem_euclid(1024) as usize;
+                    let sec = world.sector_at(tx >> 4, ty >> 3);
+                    let tile = world.tile_at(sec, tx & 0xF, ty & 0x7) as usize;
+                    let c = (world.terra_mem[tile * 4 + 3] as u32 * 8).min(255);
+                    0xFF000000 | (c << 8)
+                })
+                .collect()
+        };
+        // Near the origin the window wraps on both axes.
+        assert_eq!(bigdraw(0, 0, &world), reference(&world, 0, 0));
+        world.set_tile_at_image(3, 2, 200);
+        world.set_tile_at_image(2047, 1023, 17);
+        // Same tables, overview built from scratch.
+        let mut rebuilt = WorldData::empty();
+        rebuilt.sector_mem = world.sector_mem.clone();
+        rebuilt.map_mem = world.map_mem.clone();
+        rebuilt.terra_mem = world.terra_mem.clone();
+        for &(x, y) in &[(0, 0), (0x7FF0, 0x7FE0), (1000, 3000)] {
+            assert_eq!(bigdraw(x, y, &world), reference(&rebuilt, x, y));
+            assert_eq!(bigdraw(x, y, &world), bigdraw(x, y, &rebuilt));
+        }
+    }
 }
@@ -63,6 +63,7 @@ pub struct MenuDef {
     pub enabled: [u8; 12],
 }
 
+#[derive(Debug, Clone, PartialEq)]
 pub struct ButtonRender {
     pub display_slot: usize,
     pub menu_index: i8, // -1 = empty slot
@@ -523,6 +524,11 @@ impl MenuState {
         self.pressed_slot == Some(display_slot)
     }
 
+    /// True while a mouse press on a menu item is held (until mouse up).
+    pub fn is_holding(&self) -> bool {
+        self.committed_slot.is_some() || self.pressed_slot.is_some()
+    }
+
     /// Handle a keyboard shortcut (fmain.c:1499-1520).
     pub fn handle_key(&mut self, key: u8) -> MenuAction {
         if self.cmode == MenuMode::Keys {
@@ -4,9 +4,11 @@ pub mod direction;
 
 pub mod actor;
 pub mod adf;
+pub mod asset_cache;
 pub mod audio;
 pub mod bitblit;
 pub mod bitmap;
+pub mod bundle;
 pub mod byteops;
 pub mod collision;
 pub mod colors;
@@ -30,6 +32,7 @@ pub mod game_event;
 pub mod game_library;
 pub mod game_state;
 pub mod gfx_effects;
+pub mod gpu_playfield;
 pub mod hiscreen;
 pub mod hunk;
 pub mod iff_image;
@@ -48,9 +51,14 @@ pub mod npc_ai;
 pub mod page_flip;
 pub mod palette;
 pub mod palette_fader;
+pub mod palette_lut;
 pub mod persist;
 pub mod placard;
 pub mod placard_scene;
+pub mod planar;
+pub mod playfield_quads;
+pub mod profiler;
+pub mod region_cache;
 pub mod render_resources;
 pub mod render_task;
 pub mod scene;
@@ -59,6 +67,7 @@ pub mod shop;
 pub mod songs;
 pub mod sprite_mask;
 pub mod sprites;
+pub mod spsc;
 pub mod tile_atlas;
 pub mod victory_scene;
 pub mod viewport_zoom;
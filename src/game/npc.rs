@@ -146,7 +146,7 @@ impl Npc {
         other_actors: &[(i32, i32)],
     ) {
         use crate::game::actor::Tactic;
-        use crate::game::collision::{actor_collides, newx, newy, proxcheck, px_to_terrain_type};
+        use crate::game::collision::{actor_collides, newx, newy, proxcheck, terrain_at};
 
         if !self.active || self.state != NpcState::Walking {
             return;
@@ -158,7 +158,7 @@ impl Npc {
         // bypass the chain per fmain.c:1639 — always normal speed 2.
         let race_ignores_terrain = self.race == RACE_WRAITH || self.race == RACE_SNAKE;
         let terrain_here =
-            world.map_or(0u8, |w| px_to_terrain_type(w, self.x as i32, self.y as i32));
+            world.map_or(0u8, |w| terrain_at(w, self.x as i32, self.y as i32));
         let dist =
             crate::game::combat::npc_speed_for_terrain(terrain_here, race_ignores_terrain) as i32;
 
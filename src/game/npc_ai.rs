@@ -1495,13 +1495,13 @@ mod tests {
     }
 }
 
-use crate::game::ecs::components::{AiState, Facing};
+use crate::game::ecs::components::AiState;
 
 /// ECS adapter for the NPC AI tick.
-/// Mirrors tick_npc() but operates on ECS component types instead of &mut Npc.
+/// Mirrors tick_npc() but operates on an `ActorKinematics` row instead of &mut Npc.
 pub fn tick_npc_ecs(
     ai: &mut AiState,
-    facing: &mut Facing,
+    facing: &mut Direction,
     x: f32, y: f32,
     hero_x: f32, hero_y: f32,
     hero_dead: bool,
@@ -1528,27 +1528,21 @@ pub fn tick_npc_ecs(
         tactic: ai.tactic.clone(),
         state: ai.state.clone(),
         cleverness: ai.cleverness,
-        facing: facing.dir,
+        facing: *facing,
         ..Npc::default()
     };
 
-    let others_i32: Vec<(i32, i32)> = others.iter().map(|(ox, oy)| (*ox as i32, *oy as i32)).collect();
-    let leader_idx = if is_leader { Some(0usize) } else { None };
-
     // leader_pos slot: if a leader exists and it's not this entity, put it at index 0
-    // of the npcs slice so leader_idx=Some(0) points to it.
-    let npcs_with_leader: Vec<(i32, i32)>;
-    let (leader_idx_final, npcs_final): (Option<usize>, &[(i32, i32)]) =
-        if let Some((lx, ly)) = leader_pos {
-            npcs_with_leader = std::iter::once((lx as i32, ly as i32))
-                .chain(others_i32.iter().cloned())
-                .collect();
-            (Some(0), &npcs_with_leader)
-        } else if is_leader {
-            (leader_idx, &others_i32)
-        } else {
-            (None, &others_i32)
-        };
+    // of the npcs slice so leader_idx=Some(0) points to it.  do_tactic only reads
+    // npcs[0] and npcs[1], so the first two slots are all that is passed on.
+    let mut npcs = [(0i32, 0i32); 2];
+    let mut n_npcs = 0;
+    for &(ox, oy) in leader_pos.iter().chain(others).take(2) {
+        npcs[n_npcs] = (ox as i32, oy as i32);
+        n_npcs += 1;
+    }
+    let leader_idx_final = if leader_pos.is_some() || is_leader { Some(0usize) } else { None };
+    let npcs_final = &npcs[..n_npcs];
 
     tick_npc(
         &mut tmp,
@@ -1566,5 +1560,5 @@ pub fn tick_npc_ecs(
     ai.goal    = tmp.goal;
     ai.tactic  = tmp.tactic;
     ai.state   = tmp.state;
-    facing.dir = tmp.facing;
+    *facing    = tmp.facing;
 }
@@ -1,4 +1,7 @@
+use std::collections::HashMap;
+
 use crate::game::colors::{Palette, RGB4};
+use crate::game::palette::{amiga_color_to_rgba, PALETTE_SIZE};
 
 /// Scale an RGBA32 palette by a lightlevel percentage (0–100).
 ///
@@ -41,20 +44,9 @@ pub fn fade_page(
     light_timer: bool,
     colors: &Palette,
 ) -> Palette {
-    // Clamp channel percentages to valid range
-    let (r, g, b, g2) = if limit {
-        // Night limits: never fully dark
-        let r = r.clamp(10, 100);
-        let g = g.clamp(25, 100);
-        let b = b.clamp(60, 100);
-        let g2 = ((100 - g) / 3) as i32;
-        (r, g, b, g2)
-    } else {
-        let r = r.clamp(0, 100);
-        let g = g.clamp(0, 100);
-        let b = b.clamp(0, 100);
-        (r, g, b, 0i32)
-    };
+    let (r, g, b) = clamp_percentages(r, g, b, limit);
+    // Night blue tint strength, derived from the clamped green level.
+    let g2 = if limit { ((100 - g) / 3) as i32 } else { 0 };
 
     let mut faded = Vec::with_capacity(colors.colors.len());
 
@@ -107,6 +99,65 @@ pub fn fade_page(
     Palette { colors: faded }
 }
 
+/// Clamp `fade_page` channel percentages to their valid range.
+fn clamp_percentages(r: i16, g: i16, b: i16, limit: bool) -> (i16, i16, i16) {
+    if limit {
+        // Night limits: never fully dark
+        (r.clamp(10, 100), g.clamp(25, 100), b.clamp(60, 100))
+    } else {
+        (r.clamp(0, 100), g.clamp(0, 100), b.clamp(0, 100))
+    }
+}
+
+/// Clamped channel percentages plus the `limit` and `light_timer` flags.
+type FadeKey = (i16, i16, i16, bool, bool);
+
+/// Memoised [`fade_page`] results for one source palette, as display colours.
+///
+/// The day/night cycle re-fades the same page every few ticks, but after
+/// clamping the channel percentages only take a few hundred distinct values,
+/// so each faded palette is computed once and afterwards read from the table.
+/// Asking with a different source palette (region change) empties it.
+#[derive(Debug, Default)]
+pub struct FadeTable {
+    source: Vec<u16>,
+    faded:  HashMap<FadeKey, [u32; PALETTE_SIZE]>,
+}
+
+impl FadeTable {
+    /// `fade_page(r, g, b, limit, light_timer, colors)` as `0xAARRGGBB`
+    /// display colours; entries past the end of `colors` are mid grey.
+    pub fn get(
+        &mut self,
+        r: i16,
+        g: i16,
+        b: i16,
+        limit: bool,
+        light_timer: bool,
+        colors: &Palette,
+    ) -> &[u32; PALETTE_SIZE] {
+        if !self.source.iter().copied().eq(colors.colors.iter().map(|c| c.color)) {
+            self.source.clear();
+            self.source.extend(colors.colors.iter().map(|c| c.color));
+            self.faded.clear();
+        }
+        let (r, g, b) = clamp_percentages(r, g, b, limit);
+        self.faded.entry((r, g, b, limit, light_timer)).or_insert_with(|| {
+            let faded = fade_page(r, g, b, limit, light_timer, colors);
+            let mut out = [0xFF808080_u32; PALETTE_SIZE];
+            for (dst, entry) in out.iter_mut().zip(faded.colors.iter()) {
+                *dst = amiga_color_to_rgba(entry.color);
+            }
+            out
+        })
+    }
+
+    /// Number of faded palettes computed since the source last changed.
+    pub fn len(&self) -> usize {
+        self.faded.len()
+    }
+}
+
 /// The result of a fade operation. Determines how the fade should be applied
 /// to the rendering pipeline.
 pub enum FadeResult {
@@ -394,6 +445,31 @@ mod tests {
 
     // ---- fade_page tests ----
 
+    #[test]
+    fn test_fade_table_matches_fade_page_and_memoises() {
+        let palette = Palette {
+            colors: vec![RGB4 { color: 0xFFF }, RGB4 { color: 0xA52 }, RGB4 { color: 0x390 }],
+        };
+        let mut table = FadeTable::default();
+        let expected = fade_page(40, 55, 80, true, true, &palette);
+        let got = *table.get(40, 55, 80, true, true, &palette);
+        for (i, c) in expected.colors.iter().enumerate() {
+            assert_eq!(got[i], amiga_color_to_rgba(c.color));
+        }
+        assert_eq!(got[3], 0xFF808080, "entries past the source are grey");
+
+        // Percentages that clamp to the same values share one entry.
+        table.get(-20, 0, 0, true, false, &palette);
+        table.get(5, 10, 30, true, false, &palette);
+        assert_eq!(table.len(), 2);
+
+        // A different source palette invalidates everything.
+        let other = Palette { colors: vec![RGB4 { color: 0x123 }] };
+        let got = *table.get(100, 100, 100, false, false, &other);
+        assert_eq!(got[0], amiga_color_to_rgba(0x123));
+        assert_eq!(table.len(), 1);
+    }
+
     #[test]
     fn test_fade_page_all_zero_produces_black() {
         let palette = Palette {
@@ -0,0 +1,452 @@
+//! Palette lookup tables and the shared indexed → 32-bit pixel conversion kernel.
+//!
+//! Every renderer that turns Amiga palette indices into texture pixels goes
+//! through [`convert`]: the playfield (`EcsScene::render_map`), inventory
+//! icons, and [`BitMap::update_rgb32`](crate::game::bitmap::BitMap::update_rgb32)
+//! (which backs `ImageTexture` and the hibar compass textures).
+//!
+//! Copper-style mid-frame palette changes are [`LutBand`]s: full LUTs built
+//! once per palette change, which [`convert_rows`] switches between at row
+//! boundaries.
+//!
+//! A LUT is 32 packed words already in the destination's byte order, so the
+//! kernel never looks at colour channels — it is a pure table gather:
+//! - x86_64 with SSSE3: 16 pixels per step via two `pshufb` lookups per byte lane.
+//! - aarch64: 16 pixels per step via `tbl` + interleaving `st4`.
+//! - anything else (and the tail of every row): [`convert_scalar`].
+
+use crate::game::copper::CopperList;
+use crate::game::palette::{Palette, PALETTE_SIZE};
+
+/// Number of LUT entries; indices are masked to 5 bits (32-colour OCS display).
+pub const LUT_SIZE: usize = PALETTE_SIZE;
+
+/// 32 packed output pixels, one per palette index, in native word order.
+pub type Lut = [u32; LUT_SIZE];
+
+/// Build an ARGB8888 LUT from a `0xAARRGGBB` display palette (alpha forced opaque).
+pub fn argb8888_lut(palette: &Palette) -> Lut {
+    let mut lut = [0u32; LUT_SIZE];
+    for (dst, &src) in lut.iter_mut().zip(palette.iter()) {
+        *dst = src | 0xFF00_0000;
+    }
+    lut
+}
+
+/// Build an RGBA32 (byte order R, G, B, A) LUT from a `0xRRGGBBAA` colour table,
+/// as produced by [`crate::game::colors::Palette::to_rgba32_table`].
+/// Missing entries (tables shorter than 32) are transparent black.
+pub fn rgba32_lut(table: &[u32]) -> Lut {
+    let mut lut = [0u32; LUT_SIZE];
+    for (dst, &src) in lut.iter_mut().zip(table.iter()) {
+        *dst = u32::from_ne_bytes(src.to_be_bytes());
+    }
+    lut
+}
+
+/// A LUT that takes over from display row `row` downwards.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct LutBand {
+    pub row: usize,
+    pub lut: Lut,
+}
+
+/// An ARGB8888 LUT cached against the display palette it was built from.
+///
+/// [`PaletteLut::sync`] is called once per frame; it only rebuilds the table
+/// when the palette (day/night fade, jewel light, region change) has changed.
+/// The copper bands are rebuilt with it, from the same palette.
+#[derive(Debug, Clone)]
+pub struct PaletteLut {
+    source: Palette,
+    lut:    Lut,
+    copper: CopperList,
+    bands:  Vec<LutBand>,
+    valid:  bool,
+}
+
+impl Default for PaletteLut {
+    fn default() -> Self {
+        Self {
+            source: [0u32; PALETTE_SIZE],
+            lut:    [0u32; LUT_SIZE],
+            copper: CopperList::new(),
+            bands:  Vec::new(),
+            valid:  false,
+        }
+    }
+}
+
+impl PaletteLut {
+    /// Rebuild the LUT if `palette` differs from the one it was built from.
+    /// Returns `true` when a rebuild happened.
+    pub fn sync(&mut self, palette: &Palette) -> bool {
+        if self.valid && self.source == *palette {
+            return false;
+        }
+        self.source = *palette;
+        self.lut = argb8888_lut(palette);
+        self.bands = self.copper.lut_bands(palette);
+        self.valid = true;
+        true
+    }
+
+    /// Replace the copper list; its bands are built on the next sync.
+    pub fn set_copper(&mut self, copper: CopperList) {
+        self.copper = copper;
+        self.valid = false;
+    }
+
+    /// Force the next [`sync`](Self::sync) to rebuild.
+    pub fn invalidate(&mut self) {
+        self.valid = false;
+    }
+
+    pub fn lut(&self) -> &Lut {
+        &self.lut
+    }
+
+    /// Copper bands for [`convert_rows`], ascending by row (empty without a list).
+    pub fn bands(&self) -> &[LutBand] {
+        &self.bands
+    }
+}
+
+/// Convert palette indices to packed 32-bit pixels.
+///
+/// Writes `indices.len()` pixels (4 bytes each, `lut` word in native byte
+/// order) to the front of `out`. Indices are masked to 5 bits.
+///
+/// # Panics
+///
+/// Panics if `out` is shorter than `indices.len() * 4`.
+pub fn convert(indices: &[u8], lut: &Lut, out: &mut [u8]) {
+    assert!(out.len() >= indices.len() * 4, "palette_lut::convert: output too small");
+
+    #[cfg(all(target_arch = "x86_64", target_endian = "little"))]
+    {
+        if std::arch::is_x86_feature_detected!("ssse3") {
+            // SAFETY: SSSE3 support was just verified at runtime.
+            unsafe { x86::convert_ssse3(indices, lut, out) };
+            return;
+        }
+    }
+
+    #[cfg(all(target_arch = "aarch64", target_endian = "little"))]
+    {
+        // SAFETY: NEON is a mandatory part of the aarch64 baseline.
+        unsafe { neon::convert_neon(indices, lut, out) };
+        return;
+    }
+
+    #[allow(unreachable_code)]
+    convert_scalar(indices, lut, out);
+}
+
+/// Convert a `width`-pixel-wide indexed image into `out`, rows `pitch` bytes
+/// apart, through `base` and then each band's LUT from its row downwards.
+///
+/// `bands` must be ascending by row.  Switching tables costs one comparison
+/// per row; no palette work happens inside the frame.
+///
+/// # Panics
+///
+/// Panics if `width` is zero or an output row is shorter than `width * 4`.
+pub fn convert_rows(
+    indices: &[u8],
+    width: usize,
+    pitch: usize,
+    base: &Lut,
+    bands: &[LutBand],
+    out: &mut [u8],
+) {
+    let mut lut = base;
+    let mut bands = bands.iter().peekable();
+    for (row, (src, dst)) in indices.chunks_exact(width).zip(out.chunks_mut(pitch)).enumerate() {
+        while let Some(band) = bands.next_if(|b| b.row <= row) {
+            lut = &band.lut;
+        }
+        convert(src, lut, dst);
+    }
+}
+
+/// Reference implementation of [`convert`]; also handles SIMD row tails.
+pub fn convert_scalar(indices: &[u8], lut: &Lut, out: &mut [u8]) {
+    for (&idx, dst) in indices.iter().zip(out.chunks_exact_mut(4)) {
+        dst.copy_from_slice(&lut[(idx & 31) as usize].to_ne_bytes());
+    }
+}
+
+/// Split a LUT into four byte lanes × two 16-entry halves for table-lookup SIMD.
+/// `lanes[b][h][i]` is byte `b` (memory order) of `lut[h * 16 + i]`.
+#[cfg(any(target_arch = "x86_64", target_arch = "aarch64"))]
+fn byte_lanes(lut: &Lut) -> [[[u8; 16]; 2]; 4] {
+    let mut lanes = [[[0u8; 16]; 2]; 4];
+    for (i, word) in lut.iter().enumerate() {
+        for (b, byte) in word.to_ne_bytes().into_iter().enumerate() {
+            lanes[b][i / 16][i % 16] = byte;
+        }
+    }
+    lanes
+}
+
+#[cfg(all(target_arch = "x86_64", target_endian = "little"))]
+mod x86 {
+    use super::{byte_lanes, convert_scalar, Lut};
+    use std::arch::x86_64::*;
+
+    /// # Safety
+    ///
+    /// The caller must ensure the CPU supports SSSE3 and that
+    /// `out.len() >= indices.len() * 4`.
+    #[target_feature(enable = "ssse3")]
+    pub(super) unsafe fn convert_ssse3(indices: &[u8], lut: &Lut, out: &mut [u8]) {
+        let lanes = byte_lanes(lut);
+        let load = |t: &[u8; 16]| _mm_loadu_si128(t.as_ptr() as *const __m128i);
+        let lo = [load(&lanes[0][0]), load(&lanes[1][0]), load(&lanes[2][0]), load(&lanes[3][0])];
+        let hi = [load(&lanes[0][1]), load(&lanes[1][1]), load(&lanes[2][1]), load(&lanes[3][1])];
+        let mask5 = _mm_set1_epi8(31);
+        let fifteen = _mm_set1_epi8(15);
+
+        let blocks = indices.len() / 16;
+        for blk in 0..blocks {
+            // SAFETY: blk * 16 + 16 <= indices.len(), and out holds 4 bytes
+            // per index, so every load/store below stays in bounds.
+            let src = indices.as_ptr().add(blk * 16) as *const __m128i;
+            let dst = out.as_mut_ptr().add(blk * 64) as *mut __m128i;
+
+            let idx = _mm_and_si128(_mm_loadu_si128(src), mask5);
+            // pshufb only looks at the low 4 bits (bit 7 is clear after masking);
+            // bit 4 picks which half of the table the byte comes from.
+            let use_hi = _mm_cmpgt_epi8(idx, fifteen);
+            let pick = |l: __m128i, h: __m128i| {
+                _mm_or_si128(
+                    _mm_andnot_si128(use_hi, _mm_shuffle_epi8(l, idx)),
+                    _mm_and_si128(use_hi, _mm_shuffle_epi8(h, idx)),
+                )
+            };
+            let b0 = pick(lo[0], hi[0]);
+            let b1 = pick(lo[1], hi[1]);
+            let b2 = pick(lo[2], hi[2]);
+            let b3 = pick(lo[3], hi[3]);
+
+            // Re-interleave the four byte lanes into 16 packed words.
+            let b01_lo = _mm_unpacklo_epi8(b0, b1);
+            let b01_hi = _mm_unpackhi_epi8(b0, b1);
+            let b23_lo = _mm_unpacklo_epi8(b2, b3);
+            let b23_hi = _mm_unpackhi_epi8(b2, b3);
+            _mm_storeu_si128(dst,        _mm_unpacklo_epi16(b01_lo, b23_lo));
+            _mm_storeu_si128(dst.add(1), _mm_unpackhi_epi16(b01_lo, b23_lo));
+            _mm_storeu_si128(dst.add(2), _mm_unpacklo_epi16(b01_hi, b23_hi));
+            _mm_storeu_si128(dst.add(3), _mm_unpackhi_epi16(b01_hi, b23_hi));
+        }
+
+        let done = blocks * 16;
+        convert_scalar(&indices[done..], lut, &mut out[done * 4..]);
+    }
+}
+
+#[cfg(all(target_arch = "aarch64", target_endian = "little"))]
+mod neon {
+    use super::{byte_lanes, convert_scalar, Lut};
+    use std::arch::aarch64::*;
+
+    /// # Safety
+    ///
+    /// The caller must ensure `out.len() >= indices.len() * 4`.
+    #[target_feature(enable = "neon")]
+    pub(super) unsafe fn convert_neon(indices: &[u8], lut: &Lut, out: &mut [u8]) {
+        let lanes = byte_lanes(lut);
+        let table = |b: usize| uint8x16x2_t(vld1q_u8(lanes[b][0].as_ptr()), vld1q_u8(lanes[b][1].as_ptr()));
+        let (t0, t1, t2, t3) = (table(0), table(1), table(2), table(3));
+        let mask5 = vdupq_n_u8(31);
+
+        let blocks = indices.len() / 16;
+        for blk in 0..blocks {
+            // SAFETY: blk * 16 + 16 <= indices.len(), and out holds 4 bytes
+            // per index, so the load and the 64-byte st4 stay in bounds.
+            let idx = vandq_u8(vld1q_u8(indices.as_ptr().add(blk * 16)), mask5);
+            // tbl over a 32-byte table pair covers all five index bits at once;
+            // st4 interleaves the four byte lanes back into packed words.
+            let px = uint8x16x4_t(
+                vqtbl2q_u8(t0, idx),
+                vqtbl2q_u8(t1, idx),
+                vqtbl2q_u8(t2, idx),
+                vqtbl2q_u8(t3, idx),
+            );
+            vst4q_u8(out.as_mut_ptr().add(blk * 64), px);
+        }
+
+        let done = blocks * 16;
+        convert_scalar(&indices[done..], lut, &mut out[done * 4..]);
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn test_lut() -> Lut {
+        let mut lut = [0u32; LUT_SIZE];
+        for (i, w) in lut.iter_mut().enumerate() {
+            // Distinct bytes per lane so a lane mix-up cannot go unnoticed.
+            *w = 0x0102_0304u32.wrapping_mul(i as u32 + 1) ^ (i as u32) << 27;
+        }
+        lut
+    }
+
+    fn pattern(len: usize) -> Vec<u8> {
+        (0..len).map(|i| ((i * 7 + i / 3) & 0xFF) as u8).collect()
+    }
+
+    #[test]
+    fn convert_matches_scalar_reference() {
+        let lut = test_lut();
+        // Cover empty input, sub-block tails, exact blocks, and a playfield row.
+        for len in [0usize, 1, 15, 16, 17, 31, 32, 33, 304, 304 * 192] {
+            let idx = pattern(len);
+            let mut fast = vec![0u8; len * 4];
+            let mut slow = vec![0u8; len * 4];
+            convert(&idx, &lut, &mut fast);
+            convert_scalar(&idx, &lut, &mut slow);
+            assert_eq!(fast, slow, "mismatch at len {len}");
+        }
+    }
+
+    #[test]
+    fn indices_are_masked_to_five_bits() {
+        let lut = test_lut();
+        let idx = [0x20u8, 0x3F, 0xFF, 0xE1];
+        let mut out = [0u8; 16];
+        convert(&idx, &lut, &mut out);
+        assert_eq!(&out[0..4], &lut[0].to_ne_bytes());
+        assert_eq!(&out[4..8], &lut[31].to_ne_bytes());
+        assert_eq!(&out[8..12], &lut[31].to_ne_bytes());
+        assert_eq!(&out[12..16], &lut[1].to_ne_bytes());
+    }
+
+    #[test]
+    fn argb8888_lut_forces_opaque_alpha() {
+        let mut pal = [0u32; PALETTE_SIZE];
+        pal[3] = 0x0012_3456;
+        let lut = argb8888_lut(&pal);
+        assert_eq!(lut[3], 0xFF12_3456);
+    }
+
+    #[test]
+    fn rgba32_lut_is_byte_order_rgba() {
+        let lut = rgba32_lut(&[0x1122_33FF]);
+        assert_eq!(lut[0].to_ne_bytes(), [0x11, 0x22, 0x33, 0xFF]);
+        assert_eq!(lut[1], 0, "missing entries are transparent");
+    }
+
+    #[test]
+    fn palette_lut_rebuilds_only_on_change() {
+        let mut cache = PaletteLut::default();
+        let mut pal = [0xFF00_0000u32; PALETTE_SIZE];
+        assert!(cache.sync(&pal), "first sync always builds");
+        assert!(!cache.sync(&pal), "unchanged palette must not rebuild");
+        pal[5] = 0xFFAB_CDEF;
+        assert!(cache.sync(&pal));
+        assert_eq!(cache.lut()[5], 0xFFAB_CDEF);
+        cache.invalidate();
+        assert!(cache.sync(&pal));
+    }
+
+    #[test]
+    fn convert_rows_switches_lut_at_band_rows() {
+        let base = test_lut();
+        let mut red = base;
+        red[1] = 0xFFFF_0000;
+        let mut blue = base;
+        blue[1] = 0xFF00_00FF;
+        let bands = [LutBand { row: 1, lut: red }, LutBand { row: 3, lut: blue }];
+        // 4 rows of 2 pixels, padded to a 12-byte pitch.
+        let idx = [1u8; 8];
+        let mut out = [0u8; 48];
+        convert_rows(&idx, 2, 12, &base, &bands, &mut out);
+        let px = |row: usize| u32::from_ne_bytes(out[row * 12..row * 12 + 4].try_into().unwrap());
+        assert_eq!(px(0), base[1]);
+        assert_eq!(px(1), 0xFFFF_0000);
+        assert_eq!(px(2), 0xFFFF_0000);
+        assert_eq!(px(3), 0xFF00_00FF);
+        assert_eq!(&out[8..12], &[0; 4], "pitch padding is left alone");
+    }
+
+    #[test]
+    fn copper_bands_follow_the_palette() {
+        let mut cache = PaletteLut::default();
+        let mut copper = CopperList::new();
+        copper.add(10, 2, 0x0F00);
+        cache.set_copper(copper);
+        let mut pal = [0xFF00_0000u32; PALETTE_SIZE];
+        assert!(cache.sync(&pal));
+        assert_eq!(cache.bands().len(), 1);
+        assert_eq!(cache.bands()[0].lut[2], 0xFFFF_0000);
+        pal[5] = 0xFF12_3456;
+        assert!(cache.sync(&pal));
+        assert_eq!(cache.bands()[0].lut[5], 0xFF12_3456, "bands are rebuilt from the new palette");
+    }
+
+    /// The loop `EcsScene::render_map` used before this module existed.
+    fn push_loop_baseline(framebuf: &[u8], pal: &Palette) -> Vec<u8> {
+        let mut rgb_buf: Vec<u8> = Vec::with_capacity(framebuf.len() * 4);
+        for &idx in framebuf {
+            let rgba = pal[(idx & 31) as usize];
+            rgb_buf.push((rgba & 0xFF) as u8);
+            rgb_buf.push(((rgba >> 8) & 0xFF) as u8);
+            rgb_buf.push(((rgba >> 16) & 0xFF) as u8);
+            rgb_buf.push(0xFF);
+        }
+        rgb_buf
+    }
+
+    /// Micro-benchmark: old per-byte push loop vs. scalar LUT vs. dispatched kernel.
+    ///
+    /// Run with `cargo test --release palette_lut -- --ignored --nocapture`.
+    #[test]
+    #[ignore]
+    fn bench_indexed_to_argb() {
+        use std::hint::black_box;
+        use std::time::Instant;
+
+        let mut pal = [0u32; PALETTE_SIZE];
+        for (i, c) in pal.iter_mut().enumerate() {
+            *c = 0xFF00_0000 | (i as u32 * 0x0008_0402);
+        }
+        let lut = argb8888_lut(&pal);
+
+        // Playfield (304×192) and a full 640×480 canvas.
+        for (w, h) in [(304usize, 192usize), (640, 480)] {
+            let idx = pattern(w * h);
+            let mut out = vec![0u8; w * h * 4];
+            let iters = 500;
+
+            let t = Instant::now();
+            for _ in 0..iters {
+                black_box(push_loop_baseline(black_box(&idx), &pal));
+            }
+            let baseline = t.elapsed() / iters;
+
+            let t = Instant::now();
+            for _ in 0..iters {
+                convert_scalar(black_box(&idx), &lut, &mut out);
+                black_box(&out);
+            }
+            let scalar = t.elapsed() / iters;
+
+            let t = Instant::now();
+            for _ in 0..iters {
+                convert(black_box(&idx), &lut, &mut out);
+                black_box(&out);
+            }
+            let simd = t.elapsed() / iters;
+
+            assert_eq!(out, push_loop_baseline(&idx, &pal), "kernel must match the old loop");
+            println!(
+                "{w}x{h}: push loop {baseline:?}, scalar LUT {scalar:?}, kernel {simd:?} ({:.1}x)",
+                baseline.as_secs_f64() / simd.as_secs_f64().max(1e-12),
+            );
+        }
+    }
+}
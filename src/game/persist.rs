@@ -1,7 +1,9 @@
 //! Save/load game state using protobuf (prost).
 
-use std::io::Write;
-use std::path::Path;
+use std::io::{BufRead, Write};
+use std::path::{Path, PathBuf};
+use std::sync::mpsc::{channel, Receiver, Sender};
+use std::thread::JoinHandle;
 
 use anyhow::Context;
 use prost::Message;
@@ -67,6 +69,8 @@ fn state_to_proto(state: &GameState) -> proto::SaveFile {
         lightlevel: state.lightlevel as u32,
         cycle: state.cycle,
         flasher: state.flasher,
+        tick_counter: state.tick_counter,
+        rng_seed: 0,
 
         battleflag: state.battleflag,
         witchflag: state.witchflag,
@@ -192,6 +196,7 @@ pub fn load_from_path(path: &std::path::Path) -> anyhow::Result<GameState> {
     state.lightlevel = sf.lightlevel as u16;
     state.cycle = sf.cycle;
     state.flasher = sf.flasher;
+    state.tick_counter = sf.tick_counter;
 
     state.battleflag = sf.battleflag;
     state.witchflag = sf.witchflag;
@@ -388,6 +393,8 @@ fn ecs_to_proto(scene: &crate::game::ecs::scene::EcsScene) -> proto::SaveFile {
         lightlevel:   res.clock.lightlevel as u32,
         cycle:        res.clock.cycle,
         flasher:      res.clock.flasher,
+        tick_counter: res.clock.tick_counter,
+        rng_seed:     res.rng.seed,
         battleflag:   res.region.battleflag,
         witchflag:    res.brother.witchflag,
         safe_flag:    res.brother.safe_flag,
@@ -510,6 +517,8 @@ fn proto_to_ecs(
     scene.res.clock.lightlevel   = sf.lightlevel   as u16;
     scene.res.clock.cycle        = sf.cycle;
     scene.res.clock.flasher      = sf.flasher;
+    scene.res.clock.tick_counter = sf.tick_counter;
+    scene.res.rng.seed           = sf.rng_seed;
 
     // Region.
     scene.res.region.battleflag      = sf.battleflag;
@@ -556,14 +565,35 @@ pub fn ecs_save_to_path(
     scene: &crate::game::ecs::scene::EcsScene,
     path: &Path,
 ) -> anyhow::Result<()> {
-    let save = ecs_to_proto(scene);
+    write_save_atomic(&ecs_to_proto(scene), path)
+}
+
+/// Encode an `EcsScene` exactly as a save file would hold it (magic, version
+/// and message), for embedding in other files.
+pub fn ecs_save_to_bytes(scene: &crate::game::ecs::scene::EcsScene) -> Vec<u8> {
+    let mut out = Vec::new();
+    out.extend_from_slice(SAVE_MAGIC);
+    out.extend_from_slice(&SAVE_VERSION.to_le_bytes());
+    ecs_to_proto(scene).encode(&mut out).expect("Vec grows to fit");
+    out
+}
+
+/// Encode `save` and write it next to `path`, then rename it into place, so a
+/// crash or full disk mid-write never leaves a truncated save behind.
+fn write_save_atomic(save: &proto::SaveFile, path: &Path) -> anyhow::Result<()> {
     let encoded = save.encode_to_vec();
-    let mut f = std::fs::File::create(path)
-        .with_context(|| format!("creating save file {}", path.display()))?;
+    let mut tmp = path.as_os_str().to_owned();
+    tmp.push(".tmp");
+    let tmp = PathBuf::from(tmp);
+    let mut f = std::fs::File::create(&tmp)
+        .with_context(|| format!("creating save file {}", tmp.display()))?;
     f.write_all(SAVE_MAGIC)?;
     f.write_all(&SAVE_VERSION.to_le_bytes())?;
     f.write_all(&encoded)?;
-    Ok(())
+    f.sync_all()?;
+    drop(f);
+    std::fs::rename(&tmp, path)
+        .with_context(|| format!("replacing save file {}", path.display()))
 }
 
 /// Save `EcsScene` into slot `slot` under `~/.config/faery/saves/save{slot:02}.sav`.
@@ -571,14 +601,163 @@ pub fn ecs_save_game(
     scene: &crate::game::ecs::scene::EcsScene,
     slot: u8,
 ) -> anyhow::Result<()> {
+    ecs_save_to_path(scene, &slot_path(slot)?)
+}
+
+/// Path of save slot `slot`, creating the save directory if needed.
+fn slot_path(slot: u8) -> anyhow::Result<PathBuf> {
     let base = dirs::config_dir()
         .context("could not determine config directory")?
         .join("faery")
         .join("saves");
     std::fs::create_dir_all(&base)
         .with_context(|| format!("creating save directory {}", base.display()))?;
-    let path = base.join(format!("save{slot:02}.sav"));
-    ecs_save_to_path(scene, &path)
+    Ok(base.join(format!("save{slot:02}.sav")))
+}
+
+// --------------------------------------------------------------------------
+// Background saving
+// --------------------------------------------------------------------------
+
+struct SaveJob {
+    save: proto::SaveFile,
+    path: PathBuf,
+}
+
+/// Outcome of one write: the path, how many queued saves it covered, and
+/// whether it succeeded.
+pub type SaveResult = (PathBuf, usize, anyhow::Result<()>);
+
+/// Saves `EcsScene`s from a worker thread.
+///
+/// [`SaveWriter::save_to_path`] only snapshots the scene's plain data on the
+/// calling thread; encoding and the atomic write-rename happen on the worker.
+/// Saves to the same path that queue up behind a slow write are collapsed into
+/// the newest one.  Dropping the writer finishes every queued save.
+pub struct SaveWriter {
+    jobs:    Option<Sender<SaveJob>>,
+    results: Receiver<SaveResult>,
+    pending: usize,
+    thread:  Option<JoinHandle<()>>,
+    /// One append-only transcript per slot saved or loaded so far.
+    transcripts: Vec<(u8, TranscriptLog)>,
+}
+
+impl SaveWriter {
+    pub fn start() -> anyhow::Result<Self> {
+        let (job_tx, job_rx) = channel::<SaveJob>();
+        let (res_tx, res_rx) = channel::<SaveResult>();
+        let thread = std::thread::Builder::new()
+            .name("save-writer".to_string())
+            .spawn(move || {
+                while let Ok(first) = job_rx.recv() {
+                    // Keep only the newest snapshot per path, in queue order.
+                    let mut batch: Vec<(SaveJob, usize)> = Vec::new();
+                    for job in std::iter::once(first).chain(job_rx.try_iter()) {
+                        match batch.iter().position(|(j, _)| j.path == job.path) {
+                            Some(i) => {
+                                let (_, covered) = batch.remove(i);
+                                batch.push((job, covered + 1));
+                            }
+                            None => batch.push((job, 1)),
+                        }
+                    }
+                    for (job, covered) in batch {
+                        let written = write_save_atomic(&job.save, &job.path);
+                        if res_tx.send((job.path, covered, written)).is_err() {
+                            return;
+                        }
+                    }
+                }
+            })
+            .context("starting save writer thread")?;
+        Ok(SaveWriter {
+            jobs: Some(job_tx),
+            results: res_rx,
+            pending: 0,
+            thread: Some(thread),
+            transcripts: Vec::new(),
+        })
+    }
+
+    /// Snapshot `scene` and queue it for writing to `path`.
+    pub fn save_to_path(
+        &mut self,
+        scene: &crate::game::ecs::scene::EcsScene,
+        path: &Path,
+    ) -> anyhow::Result<()> {
+        let job = SaveJob { save: ecs_to_proto(scene), path: path.to_path_buf() };
+        self.jobs
+            .as_ref()
+            .and_then(|jobs| jobs.send(job).ok())
+            .context("save writer thread has stopped")?;
+        self.pending += 1;
+        Ok(())
+    }
+
+    /// Snapshot `scene` and queue it for slot `slot` (see [`ecs_save_game`]).
+    pub fn save_game(
+        &mut self,
+        scene: &crate::game::ecs::scene::EcsScene,
+        slot: u8,
+    ) -> anyhow::Result<()> {
+        self.save_to_path(scene, &slot_path(slot)?)
+    }
+
+    /// Bring the transcript of slot `slot` up to date with `lines`, appending
+    /// to what earlier saves of the slot wrote.  Runs on the calling thread.
+    pub fn save_transcript(&mut self, lines: &[String], slot: u8) -> anyhow::Result<()> {
+        let i = match self.transcripts.iter().position(|(s, _)| *s == slot) {
+            Some(i) => i,
+            None => {
+                self.transcripts.push((slot, TranscriptLog::for_slot(slot)?));
+                self.transcripts.len() - 1
+            }
+        };
+        self.transcripts[i].1.sync(lines)
+    }
+
+    /// Note that slot `slot` was just loaded with transcript `lines`, so the
+    /// next [`save_transcript`](Self::save_transcript) appends to it.
+    pub fn resume_transcript(&mut self, lines: &[String], slot: u8) -> anyhow::Result<()> {
+        let log = TranscriptLog::for_slot(slot)?.resume(lines);
+        self.transcripts.retain(|(s, _)| *s != slot);
+        self.transcripts.push((slot, log));
+        Ok(())
+    }
+
+    /// Queued saves not yet reported back through `poll` or `flush`.
+    pub fn pending(&self) -> usize {
+        self.pending
+    }
+
+    /// Collect finished writes without blocking.
+    pub fn poll(&mut self) -> Vec<SaveResult> {
+        let done: Vec<SaveResult> = self.results.try_iter().collect();
+        self.pending -= done.iter().map(|(_, covered, _)| covered).sum::<usize>();
+        done
+    }
+
+    /// Block until every queued save has been written.
+    pub fn flush(&mut self) -> Vec<SaveResult> {
+        let mut done = Vec::new();
+        while self.pending > 0 {
+            let Ok(result) = self.results.recv() else { break; };
+            self.pending -= result.1;
+            done.push(result);
+        }
+        done
+    }
+}
+
+impl Drop for SaveWriter {
+    fn drop(&mut self) {
+        // Closing the queue ends the worker once it has drained it.
+        self.jobs = None;
+        if let Some(thread) = self.thread.take() {
+            let _ = thread.join();
+        }
+    }
 }
 
 /// Load a save file from an explicit path into an existing `EcsScene`.
@@ -589,6 +768,14 @@ pub fn ecs_load_from_path(
 ) -> anyhow::Result<()> {
     let data = std::fs::read(path)
         .map_err(|e| anyhow::anyhow!("failed to read save file {}: {}", path.display(), e))?;
+    ecs_load_from_bytes(&data, scene)
+}
+
+/// Load save-file bytes (see [`ecs_save_to_bytes`]) into an existing `EcsScene`.
+pub fn ecs_load_from_bytes(
+    data: &[u8],
+    scene: &mut crate::game::ecs::scene::EcsScene,
+) -> anyhow::Result<()> {
     if data.len() < 8 {
         anyhow::bail!("invalid save file: too short");
     }
@@ -636,27 +823,120 @@ fn transcript_path(slot: u8) -> anyhow::Result<std::path::PathBuf> {
 }
 
 /// Overwrite (or create) the transcript file for `slot` with `lines`.
-/// Each line is written as a UTF-8 text line.
+/// Each line is written as a UTF-8 text line.  Repeated saves should go
+/// through [`SaveWriter::save_transcript`], which appends.
 pub fn save_transcript(lines: &[String], slot: u8) -> anyhow::Result<()> {
-    use std::io::Write;
-    let path = transcript_path(slot)?;
-    std::fs::create_dir_all(path.parent().unwrap())
-        .with_context(|| format!("creating save directory for transcript"))?;
-    let mut f = std::fs::File::create(&path)
-        .with_context(|| format!("creating transcript {}", path.display()))?;
-    for line in lines {
-        writeln!(f, "{}", line)?;
-    }
-    Ok(())
+    TranscriptLog::for_slot(slot)?.sync(lines)
 }
 
 /// Load the transcript for `slot`.  Returns an empty `Vec` if no file exists.
 pub fn load_transcript(slot: u8) -> Vec<String> {
-    transcript_path(slot)
+    transcript_lines(slot).collect()
+}
+
+/// Stream the transcript for `slot` line by line; empty if no file exists.
+pub fn transcript_lines(slot: u8) -> impl Iterator<Item = String> {
+    transcript_path(slot).into_iter().flat_map(|p| transcript_lines_from_path(&p))
+}
+
+/// Stream a transcript file line by line.  Exposed for testing.
+pub fn transcript_lines_from_path(path: &Path) -> impl Iterator<Item = String> {
+    std::fs::File::open(path)
         .ok()
-        .and_then(|p| std::fs::read_to_string(&p).ok())
-        .map(|data| data.lines().map(|l| l.to_string()).collect())
-        .unwrap_or_default()
+        .map(std::io::BufReader::new)
+        .into_iter()
+        .flat_map(|r| r.lines().map_while(Result::ok))
+}
+
+/// Append-only transcript file: remembers what is already on disk and writes
+/// only the new lines.  The first `sync` of a fresh log (or one after the
+/// transcript shrank, e.g. a new game) rewrites the file.  The last line may
+/// still grow (`MessageQueue::print_cont`), so it is kept and rewritten when
+/// it changes.
+pub struct TranscriptLog {
+    path:    PathBuf,
+    /// What is known to be on disk; `None` until the file has been written.
+    written: Option<Written>,
+}
+
+struct Written {
+    lines: usize,
+    /// Byte offset of the last line, and the file length.
+    last_start: u64,
+    end: u64,
+    last: String,
+}
+
+impl Written {
+    /// `lines` on disk, in a file `end` bytes long.
+    fn ending_at(lines: &[String], end: u64) -> Self {
+        let last = lines.last().cloned().unwrap_or_default();
+        let last_start = if lines.is_empty() { 0 } else { end - (last.len() as u64 + 1) };
+        Written { lines: lines.len(), last_start, end, last }
+    }
+}
+
+impl TranscriptLog {
+    pub fn for_slot(slot: u8) -> anyhow::Result<Self> {
+        Ok(Self::at_path(transcript_path(slot)?))
+    }
+
+    /// Exposed for testing.
+    pub fn at_path(path: PathBuf) -> Self {
+        TranscriptLog { path, written: None }
+    }
+
+    /// Continue a transcript that was just loaded: `lines` are already on disk.
+    pub fn resume(mut self, lines: &[String]) -> Self {
+        let end = lines.iter().map(|l| l.len() as u64 + 1).sum();
+        self.written = Some(Written::ending_at(lines, end));
+        self
+    }
+
+    /// Bring the file up to date with `lines`.
+    pub fn sync(&mut self, lines: &[String]) -> anyhow::Result<()> {
+        // Lines on disk that still match, and the file length they end at.
+        let kept = match &self.written {
+            Some(w) if w.lines > lines.len() => None,
+            Some(w) if w.lines > 0 && lines[w.lines - 1] != w.last => {
+                Some((w.lines - 1, w.last_start))
+            }
+            Some(w) => Some((w.lines, w.end)),
+            None => None,
+        };
+        let (mut f, kept, at) = match kept {
+            Some((n, _)) if n == lines.len() => return Ok(()),
+            Some((n, at)) => {
+                let f = std::fs::OpenOptions::new()
+                    .append(true)
+                    .create(true)
+                    .open(&self.path)
+                    .with_context(|| format!("opening transcript {}", self.path.display()))?;
+                // Drop a last line that has changed since it was written.
+                if self.written.as_ref().is_some_and(|w| at < w.end) {
+                    f.set_len(at)?;
+                }
+                (f, n, at)
+            }
+            None => {
+                if let Some(dir) = self.path.parent() {
+                    std::fs::create_dir_all(dir)
+                        .context("creating save directory for transcript")?;
+                }
+                let f = std::fs::File::create(&self.path)
+                    .with_context(|| format!("creating transcript {}", self.path.display()))?;
+                (f, 0, 0)
+            }
+        };
+        let mut buf = String::new();
+        for line in &lines[kept..] {
+            buf.push_str(line);
+            buf.push('\n');
+        }
+        f.write_all(buf.as_bytes())?;
+        self.written = Some(Written::ending_at(lines, at + buf.len() as u64));
+        Ok(())
+    }
 }
 
 #[cfg(test)]
@@ -898,6 +1178,8 @@ mod tests {
         scene.res.clock.cycle        = 42;
         scene.res.clock.light_timer  = 100;
         scene.res.clock.secret_timer = 50;
+        scene.res.clock.tick_counter = 777;
+        scene.res.rng.seed           = 0xdead_beef;
 
         ecs_save_to_path(&scene, &path).unwrap();
 
@@ -909,6 +1191,8 @@ mod tests {
         assert_eq!(loaded.res.clock.cycle,        42);
         assert_eq!(loaded.res.clock.light_timer,  100);
         assert_eq!(loaded.res.clock.secret_timer, 50);
+        assert_eq!(loaded.res.clock.tick_counter, 777);
+        assert_eq!(loaded.res.rng.seed,           0xdead_beef);
     }
 
     #[test]
@@ -952,6 +1236,64 @@ mod tests {
         assert_eq!(loaded.res.view.viewstatus,         99,  "viewstatus set to 99");
     }
 
+    #[test]
+    fn save_writer_keeps_the_newest_snapshot() {
+        use crate::game::ecs::components::HeroStats;
+        let dir = tempdir().unwrap();
+        let path = dir.path().join("bg.sav");
+
+        let scene = crate::game::ecs::scene::new_for_test();
+        let mut writer = SaveWriter::start().unwrap();
+        for vitality in [10, 20, 30] {
+            scene.world.get::<&mut HeroStats>(scene.res.hero_entity)
+                .map(|mut s| s.vitality = vitality).ok();
+            writer.save_to_path(&scene, &path).unwrap();
+        }
+        let results = writer.flush();
+        assert_eq!(writer.pending(), 0);
+        assert_eq!(results.iter().map(|(_, covered, _)| covered).sum::<usize>(), 3);
+        assert!(results.iter().all(|(_, _, r)| r.is_ok()));
+        assert!(!dir.path().join("bg.sav.tmp").exists(), "temp file renamed away");
+
+        let mut loaded = crate::game::ecs::scene::new_for_test();
+        ecs_load_from_path(&path, &mut loaded).unwrap();
+        let s = loaded.world.get::<&HeroStats>(loaded.res.hero_entity).unwrap();
+        assert_eq!(s.vitality, 30);
+    }
+
+    #[test]
+    fn transcript_log_appends_only_new_lines() {
+        let dir = tempdir().unwrap();
+        let path = dir.path().join("save00.txt");
+        let mut lines: Vec<String> = vec!["line 1".into()];
+
+        let mut log = TranscriptLog::at_path(path.clone());
+        log.sync(&lines).unwrap();
+        lines.push("line 2".into());
+        log.sync(&lines).unwrap();
+        log.sync(&lines).unwrap();
+        assert_eq!(transcript_lines_from_path(&path).collect::<Vec<_>>(), lines);
+
+        // A resumed log appends after what is on disk.
+        let mut resumed = TranscriptLog::at_path(path.clone()).resume(&lines);
+        lines.push("line 3".into());
+        resumed.sync(&lines).unwrap();
+        assert_eq!(transcript_lines_from_path(&path).count(), 3);
+
+        // A last line continued in place (print_cont) is rewritten.
+        lines.last_mut().unwrap().push_str(" continued");
+        resumed.sync(&lines).unwrap();
+        lines.push("line 4".into());
+        resumed.sync(&lines).unwrap();
+        assert_eq!(transcript_lines_from_path(&path).collect::<Vec<_>>(), lines);
+
+        // A shorter transcript (new game) rewrites the file.
+        let fresh = vec!["new game".to_string()];
+        resumed.sync(&fresh).unwrap();
+        assert_eq!(transcript_lines_from_path(&path).collect::<Vec<_>>(), fresh);
+        assert_eq!(transcript_lines_from_path(&dir.path().join("none.txt")).count(), 0);
+    }
+
     #[test]
     fn ecs_bad_magic_rejected() {
         let dir = tempdir().unwrap();
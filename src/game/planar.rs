@@ -0,0 +1,115 @@
+//! Amiga bitplane → chunky (one palette index per byte) conversion.
+//!
+//! Every loader that turns planar graphics into palette indices goes through
+//! [`row_to_chunky`]: the tile atlas, sprite sheets, and the `BitMap` index
+//! buffer behind IFF images.
+//!
+//! The transpose works a byte at a time: [`SPREAD`] maps one plane byte to
+//! eight pixel bytes holding that plane's bit in bit 0, so a group of eight
+//! pixels is one table load, shift and OR per plane.  Each lane only ever
+//! holds one bit per plane, so the ORs never carry between pixels.
+//! [`row_to_chunky_scalar`] is the bit-by-bit reference.
+
+/// Most planes a pixel can be built from (one bit per plane in a `u8`).
+pub const MAX_PLANES: usize = 8;
+
+/// Plane byte → eight pixel lanes in little-endian byte order; lane `i` is
+/// bit `7 - i` of the index (the leftmost pixel is the most significant bit).
+const SPREAD: [u64; 256] = build_spread();
+
+const fn build_spread() -> [u64; 256] {
+    let mut table = [0u64; 256];
+    let mut v = 0;
+    while v < 256 {
+        let mut i = 0;
+        while i < 8 {
+            if v & (0x80 >> i) != 0 {
+                table[v] |= 1 << (8 * i);
+            }
+            i += 1;
+        }
+        v += 1;
+    }
+    table
+}
+
+/// Convert one row of planar data to `out.len()` chunky pixels.
+///
+/// `planes[p]` holds the row's bytes for bitplane `p`, which becomes bit `p`
+/// of each pixel.  A plane row shorter than the output reads as zero bits.
+///
+/// # Panics
+///
+/// Panics if more than [`MAX_PLANES`] planes are given.
+pub fn row_to_chunky(planes: &[&[u8]], out: &mut [u8]) {
+    assert!(planes.len() <= MAX_PLANES, "planar::row_to_chunky: too many planes");
+    let full = out.len() / 8;
+    let mut groups = out.chunks_exact_mut(8);
+    for (byte, dst) in (&mut groups).enumerate() {
+        dst.copy_from_slice(&gather(planes, byte).to_le_bytes());
+    }
+    let tail = groups.into_remainder();
+    if !tail.is_empty() {
+        let pixels = gather(planes, full).to_le_bytes();
+        tail.copy_from_slice(&pixels[..tail.len()]);
+    }
+}
+
+/// Eight pixels from byte `byte` of every plane row.
+#[inline]
+fn gather(planes: &[&[u8]], byte: usize) -> u64 {
+    planes
+        .iter()
+        .enumerate()
+        .fold(0, |acc, (p, plane)| acc | SPREAD[plane.get(byte).copied().unwrap_or(0) as usize] << p)
+}
+
+/// Bit-by-bit reference for [`row_to_chunky`].
+pub fn row_to_chunky_scalar(planes: &[&[u8]], out: &mut [u8]) {
+    for (x, dst) in out.iter_mut().enumerate() {
+        let mut index = 0u8;
+        for (p, plane) in planes.iter().enumerate() {
+            let byte = plane.get(x / 8).copied().unwrap_or(0);
+            index |= ((byte >> (7 - x % 8)) & 1) << p;
+        }
+        *dst = index;
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn pattern(len: usize, seed: usize) -> Vec<u8> {
+        (0..len).map(|i| ((i * 37 + seed * 101 + i / 5) & 0xFF) as u8).collect()
+    }
+
+    #[test]
+    fn matches_scalar_reference() {
+        // Partial groups, word-sized sprite/tile rows, a lores screen row, and
+        // every plane count up to MAX_PLANES.
+        for depth in 1..=MAX_PLANES {
+            let rows: Vec<Vec<u8>> = (0..depth).map(|p| pattern(40, p)).collect();
+            let planes: Vec<&[u8]> = rows.iter().map(|r| r.as_slice()).collect();
+            for width in [0usize, 1, 7, 8, 9, 16, 31, 320] {
+                let mut fast = vec![0xEEu8; width];
+                let mut slow = vec![0xEEu8; width];
+                row_to_chunky(&planes, &mut fast);
+                row_to_chunky_scalar(&planes, &mut slow);
+                assert_eq!(fast, slow, "mismatch at depth {depth} width {width}");
+            }
+        }
+    }
+
+    #[test]
+    fn leftmost_pixel_is_the_high_bit() {
+        let p0 = [0x80u8, 0x01];
+        let p4 = [0x80u8, 0x00];
+        let empty: [u8; 0] = [];
+        let mut out = [0u8; 16];
+        row_to_chunky(&[&p0, &empty, &empty, &empty, &p4], &mut out);
+        assert_eq!(out[0], 0b10001);
+        assert_eq!(out[15], 0b00001);
+        assert!(out[1..15].iter().all(|&v| v == 0), "short planes read as zero");
+    }
+}
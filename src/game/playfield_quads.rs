@@ -0,0 +1,316 @@
+//! The playfield as textured quads, for `gpu_playfield`.
+//!
+//! The CPU path composes tiles into `MapRenderer::framebuf`, blits sprites
+//! over them and re-stamps masking tiles after each sprite.  The same frame
+//! is a list of copies from four kinds of texture, drawn in order:
+//!
+//! - every visible tile from the terrain atlas;
+//! - per sprite, back to front: its frame, then each span `mask_spans`
+//!   finds, taken from an atlas where only the tile's shadow-mask pixels
+//!   are opaque (or tile 64's mask, for case 6 above the ground row).
+//!
+//! Atlases hold 16 tiles (or sprite frames) per row.  Pixels are ARGB8888
+//! words through the display LUT, transparent where a pixel does not draw.
+
+use crate::game::map_view::{SCROLL_TILES, SCROLL_TILES_H, SCROLL_TILES_W};
+use crate::game::palette_lut::Lut;
+use crate::game::sprite_mask::{mask_spans, BlittedSprite, SpriteMaskTable};
+use crate::game::sprites::{FrameSource, SpriteSheet, SPRITE_H, SPRITE_W};
+use crate::game::tile_atlas::{TileAtlas, TILE_H, TILE_W, TOTAL_TILES};
+
+/// Tiles (or sprite frames) per atlas row.
+pub const ATLAS_COLS: usize = 16;
+pub const TILE_ATLAS_W: u32 = (ATLAS_COLS * TILE_W) as u32;
+pub const TILE_ATLAS_H: u32 = (TOTAL_TILES / ATLAS_COLS * TILE_H) as u32;
+
+/// Index 31 is transparent in sprite frames (all planes set).
+const SPRITE_TRANSPARENT: u8 = 31;
+
+/// Texture a quad copies from.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum Layer {
+    /// Opaque tiles.
+    Terrain,
+    /// Tiles showing only their own shadow-mask pixels.
+    Masked,
+    /// Tiles showing only tile 64's shadow-mask pixels.
+    Case6,
+    Sprite(FrameSource),
+}
+
+/// Copy `w × h` pixels from `src` in `layer` to `dst` in playfield pixels.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct Quad {
+    pub layer: Layer,
+    pub src: (i32, i32),
+    pub dst: (i32, i32),
+    pub w: i32,
+    pub h: i32,
+}
+
+/// One frame's viewport, as `MapRenderer::compose` would draw it.
+pub struct PlayfieldView<'a> {
+    pub minimap: &'a [u16; SCROLL_TILES],
+    pub ox: i32,
+    pub oy: i32,
+    pub masks: &'a SpriteMaskTable,
+    pub hero_sector: u16,
+    /// Visible size; quads are clipped to `0..w × 0..h`.
+    pub size: (i32, i32),
+}
+
+/// Append `view`'s tiles and then `sprites` (back to front) to `out`.
+pub fn build_quads<'s>(
+    out: &mut Vec<Quad>,
+    view: &PlayfieldView<'_>,
+    sheets: &[Option<SpriteSheet>],
+    object_sprites: Option<&SpriteSheet>,
+    sprites: impl IntoIterator<Item = (FrameSource, usize, &'s BlittedSprite)>,
+) {
+    let mut push = |layer, src: (i32, i32), dst: (i32, i32), w: i32, h: i32| {
+        // Clip to the view, moving the source corner with the destination.
+        let (x0, y0) = (dst.0.max(0), dst.1.max(0));
+        let x1 = (dst.0 + w).min(view.size.0);
+        let y1 = (dst.1 + h).min(view.size.1);
+        if x0 < x1 && y0 < y1 {
+            out.push(Quad {
+                layer,
+                src: (src.0 + x0 - dst.0, src.1 + y0 - dst.1),
+                dst: (x0, y0),
+                w: x1 - x0,
+                h: y1 - y0,
+            });
+        }
+    };
+
+    for ty in 0..SCROLL_TILES_H {
+        for tx in 0..SCROLL_TILES_W {
+            // Out-of-range indices draw the last tile, as in compose().
+            let tile = (view.minimap[ty * SCROLL_TILES_W + tx] as usize).min(TOTAL_TILES - 1);
+            let dst = (tx as i32 * TILE_W as i32 - view.ox, ty as i32 * TILE_H as i32 - view.oy);
+            push(Layer::Terrain, tile_origin(tile), dst, TILE_W as i32, TILE_H as i32);
+        }
+    }
+
+    for (source, frame, sprite) in sprites {
+        let Some(sheet) = source.sheet(sheets, object_sprites) else { continue };
+        if frame >= sheet.num_frames {
+            continue;
+        }
+        let rows = sprite.height.min(SPRITE_H).min(sheet.frame_h) as i32;
+        let src = (
+            (frame % ATLAS_COLS * SPRITE_W) as i32,
+            (frame / ATLAS_COLS * sheet.frame_h) as i32,
+        );
+        push(Layer::Sprite(source), src, (sprite.screen_x, sprite.screen_y), SPRITE_W as i32, rows);
+
+        mask_spans(view.minimap, view.ox, view.oy, view.masks, sprite, view.hero_sector, 0, |span| {
+            let layer = if span.case6 { Layer::Case6 } else { Layer::Masked };
+            let (sx, sy) = tile_origin(span.tile_idx);
+            push(
+                layer,
+                (sx + span.col_lo, sy + span.row_lo),
+                (span.tile_x + span.col_lo, span.tile_y + span.row_lo),
+                span.col_hi - span.col_lo + 1,
+                span.row_hi - span.row_lo + 1,
+            );
+        });
+    }
+}
+
+/// Top-left corner of `tile` in a tile atlas.
+fn tile_origin(tile: usize) -> (i32, i32) {
+    ((tile % ATLAS_COLS * TILE_W) as i32, (tile / ATLAS_COLS * TILE_H) as i32)
+}
+
+/// Fill `out` with a tile atlas image (`TILE_ATLAS_W × TILE_ATLAS_H` ARGB
+/// words, native byte order).  `rows(tile)` selects each tile's opaque
+/// pixels, bit 15 = column 0.
+pub fn tile_atlas_texels(
+    atlas: &TileAtlas,
+    lut: &Lut,
+    rows: impl Fn(usize) -> [u16; TILE_H],
+    out: &mut Vec<u8>,
+) {
+    let pitch = TILE_ATLAS_W as usize;
+    out.clear();
+    out.resize(pitch * TILE_ATLAS_H as usize * 4, 0);
+    for tile in 0..TOTAL_TILES {
+        let pixels = atlas.tile_pixels(tile);
+        let bits = rows(tile);
+        let (x0, y0) = tile_origin(tile);
+        for (row, &word) in bits.iter().enumerate() {
+            for col in 0..TILE_W {
+                if word & (0x8000 >> col) == 0 {
+                    continue;
+                }
+                let texel = ((y0 as usize + row) * pitch + x0 as usize + col) * 4;
+                let argb = lut[(pixels[row * TILE_W + col] & 0x1f) as usize];
+                out[texel..texel + 4].copy_from_slice(&argb.to_ne_bytes());
+            }
+        }
+    }
+}
+
+/// Size of `sheet`'s frame atlas.
+pub fn sheet_atlas_size(sheet: &SpriteSheet) -> (u32, u32) {
+    let rows = sheet.num_frames.div_ceil(ATLAS_COLS).max(1);
+    ((ATLAS_COLS * SPRITE_W) as u32, (rows * sheet.frame_h.max(1)) as u32)
+}
+
+/// Fill `out` with `sheet`'s frame atlas (see [`sheet_atlas_size`]),
+/// transparent where the frame is.
+pub fn sheet_atlas_texels(sheet: &SpriteSheet, lut: &Lut, out: &mut Vec<u8>) {
+    let (w, h) = sheet_atlas_size(sheet);
+    let pitch = w as usize;
+    out.clear();
+    out.resize(pitch * h as usize * 4, 0);
+    for frame in 0..sheet.num_frames {
+        let Some(pixels) = sheet.frame_pixels(frame) else { break };
+        let x0 = frame % ATLAS_COLS * SPRITE_W;
+        let y0 = frame / ATLAS_COLS * sheet.frame_h;
+        for (i, &idx) in pixels.iter().enumerate() {
+            if idx == SPRITE_TRANSPARENT {
+                continue;
+            }
+            let texel = ((y0 + i / SPRITE_W) * pitch + x0 + i % SPRITE_W) * 4;
+            out[texel..texel + 4].copy_from_slice(&lut[(idx & 0x1f) as usize].to_ne_bytes());
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::game::map_renderer::{MapRenderer, MAP_DST_H, MAP_DST_W};
+    use crate::game::sprite_mask::apply_sprite_mask;
+    use crate::game::world_data::WorldData;
+
+    /// Draw `quads` the way the GPU does: opaque terrain, alpha-tested rest.
+    fn rasterize(quads: &[Quad], layer_texels: impl Fn(Layer) -> (Vec<u8>, usize), out: &mut [u32]) {
+        for q in quads {
+            let (texels, pitch) = layer_texels(q.layer);
+            for y in 0..q.h {
+                for x in 0..q.w {
+                    let t = (((q.src.1 + y) as usize * pitch) + (q.src.0 + x) as usize) * 4;
+                    let argb = u32::from_ne_bytes(texels[t..t + 4].try_into().unwrap());
+                    if q.layer == Layer::Terrain || argb >> 24 != 0 {
+                        out[((q.dst.1 + y) * MAP_DST_W as i32 + q.dst.0 + x) as usize] = argb;
+                    }
+                }
+            }
+        }
+    }
+
+    #[test]
+    fn quads_draw_the_same_frame_as_the_framebuf() {
+        let mut world = WorldData::empty();
+        let mut seed = 0x2468_ace1_u32;
+        let mut next = move || {
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            seed
+        };
+        for b in world.image_mem.iter_mut() { *b = next() as u8; }
+        for b in world.sector_mem.iter_mut() { *b = next() as u8; }
+        for t in 0..TOTAL_TILES {
+            world.terra_mem[t * 4] = next() as u8;
+            world.terra_mem[t * 4 + 1] = (next() % 8) as u8;
+        }
+        let shadow_mem: Vec<u8> = (0..12288).map(|_| next() as u8).collect();
+        let mut mr = MapRenderer::new(&world, shadow_mem);
+        let sheet = SpriteSheet {
+            cfile_idx: 0,
+            pixels: (0..40 * 32 * 16).map(|_| (next() % 32) as u8).collect(),
+            num_frames: 40,
+            frame_h: 32,
+        };
+        let sheets = [Some(sheet)];
+
+        let mut lut = [0u32; 32];
+        for (i, v) in lut.iter_mut().enumerate() {
+            *v = 0xFF00_0000 | (i as u32 * 0x0301_07);
+        }
+        let (mut terrain, mut masked, mut case6, mut sprite_texels) = (vec![], vec![], vec![], vec![]);
+        tile_atlas_texels(&mr.atlas, &lut, |_| [0xFFFF; TILE_H], &mut terrain);
+        tile_atlas_texels(&mr.atlas, &lut, |t| mr.masks.tiles[t].rows, &mut masked);
+        tile_atlas_texels(&mr.atlas, &lut, |_| mr.masks.case6_rows, &mut case6);
+        sheet_atlas_texels(sheets[0].as_ref().unwrap(), &lut, &mut sprite_texels);
+        let tile_pitch = TILE_ATLAS_W as usize;
+        let sheet_pitch = sheet_atlas_size(sheets[0].as_ref().unwrap()).0 as usize;
+
+        let mut quads = Vec::new();
+        let mut gpu = vec![0u32; (MAP_DST_W * MAP_DST_H) as usize];
+        for frame in 0..20 {
+            let (map_x, map_y) = ((next() % 0x8000) as u16, (next() % 0x8000) as u16);
+            mr.compose(map_x, map_y, &world);
+            let sprites: Vec<(FrameSource, usize, BlittedSprite)> = (0..6)
+                .map(|_| {
+                    let screen_y = (next() % 230) as i32 - 34;
+                    let sprite = BlittedSprite {
+                        screen_x: (next() % 340) as i32 - 18,
+                        screen_y,
+                        width: SPRITE_W,
+                        height: [8, 22, 32][next() as usize % 3],
+                        ground: screen_y + 32 + (next() % 9) as i32 - 4,
+                        is_falling: next() % 5 == 0,
+                    };
+                    (FrameSource::Cfile(0), (next() % 44) as usize, sprite)
+                })
+                .collect();
+            let hero_sector = [0u16, 48][frame & 1];
+
+            for (source, idx, sprite) in &sprites {
+                let Some(pixels) = source.sheet(&sheets, None).and_then(|s| s.frame_pixels(*idx)) else { continue };
+                for row in 0..sprite.height.min(SPRITE_H) as i32 {
+                    for col in 0..SPRITE_W as i32 {
+                        let (x, y) = (sprite.screen_x + col, sprite.screen_y + row);
+                        let p = pixels[row as usize * SPRITE_W + col as usize];
+                        if p != 31 && x >= 0 && y >= 0 && x < MAP_DST_W as i32 && y < MAP_DST_H as i32 {
+                            mr.framebuf[(y * MAP_DST_W as i32 + x) as usize] = p;
+                        }
+                    }
+                }
+                apply_sprite_mask(&mut mr, sprite, hero_sector, 0);
+            }
+            let cpu: Vec<u32> = mr.framebuf.iter().map(|&p| lut[(p & 0x1f) as usize]).collect();
+
+            quads.clear();
+            let view = PlayfieldView {
+                minimap: &mr.last_minimap,
+                ox: mr.last_ox,
+                oy: mr.last_oy,
+                masks: &mr.masks,
+                hero_sector,
+                size: (MAP_DST_W as i32, MAP_DST_H as i32),
+            };
+            build_quads(&mut quads, &view, &sheets, None, sprites.iter().map(|(s, f, b)| (*s, *f, b)));
+            rasterize(
+                &quads,
+                |layer| match layer {
+                    Layer::Terrain => (terrain.clone(), tile_pitch),
+                    Layer::Masked => (masked.clone(), tile_pitch),
+                    Layer::Case6 => (case6.clone(), tile_pitch),
+                    Layer::Sprite(_) => (sprite_texels.clone(), sheet_pitch),
+                },
+                &mut gpu,
+            );
+            assert!(gpu == cpu, "frame {frame}: quads differ from the framebuf");
+        }
+    }
+
+    #[test]
+    fn quads_are_clipped_to_the_view() {
+        let masks = SpriteMaskTable { tiles: vec![Default::default(); TOTAL_TILES], case6_rows: [0; TILE_H] };
+        let minimap = [3u16; SCROLL_TILES];
+        let view = PlayfieldView { minimap: &minimap, ox: 5, oy: 7, masks: &masks, hero_sector: 0, size: (288, 140) };
+        let mut quads = Vec::new();
+        build_quads(&mut quads, &view, &[], None, []);
+        assert!(quads.iter().all(|q| q.dst.0 >= 0 && q.dst.1 >= 0 && q.dst.0 + q.w <= 288 && q.dst.1 + q.h <= 140));
+        let area: i32 = quads.iter().map(|q| q.w * q.h).sum();
+        assert_eq!(area, 288 * 140);
+        // The first tile lost its top-left corner to the offset.
+        assert_eq!(quads[0], Quad { layer: Layer::Terrain, src: (3 * 16 + 5, 7), dst: (0, 0), w: 11, h: 25 });
+    }
+}
@@ -0,0 +1,208 @@
+//! Scoped stage timer for the tick schedule and the render passes.
+//!
+//! Each named stage keeps its last [`PROFILE_WINDOW`] samples in a fixed ring
+//! (rolling min/avg/p99) plus lifetime totals.  While disabled, `start()`
+//! returns `None` without reading the clock and `record()` returns at once, so
+//! the timers stay in every build and cost one branch per stage.
+
+use std::time::{Duration, Instant};
+
+/// Number of most recent samples kept per stage.
+pub const PROFILE_WINDOW: usize = 256;
+
+struct Stage {
+    name: &'static str,
+    /// Sample durations in nanoseconds (saturating at ~4.3 s).
+    samples: [u32; PROFILE_WINDOW],
+    /// Ring write position.
+    next: usize,
+    /// Valid samples in `samples` (≤ PROFILE_WINDOW).
+    len: usize,
+    total: Duration,
+    calls: u64,
+}
+
+/// Rolling statistics for one stage, as reported by [`Profiler::summary`].
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct StageSummary {
+    pub name: &'static str,
+    /// Calls since the profiler was enabled or reset.
+    pub calls: u64,
+    /// Time since the profiler was enabled or reset.
+    pub total: Duration,
+    /// Over the rolling window.
+    pub min: Duration,
+    pub avg: Duration,
+    pub p99: Duration,
+    /// Most recent sample.
+    pub last: Duration,
+}
+
+/// Stage timings keyed by name, kept in first-recorded order.
+#[derive(Default)]
+pub struct Profiler {
+    enabled: bool,
+    stages: Vec<Stage>,
+}
+
+impl Profiler {
+    pub fn set_enabled(&mut self, enabled: bool) {
+        self.enabled = enabled;
+    }
+
+    /// Forget all samples and totals; stage order is rebuilt as they recur.
+    pub fn reset(&mut self) {
+        self.stages.clear();
+    }
+
+    /// Begin timing a stage: `None` (no clock read) while disabled.
+    #[inline]
+    pub fn start(&self) -> Option<Instant> {
+        self.enabled.then(Instant::now)
+    }
+
+    /// Charge the time since `start` to `name`.  No-op for `None`.
+    #[inline]
+    pub fn record(&mut self, name: &'static str, start: Option<Instant>) {
+        if let Some(start) = start {
+            self.record_sample(name, start.elapsed());
+        }
+    }
+
+    pub fn record_sample(&mut self, name: &'static str, elapsed: Duration) {
+        let idx = match self.stages.iter().position(|s| s.name == name) {
+            Some(i) => i,
+            None => {
+                self.stages.push(Stage {
+                    name,
+                    samples: [0; PROFILE_WINDOW],
+                    next: 0,
+                    len: 0,
+                    total: Duration::ZERO,
+                    calls: 0,
+                });
+                self.stages.len() - 1
+            }
+        };
+        let stage = &mut self.stages[idx];
+        stage.samples[stage.next] = u32::try_from(elapsed.as_nanos()).unwrap_or(u32::MAX);
+        stage.next = (stage.next + 1) % PROFILE_WINDOW;
+        stage.len = (stage.len + 1).min(PROFILE_WINDOW);
+        stage.total += elapsed;
+        stage.calls += 1;
+    }
+
+    /// Sum of lifetime totals over all stages.
+    pub fn total(&self) -> Duration {
+        self.stages.iter().map(|s| s.total).sum()
+    }
+
+    pub fn summary(&self) -> Vec<StageSummary> {
+        let mut out = Vec::with_capacity(self.stages.len());
+        self.summary_into(&mut out);
+        out
+    }
+
+    /// [`summary`](Self::summary) into an existing vector, reusing its storage.
+    pub fn summary_into(&self, out: &mut Vec<StageSummary>) {
+        let mut sorted = [0u32; PROFILE_WINDOW];
+        out.clear();
+        out.extend(self.stages.iter().map(|s| {
+            let window = &mut sorted[..s.len];
+            window.copy_from_slice(&s.samples[..s.len]);
+            window.sort_unstable();
+            let ns = |v: u32| Duration::from_nanos(u64::from(v));
+            let sum: u64 = window.iter().map(|&v| u64::from(v)).sum();
+            let last = (s.next + PROFILE_WINDOW - 1) % PROFILE_WINDOW;
+            StageSummary {
+                name: s.name,
+                calls: s.calls,
+                total: s.total,
+                min: window.first().map_or(Duration::ZERO, |&v| ns(v)),
+                avg: Duration::from_nanos(sum / s.len.max(1) as u64),
+                // Nearest-rank 99th percentile.
+                p99: window
+                    .get((s.len * 99).div_ceil(100).saturating_sub(1))
+                    .map_or(Duration::ZERO, |&v| ns(v)),
+                last: if s.len == 0 {
+                    Duration::ZERO
+                } else {
+                    ns(s.samples[last])
+                },
+            }
+        }));
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn us(n: u64) -> Duration {
+        Duration::from_micros(n)
+    }
+
+    #[test]
+    fn disabled_profiler_records_nothing() {
+        let mut p = Profiler::default();
+        let start = p.start();
+        assert!(start.is_none());
+        p.record("clock", start);
+        assert!(p.summary().is_empty());
+    }
+
+    #[test]
+    fn stages_report_in_first_recorded_order() {
+        let mut p = Profiler::default();
+        p.set_enabled(true);
+        p.record_sample("movement", us(5));
+        p.record_sample("clock", us(1));
+        p.record_sample("movement", us(7));
+        let s = p.summary();
+        assert_eq!(
+            s.iter().map(|s| s.name).collect::<Vec<_>>(),
+            ["movement", "clock"]
+        );
+        assert_eq!(s[0].calls, 2);
+        assert_eq!(s[0].total, us(12));
+        assert_eq!(s[0].min, us(5));
+        assert_eq!(s[0].avg, us(6));
+        assert_eq!(s[0].last, us(7));
+        assert_eq!(p.total(), us(13));
+    }
+
+    #[test]
+    fn window_rolls_over_but_totals_do_not() {
+        let mut p = Profiler::default();
+        p.set_enabled(true);
+        // 100 slow samples, then a full window of fast ones pushes them all out.
+        for _ in 0..100 {
+            p.record_sample("compose", us(1000));
+        }
+        for i in 0..PROFILE_WINDOW as u64 {
+            p.record_sample("compose", us(10 + i % 2));
+        }
+        let s = p.summary()[0];
+        assert_eq!(s.calls, 100 + PROFILE_WINDOW as u64);
+        assert_eq!(s.total, us(100 * 1000 + 10 * 256 + 128));
+        assert_eq!(s.min, us(10));
+        assert_eq!(s.p99, us(11));
+        assert_eq!(s.last, us(11));
+    }
+
+    #[test]
+    fn p99_picks_the_outlier_tail() {
+        let mut p = Profiler::default();
+        p.set_enabled(true);
+        // 200 samples: 197 at 1 us, 3 spikes.  Nearest rank 198 is a spike.
+        for _ in 0..197 {
+            p.record_sample("present", us(1));
+        }
+        for t in [50, 60, 70] {
+            p.record_sample("present", us(t));
+        }
+        assert_eq!(p.summary()[0].p99, us(50));
+        p.reset();
+        assert!(p.summary().is_empty());
+    }
+}
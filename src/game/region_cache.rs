@@ -0,0 +1,440 @@
+//! Region asset cache: decoded WorldData, TileAtlas and sprite mask tables per
+//! region, held in a small LRU and filled ahead of time by a background
+//! prefetch worker so region transitions don't decode on the game thread.
+//! With a data bundle attached, tile atlases are copied from it instead of
+//! being decoded from the ADF bitplanes.
+
+use std::collections::HashSet;
+use std::sync::mpsc::{channel, Receiver, Sender};
+use std::sync::{Arc, Mutex};
+use std::thread::JoinHandle;
+
+use anyhow::Result;
+
+use crate::game::adf::AdfDisk;
+use crate::game::bundle::Bundle;
+use crate::game::game_library::GameLibrary;
+use crate::game::map_renderer::MapRenderer;
+use crate::game::sprite_mask::SpriteMaskTable;
+use crate::game::tile_atlas::TileAtlas;
+use crate::game::world_data::{load_shadow_mem, WorldData};
+
+/// Number of decoded regions kept resident.
+pub const REGION_CACHE_CAPACITY: usize = 6;
+
+/// ADF block locations for one region. Owned so it can be sent to the worker.
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct RegionSource {
+    pub region: u8,
+    pub sector_block: u32,
+    pub map_blocks: Vec<u32>,
+    pub terra_block: u32,
+    pub terra2_block: u32,
+    pub image_blocks: Vec<u32>,
+    pub shadow_block: u32,
+    pub shadow_count: u32,
+}
+
+impl RegionSource {
+    /// Resolve block locations from faery.toml. Outdoor regions (< 8) load all
+    /// four overworld map strips; indoor regions load only their own.
+    pub fn from_library(game_lib: &GameLibrary, region: u8) -> Option<Self> {
+        let cfg = game_lib.find_region_config(region)?;
+        let map_blocks = if region < 8 {
+            [0u8, 2, 4, 6]
+                .iter()
+                .filter_map(|&r| game_lib.find_region_config(r))
+                .map(|c| c.map_block)
+                .collect()
+        } else {
+            vec![cfg.map_block]
+        };
+        let (shadow_block, shadow_count) = game_lib
+            .disk
+            .as_ref()
+            .map_or((0, 0), |d| (d.shadow_block, d.shadow_count));
+        Some(RegionSource {
+            region,
+            sector_block: cfg.sector_block,
+            map_blocks,
+            terra_block: cfg.terra_block,
+            terra2_block: cfg.terra2_block,
+            image_blocks: cfg.image_blocks.clone(),
+            shadow_block,
+            shadow_count,
+        })
+    }
+}
+
+/// Everything decoded from disk for one region.
+pub struct RegionAssets {
+    /// Pristine world data as loaded. The live scene gets a clone, so door
+    /// tile replacements are discarded on re-entry exactly as a disk reload would.
+    pub world: WorldData,
+    pub atlas: Arc<TileAtlas>,
+    pub masks: Arc<SpriteMaskTable>,
+    pub shadow_mem: Vec<u8>,
+}
+
+impl RegionAssets {
+    /// Load `src` from `adf`, taking the tile atlas from `bundle` when it has
+    /// one for this region.
+    pub fn load(src: &RegionSource, adf: &AdfDisk, bundle: Option<&Bundle>) -> Result<Self> {
+        // Tile images are decoded straight from the ADF; image_mem stays empty.
+        let world = WorldData::load_terrain(
+            adf,
+            src.region,
+            src.sector_block,
+            &src.map_blocks,
+            src.terra_block,
+            src.terra2_block,
+        )?;
+        // Build the collision grid here (on the prefetch worker when there is
+        // one); the live copies made by `instantiate()` copy it.  Outdoors,
+        // where the Bird Totem can show it, the overview raster too.
+        world.terrain_grid();
+        if src.region < 8 {
+            world.overview();
+        }
+        let shadow_mem = if src.shadow_count > 0 {
+            load_shadow_mem(adf, src.shadow_block, src.shadow_count)
+        } else {
+            Vec::new()
+        };
+        let atlas = bundle
+            .and_then(|b| b.tile_atlas(src.region))
+            .unwrap_or_else(|| TileAtlas::from_adf(adf, &src.image_blocks, &world.terra_mem[..]));
+        let masks = SpriteMaskTable::build(&atlas, &shadow_mem);
+        Ok(RegionAssets {
+            world,
+            atlas: Arc::new(atlas),
+            masks: Arc::new(masks),
+            shadow_mem,
+        })
+    }
+
+    /// A fresh (world, renderer) pair for the live scene. The tile atlas and
+    /// mask tables are shared, not re-decoded.  The world gets its own copy
+    /// of the terrain grid and overview (a memcpy, not a rebuild) so door
+    /// tiles written during play never copy them out from under the cache
+    /// mid-tick.
+    pub fn instantiate(&self) -> (WorldData, MapRenderer) {
+        let renderer = MapRenderer::from_tables(
+            self.atlas.clone(),
+            self.masks.clone(),
+            self.shadow_mem.clone(),
+        );
+        let mut world = self.world.clone();
+        world.unshare_caches();
+        (world, renderer)
+    }
+}
+
+type LoadResult = (u8, Result<RegionAssets>);
+
+struct Prefetcher {
+    requests: Sender<RegionSource>,
+    results: Receiver<LoadResult>,
+    _thread: JoinHandle<()>,
+}
+
+/// Decoded regions shared by several scenes in one process (batch headless
+/// runs).  Each region is decoded once, by the first scene to ask for it, and
+/// kept for the life of the store.
+#[derive(Default)]
+pub struct SharedRegions {
+    /// One slot per region asked for; a slot is filled by whichever scene
+    /// decodes it first.
+    entries: Mutex<Vec<(u8, Arc<RegionSlot>)>>,
+    bundle: Option<Arc<Bundle>>,
+}
+
+type RegionSlot = Mutex<Option<Arc<RegionAssets>>>;
+
+impl SharedRegions {
+    /// A store that takes tile atlases from `bundle` where it can.
+    pub fn with_bundle(bundle: Option<Arc<Bundle>>) -> Self {
+        SharedRegions { entries: Mutex::default(), bundle }
+    }
+
+    /// Return the assets for `src`, decoding them on first use.  Other scenes
+    /// asking for the same region meanwhile wait rather than decode it again;
+    /// scenes after other regions are not held up.
+    pub fn get(&self, src: &RegionSource, adf: &AdfDisk) -> Result<Arc<RegionAssets>> {
+        // Slots are only ever pushed or filled, so a poisoned lock is still valid.
+        let slot = {
+            let mut entries = self.entries.lock().unwrap_or_else(|e| e.into_inner());
+            match entries.iter().find(|(r, _)| *r == src.region) {
+                Some((_, slot)) => slot.clone(),
+                None => {
+                    let slot = Arc::new(RegionSlot::default());
+                    entries.push((src.region, slot.clone()));
+                    slot
+                }
+            }
+        };
+        let mut slot = slot.lock().unwrap_or_else(|e| e.into_inner());
+        if let Some(assets) = slot.as_ref() {
+            return Ok(assets.clone());
+        }
+        let assets = Arc::new(RegionAssets::load(src, adf, self.bundle.as_deref())?);
+        *slot = Some(assets.clone());
+        Ok(assets)
+    }
+}
+
+/// LRU of decoded regions keyed by region number, with an optional worker
+/// thread that loads regions requested via `prefetch()`.
+pub struct RegionCache {
+    capacity: usize,
+    /// Most recently used last.
+    entries: Vec<(u8, Arc<RegionAssets>)>,
+    worker: Option<Prefetcher>,
+    in_flight: HashSet<u8>,
+    /// Store consulted on a miss instead of decoding locally.
+    shared: Option<Arc<SharedRegions>>,
+    /// Precompiled tile atlases, shared with the prefetch worker.
+    bundle: Option<Arc<Bundle>>,
+}
+
+impl Default for RegionCache {
+    fn default() -> Self {
+        Self::new(REGION_CACHE_CAPACITY)
+    }
+}
+
+impl RegionCache {
+    pub fn new(capacity: usize) -> Self {
+        RegionCache {
+            capacity: capacity.max(1),
+            entries: Vec::new(),
+            worker: None,
+            in_flight: HashSet::new(),
+            shared: None,
+            bundle: None,
+        }
+    }
+
+    /// Serve misses from `shared` so scenes running side by side decode each
+    /// region only once.
+    pub fn set_shared(&mut self, shared: Arc<SharedRegions>) {
+        self.shared = Some(shared);
+    }
+
+    /// Copy tile atlases from `bundle` instead of decoding them.  Call before
+    /// `start_prefetcher` so the worker sees it too.
+    pub fn set_bundle(&mut self, bundle: Arc<Bundle>) {
+        self.bundle = Some(bundle);
+    }
+
+    /// Start the prefetch worker for `adf`. Without it, `prefetch()` is a no-op
+    /// and every miss loads synchronously.
+    pub fn start_prefetcher(&mut self, adf: Arc<AdfDisk>) {
+        let (req_tx, req_rx) = channel::<RegionSource>();
+        let (res_tx, res_rx) = channel::<LoadResult>();
+        let bundle = self.bundle.clone();
+        let spawned = std::thread::Builder::new()
+            .name("region-prefetch".to_string())
+            .spawn(move || {
+                for src in req_rx {
+                    let loaded = RegionAssets::load(&src, &adf, bundle.as_deref());
+                    if res_tx.send((src.region, loaded)).is_err() {
+                        break;
+                    }
+                }
+            });
+        self.in_flight.clear();
+        self.worker = spawned.ok().map(|thread| Prefetcher {
+            requests: req_tx,
+            results: res_rx,
+            _thread: thread,
+        });
+    }
+
+    pub fn contains(&self, region: u8) -> bool {
+        self.entries.iter().any(|(r, _)| *r == region)
+    }
+
+    /// Queue a background load of `src` unless it is cached or already queued.
+    pub fn prefetch(&mut self, src: &RegionSource) {
+        self.poll();
+        if self.contains(src.region) || self.in_flight.contains(&src.region) {
+            return;
+        }
+        let Some(worker) = &self.worker else { return; };
+        if worker.requests.send(src.clone()).is_ok() {
+            self.in_flight.insert(src.region);
+        } else {
+            self.worker = None;
+        }
+    }
+
+    /// Move finished background loads into the cache without blocking.
+    pub fn poll(&mut self) {
+        while let Some(result) = self.worker.as_ref().and_then(|w| w.results.try_recv().ok()) {
+            self.accept(result);
+        }
+    }
+
+    /// Return the assets for `src`, waiting for an in-flight prefetch or
+    /// loading synchronously on a miss.
+    pub fn get(&mut self, src: &RegionSource, adf: &AdfDisk) -> Result<Arc<RegionAssets>> {
+        self.poll();
+        while self.in_flight.contains(&src.region) {
+            match self.worker.as_ref().map(|w| w.results.recv()) {
+                Some(Ok(result)) => self.accept(result),
+                // Worker gone (e.g. it panicked): fall back to a synchronous load.
+                _ => {
+                    self.worker = None;
+                    self.in_flight.clear();
+                }
+            }
+        }
+        if let Some(assets) = self.touch(src.region) {
+            return Ok(assets);
+        }
+        let assets = match &self.shared {
+            Some(shared) => shared.get(src, adf)?,
+            None => Arc::new(RegionAssets::load(src, adf, self.bundle.as_deref())?),
+        };
+        self.insert(src.region, assets.clone());
+        Ok(assets)
+    }
+
+    fn accept(&mut self, (region, loaded): LoadResult) {
+        self.in_flight.remove(&region);
+        // A failed prefetch is dropped; the synchronous load in get() reports it.
+        if let Ok(assets) = loaded {
+            self.insert(region, Arc::new(assets));
+        }
+    }
+
+    fn touch(&mut self, region: u8) -> Option<Arc<RegionAssets>> {
+        let pos = self.entries.iter().position(|(r, _)| *r == region)?;
+        let entry = self.entries.remove(pos);
+        let assets = entry.1.clone();
+        self.entries.push(entry);
+        Some(assets)
+    }
+
+    fn insert(&mut self, region: u8, assets: Arc<RegionAssets>) {
+        self.entries.retain(|(r, _)| *r != region);
+        self.entries.push((region, assets));
+        while self.entries.len() > self.capacity {
+            self.entries.remove(0);
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn source(region: u8) -> RegionSource {
+        RegionSource {
+            region,
+            sector_block: 0,
+            map_blocks: vec![64],
+            terra_block: 72,
+            terra2_block: 73,
+            image_blocks: vec![80, 120, 160, 200],
+            shadow_block: 240,
+            shadow_count: 24,
+        }
+    }
+
+    fn make_adf() -> Arc<AdfDisk> {
+        let data = (0..2048 * 512).map(|i: usize| (i * 7 + i / 512) as u8).collect();
+        Arc::new(AdfDisk::from_bytes(data))
+    }
+
+    #[test]
+    fn hit_returns_shared_assets() {
+        let adf = make_adf();
+        let mut cache = RegionCache::new(2);
+        let a = cache.get(&source(3), &adf).unwrap();
+        let b = cache.get(&source(3), &adf).unwrap();
+        assert!(Arc::ptr_eq(&a, &b));
+        assert_eq!(a.shadow_mem.len(), 24 * 512);
+    }
+
+    #[test]
+    fn evicts_least_recently_used() {
+        let adf = make_adf();
+        let mut cache = RegionCache::new(2);
+        cache.get(&source(1), &adf).unwrap();
+        cache.get(&source(2), &adf).unwrap();
+        cache.get(&source(1), &adf).unwrap(); // 2 is now least recent
+        cache.get(&source(3), &adf).unwrap();
+        assert!(cache.contains(1));
+        assert!(!cache.contains(2));
+        assert!(cache.contains(3));
+    }
+
+    #[test]
+    fn prefetched_region_is_served_without_reload() {
+        let adf = make_adf();
+        let mut cache = RegionCache::new(4);
+        cache.start_prefetcher(adf.clone());
+        cache.prefetch(&source(9));
+        // get() waits for the in-flight load instead of decoding again.
+        let assets = cache.get(&source(9), &adf).unwrap();
+        assert!(cache.in_flight.is_empty());
+        let direct = RegionAssets::load(&source(9), &adf, None).unwrap();
+        assert!(assets.atlas.pixels == direct.atlas.pixels);
+    }
+
+    #[test]
+    fn caches_sharing_a_store_decode_once() {
+        let adf = make_adf();
+        let shared = Arc::new(SharedRegions::default());
+        let mut a = RegionCache::new(1);
+        let mut b = RegionCache::new(1);
+        a.set_shared(shared.clone());
+        b.set_shared(shared.clone());
+        let from_a = a.get(&source(5), &adf).unwrap();
+        a.get(&source(6), &adf).unwrap(); // evicts 5 from a, not from the store
+        let from_b = b.get(&source(5), &adf).unwrap();
+        assert!(Arc::ptr_eq(&from_a, &from_b));
+        assert!(Arc::ptr_eq(&a.get(&source(5), &adf).unwrap(), &from_a));
+    }
+
+    #[test]
+    fn bundled_atlas_replaces_the_decode() {
+        use crate::game::bundle::BundleWriter;
+        let adf = make_adf();
+        let decoded = RegionAssets::load(&source(4), &adf, None).unwrap();
+        let mut atlas = TileAtlas {
+            pixels: decoded.atlas.pixels.clone(),
+            mask_type: decoded.atlas.mask_type,
+            maptag: decoded.atlas.maptag,
+        };
+        atlas.pixels[0] ^= 1;
+        let mut w = BundleWriter::default();
+        w.add_tile_atlas(4, &atlas);
+        let bundle = Arc::new(Bundle::from_bytes(w.to_bytes(0), 0).unwrap());
+
+        let mut cache = RegionCache::new(2);
+        cache.set_bundle(bundle);
+        assert!(cache.get(&source(4), &adf).unwrap().atlas.pixels == atlas.pixels);
+        // Regions missing from the bundle still decode from the ADF.
+        let other = cache.get(&source(5), &adf).unwrap();
+        assert!(other.atlas.pixels == RegionAssets::load(&source(5), &adf, None).unwrap().atlas.pixels);
+    }
+
+    #[test]
+    fn instantiated_world_is_an_independent_copy() {
+        let adf = make_adf();
+        let mut cache = RegionCache::new(1);
+        let assets = cache.get(&source(0), &adf).unwrap();
+        let (mut world, renderer) = assets.instantiate();
+        let pristine = assets.world.sector_mem[0];
+        world.sector_mem[0] = pristine.wrapping_add(1);
+        assert_eq!(assets.world.sector_mem[0], pristine);
+        assert!(Arc::ptr_eq(&renderer.atlas, &assets.atlas));
+        // Its terrain grid and overview are copies, so door writes never
+        // touch the cache's.
+        assert!(!std::ptr::eq(world.terrain_grid(), assets.world.terrain_grid()));
+        assert!(!std::ptr::eq(world.overview(), assets.world.overview()));
+    }
+}
@@ -1,9 +1,13 @@
 
 ///
-/// [`RenderResources`] owns every SDL texture that the game creates at
-/// startup — the shared font atlas, the shared image atlas, and the two
-/// off-screen render targets — keeping them decoupled from the raw asset
-/// data in [`GameLibrary`].
+/// [`RenderResources`] owns every SDL texture the game draws from — the
+/// shared font atlas, the image textures, the streaming playfield texture,
+/// the hibar target, and the two off-screen render targets — keeping them
+/// decoupled from the raw asset data in [`GameLibrary`].
+///
+/// Images are uploaded per scene: [`RenderResources::load_images`] creates
+/// textures for the names a scene draws, and
+/// [`RenderResources::evict_images`] frees them once no scene needs them.
 ///
 /// # Lifetime
 ///
@@ -18,6 +22,9 @@
 /// let sys_palette = game_lib.find_palette("introcolors").unwrap();
 /// let mut rr = RenderResources::build(&tex_maker, &game_lib, sys_palette);
 ///
+/// // on scene change:
+/// rr.load_images(&game_lib, scene.images());
+///
 /// // each frame:
 /// let mut resources = rr.prepare(&mut scratch_tex, audio.as_ref());
 /// scene.update(&mut canvas, &mut play_tex, delta, &game_lib, &mut resources);
@@ -37,22 +44,30 @@ use crate::game::bitmap::BitMap;
 use crate::game::colors::Palette;
 use crate::game::font_texture::FontTexture;
 use crate::game::game_library::GameLibrary;
+use crate::game::gpu_playfield::GpuPlayfield;
 use crate::game::image_texture::ImageTexture;
+use crate::game::map_renderer::{MAP_DST_H, MAP_DST_W};
 use crate::game::scene::SceneResources;
 
-// Atlas dimensions — large enough to hold all game images in a single texture.
-const IMAGE_ATLAS_W: u32 = 4096;
-const IMAGE_ATLAS_H: u32 = 4096;
+/// Native size of the hibar (status bar) render target.
+pub const HIBAR_TEX_W: u32 = 640;
+pub const HIBAR_TEX_H: u32 = 57;
 
 pub struct RenderResources<'tex> {
+    tex_maker: &'tex TextureCreator<WindowContext>,
+    /// Fallback for images without their own colormap.
+    sys_palette: Palette,
+
     // --- Font atlas ---
     // The backing texture is kept alive by `Rc`; `FontTexture` holds a `Weak`.
     _font_backing: Rc<RefCell<Texture<'tex>>>,
     pub amber: FontTexture<'tex>,
     pub topaz: FontTexture<'tex>,
 
-    // --- Image atlas ---
-    _image_backing: Rc<RefCell<Texture<'tex>>>,
+    // --- Images ---
+    // One backing texture per uploaded image, parallel to `images`; each
+    // `ImageTexture` holds a `Weak` to its own entry.
+    image_backing: Vec<Rc<RefCell<Texture<'tex>>>>,
     images: Vec<ImageTexture<'tex>>,
     image_map: HashMap<String, usize>,
 
@@ -60,13 +75,25 @@ pub struct RenderResources<'tex> {
     // Pre-composited from hiscreen background + hinor/hivar plane 2 data.
     compass_normal: Option<Texture<'tex>>,
     compass_highlight: Option<Texture<'tex>>,
+
+    // --- Playfield ---
+    // Streaming ARGB8888 texture (MAP_DST_W × MAP_DST_H) that the gameplay
+    // scene locks and rewrites in place each frame from the indexed framebuf.
+    playfield: Texture<'tex>,
+    // Texture-atlas playfield backend, when enabled with `--gpu-playfield`.
+    gpu_playfield: Option<GpuPlayfield<'tex>>,
+
+    // --- Hibar ---
+    // Render target (HIBAR_TEX_W × HIBAR_TEX_H) the gameplay scene repaints
+    // only when the status bar's contents change.
+    hibar: Texture<'tex>,
 }
 
 impl<'tex> RenderResources<'tex> {
     /// Build all SDL rendering resources from the loaded game library.
     ///
-    /// Fonts and images are uploaded to their respective atlas textures
-    /// immediately; the `GameLibrary` reference is not retained.
+    /// Fonts are uploaded to the font atlas immediately; images wait for
+    /// [`Self::load_images`].  The `GameLibrary` reference is not retained.
     pub fn build(
         tex_maker: &'tex TextureCreator<WindowContext>,
         game_lib: &GameLibrary,
@@ -118,68 +145,101 @@ impl<'tex> RenderResources<'tex> {
             topaz.init_stencil(s);
         }
 
-        // ── Image atlas ───────────────────────────────────────────────────
-        let image_atlas_rect = Rect::new(0, 0, IMAGE_ATLAS_W, IMAGE_ATLAS_H);
-        let mut image_atlas_tex = tex_maker
-            .create_texture_static(Some(PixelFormat::RGBA32), IMAGE_ATLAS_W, IMAGE_ATLAS_H)
-            .unwrap();
-        image_atlas_tex.set_scale_mode(sdl3::render::ScaleMode::Nearest);
-        let image_backing = Rc::new(RefCell::new(image_atlas_tex));
-
-        let mut images: Vec<ImageTexture<'tex>> = Vec::new();
-        let mut image_map: HashMap<String, usize> = HashMap::new();
-        let mut next_x: u32 = 0;
-        let mut next_y: u32 = 0;
-        let mut row_h: u32 = 0;
-
-        for name in game_lib.get_image_names() {
-            let asset = game_lib.find_image(&name).unwrap();
-            let iff = match asset.image.as_ref() {
-                Some(i) => i,
-                None => {
-                    println!("Warning: ImageAsset {} has no IffImage data", asset.path);
-                    continue;
-                }
-            };
-
-            // Advance to next row if this image does not fit horizontally.
-            if next_x + iff.width as u32 > image_atlas_rect.width() {
-                next_x = 0;
-                next_y += row_h;
-                row_h = 0;
-            }
-            let slot = Rect::new(
-                next_x as i32,
-                next_y as i32,
-                iff.width as u32,
-                iff.height as u32,
-            );
-            let mut img_tex = ImageTexture::new(iff, &slot, Rc::downgrade(&image_backing));
-
-            let palette = iff.colormap.as_ref().unwrap_or(sys_palette);
-            img_tex.update(palette, iff.transparent_color);
-
-            next_x += iff.width as u32;
-            row_h = row_h.max(iff.height as u32);
-
-            image_map.insert(name, images.len());
-            images.push(img_tex);
-        }
-
         // ── Compass textures ───────────────────────────────────────────────
         // Extract the compass region from hiscreen, combine with hinor/hivar
         // as plane 2, convert to RGBA using the textcolors palette.
         let (compass_normal, compass_highlight) = Self::build_compass_textures(tex_maker, game_lib);
 
+        // ── Playfield streaming texture ────────────────────────────────────
+        let mut playfield = tex_maker
+            .create_texture_streaming(Some(PixelFormat::ARGB8888), MAP_DST_W, MAP_DST_H)
+            .unwrap();
+        playfield.set_scale_mode(sdl3::render::ScaleMode::Nearest);
+
+        // ── Hibar render target ────────────────────────────────────────────
+        let mut hibar = tex_maker
+            .create_texture_target(PixelFormat::RGBA32, HIBAR_TEX_W, HIBAR_TEX_H)
+            .unwrap();
+        hibar.set_scale_mode(sdl3::render::ScaleMode::Nearest);
+
         RenderResources {
+            tex_maker,
+            sys_palette: sys_palette.clone(),
             _font_backing: font_backing,
             amber,
             topaz,
-            _image_backing: image_backing,
-            images,
-            image_map,
+            image_backing: Vec::new(),
+            images: Vec::new(),
+            image_map: HashMap::new(),
             compass_normal,
             compass_highlight,
+            playfield,
+            gpu_playfield: None,
+            hibar,
+        }
+    }
+
+    /// Draw the playfield from tile and sprite textures instead of streaming
+    /// the software framebuf (see [`GpuPlayfield`]).
+    pub fn enable_gpu_playfield(&mut self) {
+        self.gpu_playfield = Some(GpuPlayfield::new(self.tex_maker));
+    }
+
+    // ── Image upload ──────────────────────────────────────────────────────
+
+    /// Upload the images in `names` that are not resident yet, decoding them
+    /// through the library's cache.  Images that fail to load are skipped
+    /// with a warning; scenes already tolerate a missing `find_image`.
+    pub fn load_images(&mut self, game_lib: &GameLibrary, names: &[&str]) {
+        for &name in names {
+            if self.image_map.contains_key(name) {
+                continue;
+            }
+            let iff = match game_lib.load_image(name) {
+                Ok(i) => i,
+                Err(e) => {
+                    println!("Warning: {}", e);
+                    continue;
+                }
+            };
+            let mut tex = match self.tex_maker.create_texture_static(
+                Some(PixelFormat::RGBA32),
+                iff.width as u32,
+                iff.height as u32,
+            ) {
+                Ok(t) => t,
+                Err(e) => {
+                    println!("Warning: could not create texture for image {}: {}", name, e);
+                    continue;
+                }
+            };
+            tex.set_scale_mode(sdl3::render::ScaleMode::Nearest);
+            let backing = Rc::new(RefCell::new(tex));
+
+            let bounds = Rect::new(0, 0, iff.width as u32, iff.height as u32);
+            let mut img_tex = ImageTexture::new(&iff, &bounds, Rc::downgrade(&backing));
+            let palette = iff.colormap.as_ref().unwrap_or(&self.sys_palette);
+            img_tex.update(palette, iff.transparent_color);
+
+            self.image_map.insert(name.to_string(), self.images.len());
+            self.images.push(img_tex);
+            self.image_backing.push(backing);
+        }
+    }
+
+    /// Free the textures of `names`.  Unknown or already-evicted names are
+    /// ignored.
+    pub fn evict_images(&mut self, names: &[&str]) {
+        for name in names {
+            let Some(idx) = self.image_map.remove(*name) else {
+                continue;
+            };
+            self.images.swap_remove(idx);
+            self.image_backing.swap_remove(idx);
+            // The last image moved into `idx`.
+            if let Some(slot) = self.image_map.values_mut().find(|i| **i == self.images.len()) {
+                *slot = idx;
+            }
         }
     }
 
@@ -224,6 +284,9 @@ impl<'tex> RenderResources<'tex> {
             audio,
             compass_normal: self.compass_normal.as_ref(),
             compass_highlight: self.compass_highlight.as_ref(),
+            playfield: &mut self.playfield,
+            gpu_playfield: self.gpu_playfield.as_mut(),
+            hibar: &mut self.hibar,
         }
     }
 
@@ -255,9 +318,7 @@ impl<'tex> RenderResources<'tex> {
         const CH: usize = 24;
 
         let compass_cfg = game_lib.get_compass()?;
-        let hiscreen_iff = game_lib
-            .find_image("hiscreen")
-            .and_then(|a| a.image.as_ref())?;
+        let hiscreen_iff = game_lib.load_image("hiscreen").ok()?;
         let textcolors = game_lib.find_palette("textcolors")?;
 
         // Create a BitMap from the full hiscreen image.
@@ -8,6 +8,7 @@ use sdl3::video::Window;
 use crate::game::audio::AudioSystem;
 use crate::game::font_texture::FontTexture;
 use crate::game::game_library::GameLibrary;
+use crate::game::gpu_playfield::GpuPlayfield;
 use crate::game::image_texture::ImageTexture;
 
 /**
@@ -53,6 +54,15 @@ pub struct SceneResources<'a, 'tex> {
     /// Pre-composited compass textures (normal and highlighted).
     pub compass_normal: Option<&'a Texture<'tex>>,
     pub compass_highlight: Option<&'a Texture<'tex>>,
+    /// Streaming ARGB8888 playfield texture (MAP_DST_W × MAP_DST_H).
+    /// Locked and rewritten in place by EcsScene each frame.
+    pub playfield: &'a mut Texture<'tex>,
+    /// Texture-atlas playfield backend; when present EcsScene draws the
+    /// playfield as quads and leaves `playfield` untouched.
+    pub gpu_playfield: Option<&'a mut GpuPlayfield<'tex>>,
+    /// Hibar render target (HIBAR_TEX_W × HIBAR_TEX_H). Its contents persist
+    /// across frames; EcsScene repaints it only when the status bar changes.
+    pub hibar: &'a mut Texture<'tex>,
 }
 
 impl<'a, 'tex> SceneResources<'a, 'tex> {
@@ -111,11 +121,28 @@ pub trait Scene {
         resources: &mut SceneResources<'_, '_>,
     ) -> SceneResult;
 
+    /**
+     * Present the frame `update()` drew. Called after an update that
+     * returned SceneResult::Continue; scenes may overlap other work with
+     * the (vsync-blocking) present.
+     */
+    fn present(&mut self, canvas: &mut Canvas<Window>, _game_lib: &GameLibrary) {
+        canvas.present();
+    }
+
     /**
      * Called when the scene is about to be replaced. Clean up any resources.
      */
     fn on_exit(&mut self) {}
 
+    /**
+     * Names of the faery.toml images this scene draws. main.rs uploads them
+     * when the scene becomes active and frees them once no scene needs them.
+     */
+    fn images(&self) -> &'static [&'static str] {
+        &[]
+    }
+
     /**
      * Downcast support so callers can recover the concrete scene type.
      */
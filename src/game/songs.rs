@@ -37,6 +37,7 @@ use std::fs;
 ///
 /// Amiga Paula period → frequency: `freq = AMIGA_CLOCK_NTSC / period`.
 use std::path::Path;
+use std::sync::Arc;
 
 // ---------------------------------------------------------------------------
 // Amiga hardware constants
@@ -231,6 +232,108 @@ pub enum TrackEvent {
 /// two-byte-pair stream.
 pub type Track = Vec<TrackEvent>;
 
+/// Gap between the end-of-note and the start of the next event, in timeclock
+/// units.  Ported from `#300` in `gdriver.asm` `note_comm`.
+pub const NOTE_GAP: u32 = 300;
+
+// ---------------------------------------------------------------------------
+// Compiled tracks
+// ---------------------------------------------------------------------------
+
+/// What the sequencer does on reaching a [`Step`].
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum StepKind {
+    /// Trigger `pitch`; it sounds for `sustain` timeclock units.
+    Note { pitch: u8, sustain: u32 },
+    /// Silence the voice.
+    Rest,
+    /// End of track; `looping` wraps to step 0.
+    End { looping: bool },
+    /// The stream ran out without an `End` event: the voice idles forever.
+    Unterminated,
+}
+
+/// One timed event of a [`CompiledTrack`], with the untimed commands that
+/// precede it in the stream folded in.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct Step {
+    pub kind: StepKind,
+    /// Timeclock units until the next step fires (0 for end steps).
+    pub duration: u32,
+    /// Last `SetInstrument` slot since the previous step.
+    pub instrument: Option<u8>,
+    /// Last `SetTempo` value since the previous step.
+    pub tempo: Option<u8>,
+}
+
+/// A track flattened at load time for the sequencer: every step knows its
+/// duration and sustain, and instrument/tempo changes ride on the step they
+/// precede, so playback only advances a cursor.
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct CompiledTrack {
+    pub steps: Vec<Step>,
+    /// [`SongLibrary::track_duration_ticks`] of the source track.
+    pub duration_ticks: u32,
+}
+
+impl CompiledTrack {
+    pub fn compile(track: &Track) -> Self {
+        const IDLE: Step = Step {
+            kind: StepKind::Unterminated, duration: 0, instrument: None, tempo: None,
+        };
+        let mut steps = Vec::new();
+        // Collects untimed commands until the timed event they precede.
+        let mut next = IDLE;
+        for event in track {
+            match *event {
+                TrackEvent::Note { pitch, duration_idx } => {
+                    let dur = NOTE_DURATIONS[(duration_idx as usize).min(63)] as u32;
+                    // Original gdriver.asm `note_comm`:
+                    //   sub.l #300,d4   ; d4 = duration - NOTE_GAP
+                    //   bpl.s nc1       ; if ≥ 0, keep reduced duration
+                    //   move.l d5,d4    ; else no gap: use full duration
+                    // Short notes (dur < NOTE_GAP) get no gap at all,
+                    // NOT a gap equal to their full duration (which would
+                    // set event_stop == event_start and silence them immediately).
+                    let sustain = if dur >= NOTE_GAP { dur - NOTE_GAP } else { dur };
+                    next.kind = StepKind::Note { pitch, sustain };
+                    next.duration = dur;
+                }
+                TrackEvent::Rest { duration_idx } => {
+                    next.kind = StepKind::Rest;
+                    next.duration = NOTE_DURATIONS[(duration_idx as usize).min(63)] as u32;
+                }
+                TrackEvent::End { looping } => next.kind = StepKind::End { looping },
+                TrackEvent::SetInstrument { slot } => {
+                    next.instrument = Some(slot);
+                    continue;
+                }
+                TrackEvent::SetTempo { value } => {
+                    next.tempo = Some(value);
+                    continue;
+                }
+                TrackEvent::Unknown { .. } => continue,
+            }
+            let step = std::mem::replace(&mut next, IDLE);
+            steps.push(step);
+            if let StepKind::End { .. } = step.kind {
+                break;
+            }
+        }
+        if !matches!(steps.last(), Some(Step { kind: StepKind::End { .. }, .. })) {
+            steps.push(next);
+        }
+        // A loop with no timed step would spin the sequencer forever within a
+        // single VBL; end such a track instead.
+        if !steps.iter().any(|s| s.duration > 0) {
+            if let Some(Step { kind: kind @ StepKind::End { looping: true }, .. }) = steps.last_mut() {
+                *kind = StepKind::End { looping: false };
+            }
+        }
+        CompiledTrack { steps, duration_ticks: SongLibrary::track_duration_ticks(track) }
+    }
+}
+
 // ---------------------------------------------------------------------------
 // SongLibrary
 // ---------------------------------------------------------------------------
@@ -245,6 +348,8 @@ pub type Track = Vec<TrackEvent>;
 pub struct SongLibrary {
     /// All decoded tracks in file order.  Length ≤ 28.
     pub tracks: Vec<Track>,
+    /// `tracks` compiled for the sequencer, same order.
+    pub compiled: Vec<Arc<CompiledTrack>>,
 }
 
 impl SongLibrary {
@@ -304,7 +409,8 @@ impl SongLibrary {
             tracks.push(Self::decode_track(track_bytes));
         }
 
-        SongLibrary { tracks }
+        let compiled = tracks.iter().map(|t| Arc::new(CompiledTrack::compile(t))).collect();
+        SongLibrary { tracks, compiled }
     }
 
     /// Decode a raw (command, value) byte stream into a [`Track`].
@@ -386,6 +492,20 @@ impl SongLibrary {
         self.group(Self::INTRO_TRACK_BASE / Self::VOICES)
     }
 
+    /// Compiled counterpart of [`group`](Self::group), ready for playback.
+    pub fn compiled_group(&self, group: usize) -> Option<[Arc<CompiledTrack>; 4]> {
+        let base = group * Self::VOICES;
+        if base + 3 >= self.compiled.len() {
+            return None;
+        }
+        Some(std::array::from_fn(|v| Arc::clone(&self.compiled[base + v])))
+    }
+
+    /// Compiled counterpart of [`intro_tracks`](Self::intro_tracks).
+    pub fn compiled_intro(&self) -> Option<[Arc<CompiledTrack>; 4]> {
+        self.compiled_group(Self::INTRO_TRACK_BASE / Self::VOICES)
+    }
+
     /// Compute the approximate playback frequency (Hz) for a pitch index.
     ///
     /// Returns `None` if the pitch index is out of range.
@@ -430,12 +550,8 @@ impl SongLibrary {
     /// voice determines when the song is fully done).  Returns `0` if the
     /// intro tracks are not present in the library.
     pub fn intro_duration_ticks(&self) -> u32 {
-        match self.intro_tracks() {
-            Some(tracks) => tracks
-                .iter()
-                .map(|t| Self::track_duration_ticks(t))
-                .max()
-                .unwrap_or(0),
+        match self.compiled_intro() {
+            Some(tracks) => tracks.iter().map(|t| t.duration_ticks).max().unwrap_or(0),
             None => 0,
         }
     }
@@ -616,4 +732,51 @@ mod tests {
             }
         }
     }
+
+    #[test]
+    fn test_compile_folds_commands_into_the_next_step() {
+        // SetInstrument 5, SetTempo 90, Note 10 (dur idx 2), SetInstrument 7,
+        // Unknown, Rest (dur idx 7 = 210 < NOTE_GAP), End looping.
+        let bytes = [129, 5, 0x90, 90, 10, 2, 129, 7, 0x85, 0, 128, 7, 0xff, 1];
+        let track = SongLibrary::parse_track_bytes(&bytes);
+        let compiled = CompiledTrack::compile(&track);
+        assert_eq!(compiled.steps, vec![
+            Step {
+                kind: StepKind::Note { pitch: 10, sustain: 6720 - NOTE_GAP },
+                duration: 6720,
+                instrument: Some(5),
+                tempo: Some(90),
+            },
+            Step { kind: StepKind::Rest, duration: 210, instrument: Some(7), tempo: None },
+            Step { kind: StepKind::End { looping: true }, duration: 0, instrument: None, tempo: None },
+        ]);
+        assert_eq!(compiled.duration_ticks, SongLibrary::track_duration_ticks(&track));
+
+        // Short notes keep their full length as sustain.
+        let short = CompiledTrack::compile(&SongLibrary::parse_track_bytes(&[3, 7, 0xff, 0]));
+        assert_eq!(short.steps[0].kind, StepKind::Note { pitch: 3, sustain: 210 });
+    }
+
+    #[test]
+    fn test_compile_unterminated_and_empty_loops() {
+        let open = CompiledTrack::compile(&SongLibrary::parse_track_bytes(&[3, 0, 129, 2]));
+        assert_eq!(open.steps.len(), 2);
+        assert_eq!(open.steps[1].kind, StepKind::Unterminated);
+        assert_eq!(open.steps[1].instrument, Some(2));
+
+        // A loop with nothing to wait on would never yield; it ends instead.
+        let spin = CompiledTrack::compile(&SongLibrary::parse_track_bytes(&[129, 2, 0xff, 1]));
+        assert_eq!(spin.steps[0].kind, StepKind::End { looping: false });
+    }
+
+    #[test]
+    fn test_library_compiles_every_track() {
+        let lib = load_songs();
+        assert_eq!(lib.compiled.len(), lib.tracks.len());
+        let intro = lib.compiled_intro().expect("intro tracks");
+        assert!(Arc::ptr_eq(&intro[0], &lib.compiled[SongLibrary::INTRO_TRACK_BASE]));
+        for track in &lib.compiled {
+            assert!(matches!(track.steps.last().map(|s| s.kind), Some(StepKind::End { .. })));
+        }
+    }
 }
@@ -2,8 +2,8 @@
 //! ported from fmain.c lines 3134-3184 and fsubs.asm maskit().
 
 use crate::game::map_renderer::{MapRenderer, MAP_DST_H, MAP_DST_W};
-use crate::game::map_view::{SCROLL_TILES_H, SCROLL_TILES_W};
-use crate::game::tile_atlas::{TILE_H, TILE_W, TOTAL_TILES};
+use crate::game::map_view::{SCROLL_TILES, SCROLL_TILES_H, SCROLL_TILES_W};
+use crate::game::tile_atlas::{TileAtlas, TILE_H, TILE_W, TOTAL_TILES};
 
 /// Check whether a tile with masking type `k` should mask a sprite at the given position.
 ///
@@ -75,25 +75,127 @@ pub struct BlittedSprite {
     pub is_falling: bool,
 }
 
-/// Apply sprite-depth masking for one sprite against the tile map.
+/// Occlusion data for one tile, resolved once per region from terra_mem and
+/// shadow_mem so sprite masking never touches the raw tables per pixel.
+#[derive(Debug, Clone, Copy, Default)]
+pub struct TileMask {
+    /// Mask type 0-7 (`TileAtlas::mask_type`).
+    pub kind: u8,
+    /// shadow_mem rows for this tile's maptag. Bit 15 = column 0.
+    pub rows: [u16; TILE_H],
+}
+
+/// Per-tile occlusion masks for the current region, built by MapRenderer::new().
+pub struct SpriteMaskTable {
+    pub tiles: Vec<TileMask>,
+    /// Rows for tile 64's maptag: the case-6 substitute above the ground row.
+    pub case6_rows: [u16; TILE_H],
+}
+
+impl SpriteMaskTable {
+    pub fn build(atlas: &TileAtlas, shadow_mem: &[u8]) -> Self {
+        let tiles = (0..TOTAL_TILES)
+            .map(|t| TileMask {
+                kind: atlas.mask_type[t],
+                rows: shadow_rows(shadow_mem, atlas.maptag[t]),
+            })
+            .collect();
+        let tile64 = 64usize.min(TOTAL_TILES - 1);
+        SpriteMaskTable {
+            tiles,
+            case6_rows: shadow_rows(shadow_mem, atlas.maptag[tile64]),
+        }
+    }
+}
+
+/// Unpack one 64-byte shadow_mem mask into row words. A mask that runs past
+/// the end of shadow_mem is treated as empty (never re-stamps anything).
+fn shadow_rows(shadow_mem: &[u8], maptag: u8) -> [u16; TILE_H] {
+    let mut rows = [0u16; TILE_H];
+    let offset = maptag as usize * 64;
+    if let Some(tile) = shadow_mem.get(offset..offset + 64) {
+        for (row, word) in rows.iter_mut().enumerate() {
+            *word = u16::from_be_bytes([tile[row * 2], tile[row * 2 + 1]]);
+        }
+    }
+    rows
+}
+
+/// Row bitmask with columns `lo..=hi` set (bit 15 = column 0).
+fn col_span_mask(lo: i32, hi: i32) -> u16 {
+    (0xFFFF_u16 >> lo) & (0xFFFF_u16 << (15 - hi))
+}
+
+/// `BYTE_SELECT[b]` expands the 8 bits of `b` into 8 byte lanes (MSB → lane 0,
+/// little-endian), for selecting pixels with plain AND/ANDN.
+const BYTE_SELECT: [u64; 256] = {
+    let mut table = [0u64; 256];
+    let mut b = 0;
+    while b < 256 {
+        let mut i = 0;
+        while i < 8 {
+            if b & (0x80 >> i) != 0 {
+                table[b] |= 0xFF_u64 << (8 * i);
+            }
+            i += 1;
+        }
+        b += 1;
+    }
+    table
+};
+
+/// Copy the `mask`-selected pixels of a 16-px tile row over `dst`.
+fn blend_row16(dst: &mut [u8], src: &[u8], mask: u16) {
+    for (half, bits) in [(mask >> 8) as u8, mask as u8].into_iter().enumerate() {
+        if bits == 0 {
+            continue;
+        }
+        let span = half * 8..half * 8 + 8;
+        let sel = BYTE_SELECT[bits as usize];
+        let d = u64::from_le_bytes(dst[span.clone()].try_into().unwrap());
+        let s = u64::from_le_bytes(src[span.clone()].try_into().unwrap());
+        dst[span].copy_from_slice(&((d & !sel) | (s & sel)).to_le_bytes());
+    }
+}
+
+/// One tile's share of a sprite's depth mask: the tile drawn at framebuf
+/// `(tile_x, tile_y)` re-stamps its mask-selected pixels within tile-local
+/// columns `col_lo..=col_hi` and rows `row_lo..=row_hi`.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct MaskSpan {
+    pub tile_idx: usize,
+    /// Use `SpriteMaskTable::case6_rows` instead of the tile's own rows.
+    pub case6: bool,
+    pub tile_x: i32,
+    pub tile_y: i32,
+    pub col_lo: i32,
+    pub col_hi: i32,
+    pub row_lo: i32,
+    pub row_hi: i32,
+}
+
+/// Find the tiles that mask `sprite`, for a viewport showing `minimap` at
+/// sub-tile offset `(ox, oy)`.
 ///
 /// For each 16×32 tile that overlaps the sprite's bounding box, checks
-/// the tile's mask_type against the sprite's ground-line position. If
-/// masking applies, reads the shadow_mem bitmask and re-stamps tile
-/// pixels over the sprite area in the framebuf.
-pub fn apply_sprite_mask(
-    mr: &mut MapRenderer,
+/// the tile's mask_type against the sprite's ground-line position and
+/// passes each tile that masks to `emit`, clipped to the sprite and the
+/// framebuf.  Spans come out column by column, top to bottom.
+pub fn mask_spans(
+    minimap: &[u16; SCROLL_TILES],
+    ox: i32,
+    oy: i32,
+    masks: &SpriteMaskTable,
     sprite: &BlittedSprite,
     hero_sector: u16,
-    _actor_idx: usize,
+    actor_idx: usize,
+    mut emit: impl FnMut(MaskSpan),
 ) {
     let fb_w = MAP_DST_W as i32;
     let fb_h = MAP_DST_H as i32;
-    let ox = mr.last_ox;
-    let oy = mr.last_oy;
 
     let is_bridge_sector = hero_sector == 48;
-    let is_actor_1 = _actor_idx == 1;
+    let is_actor_1 = actor_idx == 1;
 
     let sprite_left = sprite.screen_x;
     let sprite_right = sprite.screen_x + sprite.width as i32 - 1;
@@ -143,13 +245,13 @@ pub fn apply_sprite_mask(
                 continue;
             }
 
-            let tile_idx = mr.last_minimap[ty * SCROLL_TILES_W + tx] as usize;
+            let tile_idx = minimap[ty * SCROLL_TILES_W + tx] as usize;
             if tile_idx >= TOTAL_TILES {
                 continue;
             }
 
-            let k = mr.atlas.mask_type[tile_idx];
-            if k == 0 {
+            let mask = &masks.tiles[tile_idx];
+            if mask.kind == 0 {
                 continue;
             }
 
@@ -164,59 +266,86 @@ pub fn apply_sprite_mask(
                     3u8
                 }
             } else {
-                k
-            };
-
-            // Case 6: substitute tile 64's maptag for rows above ground
-            let maptag = if k == 6 && ym != 0 {
-                let tile64 = 64usize.min(TOTAL_TILES - 1);
-                mr.atlas.maptag[tile64]
-            } else {
-                mr.atlas.maptag[tile_idx]
+                mask.kind
             };
 
             if !should_mask_tile(k, xm, ystop, ym, is_bridge_sector, is_actor_1) {
                 continue;
             }
 
-            // Apply shadow_mem bitmask: re-stamp tile pixels where mask bit is set.
-            let shadow_offset = maptag as usize * 64;
-            if shadow_offset + 63 >= mr.shadow_mem.len() {
+            let tile_x = tx as i32 * TILE_W as i32 - ox;
+            let tile_y = ty as i32 * TILE_H as i32 - oy;
+
+            // Tile-local span covered by both the sprite and the framebuf.
+            let col_lo = (sprite_left.max(0) - tile_x).max(0);
+            let col_hi = (sprite_right.min(fb_w - 1) - tile_x).min(TILE_W as i32 - 1);
+            let row_lo = (sprite_top.max(0) - tile_y).max(0);
+            let row_hi = (sprite_bottom.min(fb_h - 1) - tile_y).min(TILE_H as i32 - 1);
+            if col_lo > col_hi || row_lo > row_hi {
                 continue;
             }
-            let shadow_tile = &mr.shadow_mem[shadow_offset..shadow_offset + 64];
-            let tile_pixels = mr.atlas.tile_pixels(tile_idx);
-
-            let tile_screen_x = tx as i32 * TILE_W as i32 - ox;
-            let tile_screen_y = ty as i32 * TILE_H as i32 - oy;
-
-            for row in 0..TILE_H {
-                let py = tile_screen_y + row as i32;
-                if py < 0 || py >= fb_h {
-                    continue;
-                }
-                if py < sprite_top || py > sprite_bottom {
-                    continue;
-                }
-
-                for col in 0..TILE_W {
-                    let px = tile_screen_x + col as i32;
-                    if px < 0 || px >= fb_w {
-                        continue;
-                    }
-                    if px < sprite_left || px > sprite_right {
-                        continue;
-                    }
+            emit(MaskSpan {
+                tile_idx,
+                // Case 6: substitute tile 64's mask for rows above ground
+                case6: k == 6 && ym != 0,
+                tile_x,
+                tile_y,
+                col_lo,
+                col_hi,
+                row_lo,
+                row_hi,
+            });
+        }
+    }
+}
 
-                    if shadow_bit_at(shadow_tile, row, col) {
-                        let fb_idx = (py * fb_w + px) as usize;
-                        let tile_px = tile_pixels[row * TILE_W + col];
-                        mr.framebuf[fb_idx] = tile_px;
-                    }
+/// Apply sprite-depth masking for one sprite against the tile map.
+///
+/// For each tile that masks the sprite (see [`mask_spans`]), ANDs the
+/// tile's precomputed shadow rows with the sprite's column span and
+/// re-stamps the selected tile pixels over the sprite area in the framebuf.
+pub fn apply_sprite_mask(
+    mr: &mut MapRenderer,
+    sprite: &BlittedSprite,
+    hero_sector: u16,
+    _actor_idx: usize,
+) {
+    let fb_w = MAP_DST_W as i32;
+    let masks = &mr.masks;
+    let atlas = &mr.atlas;
+    let framebuf = &mut mr.framebuf;
+    mask_spans(&mr.last_minimap, mr.last_ox, mr.last_oy, masks, sprite, hero_sector, _actor_idx, |span| {
+        let rows = if span.case6 {
+            &masks.case6_rows
+        } else {
+            &masks.tiles[span.tile_idx].rows
+        };
+        let clip = col_span_mask(span.col_lo, span.col_hi);
+        let fully_on_screen = span.tile_x >= 0 && span.tile_x + TILE_W as i32 <= fb_w;
+        let tile_pixels = atlas.tile_pixels(span.tile_idx);
+
+        for row in span.row_lo as usize..=span.row_hi as usize {
+            let bits = rows[row] & clip;
+            if bits == 0 {
+                continue;
+            }
+            let src = &tile_pixels[row * TILE_W..(row + 1) * TILE_W];
+            let row_base = (span.tile_y + row as i32) * fb_w + span.tile_x;
+            if fully_on_screen {
+                let start = row_base as usize;
+                blend_row16(&mut framebuf[start..start + TILE_W], src, bits);
+            } else {
+                // Tile straddles the framebuf edge: clip has already
+                // dropped off-screen columns, so walk the set bits.
+                let mut rest = bits;
+                while rest != 0 {
+                    let col = rest.leading_zeros() as usize;
+                    rest &= !(0x8000 >> col);
+                    framebuf[(row_base + col as i32) as usize] = src[col];
                 }
             }
         }
-    }
+    });
 }
 
 #[cfg(test)]
@@ -316,4 +445,115 @@ mod tests {
             assert!(!shadow_bit_at(&shadow, 2, col));
         }
     }
+
+    /// Per-pixel port of maskit() as it was before the precomputed tables.
+    fn reference_mask(mr: &mut MapRenderer, sprite: &BlittedSprite, hero_sector: u16, actor_idx: usize) {
+        let (fb_w, fb_h) = (MAP_DST_W as i32, MAP_DST_H as i32);
+        let (ox, oy) = (mr.last_ox, mr.last_oy);
+        let left = sprite.screen_x;
+        let right = left + sprite.width as i32 - 1;
+        let top = sprite.screen_y;
+        let bottom = top + sprite.height as i32 - 1;
+        if right + ox < 0 || bottom + oy < 0 {
+            return;
+        }
+        let ym_base = if top + oy < 0 { 0u8 } else { ((top + oy) >> 5) as u8 };
+        let ground = sprite.ground + oy;
+        let tx_start = (left + ox).max(0) as usize / TILE_W;
+        let ty_start = (top + oy).max(0) as usize / TILE_H;
+        for tx in tx_start..=((right + ox) as usize / TILE_W).min(SCROLL_TILES_W - 1) {
+            let xm = (tx as i32 - (left + ox).max(0) / TILE_W as i32).max(0) as u8;
+            for ty in ty_start..=((bottom + oy) as usize / TILE_H).min(SCROLL_TILES_H - 1) {
+                let tile_idx = mr.last_minimap[ty * SCROLL_TILES_W + tx] as usize;
+                if tile_idx >= TOTAL_TILES || mr.atlas.mask_type[tile_idx] == 0 {
+                    continue;
+                }
+                let ym = ty as u8 - ym_base.min(ty as u8);
+                let ystop = ground - ((ym as i32 + ym_base as i32) << 5);
+                let k = match (sprite.is_falling, tile_idx <= 220) {
+                    (true, true) => continue,
+                    (true, false) => 3,
+                    (false, _) => mr.atlas.mask_type[tile_idx],
+                };
+                let maptag = if k == 6 && ym != 0 { mr.atlas.maptag[64] } else { mr.atlas.maptag[tile_idx] };
+                if !should_mask_tile(k, xm, ystop, ym, hero_sector == 48, actor_idx == 1) {
+                    continue;
+                }
+                let off = maptag as usize * 64;
+                if off + 63 >= mr.shadow_mem.len() {
+                    continue;
+                }
+                let shadow = mr.shadow_mem[off..off + 64].to_vec();
+                for row in 0..TILE_H {
+                    for col in 0..TILE_W {
+                        let px = tx as i32 * TILE_W as i32 - ox + col as i32;
+                        let py = ty as i32 * TILE_H as i32 - oy + row as i32;
+                        if px < 0 || py < 0 || px >= fb_w || py >= fb_h
+                            || px < left || px > right || py < top || py > bottom
+                        {
+                            continue;
+                        }
+                        if shadow_bit_at(&shadow, row, col) {
+                            mr.framebuf[(py * fb_w + px) as usize] = mr.atlas.tile_pixels(tile_idx)[row * TILE_W + col];
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    #[test]
+    fn precomputed_masks_match_per_pixel_reference() {
+        use crate::game::world_data::WorldData;
+        let mut world = WorldData::empty();
+        let mut seed = 0x1234_5678_u32;
+        let mut next = move || {
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            seed
+        };
+        for b in world.image_mem.iter_mut() { *b = next() as u8; }
+        for b in world.sector_mem.iter_mut() { *b = next() as u8; }
+        for t in 0..TOTAL_TILES {
+            world.terra_mem[t * 4] = next() as u8; // maptag; some run past shadow_mem
+            world.terra_mem[t * 4 + 1] = (next() % 8) as u8;
+        }
+        let shadow_mem: Vec<u8> = (0..12288).map(|_| next() as u8).collect();
+        let mut mr = MapRenderer::new(&world, shadow_mem.clone());
+        let mut expected = MapRenderer::new(&world, shadow_mem);
+
+        for frame in 0..40 {
+            let (map_x, map_y) = ((next() % 0x8000) as u16, (next() % 0x8000) as u16);
+            mr.compose(map_x, map_y, &world);
+            expected.compose(map_x, map_y, &world);
+            for _ in 0..8 {
+                let height = [8, 22, 32][next() as usize % 3];
+                let sprite = BlittedSprite {
+                    screen_x: (next() % 340) as i32 - 18,
+                    screen_y: (next() % 230) as i32 - 34,
+                    width: 16,
+                    height,
+                    ground: 0,
+                    is_falling: next() % 5 == 0,
+                };
+                let sprite = BlittedSprite { ground: sprite.screen_y + 32 + (next() % 9) as i32 - 4, ..sprite };
+                let (hero_sector, actor_idx) = ([0u16, 48][frame & 1], (next() % 3) as usize);
+                // Paint the sprite area so masking has something to overwrite.
+                for b in mr.framebuf.iter_mut() { *b |= 0x20; }
+                expected.framebuf.copy_from_slice(&mr.framebuf);
+                reference_mask(&mut expected, &sprite, hero_sector, actor_idx);
+                apply_sprite_mask(&mut mr, &sprite, hero_sector, actor_idx);
+                assert!(mr.framebuf == expected.framebuf, "frame {frame}: mask mismatch");
+            }
+        }
+    }
+
+    #[test]
+    fn col_span_mask_selects_inclusive_columns() {
+        assert_eq!(col_span_mask(0, 15), 0xFFFF);
+        assert_eq!(col_span_mask(0, 0), 0x8000);
+        assert_eq!(col_span_mask(15, 15), 0x0001);
+        assert_eq!(col_span_mask(4, 11), 0x0FF0);
+    }
 }
@@ -694,22 +694,12 @@ impl SpriteSheet {
 
             for row in 0..frame_h {
                 let row_off = row * PLANE_ROW_BYTES;
-
-                let mut planes = [0u16; SPRITE_PLANES];
-                for p in 0..SPRITE_PLANES {
-                    let pb = &data[frame_base + p * plane_frame_bytes + row_off..];
-                    planes[p] = u16::from_be_bytes([pb[0], pb[1]]);
-                }
-
-                for col in 0..SPRITE_W {
-                    let bit = 15 - col;
-                    let color_idx = (0..SPRITE_PLANES)
-                        .map(|p| ((planes[p] >> bit) & 1) << p)
-                        .fold(0usize, |acc, b| acc | b as usize);
-                    let pixel_idx = frame * frame_h * SPRITE_W + row * SPRITE_W + col;
-                    pixels[pixel_idx] = color_idx as u8;
-                    // index 31 stays as initialized (transparent)
-                }
+                let planes: [&[u8]; SPRITE_PLANES] = std::array::from_fn(|p| {
+                    let start = frame_base + p * plane_frame_bytes + row_off;
+                    &data[start..start + PLANE_ROW_BYTES]
+                });
+                let dst = frame * frame_h * SPRITE_W + row * SPRITE_W;
+                crate::game::planar::row_to_chunky(&planes, &mut pixels[dst..dst + SPRITE_W]);
             }
         }
         SpriteSheet {
@@ -759,6 +749,28 @@ impl SpriteSheet {
     }
 }
 
+/// Sprite sheet a queued actor draw reads its frame from.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum FrameSource {
+    /// `SpriteSheets::sheets[idx]` (cfile index).
+    Cfile(usize),
+    /// The OBJECTS sheet (weapons, bubbles, fairy).
+    Objects,
+}
+
+impl FrameSource {
+    pub fn sheet<'a>(
+        self,
+        sheets: &'a [Option<SpriteSheet>],
+        object_sprites: Option<&'a SpriteSheet>,
+    ) -> Option<&'a SpriteSheet> {
+        match self {
+            FrameSource::Cfile(idx) => sheets.get(idx).and_then(Option::as_ref),
+            FrameSource::Objects => object_sprites,
+        }
+    }
+}
+
 /// One entry of statelist[87]: per-animation-index weapon sprite offsets.
 /// Ported verbatim from original/fmain.c statelist[].
 #[derive(Debug, Clone, Copy)]
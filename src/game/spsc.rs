@@ -0,0 +1,175 @@
+//! Bounded single-producer/single-consumer ring buffer.
+//!
+//! Carries control commands from the game thread to the SDL audio callback.
+//! Neither end takes a lock or allocates after construction, so the realtime
+//! callback can never be stalled by the game thread (or vice versa).
+//!
+//! Each end is `Send` but not `Sync`: it can be moved to its thread, but never
+//! shared, which is what makes the single-producer/single-consumer protocol
+//! below sound without `&mut self` on `push`/`pop`.
+
+use std::cell::{Cell, UnsafeCell};
+use std::marker::PhantomData;
+use std::mem::MaybeUninit;
+use std::sync::atomic::{AtomicUsize, Ordering};
+use std::sync::Arc;
+
+struct Ring<T> {
+    slots: Box<[UnsafeCell<MaybeUninit<T>>]>,
+    /// Count of values popped so far (wrapping). Written only by the consumer.
+    head: AtomicUsize,
+    /// Count of values pushed so far (wrapping). Written only by the producer.
+    tail: AtomicUsize,
+}
+
+// SAFETY: a slot is only touched by the producer while it is outside
+// `head..tail` and only by the consumer while it is inside; ownership of the
+// slot is handed over by the Release store / Acquire load of `tail` (push →
+// pop) and `head` (pop → push). Values of `T` cross threads, hence `T: Send`.
+unsafe impl<T: Send> Sync for Ring<T> {}
+
+impl<T> Drop for Ring<T> {
+    fn drop(&mut self) {
+        let head = *self.head.get_mut();
+        let tail = *self.tail.get_mut();
+        let cap = self.slots.len();
+        let mut i = head;
+        while i != tail {
+            // SAFETY: slots in `head..tail` hold initialised values that were
+            // never popped; we have exclusive access in `drop`.
+            unsafe { self.slots[i % cap].get_mut().assume_init_drop() };
+            i = i.wrapping_add(1);
+        }
+    }
+}
+
+/// Sending end of the ring.
+pub struct Producer<T> {
+    ring: Arc<Ring<T>>,
+    _not_sync: PhantomData<Cell<()>>,
+}
+
+/// Receiving end of the ring.
+pub struct Consumer<T> {
+    ring: Arc<Ring<T>>,
+    _not_sync: PhantomData<Cell<()>>,
+}
+
+/// Create a ring that holds up to `capacity` values (at least 1).
+pub fn channel<T: Send>(capacity: usize) -> (Producer<T>, Consumer<T>) {
+    let slots = (0..capacity.max(1))
+        .map(|_| UnsafeCell::new(MaybeUninit::uninit()))
+        .collect();
+    let ring = Arc::new(Ring {
+        slots,
+        head: AtomicUsize::new(0),
+        tail: AtomicUsize::new(0),
+    });
+    (
+        Producer {
+            ring: Arc::clone(&ring),
+            _not_sync: PhantomData,
+        },
+        Consumer {
+            ring,
+            _not_sync: PhantomData,
+        },
+    )
+}
+
+impl<T> Producer<T> {
+    /// Append `value`, or hand it back if the ring is full.
+    pub fn push(&self, value: T) -> Result<(), T> {
+        let ring = &*self.ring;
+        let tail = ring.tail.load(Ordering::Relaxed);
+        let head = ring.head.load(Ordering::Acquire);
+        let cap = ring.slots.len();
+        if tail.wrapping_sub(head) == cap {
+            return Err(value);
+        }
+        // SAFETY: the slot at `tail` is outside `head..tail`, so the consumer
+        // will not read it until the Release store below publishes it, and this
+        // `Producer` is the only writer (it is not `Sync` and not `Clone`).
+        unsafe { (*ring.slots[tail % cap].get()).write(value) };
+        ring.tail.store(tail.wrapping_add(1), Ordering::Release);
+        Ok(())
+    }
+}
+
+impl<T> Consumer<T> {
+    /// Remove the oldest value, or `None` if the ring is empty.
+    pub fn pop(&self) -> Option<T> {
+        let ring = &*self.ring;
+        let head = ring.head.load(Ordering::Relaxed);
+        let tail = ring.tail.load(Ordering::Acquire);
+        if head == tail {
+            return None;
+        }
+        let cap = ring.slots.len();
+        // SAFETY: the slot at `head` is inside `head..tail`, so the producer
+        // initialised it before its Release store of `tail`, and will not reuse
+        // it until the Release store of `head` below. This `Consumer` is the
+        // only reader.
+        let value = unsafe { (*ring.slots[head % cap].get()).assume_init_read() };
+        ring.head.store(head.wrapping_add(1), Ordering::Release);
+        Some(value)
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn preserves_fifo_order_across_wraparound() {
+        let (tx, rx) = channel(3);
+        for round in 0..5 {
+            for i in 0..3 {
+                tx.push(round * 10 + i).unwrap();
+            }
+            assert_eq!(tx.push(99), Err(99), "ring should be full");
+            for i in 0..3 {
+                assert_eq!(rx.pop(), Some(round * 10 + i));
+            }
+            assert_eq!(rx.pop(), None);
+        }
+    }
+
+    #[test]
+    fn unpopped_values_are_dropped_with_the_ring() {
+        let marker = Arc::new(());
+        let (tx, rx) = channel(4);
+        tx.push(Arc::clone(&marker)).unwrap();
+        tx.push(Arc::clone(&marker)).unwrap();
+        drop(rx.pop());
+        drop((tx, rx));
+        assert_eq!(Arc::strong_count(&marker), 1);
+    }
+
+    #[test]
+    fn transfers_every_value_between_threads() {
+        const N: u32 = 100_000;
+        let (tx, rx) = channel(16);
+        let producer = std::thread::spawn(move || {
+            for i in 0..N {
+                let mut v = i;
+                while let Err(back) = tx.push(v) {
+                    v = back;
+                    std::thread::yield_now();
+                }
+            }
+        });
+        let mut expected = 0;
+        while expected < N {
+            match rx.pop() {
+                Some(v) => {
+                    assert_eq!(v, expected);
+                    expected += 1;
+                }
+                None => std::thread::yield_now(),
+            }
+        }
+        producer.join().unwrap();
+        assert_eq!(rx.pop(), None);
+    }
+}
@@ -1,6 +1,8 @@
 //! Tile atlas: decodes WorldData image_mem into an indexed tile atlas.
 //! 256 tiles (4 groups × 64), each 16×32 px, 5 Amiga bitplanes → u8 palette index.
 
+use crate::game::adf::AdfDisk;
+use crate::game::planar;
 use crate::game::world_data::WorldData;
 
 pub const TILES_PER_GROUP: usize = 64;
@@ -31,40 +33,51 @@ impl TileAtlas {
     /// Decode all 256 tiles from WorldData.image_mem into palette indices.
     /// No palette needed — indices are resolved at render time.
     pub fn from_world_data(world: &WorldData) -> Self {
+        let groups: [&[u8]; TILE_GROUPS] = std::array::from_fn(|g| {
+            let start = (g * BYTES_PER_GROUP).min(world.image_mem.len());
+            let end = ((g + 1) * BYTES_PER_GROUP).min(world.image_mem.len());
+            &world.image_mem[start..end]
+        });
+        Self::from_planes(groups, &world.terra_mem[..])
+    }
+
+    /// Decode tiles straight from the ADF's image group blocks (no image_mem copy).
+    /// Missing or out-of-range groups decode as color 0, like a zeroed image_mem.
+    pub fn from_adf(adf: &AdfDisk, image_group_blocks: &[u32], terra_mem: &[u8]) -> Self {
+        let groups: [&[u8]; TILE_GROUPS] = std::array::from_fn(|g| {
+            image_group_blocks
+                .get(g)
+                .and_then(|&block| WorldData::image_group_slice(adf, block))
+                .unwrap_or(&[])
+        });
+        Self::from_planes(groups, terra_mem)
+    }
+
+    /// Decode from per-group planar data (BYTES_PER_GROUP bytes each; shorter
+    /// slices are zero-extended) plus terra_mem masking metadata.
+    fn from_planes(groups: [&[u8]; TILE_GROUPS], terra_mem: &[u8]) -> Self {
         let mut pixels = vec![0u8; TOTAL_TILES * TILE_PIXELS];
         let mut mask_type = [0u8; TOTAL_TILES];
         let mut maptag = [0u8; TOTAL_TILES];
         for tile_idx in 0..TOTAL_TILES {
-            let group = tile_idx / TILES_PER_GROUP;
+            let group = groups[tile_idx / TILES_PER_GROUP];
             let local = tile_idx % TILES_PER_GROUP;
             let dst_base = tile_idx * TILE_PIXELS;
             for row in 0..TILE_H {
-                let mut planes = [0u16; NUM_PLANES];
-                for p in 0..NUM_PLANES {
-                    let offset = group * BYTES_PER_GROUP
-                        + p * BYTES_PER_PLANE_QUARTER
+                let planes: [&[u8]; NUM_PLANES] = std::array::from_fn(|p| {
+                    let offset = p * BYTES_PER_PLANE_QUARTER
                         + local * BYTES_PER_TILE_PLANE
                         + row * BYTES_PER_ROW;
-                    if offset + 1 < world.image_mem.len() {
-                        planes[p] = u16::from_be_bytes([
-                            world.image_mem[offset],
-                            world.image_mem[offset + 1],
-                        ]);
-                    }
-                }
-                for col in 0..TILE_W {
-                    let bit = 15 - col;
-                    let color_idx = (0..NUM_PLANES)
-                        .map(|p| (((planes[p] >> bit) & 1) as usize) << p)
-                        .fold(0, |acc, b| acc | b);
-                    pixels[dst_base + row * TILE_W + col] = color_idx as u8;
-                }
+                    group.get(offset..offset + BYTES_PER_ROW).unwrap_or(&[])
+                });
+                let dst = dst_base + row * TILE_W;
+                planar::row_to_chunky(&planes, &mut pixels[dst..dst + TILE_W]);
             }
             // Sprite-depth masking metadata from terra_mem.
             let terra_base = tile_idx * 4;
-            if terra_base + 1 < world.terra_mem.len() {
-                maptag[tile_idx] = world.terra_mem[terra_base];
-                mask_type[tile_idx] = world.terra_mem[terra_base + 1] & 0x0F;
+            if terra_base + 1 < terra_mem.len() {
+                maptag[tile_idx] = terra_mem[terra_base];
+                mask_type[tile_idx] = terra_mem[terra_base + 1] & 0x0F;
             }
         }
         TileAtlas {
@@ -139,4 +152,17 @@ mod tests {
         assert_eq!(atlas.mask_type[2], 6);
         assert_eq!(atlas.maptag[2], 10);
     }
+
+    #[test]
+    fn test_from_adf_matches_image_mem_decode() {
+        let data = (0..2048 * 512).map(|i: usize| (i * 31 + i / 7) as u8).collect();
+        let adf = AdfDisk::from_bytes(data);
+        let blocks = [100, 300, 500, 2040]; // last group runs past the image
+        let world = WorldData::load(&adf, 0, 0, &[], 10, 11, &blocks).unwrap();
+        let copied = TileAtlas::from_world_data(&world);
+        let direct = TileAtlas::from_adf(&adf, &blocks, &world.terra_mem[..]);
+        assert!(copied.pixels == direct.pixels);
+        assert_eq!(copied.mask_type, direct.mask_type);
+        assert_eq!(copied.maptag, direct.maptag);
+    }
 }
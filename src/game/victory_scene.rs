@@ -30,6 +30,8 @@ const HOLD_TICKS: u32 = 180;
 /// Fade-to-black duration (ticks at 30 Hz).
 const FADE_TICKS: u32 = 60;
 
+pub const IMAGES: &[&str] = &["winpic"];
+
 enum Phase {
     Hold { ticks_remaining: u32 },
     Fade { ticks_remaining: u32 },
@@ -59,6 +61,10 @@ impl Default for VictoryScene {
 }
 
 impl Scene for VictoryScene {
+    fn images(&self) -> &'static [&'static str] {
+        IMAGES
+    }
+
     fn as_any(&self) -> &dyn Any {
         self
     }
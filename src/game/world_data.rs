@@ -1,6 +1,8 @@
 //! Game world data for a single region.
 //! Mirrors the sector_mem, map_mem, terra_mem, image_mem arrays from fmain.c.
 
+use std::sync::{Arc, OnceLock};
+
 use crate::game::adf::AdfDisk;
 use crate::game::palette::{amiga_color_to_rgba, Palette, PALETTE_SIZE};
 use anyhow::Result;
@@ -17,12 +19,146 @@ pub const IMAGE_GROUP_COUNT: u32 = 4;
 /// Indoor regions use only the first 4096 bytes (128 × 32 rows).
 pub const MAP_MEM_SIZE: usize = 16384;
 
+/// Tile image data: 4 groups × 40 blocks × 512 bytes.
+pub const IMAGE_MEM_SIZE: usize = (IMAGE_GROUP_COUNT * IMAGE_BLOCKS_PER_GROUP) as usize * 512;
+
+#[derive(Clone)]
 pub struct WorldData {
     pub sector_mem: Box<[u8; 32768]>,
     pub map_mem: Box<[u8; MAP_MEM_SIZE]>,
     pub terra_mem: Box<[u8; 1024]>,
-    pub image_mem: Box<[u8; 81920]>,
+    /// Planar tile images (81,920 bytes) as copied by `load`. Left empty by
+    /// `load_terrain`, whose callers decode tiles straight from the ADF.
+    pub image_mem: Vec<u8>,
     pub region_num: u8,
+    /// Built on first use by `terrain_grid()`; `set_tile_at_image` patches it.
+    /// Direct writes to the tables above must happen before the first probe.
+    terrain_grid: OnceLock<Arc<TerrainGrid>>,
+    /// Built on first use by `overview()`; `set_tile_at_image` patches it.
+    overview: OnceLock<Arc<OverviewRaster>>,
+}
+
+/// Terrain type of every 8×8-pixel cell, packed two cells per byte.
+///
+/// The d4 bitmask in `px_to_im` (fsubs.asm) splits each 16×32 tile into 2×4
+/// cells of 8×8 pixels.  One byte covers one tile column of one 8-pixel row:
+/// the low nibble is the left cell (x bit 3 clear), the high nibble the right.
+/// A probe is then one load plus a shift and mask instead of the
+/// map_mem → sector_mem → terra_mem chain.
+#[derive(Clone)]
+pub struct TerrainGrid {
+    cells: Vec<u8>,
+    rows: usize,
+}
+
+impl TerrainGrid {
+    /// Tile columns across the 128-sector map.
+    pub const COLS: usize = 128 * 16;
+
+    fn build(world: &WorldData) -> Self {
+        // Indoor map_mem holds a single 32-sector-row strip.
+        let sector_rows = if world.region_num >= 8 { 32 } else { 128 };
+        // Per tile and 8-pixel row within it: both cells, already packed.
+        let tile_rows: [[u8; 4]; 256] =
+            std::array::from_fn(|t| Self::tile_rows(&world.terra_mem, t as u8));
+        let rows = sector_rows * 8 * 4;
+        let mut cells = vec![0u8; rows * Self::COLS];
+        for (row, line) in cells.chunks_exact_mut(Self::COLS).enumerate() {
+            let imy = row >> 2;
+            let (ys, local_y, sub) = (imy >> 3, imy & 7, row & 3);
+            for (xs, sector) in line.chunks_exact_mut(16).enumerate() {
+                let sec_num = world.sector_at(xs, ys);
+                for (local_x, cell) in sector.iter_mut().enumerate() {
+                    *cell = tile_rows[world.tile_at(sec_num, local_x, local_y) as usize][sub];
+                }
+            }
+        }
+        TerrainGrid { cells, rows }
+    }
+
+    /// Both cells of each 8-pixel row of `tile`, packed.
+    fn tile_rows(terra_mem: &[u8; 1024], tile: u8) -> [u8; 4] {
+        let t = tile as usize;
+        let kind = (terra_mem[t * 4 + 1] >> 4) & 0xF;
+        let mask = terra_mem[t * 4 + 2];
+        std::array::from_fn(|r| {
+            let left = if mask & (0x80 >> r) != 0 { kind } else { 0 };
+            let right = if mask & (0x08 >> r) != 0 { kind } else { 0 };
+            left | right << 4
+        })
+    }
+
+    /// Rewrite tile (local_x, local_y) of sector `sec_num` at every map
+    /// position that uses it.
+    fn patch(&mut self, map_mem: &[u8], sec_num: usize, local_x: usize, local_y: usize, packed: [u8; 4]) {
+        for (pos, _) in map_mem.iter().enumerate().filter(|&(_, &s)| s as usize == sec_num) {
+            let (xs, ys) = (pos % 128, pos / 128);
+            let row = (ys * 8 + local_y) * 4;
+            if row >= self.rows {
+                break;
+            }
+            for (sub, &b) in packed.iter().enumerate() {
+                self.cells[(row + sub) * Self::COLS + xs * 16 + local_x] = b;
+            }
+        }
+    }
+
+    /// Terrain type at pixel (x, y), with y already relative to the map base
+    /// (indoor yreg removed).  `None` outside the grid.
+    #[inline]
+    pub fn get(&self, x: i32, y: i32) -> Option<u8> {
+        let (col, row) = ((x >> 4) as usize, (y >> 3) as usize);
+        if x < 0 || y < 0 || col >= Self::COLS || row >= self.rows {
+            return None;
+        }
+        let b = self.cells[row * Self::COLS + col];
+        Some((b >> ((x & 8) >> 1)) & 0xF)
+    }
+}
+
+/// Terrain colour byte (`terra_mem[tile * 4 + 3]`) of every tile on the
+/// wrapping 2048×1024 tile map: the source of the `map_view::bigdraw`
+/// overview, one byte per overview pixel.
+#[derive(Clone)]
+pub struct OverviewRaster {
+    cells: Vec<u8>,
+}
+
+impl OverviewRaster {
+    /// Tile columns and rows the overview wraps at.
+    pub const COLS: usize = 128 * 16;
+    pub const ROWS: usize = 128 * 8;
+
+    /// Rows are filled in parallel bands.
+    fn build(world: &WorldData) -> Self {
+        let colour: [u8; 256] = std::array::from_fn(|t| world.terra_mem[t * 4 + 3]);
+        let mut cells = vec![0u8; Self::COLS * Self::ROWS];
+        let threads = std::thread::available_parallelism().map_or(1, |n| n.get()).min(8);
+        let band_rows = Self::ROWS.div_ceil(threads);
+        std::thread::scope(|s| {
+            for (band, chunk) in cells.chunks_mut(band_rows * Self::COLS).enumerate() {
+                let colour = &colour;
+                s.spawn(move || {
+                    for (i, line) in chunk.chunks_exact_mut(Self::COLS).enumerate() {
+                        let ty = band * band_rows + i;
+                        let (ys, local_y) = (ty >> 3, ty & 7);
+                        for (xs, sector) in line.chunks_exact_mut(16).enumerate() {
+                            let sec_num = world.sector_at(xs, ys);
+                            for (local_x, cell) in sector.iter_mut().enumerate() {
+                                *cell = colour[world.tile_at(sec_num, local_x, local_y) as usize];
+                            }
+                        }
+                    }
+                });
+            }
+        });
+        OverviewRaster { cells }
+    }
+
+    /// Colour bytes of tile row `ty` (0..ROWS).
+    pub fn row(&self, ty: usize) -> &[u8] {
+        &self.cells[ty * Self::COLS..(ty + 1) * Self::COLS]
+    }
 }
 
 impl WorldData {
@@ -32,8 +168,10 @@ impl WorldData {
             sector_mem: Box::new([0u8; 32768]),
             map_mem: Box::new([0u8; MAP_MEM_SIZE]),
             terra_mem: Box::new([0u8; 1024]),
-            image_mem: Box::new([0u8; 81920]),
+            image_mem: vec![0u8; IMAGE_MEM_SIZE],
             region_num: 0,
+            terrain_grid: OnceLock::new(),
+            overview: OnceLock::new(),
         }
     }
 
@@ -56,11 +194,51 @@ impl WorldData {
         terra_block: u32,
         terra2_block: u32,
         image_group_blocks: &[u32],
+    ) -> Result<Self> {
+        let mut world = Self::load_terrain(adf, region_num, sector_block, map_blocks, terra_block, terra2_block)?;
+        let mut image_mem = vec![0u8; IMAGE_MEM_SIZE];
+
+        // Load image groups. Each group = IMAGE_BLOCKS_PER_GROUP (40) consecutive ADF blocks.
+        // Groups are packed consecutively in image_mem: group 0 at 0, group 1 at 20480, etc.
+        for (gi, &group_block) in image_group_blocks
+            .iter()
+            .enumerate()
+            .take(IMAGE_GROUP_COUNT as usize)
+        {
+            let dest_base = gi * (IMAGE_BLOCKS_PER_GROUP as usize * 512);
+            if let Ok(slice) = Self::try_load(adf, group_block, IMAGE_BLOCKS_PER_GROUP) {
+                if dest_base + slice.len() > image_mem.len() {
+                    eprintln!(
+                        "world_data: image group {} exceeds buffer ({} + {} > {})",
+                        gi,
+                        dest_base,
+                        slice.len(),
+                        image_mem.len()
+                    );
+                    continue;
+                }
+                let dest = &mut image_mem[dest_base..dest_base + slice.len()];
+                dest.copy_from_slice(slice);
+            }
+        }
+
+        world.image_mem = image_mem;
+        Ok(world)
+    }
+
+    /// Like `load`, but skips the tile images (image_mem stays empty).
+    /// Pair with `TileAtlas::from_adf` to decode tiles straight from the disk image.
+    pub fn load_terrain(
+        adf: &AdfDisk,
+        region_num: u8,
+        sector_block: u32,
+        map_blocks: &[u32],
+        terra_block: u32,
+        terra2_block: u32,
     ) -> Result<Self> {
         let mut sector_mem = Box::new([0u8; 32768]);
         let mut map_mem = Box::new([0u8; MAP_MEM_SIZE]);
         let mut terra_mem = Box::new([0u8; 1024]);
-        let mut image_mem = Box::new([0u8; 81920]);
 
         if let Ok(slice) = Self::try_load(adf, sector_block, SECTOR_BLOCKS) {
             sector_mem[..slice.len()].copy_from_slice(slice);
@@ -91,39 +269,22 @@ impl WorldData {
                 .copy_from_slice(&slice[..slice.len().min(512)]);
         }
 
-        // Load image groups. Each group = IMAGE_BLOCKS_PER_GROUP (40) consecutive ADF blocks.
-        // Groups are packed consecutively in image_mem: group 0 at 0, group 1 at 20480, etc.
-        for (gi, &group_block) in image_group_blocks
-            .iter()
-            .enumerate()
-            .take(IMAGE_GROUP_COUNT as usize)
-        {
-            let dest_base = gi * (IMAGE_BLOCKS_PER_GROUP as usize * 512);
-            if let Ok(slice) = Self::try_load(adf, group_block, IMAGE_BLOCKS_PER_GROUP) {
-                if dest_base + slice.len() > image_mem.len() {
-                    eprintln!(
-                        "world_data: image group {} exceeds buffer ({} + {} > {})",
-                        gi,
-                        dest_base,
-                        slice.len(),
-                        image_mem.len()
-                    );
-                    continue;
-                }
-                let dest = &mut image_mem[dest_base..dest_base + slice.len()];
-                dest.copy_from_slice(slice);
-            }
-        }
-
         Ok(WorldData {
             sector_mem,
             map_mem,
             terra_mem,
-            image_mem,
+            image_mem: Vec::new(),
             region_num,
+            terrain_grid: OnceLock::new(),
+            overview: OnceLock::new(),
         })
     }
 
+    /// The 40 ADF blocks of the image group starting at `group_block`, or None if out of range.
+    pub fn image_group_slice(adf: &AdfDisk, group_block: u32) -> Option<&[u8]> {
+        Self::try_load(adf, group_block, IMAGE_BLOCKS_PER_GROUP).ok()
+    }
+
     fn try_load(adf: &AdfDisk, f_block: u32, count: u32) -> Result<&[u8]> {
         let end_block = f_block + count;
         if end_block as usize > adf.num_blocks() {
@@ -154,6 +315,32 @@ impl WorldData {
         self.sector_mem[(base + ly * 16 + lx).min(32767)]
     }
 
+    /// The packed terrain grid, built from the current tables on first use.
+    /// Clones share it until one of them changes a tile.
+    pub fn terrain_grid(&self) -> &TerrainGrid {
+        self.terrain_grid
+            .get_or_init(|| Arc::new(TerrainGrid::build(self)))
+    }
+
+    /// Give this copy its own terrain grid and overview, so the first
+    /// `set_tile_at_image` patches them in place instead of copying them
+    /// mid-tick.
+    pub fn unshare_caches(&mut self) {
+        if let Some(grid) = self.terrain_grid.get_mut() {
+            Arc::make_mut(grid);
+        }
+        if let Some(overview) = self.overview.get_mut() {
+            Arc::make_mut(overview);
+        }
+    }
+
+    /// The overview colour raster, built from the current tables on first use.
+    /// Clones share it until one of them changes a tile.
+    pub fn overview(&self) -> &OverviewRaster {
+        self.overview
+            .get_or_init(|| Arc::new(OverviewRaster::build(self)))
+    }
+
     /// Write a tile into sector_mem by image-space coordinates.
     /// imx = pixel_x / 16, imy = pixel_y / 32 (after any indoor Y offset adjustment).
     /// Mirrors `*(mapxy(x, y)) = tile` in fmain.c doorfind().
@@ -166,6 +353,19 @@ impl WorldData {
         let offset = sec_num * 128 + local_y * 16 + local_x;
         if offset < 32768 {
             self.sector_mem[offset] = tile;
+            // The sector may appear at many map positions; patch each one.
+            if let Some(grid) = self.terrain_grid.get_mut() {
+                let packed = TerrainGrid::tile_rows(&self.terra_mem, tile);
+                Arc::make_mut(grid).patch(&self.map_mem[..], sec_num, local_x, local_y, packed);
+            }
+            if let Some(overview) = self.overview.get_mut() {
+                let colour = self.terra_mem[tile as usize * 4 + 3];
+                let cells = &mut Arc::make_mut(overview).cells;
+                for (pos, _) in self.map_mem.iter().enumerate().filter(|&(_, &s)| s as usize == sec_num) {
+                    let (xs, ys) = (pos % 128, pos / 128);
+                    cells[(ys * 8 + local_y) * OverviewRaster::COLS + xs * 16 + local_x] = colour;
+                }
+            }
         }
     }
 
@@ -207,4 +407,27 @@ mod tests {
         let y = ((43u16 << 8) | 64) as f32;
         assert_eq!(w.sector_at_pos(x, y), 144);
     }
+
+    #[test]
+    fn set_tile_at_image_patches_terrain_grid() {
+        let mut w = WorldData::empty();
+        w.terra_mem[5] = 3 << 4; // tile 1: terrain type 3
+        w.terra_mem[6] = 0xFF; // every cell set
+        assert_eq!(w.terrain_grid().get(40, 72), Some(0));
+        // imx = 40/16 = 2, imy = 72/32 = 2 → sector 0, tile (2, 2).
+        w.set_tile_at_image(2, 2, 1);
+        assert_eq!(w.terrain_grid().get(40, 72), Some(3));
+        // Every map position that uses sector 0 sees the change.
+        assert_eq!(w.terrain_grid().get(40 + 256, 72 + 256), Some(3));
+        assert!(w.terrain_grid().cells == TerrainGrid::build(&w).cells);
+    }
+
+    #[test]
+    fn terrain_grid_covers_only_the_loaded_indoor_strip() {
+        let mut w = WorldData::empty();
+        w.region_num = 9;
+        assert_eq!(w.terrain_grid().get(0, 32 * 256 - 1), Some(0));
+        assert_eq!(w.terrain_grid().get(0, 32 * 256), None);
+        assert_eq!(w.terrain_grid().get(128 * 256, 0), None);
+    }
 }
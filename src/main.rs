@@ -21,18 +21,18 @@ use crate::game::colors::Palette;
 use crate::game::copy_protect_scene::CopyProtectScene;
 use crate::game::cursor::CursorAsset;
 use crate::game::debug_command::{DebugCommand, DEFAULT_TICK_RATE_HZ};
-use crate::game::debug_tui::bridge::{build_ecs_actor_snapshots, build_ecs_hero_extras, build_ecs_narrative_preview};
+use crate::game::debug_tui::bridge::update_ecs_snapshot;
 use crate::game::debug_tui::{DebugConsole, DebugSnapshot};
 use crate::game::game_clock::GameClock;
-use crate::game::day_phase::DayPhase;
-use crate::game::ecs::scene::EcsScene;
+use crate::game::ecs::journal;
+use crate::game::ecs::scene::{self as ecs_scene, EcsScene};
 use crate::game::intro_scene::IntroScene;
 use crate::game::placard_scene::PlacardScene;
 use crate::game::render_resources::RenderResources;
 use crate::game::scene::{Scene, SceneResult};
 use crate::game::settings::{self, GameSettings};
-use crate::game::songs::{SongLibrary, Track};
-use crate::game::victory_scene::VictoryScene;
+use crate::game::songs::{CompiledTrack, SongLibrary};
+use crate::game::victory_scene::{self, VictoryScene};
 
 #[derive(Parser, Debug)]
 #[command(name = "fmainrs", about = "The Faery Tale Adventure")]
@@ -46,6 +46,24 @@ struct Cli {
     /// Skip the intro sequence and jump straight to gameplay (requires --debug)
     #[arg(long, requires = "debug")]
     skip_intro: bool,
+    /// Most times per second the debug console redraws (requires --debug)
+    #[arg(long, requires = "debug", default_value_t = 30)]
+    debug_redraw_hz: u32,
+    /// Record the first gameplay session's input to FILE, for replay with
+    /// `sim_bench --replay`
+    #[arg(long, value_name = "FILE")]
+    record: Option<std::path::PathBuf>,
+    /// Ticks between state hashes in the recorded journal (0 = none)
+    #[arg(long, requires = "record", default_value_t = journal::DEFAULT_HASH_INTERVAL)]
+    record_hash_interval: u32,
+    /// Draw the playfield from tile and sprite textures on the GPU instead of
+    /// converting the software framebuffer every frame
+    #[arg(long)]
+    gpu_playfield: bool,
+    /// Run each frame's gameplay ticks on a worker thread while the frame is
+    /// presented. Input shows up one frame later than without it
+    #[arg(long)]
+    pipeline: bool,
     /// Print diagnostic log messages to stderr (no-console path only)
     #[arg(long, short)]
     verbose: bool,
@@ -244,11 +262,8 @@ pub fn main() -> Result<(), String> {
         .map(|a| a.instruments.as_str())
         .unwrap_or("game/v6");
     let song_library: Option<SongLibrary> = SongLibrary::load(Path::new(songs_path));
-    let intro_tracks: Option<[Arc<Track>; 4]> = song_library.as_ref().and_then(|songs| {
-        songs
-            .intro_tracks()
-            .map(|t| t.map(|tr| Arc::new(tr.clone())))
-    });
+    let intro_tracks: Option<[Arc<CompiledTrack>; 4]> =
+        song_library.as_ref().and_then(|songs| songs.compiled_intro());
     let audio_system: Option<AudioSystem> = {
         match (
             audio_subsystem.as_ref(),
@@ -291,8 +306,12 @@ pub fn main() -> Result<(), String> {
         mouse_cursor = set_mouse(pointer, &bow_palette);
     }
 
-    // Build all SDL3 rendering resources (font atlas, image atlas, render targets).
+    // Build all SDL3 rendering resources (font atlas, render targets); images are
+    // uploaded per scene in the loop below.
     let mut render_resources = RenderResources::build(&tex_maker, &game_lib, &sys_palette);
+    if cli.gpu_playfield {
+        render_resources.enable_gpu_playfield();
+    }
 
     let mut play_tex = tex_maker
         .create_texture_target(Some(PixelFormat::RGBA32), 320, 200)
@@ -323,11 +342,30 @@ pub fn main() -> Result<(), String> {
         VictoryPlacard,
         VictoryImage,
     }
+    /// Images of the scene that follows `phase`, decoded in the background
+    /// while `phase` runs.
+    fn upcoming_images(phase: &ScenePhase) -> &'static [&'static str] {
+        match phase {
+            ScenePhase::CopyProtect => ecs_scene::IMAGES,
+            ScenePhase::VictoryPlacard => victory_scene::IMAGES,
+            _ => &[],
+        }
+    }
     // Holds the EcsScene while brother-succession placards are shown.
     let mut stashed_scene: Option<Box<dyn Scene>> = None;
+    // Only the first gameplay session is recorded.
+    let mut record = cli.record.clone();
+    let mut new_gameplay = |show_start_placard: bool| {
+        let mut scene = EcsScene::new(&game_lib, None, show_start_placard);
+        scene.pipelined = cli.pipeline;
+        if let Some(path) = record.take() {
+            scene.record_journal(path, cli.record_hash_interval);
+        }
+        scene
+    };
     let (mut scene_phase, mut active_scene): (ScenePhase, Option<Box<dyn Scene>>) =
         if cli.skip_intro {
-            let gs: Box<dyn Scene> = Box::new(EcsScene::new(&game_lib, None, false));
+            let gs: Box<dyn Scene> = Box::new(new_gameplay(false));
             (ScenePhase::Gameplay, Some(gs))
         } else {
             (
@@ -338,7 +376,7 @@ pub fn main() -> Result<(), String> {
 
     // Debug console (TUI in the launch terminal), active only when --debug is passed
     let mut debug_console: Option<DebugConsole> = if cli.debug {
-        match DebugConsole::new() {
+        match DebugConsole::new(cli.debug_redraw_hz) {
             Ok(dc) => Some(dc),
             Err(e) => {
                 eprintln!("Warning: could not create debug console: {}", e);
@@ -351,6 +389,8 @@ pub fn main() -> Result<(), String> {
     for msg in pre_console_log.drain(..) {
         diag(&mut debug_console, msg);
     }
+    // Updated in place each frame; the console is sent only what changed.
+    let mut debug_status = DebugSnapshot::default();
 
     // Game-side FPS tracking
     let mut game_frame_count: u64 = 0;
@@ -363,12 +403,17 @@ pub fn main() -> Result<(), String> {
     let mut debug_step_budget: u32 = 0;
     let mut debug_tick_hz: u32 = DEFAULT_TICK_RATE_HZ;
     let mut debug_tick_accum: f64 = 0.0;
+    // Turbo (/turbo): gameplay ticks per presented frame, 0 = off.
+    let mut debug_turbo_ticks: u32 = 0;
+    // Images uploaded for the active scene (see Scene::images).
+    let mut scene_images: &'static [&'static str] = &[];
 
     'running: loop {
         let raw_delta = clock.update();
         // When the debug console has paused gameplay, freeze scene time by
         // zeroing the delta. Step frames temporarily consume from the budget.
-        let delta_ticks = if clock.paused && debug_step_budget == 0 {
+        let frozen = clock.paused && debug_step_budget == 0;
+        let delta_ticks = if frozen {
             0
         } else {
             if debug_step_budget > 0 {
@@ -381,8 +426,11 @@ pub fn main() -> Result<(), String> {
         // Accumulate fractional ticks so rates like 15 Hz work correctly
         // even though raw_delta is discrete (0 or 1 per frame at 60 fps).
         // Only gameplay is subject to the tick-rate throttle; intro/cutscene
-        // scenes always run at the native 30 Hz tick rate.
-        let delta_ticks = if matches!(scene_phase, ScenePhase::Gameplay) {
+        // scenes always run at the native 30 Hz tick rate.  Turbo replaces
+        // the throttle with a fixed batch per frame (still honouring pause).
+        let delta_ticks = if matches!(scene_phase, ScenePhase::Gameplay) && debug_turbo_ticks > 0 {
+            if frozen { 0 } else { debug_turbo_ticks }
+        } else if matches!(scene_phase, ScenePhase::Gameplay) {
             debug_tick_accum += delta_ticks as f64 * (debug_tick_hz as f64 / 30.0);
             let d = debug_tick_accum as u32;
             debug_tick_accum -= d as f64;
@@ -532,6 +580,20 @@ pub fn main() -> Result<(), String> {
 
         // Scene rendering takes priority when active
         if let Some(ref mut scene) = active_scene {
+            if scene.images() != scene_images {
+                // Free what neither the new scene nor a stashed one draws.
+                let stashed = stashed_scene.as_ref().map_or(&[][..], |s| s.images());
+                let stale: Vec<&str> = scene_images
+                    .iter()
+                    .copied()
+                    .filter(|n| !scene.images().contains(n) && !stashed.contains(n))
+                    .collect();
+                render_resources.evict_images(&stale);
+                game_lib.evict_images(&stale);
+                scene_images = scene.images();
+                render_resources.load_images(&game_lib, scene_images);
+                game_lib.prewarm_images(upcoming_images(&scene_phase));
+            }
             let mut resources = render_resources.prepare(&mut scratch_tex, audio_system.as_ref());
             let result = scene.update(
                 &mut canvas,
@@ -569,11 +631,7 @@ pub fn main() -> Result<(), String> {
                             if let Some(ref a) = audio_system {
                                 a.stop_score();
                             }
-                            active_scene = Some(Box::new(EcsScene::new(
-                                &game_lib,
-                                None,
-                                true,
-                            )));
+                            active_scene = Some(Box::new(new_gameplay(true)));
                             scene_phase = ScenePhase::Gameplay;
                             dirty = true;
                             clear_flag = true;
@@ -597,7 +655,7 @@ pub fn main() -> Result<(), String> {
                                 scene_phase = ScenePhase::VictoryPlacard;
                             } else {
                                 // Game over or restart — re-create gameplay scene
-                                active_scene = Some(Box::new(EcsScene::new(&game_lib, None, true)));
+                                active_scene = Some(Box::new(new_gameplay(true)));
                             }
                             dirty = true;
                         }
@@ -649,7 +707,7 @@ pub fn main() -> Result<(), String> {
                     break 'running;
                 }
                 SceneResult::Continue => {
-                    canvas.present();
+                    scene.present(&mut canvas, &game_lib);
                 }
                 SceneResult::BrotherSuccession { dead_placard, start_placard } => {
                     // EcsScene has already swapped the hero entity internally.
@@ -734,136 +792,64 @@ pub fn main() -> Result<(), String> {
             (debug_console.as_mut(), active_scene.as_mut())
         {
             let cmds = dc.drain_commands();
+            let song_group_count = song_library
+                .as_ref()
+                .map(|l| l.tracks.len() / SongLibrary::VOICES)
+                .unwrap_or(0);
+            let current_song_group = audio_system.as_ref().and_then(|a| a.current_group());
             if let Some(ecs) = scene.as_any_mut().downcast_mut::<EcsScene>() {
                 for cmd in cmds {
-                    if let DebugCommand::SetTickRate { hz } = cmd {
-                        debug_tick_hz = hz;
-                        dc.log(format!(
-                            "Tick rate: {} Hz  ({:.2}x speed)",
-                            hz,
-                            hz as f64 / 30.0
-                        ));
-                    } else {
-                        crate::game::ecs::debug_commands::handle(cmd, &mut ecs.world, &mut ecs.res);
+                    match cmd {
+                        DebugCommand::SetTickRate { hz } => {
+                            debug_tick_hz = hz;
+                            dc.log(format!(
+                                "Tick rate: {} Hz  ({:.2}x speed)",
+                                hz,
+                                hz as f64 / 30.0
+                            ));
+                        }
+                        DebugCommand::SetTurbo { ticks_per_frame } => {
+                            debug_turbo_ticks = ticks_per_frame;
+                            debug_tick_accum = 0.0;
+                        }
+                        DebugCommand::SetProfiling { enabled } => ecs.profiler.set_enabled(enabled),
+                        DebugCommand::ResetProfiler => ecs.profiler.reset(),
+                        cmd => crate::game::ecs::debug_commands::handle(cmd, &mut ecs.world, &mut ecs.res),
                     }
                 }
+                ecs.turbo = debug_turbo_ticks > 0;
                 for msg in ecs.res.diag_log.drain(..) {
                     dc.log(msg);
                 }
-                let song_group_count = song_library
-                    .as_ref()
-                    .map(|l| l.tracks.len() / SongLibrary::VOICES)
-                    .unwrap_or(0);
-                let current_song_group = audio_system.as_ref().and_then(|a| a.current_group());
-                // Derive time fields from ECS clock.
-                let ecs_daynight = ecs.res.clock.daynight;
-                let ecs_dayperiod = (ecs_daynight / 2000) as u8;
-                // daynight 0..24000 ≡ 24 h; hour = daynight * 24 / 24000
-                let ecs_hour = (ecs_daynight as u32 * 24 / 24000) as u32;
-                let ecs_minute = ((ecs_daynight as u32 * 24 * 60 / 24000) % 60) as u32;
-                let ecs_day_phase = match ecs_dayperiod {
-                    0..=3 => DayPhase::Midnight,
-                    4..=5 => DayPhase::Morning,
-                    6..=8 => DayPhase::Midday,
-                    _     => DayPhase::Evening,
-                };
-                // Hero position + stats from ECS.
-                let (hero_x, hero_y, hero_brother, hero_vit, hero_hunger, hero_fatigue,
-                     hero_brave, hero_luck, hero_kind, hero_wealth) = {
-                    use crate::game::ecs::components::{Position, BrotherKind, HeroStats};
-                    let px = ecs.world.get::<&Position>(ecs.res.hero_entity)
-                        .map(|p| (p.x as u16, p.y as u16)).unwrap_or((0, 0));
-                    let bk = ecs.world.get::<&BrotherKind>(ecs.res.hero_entity)
-                        .map(|b| b.id).unwrap_or(0);
-                    let hs = ecs.world.get::<&HeroStats>(ecs.res.hero_entity);
-                    let (v, h, f, br, lk, ki, we) = hs.as_deref().map(|s| (
-                        s.vitality, s.hunger, s.fatigue, s.brave, s.luck, s.kind, s.wealth,
-                    )).unwrap_or_default();
-                    (px.0, px.1, bk, v, h, f, br, lk, ki, we)
-                };
-                let hero_extras = build_ecs_hero_extras(&ecs.world, ecs.res.hero_entity, &ecs.res);
-                let hero_stuff: Vec<u8> = {
-                    use crate::game::ecs::components::Inventory;
-                    ecs.world.get::<&Inventory>(ecs.res.hero_entity)
-                        .map(|inv| inv.stuff.to_vec())
-                        .unwrap_or_default()
-                };
-                let status = DebugSnapshot {
-                    fps: game_fps,
-                    tps: game_tps,
-                    game_ticks: clock.game_ticks,
-                    paused: clock.paused,
-                    is_paused: clock.paused,
-                    scene_name: Some("Gameplay".to_owned()),
-                    song_group_count,
-                    current_song_group,
-                    cave_mode: audio_system.as_ref().map_or(false, |a| a.is_cave_mode()),
-                    game_day: ecs.res.clock.game_days,
-                    game_hour: ecs_hour,
-                    game_minute: ecs_minute,
-                    daynight: ecs_daynight,
-                    lightlevel: ecs.res.clock.lightlevel,
-                    day_phase: ecs_day_phase,
-                    hero_x,
-                    hero_y,
-                    brother: hero_brother,
-                    region_num: ecs.res.region.region_num,
-                    vitality: hero_vit,
-                    hunger: hero_hunger,
-                    fatigue: hero_fatigue,
-                    brave: hero_brave as u16,
-                    luck: hero_luck,
-                    kind: hero_kind,
-                    wealth: hero_wealth as u16,
-                    max_vitality: hero_extras.max_vitality,
-                    hero_weapon: hero_extras.hero_weapon,
-                    hero_weapon_name: hero_extras.hero_weapon_name,
-                    hero_state_u8: hero_extras.hero_state_u8,
-                    hero_state_name: hero_extras.hero_state_name,
-                    hero_facing: hero_extras.hero_facing,
-                    hero_environ: hero_extras.hero_environ,
-                    active_carrier: hero_extras.active_carrier,
-                    active_carrier_name: hero_extras.active_carrier_name,
-                    jewel_timer: hero_extras.jewel_timer,
-                    orb_timer: hero_extras.orb_timer,
-                    freeze_timer: hero_extras.freeze_timer,
-                    actors: build_ecs_actor_snapshots(&ecs.world, ecs.res.hero_entity, 20),
-                    princess_captive: ecs.res.quest.princess_rescues < 3,
-                    princess_rescues: ecs.res.quest.princess_rescues as u16,
-                    statues_collected: ecs.res.quest.statues_collected,
-                    has_writ: ecs.res.quest.writ_obtained,
-                    has_talisman: ecs.res.quest.talisman_obtained,
-                    narrative_pending_count: ecs.res.narrative.pending.len() as u32,
-                    narrative_active: ecs.res.narrative.active.is_some(),
-                    narrative_timer: ecs.res.narrative.active_ticks,
-                    narrative_preview: build_ecs_narrative_preview(&ecs.res.narrative, 3),
-                    stuff: hero_stuff,
-                    ..DebugSnapshot::default()
-                };
+                let status = &mut debug_status;
+                if status.scene_name != Some("Gameplay") {
+                    *status = DebugSnapshot::default();
+                    status.scene_name = Some("Gameplay");
+                }
+                update_ecs_snapshot(status, &ecs.world, &ecs.res);
+                status.fps = game_fps;
+                status.tps = game_tps;
+                status.game_ticks = clock.game_ticks;
+                status.paused = clock.paused;
+                status.is_paused = clock.paused;
+                status.song_group_count = song_group_count;
+                status.current_song_group = current_song_group;
+                status.cave_mode = audio_system.as_ref().map_or(false, |a| a.is_cave_mode());
+                ecs.profiler.summary_into(&mut status.profile);
                 dc.update_status(status);
             } else {
                 // Not yet in gameplay (intro / copy-protect scene)
-                let song_group_count = song_library
-                    .as_ref()
-                    .map(|l| l.tracks.len() / SongLibrary::VOICES)
-                    .unwrap_or(0);
-                let current_song_group = audio_system.as_ref().and_then(|a| a.current_group());
-                let status = DebugSnapshot {
-                    fps: game_fps,
-                    tps: game_tps,
-                    game_day: 0,
-                    game_hour: 0,
-                    game_minute: 0,
-                    day_phase: DayPhase::default(),
-                    daynight: 0,
-                    lightlevel: 0,
-                    game_ticks: clock.game_ticks,
-                    paused: clock.paused,
-                    scene_name: Some("Intro".to_owned()),
-                    song_group_count,
-                    current_song_group,
-                    ..DebugSnapshot::default()
-                };
+                let status = &mut debug_status;
+                if status.scene_name != Some("Intro") {
+                    *status = DebugSnapshot::default();
+                    status.scene_name = Some("Intro");
+                }
+                status.fps = game_fps;
+                status.tps = game_tps;
+                status.game_ticks = clock.game_ticks;
+                status.paused = clock.paused;
+                status.song_group_count = song_group_count;
+                status.current_song_group = current_song_group;
                 dc.update_status(status);
                 // Drain any leftover commands (no-op during intro)
                 for _ in cmds {}
@@ -910,27 +896,19 @@ pub fn main() -> Result<(), String> {
             dc.render();
         } else if let Some(ref mut dc) = debug_console {
             // Console active but no scene yet
-            let song_group_count = song_library
+            let status = &mut debug_status;
+            if status.scene_name.is_some() {
+                *status = DebugSnapshot::default();
+            }
+            status.fps = game_fps;
+            status.tps = game_tps;
+            status.game_ticks = clock.game_ticks;
+            status.paused = clock.paused;
+            status.song_group_count = song_library
                 .as_ref()
                 .map(|l| l.tracks.len() / SongLibrary::VOICES)
                 .unwrap_or(0);
-            let current_song_group = audio_system.as_ref().and_then(|a| a.current_group());
-            let status = DebugSnapshot {
-                fps: game_fps,
-                tps: game_tps,
-                game_day: 0,
-                game_hour: 0,
-                game_minute: 0,
-                day_phase: DayPhase::default(),
-                daynight: 0,
-                lightlevel: 0,
-                game_ticks: clock.game_ticks,
-                paused: clock.paused,
-                scene_name: None,
-                song_group_count,
-                current_song_group,
-                ..DebugSnapshot::default()
-            };
+            status.current_song_group = audio_system.as_ref().and_then(|a| a.current_group());
             dc.update_status(status);
             dc.render();
         }